@@ -32,16 +32,33 @@ enum class FilterType
     POTASSIUM
 };
 
+/**
+ * @brief Стадии конвейера фильтрации канала
+ * @details Порядок стадий канала задаётся config.filterStageOrder[FilterType]: полубайты FilterStage,
+ * младший полубайт — первая стадия, NONE завершает список. Например, 0x5431 — выбросы, EMA, Калман, окно.
+ */
+enum class FilterStage : uint8_t
+{
+    NONE = 0,
+    OUTLIER_GATE = 1,   // Отсев выбросов по σ скользящей статистики (config.adaptiveFiltering)
+    EC_SPIKE = 2,       // Подавление периодических всплесков относительно базового уровня
+    EMA = 3,            // Экспоненциальное сглаживание
+    KALMAN = 4,         // Фильтр Калмана (config.kalmanEnabled)
+    MOVING_WINDOW = 5,  // Скользящее среднее / медиана (config.movingAverageWindow)
+};
+
 // ============================================================================
 // ПУБЛИЧНЫЕ ФУНКЦИИ
 // ============================================================================
 
 /**
- * @brief Применяет улучшенную фильтрацию к данным датчика
+ * @brief Пропускает каждый канал показаний через его цепочку фильтров
  * @param data Данные датчика для фильтрации
- * @details Комбинирует экспоненциальное сглаживание, адаптивные пороги и фильтр Калмана
+ * @param windows Окна скользящего среднего опрашиваемого датчика (стадия MOVING_WINDOW)
+ * @param adaptive true — выполнять все стадии; false — только MOVING_WINDOW (дополнительные датчики шины,
+ * у которых нет собственной статистики, EMA и Калмана)
  */
-void applyAdvancedFiltering(SensorData& data);
+void applyAdvancedFiltering(SensorData& data, SensorFilterState& windows, bool adaptive);
 
 /**
  * @brief Сбрасывает все фильтры в начальное состояние
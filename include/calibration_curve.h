@@ -0,0 +1,206 @@
+#pragma once
+
+/**
+ * @file calibration_curve.h
+ * @brief Скомпилированная калибровочная кривая одного канала
+ * @details Точки калибровки сортируются один раз при загрузке таблицы, для каждого отрезка заранее считаются
+ * наклон (линейная интерполяция) или касательные монотонного кубического сплайна (PCHIP, Фритч–Карлсон).
+ * Поиск отрезка — бинарный, расчёт значения не выделяет память. За пределами таблицы возвращается
+ * эталон ближайшей крайней точки, как и в прежней реализации.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+enum class CalibrationInterpolation : uint8_t
+{
+    LINEAR = 0,  // Кусочно-линейная
+    PCHIP = 1    // Монотонный кубический сплайн Эрмита: без выбросов между точками
+};
+
+class CalibrationCurve
+{
+   public:
+    /**
+     * @brief Построить кривую по точкам (сырое значение → эталон)
+     * @param raw Сырые значения
+     * @param reference Эталонные значения
+     * @param count Количество точек; порядок произвольный, при повторе сырого значения остаётся первая точка
+     */
+    void build(const float* raw, const float* reference, size_t count, CalibrationInterpolation interpolation)
+    {
+        mode = interpolation;
+
+        std::vector<std::pair<float, float>> sorted;
+        sorted.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            sorted.emplace_back(raw[i], reference[i]);
+        }
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const std::pair<float, float>& lhs, const std::pair<float, float>& rhs)
+                         { return lhs.first < rhs.first; });
+        sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                                 [](const std::pair<float, float>& lhs, const std::pair<float, float>& rhs)
+                                 { return lhs.first == rhs.first; }),
+                     sorted.end());
+
+        xs.clear();
+        ys.clear();
+        xs.reserve(sorted.size());
+        ys.reserve(sorted.size());
+        for (const auto& point : sorted)
+        {
+            xs.push_back(point.first);
+            ys.push_back(point.second);
+        }
+
+        computeSlopes();
+        if (mode == CalibrationInterpolation::PCHIP)
+        {
+            computeTangents();
+        }
+        else
+        {
+            tangents.clear();
+        }
+    }
+
+    void clear()
+    {
+        xs.clear();
+        ys.clear();
+        slopes.clear();
+        tangents.clear();
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return xs.size();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return xs.empty();
+    }
+
+    [[nodiscard]] CalibrationInterpolation interpolation() const
+    {
+        return mode;
+    }
+
+    // Откалиброванное значение; пустая кривая возвращает исходное
+    [[nodiscard]] float evaluate(float rawValue) const
+    {
+        const size_t count = xs.size();
+        if (count == 0)
+        {
+            return rawValue;
+        }
+        if (count == 1 || rawValue <= xs.front())
+        {
+            return ys.front();
+        }
+        if (rawValue >= xs.back())
+        {
+            return ys.back();
+        }
+
+        // Индекс отрезка [xs[i], xs[i+1]], содержащего rawValue
+        const size_t i = static_cast<size_t>(std::upper_bound(xs.begin(), xs.end(), rawValue) - xs.begin()) - 1;
+        const float dx = rawValue - xs[i];
+
+        if (mode == CalibrationInterpolation::LINEAR)
+        {
+            return ys[i] + slopes[i] * dx;
+        }
+
+        // Кубический полином Эрмита на отрезке
+        const float h = xs[i + 1] - xs[i];
+        const float t = dx / h;
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        const float h00 = 2.0F * t3 - 3.0F * t2 + 1.0F;
+        const float h10 = t3 - 2.0F * t2 + t;
+        const float h01 = -2.0F * t3 + 3.0F * t2;
+        const float h11 = t3 - t2;
+        return h00 * ys[i] + h10 * h * tangents[i] + h01 * ys[i + 1] + h11 * h * tangents[i + 1];
+    }
+
+   private:
+    void computeSlopes()
+    {
+        slopes.assign(xs.size() > 1 ? xs.size() - 1 : 0, 0.0F);
+        for (size_t i = 0; i + 1 < xs.size(); ++i)
+        {
+            slopes[i] = (ys[i + 1] - ys[i]) / (xs[i + 1] - xs[i]);
+        }
+    }
+
+    static float sign(float value)
+    {
+        return static_cast<float>((value > 0.0F) - (value < 0.0F));
+    }
+
+    // Крайняя касательная по трём точкам с сохранением формы
+    static float edgeTangent(float h0, float h1, float d0, float d1)
+    {
+        float tangent = ((2.0F * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+        if (sign(tangent) != sign(d0))
+        {
+            tangent = 0.0F;
+        }
+        else if (sign(d0) != sign(d1) && std::fabs(tangent) > std::fabs(3.0F * d0))
+        {
+            tangent = 3.0F * d0;
+        }
+        return tangent;
+    }
+
+    void computeTangents()
+    {
+        const size_t count = xs.size();
+        tangents.assign(count, 0.0F);
+        if (count < 2)
+        {
+            return;
+        }
+        if (count == 2)
+        {
+            tangents[0] = slopes[0];
+            tangents[1] = slopes[0];
+            return;
+        }
+
+        // Внутренние точки: взвешенное гармоническое среднее соседних наклонов, 0 на экстремумах
+        for (size_t k = 1; k + 1 < count; ++k)
+        {
+            const float dPrev = slopes[k - 1];
+            const float dNext = slopes[k];
+            if (dPrev * dNext <= 0.0F)
+            {
+                tangents[k] = 0.0F;
+                continue;
+            }
+            const float hPrev = xs[k] - xs[k - 1];
+            const float hNext = xs[k + 1] - xs[k];
+            const float w1 = 2.0F * hNext + hPrev;
+            const float w2 = hNext + 2.0F * hPrev;
+            tangents[k] = (w1 + w2) / (w1 / dPrev + w2 / dNext);
+        }
+
+        tangents[0] = edgeTangent(xs[1] - xs[0], xs[2] - xs[1], slopes[0], slopes[1]);
+        tangents[count - 1] = edgeTangent(xs[count - 1] - xs[count - 2], xs[count - 2] - xs[count - 3],
+                                          slopes[count - 2], slopes[count - 3]);
+    }
+
+    CalibrationInterpolation mode = CalibrationInterpolation::LINEAR;
+    std::vector<float> xs;        // Сырые значения по возрастанию
+    std::vector<float> ys;        // Эталонные значения
+    std::vector<float> slopes;    // Наклон каждого отрезка
+    std::vector<float> tangents;  // Касательные в точках (только PCHIP)
+};
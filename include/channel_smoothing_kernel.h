@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file channel_smoothing_kernel.h
+ * @brief Экспоненциальное сглаживание и скалярный фильтр Калмана сразу для группы каналов
+ * @details Состояние хранится структурой массивов (по массиву на величину, элемент — канал), а шаг фильтра —
+ * один цикл без ветвлений по каналам, который компилятор может векторизовать. Маска выбирает каналы,
+ * для которых стадия выполняется на этом шаге; остальные каналы не меняются.
+ * Выбор между старым и новым значением делается битовой маской, а не ветвлением: так цикл векторизуется
+ * и при -ftrapping-math (по умолчанию), где компилятор не превращает условные float-выражения в select.
+ * Формулы и порядок операций совпадают со скалярной реализацией (S = α·X + (1−α)·S, Калман с P/Q/R),
+ * поэтому результаты побитово равны поканальному расчёту. Для совпадения с устройством на сервере
+ * собирайте без слияния в FMA (-ffp-contract=off), иначе округление зависит от набора инструкций.
+ * Заголовок не зависит от Arduino: тот же код прогоняет архивные данные нескольких датчиков на сервере.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+template <size_t Lanes>
+class ChannelSmoothingKernel
+{
+    static_assert(Lanes > 0, "Нужен хотя бы один канал");
+
+   public:
+    static constexpr size_t LANES = Lanes;
+    static constexpr uint32_t LANE_ACTIVE = 0xFFFFFFFFU;  // Элемент маски: канал участвует в шаге
+    static constexpr uint32_t LANE_IDLE = 0U;             // Элемент маски: канал пропускает шаг
+
+    /**
+     * @param processNoise Шум процесса Q
+     * @param measurementNoise Шум измерений R
+     * @param initialUncertainty Начальная ковариация ошибки P
+     */
+    ChannelSmoothingKernel(float processNoise, float measurementNoise,
+                           float initialUncertainty)  // NOLINT(bugprone-easily-swappable-parameters)
+        : q(processNoise), r(measurementNoise), p0(initialUncertainty)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        smoothed.fill(0.0F);
+        smoothedReady.fill(0);
+        estimate.fill(0.0F);
+        covariance.fill(p0);
+        estimateReady.fill(0);
+    }
+
+    // Коэффициент α канала (уже с поправкой канала)
+    void setAlpha(size_t lane, float value)
+    {
+        alpha[lane] = value;
+    }
+
+    /**
+     * @brief Шаг экспоненциального сглаживания
+     * @param values Значения каналов; для каналов из маски заменяются сглаженными
+     * @param mask LANE_ACTIVE или LANE_IDLE для каждого канала
+     */
+    void smooth(float* values, const uint32_t* mask)
+    {
+        for (size_t i = 0; i < Lanes; ++i)
+        {
+            const float input = values[i];
+            const uint32_t active = mask[i];
+            const float blended = alpha[i] * input + (1.0F - alpha[i]) * smoothed[i];
+            // Первое измерение канала принимается как есть
+            const float next = select(smoothedReady[i], blended, input);
+            smoothed[i] = select(active, next, smoothed[i]);
+            smoothedReady[i] |= active;
+            values[i] = select(active, next, input);
+        }
+    }
+
+    /**
+     * @brief Шаг скалярного фильтра Калмана
+     * @param values Значения каналов; для каналов из маски заменяются оценкой
+     * @param mask LANE_ACTIVE или LANE_IDLE для каждого канала
+     */
+    void kalman(float* values, const uint32_t* mask)
+    {
+        for (size_t i = 0; i < Lanes; ++i)
+        {
+            const float measurement = values[i];
+            const uint32_t active = mask[i];
+
+            // Предсказание и обновление
+            const float predicted = covariance[i] + q;
+            const float gain = predicted / (predicted + r);
+            const float updated = estimate[i] + gain * (measurement - estimate[i]);
+            const float updatedCovariance = (1.0F - gain) * predicted;
+
+            // Первое измерение канала задаёт оценку и не меняет ковариацию
+            const float nextEstimate = select(estimateReady[i], updated, measurement);
+            const float nextCovariance = select(estimateReady[i], updatedCovariance, covariance[i]);
+
+            estimate[i] = select(active, nextEstimate, estimate[i]);
+            covariance[i] = select(active, nextCovariance, covariance[i]);
+            estimateReady[i] |= active;
+            values[i] = select(active, nextEstimate, measurement);
+        }
+    }
+
+    [[nodiscard]] float smoothedValue(size_t lane) const
+    {
+        return smoothed[lane];
+    }
+
+    [[nodiscard]] float kalmanEstimate(size_t lane) const
+    {
+        return estimate[lane];
+    }
+
+   private:
+    // mask — все единицы: a, все нули: b (побитово, без ветвления)
+    static float select(uint32_t mask, float a, float b)
+    {
+        uint32_t bitsA = 0;
+        uint32_t bitsB = 0;
+        std::memcpy(&bitsA, &a, sizeof(bitsA));
+        std::memcpy(&bitsB, &b, sizeof(bitsB));
+        const uint32_t bits = (bitsA & mask) | (bitsB & ~mask);
+        float result = 0.0F;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    float q;
+    float r;
+    float p0;
+
+    // Экспоненциальное сглаживание
+    std::array<float, Lanes> alpha{};
+    std::array<float, Lanes> smoothed{};
+    std::array<uint32_t, Lanes> smoothedReady{};  // Маска: первое измерение уже принято
+
+    // Фильтр Калмана
+    std::array<float, Lanes> estimate{};    // x
+    std::array<float, Lanes> covariance{};  // P
+    std::array<uint32_t, Lanes> estimateReady{};
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+/**
+ * @file config_schema.h
+ * @brief Схема настроек: одна строка таблицы на каждое поле Config
+ * @details CONFIG_VALUE_FIELDS и CONFIG_STRING_FIELDS перечисляют поля Config с ключом NVS, значением по умолчанию,
+ * допустимым диапазоном и местом в экспортируемом JSON. Загрузка, сохранение и сброс (config.cpp), экспорт и импорт
+ * с проверкой диапазонов (routes_config.cpp) получаются разворачиванием таблиц своим макросом-обработчиком, а то,
+ * что зависит от типа поля, задают специализации ConfigField. Новая настройка — одна строка таблицы.
+ * Ключ NVS не длиннее 15 символов, иначе NVS отвечает KEY_TOO_LONG. Поля с группой nullptr в JSON не попадают.
+ * Вручную остаются поля, которые не укладываются в таблицу: порядок стадий фильтров (массив байт), формат пакетов
+ * MQTT (строка в JSON), пароль веб-интерфейса и устаревший 16-битный thingspeakInterval.
+ */
+
+#include <Preferences.h>
+#include <cstdint>
+#include "jxct_config_vars.h"
+#include "jxct_constants.h"
+
+enum class ConfigKind : uint8_t
+{
+    FLAG,    // Битовое поле flags, bool в NVS и JSON
+    UINT8,   // uint8_t
+    UINT16,  // uint16_t
+    UINT32,  // uint32_t
+    FLOAT    // float
+};
+
+template <ConfigKind Kind>
+struct ConfigField;
+
+template <>
+struct ConfigField<ConfigKind::FLAG>
+{
+    using Type = bool;
+    static Type load(Preferences& nvs, const char* key, Type fallback)
+    {
+        return nvs.getBool(key, fallback);
+    }
+    static size_t store(Preferences& nvs, const char* key, Type value)
+    {
+        return nvs.putBool(key, value);
+    }
+};
+
+template <>
+struct ConfigField<ConfigKind::UINT8>
+{
+    using Type = uint8_t;
+    static Type load(Preferences& nvs, const char* key, Type fallback)
+    {
+        return nvs.getUChar(key, fallback);
+    }
+    static size_t store(Preferences& nvs, const char* key, Type value)
+    {
+        return nvs.putUChar(key, value);
+    }
+};
+
+template <>
+struct ConfigField<ConfigKind::UINT16>
+{
+    using Type = uint16_t;
+    static Type load(Preferences& nvs, const char* key, Type fallback)
+    {
+        return nvs.getUShort(key, fallback);
+    }
+    static size_t store(Preferences& nvs, const char* key, Type value)
+    {
+        return nvs.putUShort(key, value);
+    }
+};
+
+template <>
+struct ConfigField<ConfigKind::UINT32>
+{
+    using Type = uint32_t;
+    static Type load(Preferences& nvs, const char* key, Type fallback)
+    {
+        return nvs.getUInt(key, fallback);
+    }
+    static size_t store(Preferences& nvs, const char* key, Type value)
+    {
+        return nvs.putUInt(key, value);
+    }
+};
+
+template <>
+struct ConfigField<ConfigKind::FLOAT>
+{
+    using Type = float;
+    static Type load(Preferences& nvs, const char* key, Type fallback)
+    {
+        return nvs.getFloat(key, fallback);
+    }
+    static size_t store(Preferences& nvs, const char* key, Type value)
+    {
+        return nvs.putFloat(key, value);
+    }
+};
+
+// X(тип, поле Config, ключ NVS, по умолчанию, минимум, максимум, группа JSON, имя в группе)
+#define CONFIG_VALUE_FIELDS(X)                                                                                         \
+    /* MQTT */                                                                                                         \
+    X(FLAG, flags.mqttEnabled, "mqttEnabled", false, 0, 1, "mqtt", "enabled")                                          \
+    X(UINT16, mqttPort, "mqttPort", 1883, CONFIG_MQTT_PORT_MIN, CONFIG_MQTT_PORT_MAX, "mqtt", "port")                  \
+    X(UINT8, mqttQos, "mqttQos", 0, 0, 2, nullptr, nullptr)                                                            \
+    X(UINT8, mqttBatchSize, "mqttBatch", 1, CONFIG_MQTT_BATCH_MIN, CONFIG_MQTT_BATCH_MAX, "mqtt", "batch_size")        \
+    X(UINT8, mqttPayloadFormat, "mqttFormat", 0, 0, 1, nullptr, nullptr)                                               \
+    X(FLAG, flags.hassEnabled, "hassEnabled", false, 0, 1, "device", "hass_enabled")                                   \
+    /* ThingSpeak и прочие флаги */                                                                                    \
+    X(FLAG, flags.thingSpeakEnabled, "tsEnabled", false, 0, 1, "thingspeak", "enabled")                                \
+    X(FLAG, flags.useRealSensor, "useRealSensor", true, 0, 1, "device", "use_real_sensor")                             \
+    X(FLAG, flags.calibrationEnabled, "calEnabled", false, 0, 1, nullptr, nullptr)                                     \
+    X(FLAG, flags.autoOtaEnabled, "autoOTA", false, 0, 1, nullptr, nullptr)                                            \
+    /* Датчик */                                                                                                       \
+    X(UINT8, modbusId, "modbusId", JXCT_MODBUS_ID, 1, MODBUS_ADDRESS_MAX, "device", "modbus_id")                       \
+    X(UINT8, busProbeCount, "busProbes", 1, CONFIG_BUS_PROBES_MIN, CONFIG_BUS_PROBES_MAX, "device",                    \
+      "bus_probe_count")                                                                                               \
+    /* Интервалы, мс */                                                                                                \
+    X(UINT32, ntpUpdateInterval, "ntpIntvl", 60000, 10000, 86400000, nullptr, nullptr)                                 \
+    X(UINT32, sensorReadInterval, "sensorInterval", SENSOR_READ_INTERVAL, CONFIG_INTERVAL_MIN, CONFIG_INTERVAL_MAX,    \
+      "intervals", "sensor_read")                                                                                      \
+    X(UINT32, mqttPublishInterval, "mqttInterval", MQTT_PUBLISH_INTERVAL, CONFIG_INTERVAL_MIN, CONFIG_INTERVAL_MAX,    \
+      "intervals", "mqtt_publish")                                                                                     \
+    X(UINT32, thingSpeakInterval, "tsInterval", THINGSPEAK_INTERVAL, CONFIG_THINGSPEAK_MIN, CONFIG_THINGSPEAK_MAX,     \
+      "intervals", "thingspeak")                                                                                       \
+    X(UINT32, webUpdateInterval, "webInterval", WEB_UPDATE_INTERVAL, CONFIG_INTERVAL_MIN,                              \
+      CONFIG_WEB_INTERVAL_MAX_SEC * CONVERSION_SEC_TO_MS, "intervals", "web_update")                                   \
+    /* Пороги дельта-фильтра */                                                                                        \
+    X(FLOAT, deltaTemperature, "deltaTemp", DELTA_TEMPERATURE, 0.1F, 5.0F, "filters", "delta_temperature")             \
+    X(FLOAT, deltaHumidity, "deltaHum", DELTA_HUMIDITY, CONFIG_DELTA_HUMIDITY_MIN, CONFIG_DELTA_HUMIDITY_MAX,          \
+      "filters", "delta_humidity")                                                                                     \
+    X(FLOAT, deltaPh, "deltaPh", DELTA_PH, CONFIG_DELTA_PH_MIN, CONFIG_DELTA_PH_MAX, "filters", "delta_ph")            \
+    X(FLOAT, deltaEc, "deltaEc", DELTA_EC, CONFIG_DELTA_EC_MIN, CONFIG_DELTA_EC_MAX, "filters", "delta_ec")            \
+    X(FLOAT, deltaNpk, "deltaNpk", DELTA_NPK, CONFIG_DELTA_NPK_MIN, CONFIG_DELTA_NPK_MAX, "filters", "delta_npk")      \
+    /* Фильтрация */                                                                                                   \
+    X(UINT8, movingAverageWindow, "avgWindow", 5, CONFIG_AVG_WINDOW_MIN, CONFIG_AVG_WINDOW_MAX, "filters",             \
+      "moving_average_window")                                                                                         \
+    X(UINT8, forcePublishCycles, "forceCycles", FORCE_PUBLISH_CYCLES, CONFIG_FORCE_CYCLES_MIN,                         \
+      CONFIG_FORCE_CYCLES_MAX, "filters", "force_publish_cycles")                                                      \
+    X(UINT8, filterAlgorithm, "filterAlgo", 0, 0, 3, "filters", "filter_algorithm")                                    \
+    X(UINT8, outlierFilterEnabled, "outlierFilter", 0, 0, 1, "filters", "outlier_filter_enabled")                      \
+    X(FLOAT, exponentialAlpha, "expAlpha", EXPONENTIAL_ALPHA_DEFAULT, 0.01F, 0.99F, "filters",                         \
+      "exponential_alpha")                                                                                             \
+    X(FLOAT, outlierThreshold, "outlierThresh", OUTLIER_THRESHOLD_DEFAULT, 1.0F, 5.0F, "filters",                      \
+      "outlier_threshold")                                                                                             \
+    X(UINT8, kalmanEnabled, "kalmanEnabled", 0, 0, 1, "filters", "kalman_enabled")                                     \
+    X(UINT8, adaptiveFiltering, "adaptiveFilter", 0, 0, 1, "filters", "adaptive_filtering")                            \
+    /* Почва и агро-поля */                                                                                            \
+    X(UINT8, soilProfile, "soilProfile", 0, 0, 4, nullptr, nullptr)                                                    \
+    X(UINT8, calibrationInterpolation, "calInterp", 0, 0, 1, "device", "calibration_interpolation")                    \
+    X(FLOAT, latitude, "lat", 0.0F, -90.0F, 90.0F, nullptr, nullptr)                                                   \
+    X(FLOAT, longitude, "lon", 0.0F, -180.0F, 180.0F, nullptr, nullptr)                                                \
+    X(FLAG, flags.isGreenhouse, "greenhouse", false, 0, 1, nullptr, nullptr)                                           \
+    X(FLOAT, irrigationSpikeThreshold, "irrigTh", 8.0F, 0.0F, 100.0F, nullptr, nullptr)                                \
+    X(UINT16, irrigationHoldMinutes, "irrigHold", 5, 0, 1440, nullptr, nullptr)                                        \
+    X(UINT8, environmentType, "envType", 0, 0, 2, nullptr, nullptr)                                                    \
+    X(FLAG, flags.seasonalAdjustEnabled, "seasonAdj", true, 0, 1, nullptr, nullptr)
+
+// X(поле Config, ключ NVS, по умолчанию, группа JSON, имя в группе, заглушка в экспорте вместо секрета или nullptr)
+#define CONFIG_STRING_FIELDS(X)                                                                                        \
+    X(ssid, "ssid", "", "wifi", "ssid", nullptr)                                                                       \
+    X(password, "password", "", "wifi", "password", "YOUR_WIFI_PASSWORD_HERE")                                         \
+    X(mqttServer, "mqttServer", "", "mqtt", "server", "YOUR_MQTT_SERVER_HERE")                                         \
+    X(mqttUser, "mqttUser", "", "mqtt", "user", "YOUR_MQTT_USER_HERE")                                                 \
+    X(mqttPassword, "mqttPassword", "", "mqtt", "password", "YOUR_MQTT_PASSWORD_HERE")                                 \
+    X(mqttTopicPrefix, "mqttTopicPrefix", "", nullptr, nullptr, nullptr)                                               \
+    X(mqttDeviceName, "mqttDeviceName", "", nullptr, nullptr, nullptr)                                                 \
+    X(thingSpeakApiKey, "tsApiKey", "", "thingspeak", "api_key", "YOUR_API_KEY_HERE")                                  \
+    X(thingSpeakChannelId, "tsChannelId", "", "thingspeak", "channel_id", "YOUR_CHANNEL_ID_HERE")                      \
+    X(manufacturer, "manufacturer", "", nullptr, nullptr, nullptr)                                                     \
+    X(model, "model", "", nullptr, nullptr, nullptr)                                                                   \
+    X(swVersion, "swVersion", "", nullptr, nullptr, nullptr)                                                           \
+    X(ntpServer, "ntpServer", "pool.ntp.org", nullptr, nullptr, nullptr)                                               \
+    X(cropId, "cropId", "", nullptr, nullptr, nullptr)
@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file flash_write_buffer.h
+ * @brief Накопитель записи на флеш: мелкие записи сливаются в куски, которые заканчиваются на границе страницы
+ * @details SPI-флеш программируется страницами по 256 байт, и каждая запись в файловую систему, даже в один
+ * байт, стоит как минимум одной страницы и прохода по метаданным LittleFS. Накопитель копит данные и отдаёт их
+ * стоку, когда буфер заполнен, когда данные лежат дольше заданного времени или при явном сбросе. Первый кусок
+ * после открытия дополняет страницу, начатую в файле, поэтому все следующие полные куски выровнены по страницам.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+constexpr size_t FLASH_PAGE_SIZE = 256;  // Страница программирования SPI-флеша
+
+// Страниц флеша, которые затрагивает запись length байт с позиции offset в файле
+inline uint32_t flashPagesTouched(size_t offset, size_t length)
+{
+    if (length == 0)
+    {
+        return 0;
+    }
+    const size_t first = offset / FLASH_PAGE_SIZE;
+    const size_t last = (offset + length - 1) / FLASH_PAGE_SIZE;
+    return static_cast<uint32_t>(last - first + 1);
+}
+
+template <size_t Capacity>
+class FlashWriteBuffer
+{
+    static_assert(Capacity >= FLASH_PAGE_SIZE && Capacity % FLASH_PAGE_SIZE == 0, "буфер — целое число страниц");
+
+   public:
+    // Сток получает накопленный кусок и его позицию в файле; false — запись не удалась
+    using Sink = bool (*)(const uint8_t* data, size_t length, size_t offset, void* context);
+
+    // Начать накопление с позиции position в файле (размер файла при дописывании, 0 при перезаписи)
+    void reset(size_t position)
+    {
+        offset = position;
+        used = 0;
+    }
+
+    // false — сток не принял один из кусков; остаток данных тогда не записывается
+    bool write(const uint8_t* data, size_t length, unsigned long nowMs, Sink sink, void* context)
+    {
+        while (length > 0)
+        {
+            if (used == 0)
+            {
+                firstPendingMs = nowMs;
+            }
+            const size_t chunk = std::min(length, limit() - used);
+            memcpy(buffer.data() + used, data, chunk);
+            used += chunk;
+            data += chunk;
+            length -= chunk;
+            if (used == limit() && !flush(sink, context))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Отдать стоку данные, лежащие в буфере дольше maxAgeMs
+    bool flushIfStale(unsigned long nowMs, unsigned long maxAgeMs, Sink sink, void* context)
+    {
+        return used == 0 || nowMs - firstPendingMs < maxAgeMs || flush(sink, context);
+    }
+
+    bool flush(Sink sink, void* context)
+    {
+        if (used == 0)
+        {
+            return true;
+        }
+        const bool written = sink(buffer.data(), used, offset, context);
+        offset += used;
+        used = 0;
+        return written;
+    }
+
+    size_t pending() const
+    {
+        return used;
+    }
+
+   private:
+    // Кусок заканчивается на границе страницы файла
+    size_t limit() const
+    {
+        return Capacity - offset % FLASH_PAGE_SIZE;
+    }
+
+    std::array<uint8_t, Capacity> buffer{};
+    size_t offset = 0;  // Позиция начала буфера в файле
+    size_t used = 0;
+    unsigned long firstPendingMs = 0;
+};
@@ -0,0 +1,464 @@
+#pragma once
+
+/**
+ * @file history_block_codec.h
+ * @brief Сжатый блок архива: записи HistoryRecord по столбцам с разностным битовым кодированием
+ * @details Блок хранит записи не подряд, а по столбцам: время, число показаний и по каждому каналу среднее
+ * и отступы минимума и максимума от среднего. Соседние значения столбца почти совпадают, поэтому в столбец
+ * пишется разность с предыдущим значением (для времени — разность разностей: при записи раз в минуту она
+ * нулевая). Разность кодируется zig-zag и префиксным кодом переменной длины, как в Gorilla: ноль — один бит,
+ * от −2 до 1 — четыре, до ±8 — семь, до ±32768 — двадцать. Формат версии 1:
+ *   байт 0 — версия, байт 1 — число столбцов, байты 2–3 — число записей, 4–7 и 8–11 — время первой и
+ *   последней записи (по ним блок пропускается без распаковки), далее смещения столбцов (по 2 байта
+ *   от конца заголовка), столбцы, выровненные на байт, и CRC-16 всего предшествующего.
+ * Упаковка и распаковка потоковые: записи не собираются в памяти, для каждого столбца хранится только позиция
+ * и последнее значение.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "history_record.h"
+#include "uplink_record.h"
+#include "varint.h"
+
+constexpr uint8_t HISTORY_BLOCK_VERSION = 1;
+// Время, число показаний и по три столбца на канал
+constexpr size_t HISTORY_BLOCK_COLUMNS = 2 + 3 * UPLINK_CHANNEL_COUNT;
+constexpr size_t HISTORY_BLOCK_RANGE_SIZE = 12;  // Версия, столбцы, число записей, первое и последнее время
+constexpr size_t HISTORY_BLOCK_HEADER_SIZE = HISTORY_BLOCK_RANGE_SIZE + 2 * HISTORY_BLOCK_COLUMNS;
+constexpr size_t HISTORY_BLOCK_MAX_RECORDS = UINT16_MAX;
+
+namespace history_block
+{
+// Классы префиксного кода: после k единиц и нуля идут CODE_BITS[k] бит значения, после четырёх единиц — 33 бита
+constexpr std::array<uint8_t, 4> CODE_BITS = {2, 4, 16, 33};
+
+// Длина кода разности в битах
+inline uint8_t codeLength(int64_t delta)
+{
+    const uint64_t value = zigzagEncode(delta);
+    if (value == 0)
+    {
+        return 1;
+    }
+    for (size_t level = 0; level + 1 < CODE_BITS.size(); ++level)
+    {
+        if (value < (uint64_t{1} << CODE_BITS[level]))
+        {
+            return static_cast<uint8_t>(level + 2 + CODE_BITS[level]);
+        }
+    }
+    return static_cast<uint8_t>(CODE_BITS.size() + CODE_BITS.back());
+}
+
+// Запись бит столбца, начиная с байта begin; за end не пишет
+class BitWriter
+{
+   public:
+    void reset(uint8_t* target, size_t begin, size_t end)
+    {
+        out = target;
+        bit = begin * 8;
+        limit = end * 8;
+    }
+
+    void put(uint64_t value, uint8_t count)
+    {
+        for (uint8_t i = count; i > 0 && bit < limit; --i)
+        {
+            const auto mask = static_cast<uint8_t>(0x80 >> (bit % 8));
+            uint8_t& byte = out[bit / 8];
+            byte = ((value >> (i - 1)) & 1) != 0 ? static_cast<uint8_t>(byte | mask)
+                                                  : static_cast<uint8_t>(byte & ~mask);
+            ++bit;
+        }
+    }
+
+    void putDelta(int64_t delta)
+    {
+        const uint64_t value = zigzagEncode(delta);
+        if (value == 0)
+        {
+            put(0, 1);
+            return;
+        }
+        for (size_t level = 0; level < CODE_BITS.size(); ++level)
+        {
+            const bool last = level + 1 == CODE_BITS.size();
+            if (last || value < (uint64_t{1} << CODE_BITS[level]))
+            {
+                // level+1 единиц и завершающий ноль (у последнего класса нуля нет)
+                put(last ? 0x0F : ((uint64_t{1} << (level + 2)) - 2), static_cast<uint8_t>(last ? 4 : level + 2));
+                put(value, CODE_BITS[level]);
+                return;
+            }
+        }
+    }
+
+   private:
+    uint8_t* out = nullptr;
+    size_t bit = 0;
+    size_t limit = 0;
+};
+
+class BitReader
+{
+   public:
+    void reset(const uint8_t* source, size_t begin, size_t end)
+    {
+        data = source;
+        bit = begin * 8;
+        limit = end * 8;
+    }
+
+    bool get(uint8_t count, uint64_t& value)
+    {
+        value = 0;
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            if (bit >= limit)
+            {
+                return false;
+            }
+            value = (value << 1) | ((data[bit / 8] >> (7 - bit % 8)) & 1);
+            ++bit;
+        }
+        return true;
+    }
+
+    bool getDelta(int64_t& delta)
+    {
+        // Число единиц до нуля: 0 — нулевая разность, 1…3 — класс с CODE_BITS[n−1] битами, 4 — последний класс
+        size_t level = 0;
+        uint64_t flag = 0;
+        while (level < CODE_BITS.size())
+        {
+            if (!get(1, flag))
+            {
+                return false;
+            }
+            if (flag == 0)
+            {
+                break;
+            }
+            ++level;
+        }
+        uint64_t value = 0;
+        if (level > 0 && !get(CODE_BITS[level - 1], value))
+        {
+            return false;
+        }
+        delta = zigzagDecode(value);
+        return true;
+    }
+
+   private:
+    const uint8_t* data = nullptr;
+    size_t bit = 0;
+    size_t limit = 0;
+};
+
+// Значение столбца записи: среднее и отступы минимума и максимума от него
+inline int64_t columnValue(const HistoryRecord& record, size_t column)
+{
+    if (column == 0)
+    {
+        return record.timestamp;
+    }
+    if (column == 1)
+    {
+        return record.samples;
+    }
+    const size_t channel = (column - 2) / 3;
+    const int64_t mean = record.mean[channel];
+    switch ((column - 2) % 3)
+    {
+        case 0:
+            return mean;
+        case 1:
+            return mean - record.minimum[channel];
+        default:
+            return record.maximum[channel] - mean;
+    }
+}
+
+// Разность, которая пишется в столбец: для времени — разность разностей
+struct ColumnDelta
+{
+    int64_t previous = 0;
+    int64_t previousDelta = 0;
+
+    int64_t next(int64_t value, bool secondOrder)
+    {
+        const int64_t delta = value - previous;
+        const int64_t coded = secondOrder ? delta - previousDelta : delta;
+        previous = value;
+        previousDelta = delta;
+        return coded;
+    }
+};
+
+inline void putU16(uint8_t* out, uint16_t value)
+{
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void putU32(uint8_t* out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+inline uint32_t getU32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+}  // namespace history_block
+
+/**
+ * @brief Потоковая упаковка в два прохода: measure() по всем записям, затем begin() и write() по тем же записям
+ * @details Первый проход считает длину каждого столбца, второй пишет каждый столбец со своей позиции, поэтому
+ * записи не нужно держать в памяти — их можно дважды прочитать из файла. Нужен только буфер размера size().
+ */
+class HistoryBlockEncoder
+{
+   public:
+    void measure(const HistoryRecord& record)
+    {
+        if (count == 0)
+        {
+            first = record.timestamp;
+        }
+        last = record.timestamp;
+        ++count;
+        for (size_t column = 0; column < HISTORY_BLOCK_COLUMNS; ++column)
+        {
+            Column& state = columns[column];
+            state.bits += history_block::codeLength(
+                state.delta.next(history_block::columnValue(record, column), column == 0));
+        }
+    }
+
+    // Размер блока; 0 — записей нет или их больше HISTORY_BLOCK_MAX_RECORDS
+    [[nodiscard]] size_t size() const
+    {
+        if (count == 0 || count > HISTORY_BLOCK_MAX_RECORDS)
+        {
+            return 0;
+        }
+        size_t total = HISTORY_BLOCK_HEADER_SIZE + 2;
+        for (const Column& state : columns)
+        {
+            total += (state.bits + 7) / 8;
+        }
+        return total;
+    }
+
+    // Начать второй проход; false — блок не помещается в capacity или смещения столбцов не влезают в 16 бит
+    bool begin(uint8_t* out, size_t capacity)
+    {
+        const size_t total = size();
+        if (total == 0 || capacity < total)
+        {
+            return false;
+        }
+        block = out;
+        out[0] = HISTORY_BLOCK_VERSION;
+        out[1] = static_cast<uint8_t>(HISTORY_BLOCK_COLUMNS);
+        history_block::putU16(out + 2, static_cast<uint16_t>(count));
+        history_block::putU32(out + 4, first);
+        history_block::putU32(out + 8, last);
+        size_t position = HISTORY_BLOCK_HEADER_SIZE;
+        for (size_t column = 0; column < HISTORY_BLOCK_COLUMNS; ++column)
+        {
+            Column& state = columns[column];
+            const size_t offset = position - HISTORY_BLOCK_HEADER_SIZE;
+            if (offset > UINT16_MAX)
+            {
+                return false;
+            }
+            history_block::putU16(out + HISTORY_BLOCK_RANGE_SIZE + 2 * column, static_cast<uint16_t>(offset));
+            const size_t end = position + (state.bits + 7) / 8;
+            state.writer.reset(out, position, end);
+            state.delta = history_block::ColumnDelta{};
+            out[end - 1] = 0;  // Хвост последнего байта столбца
+            position = end;
+        }
+        written = 0;
+        return true;
+    }
+
+    void write(const HistoryRecord& record)
+    {
+        ++written;
+        for (size_t column = 0; column < HISTORY_BLOCK_COLUMNS; ++column)
+        {
+            Column& state = columns[column];
+            state.writer.putDelta(state.delta.next(history_block::columnValue(record, column), column == 0));
+        }
+    }
+
+    // Дописать CRC; 0 — второй проход не совпал с первым по числу записей
+    size_t finish()
+    {
+        const size_t total = size();
+        if (block == nullptr || written != count || total == 0)
+        {
+            return 0;
+        }
+        history_block::putU16(block + total - 2, uplinkCrc16(block, total - 2));
+        return total;
+    }
+
+   private:
+    struct Column
+    {
+        size_t bits = 0;
+        history_block::ColumnDelta delta;
+        history_block::BitWriter writer;
+    };
+
+    std::array<Column, HISTORY_BLOCK_COLUMNS> columns = {};
+    uint8_t* block = nullptr;
+    size_t count = 0;
+    size_t written = 0;
+    uint32_t first = 0;
+    uint32_t last = 0;
+};
+
+/**
+ * @brief Упаковать count записей, упорядоченных по времени
+ * @return Размер блока или 0, если он не помещается в capacity
+ */
+inline size_t encodeHistoryBlock(const HistoryRecord* records, size_t count, uint8_t* out, size_t capacity)
+{
+    HistoryBlockEncoder encoder;
+    for (size_t i = 0; i < count; ++i)
+    {
+        encoder.measure(records[i]);
+    }
+    if (!encoder.begin(out, capacity))
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        encoder.write(records[i]);
+    }
+    return encoder.finish();
+}
+
+// Время первой и последней записи по первым HISTORY_BLOCK_RANGE_SIZE байтам блока; false — не блок версии 1
+inline bool peekHistoryBlockRange(const uint8_t* data, size_t length, uint32_t& first, uint32_t& last)
+{
+    if (length < HISTORY_BLOCK_RANGE_SIZE || data[0] != HISTORY_BLOCK_VERSION || data[1] != HISTORY_BLOCK_COLUMNS)
+    {
+        return false;
+    }
+    first = history_block::getU32(data + 4);
+    last = history_block::getU32(data + 8);
+    return true;
+}
+
+/**
+ * @brief Потоковая распаковка блока: next() выдаёт записи по одной в исходном порядке
+ * @details Блок проверяется целиком (CRC) в open(); буфер блока должен жить, пока идёт чтение.
+ */
+class HistoryBlockReader
+{
+   public:
+    // false — блок повреждён или другой версии
+    bool open(const uint8_t* data, size_t length)
+    {
+        remaining = 0;
+        if (length < HISTORY_BLOCK_HEADER_SIZE + 2 || data[0] != HISTORY_BLOCK_VERSION ||
+            data[1] != HISTORY_BLOCK_COLUMNS)
+        {
+            return false;
+        }
+        const size_t payloadEnd = length - 2;
+        if (uplinkCrc16(data, payloadEnd) != (data[payloadEnd] | (data[payloadEnd + 1] << 8)))
+        {
+            return false;
+        }
+        for (size_t column = 0; column < HISTORY_BLOCK_COLUMNS; ++column)
+        {
+            const uint8_t* entry = data + HISTORY_BLOCK_RANGE_SIZE + 2 * column;
+            const uint8_t* next = entry + 2;
+            const size_t begin = HISTORY_BLOCK_HEADER_SIZE + (entry[0] | (entry[1] << 8));
+            const size_t end = column + 1 < HISTORY_BLOCK_COLUMNS
+                                   ? HISTORY_BLOCK_HEADER_SIZE + (next[0] | (next[1] << 8))
+                                   : payloadEnd;
+            if (begin > end || end > payloadEnd)
+            {
+                return false;
+            }
+            columns[column].reader.reset(data, begin, end);
+            columns[column].previous = 0;
+        }
+        previousDelta = 0;
+        remaining = data[2] | (data[3] << 8);
+        return true;
+    }
+
+    // Записей, которые ещё не выданы
+    [[nodiscard]] size_t pending() const
+    {
+        return remaining;
+    }
+
+    // false — записи кончились или столбец оборван
+    bool next(HistoryRecord& record)
+    {
+        if (remaining == 0)
+        {
+            return false;
+        }
+        std::array<int64_t, HISTORY_BLOCK_COLUMNS> values{};
+        for (size_t column = 0; column < HISTORY_BLOCK_COLUMNS; ++column)
+        {
+            Column& state = columns[column];
+            int64_t delta = 0;
+            if (!state.reader.getDelta(delta))
+            {
+                remaining = 0;
+                return false;
+            }
+            if (column == 0)
+            {
+                previousDelta += delta;
+                delta = previousDelta;
+            }
+            state.previous += delta;
+            values[column] = state.previous;
+        }
+        --remaining;
+
+        record.timestamp = static_cast<uint32_t>(values[0]);
+        record.samples = static_cast<uint32_t>(values[1]);
+        for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+        {
+            const int64_t mean = values[2 + 3 * channel];
+            record.mean[channel] = static_cast<int16_t>(mean);
+            record.minimum[channel] = static_cast<int16_t>(mean - values[3 + 3 * channel]);
+            record.maximum[channel] = static_cast<int16_t>(mean + values[4 + 3 * channel]);
+        }
+        return true;
+    }
+
+   private:
+    struct Column
+    {
+        history_block::BitReader reader;
+        int64_t previous = 0;
+    };
+
+    std::array<Column, HISTORY_BLOCK_COLUMNS> columns = {};
+    int64_t previousDelta = 0;
+    size_t remaining = 0;
+};
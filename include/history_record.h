@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+ * @file history_record.h
+ * @brief Запись архива показаний: минимум, среднее и максимум каналов за интервал
+ * @details Запись архива описывает интервал (минуту, час или сутки) целиком: начало интервала, число показаний
+ * и по каждому каналу минимум, среднее и максимум в квантованном виде, как в очереди отправки
+ * (UPLINK_CHANNEL_SCALE, «нет значения» — UPLINK_VALUE_MISSING). Запись занимает 52 байта и закрыта CRC-16.
+ * HistoryAccumulator собирает запись из показаний или из записей более мелкого интервала: среднее
+ * взвешивается числом показаний, поэтому сутки, собранные из часов, совпадают со средним по всем показаниям.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "uplink_record.h"
+
+// Начало интервала (4 байта), число показаний (4 байта), три значения по 2 байта на канал и CRC (2 байта)
+constexpr size_t HISTORY_RECORD_SIZE = 4 + 4 + 3 * 2 * UPLINK_CHANNEL_COUNT + 2;
+
+struct HistoryRecord
+{
+    uint32_t timestamp;  // UNIX-время начала интервала
+    uint32_t samples;    // Показаний за интервал
+    std::array<int16_t, UPLINK_CHANNEL_COUNT> minimum;
+    std::array<int16_t, UPLINK_CHANNEL_COUNT> mean;
+    std::array<int16_t, UPLINK_CHANNEL_COUNT> maximum;
+};
+
+inline void encodeHistoryRecord(const HistoryRecord& record, uint8_t* out)
+{
+    size_t offset = 0;
+    for (const uint32_t field : {record.timestamp, record.samples})
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            out[offset++] = static_cast<uint8_t>(field >> shift);
+        }
+    }
+    for (const auto* values : {&record.minimum, &record.mean, &record.maximum})
+    {
+        for (const int16_t value : *values)
+        {
+            const auto bits = static_cast<uint16_t>(value);
+            out[offset++] = static_cast<uint8_t>(bits);
+            out[offset++] = static_cast<uint8_t>(bits >> 8);
+        }
+    }
+    const uint16_t crc = uplinkCrc16(out, offset);
+    out[offset++] = static_cast<uint8_t>(crc);
+    out[offset] = static_cast<uint8_t>(crc >> 8);
+}
+
+// false — запись повреждена (не совпала CRC)
+inline bool decodeHistoryRecord(const uint8_t* data, HistoryRecord& record)
+{
+    const size_t payload = HISTORY_RECORD_SIZE - 2;
+    const auto stored = static_cast<uint16_t>(data[payload] | (data[payload + 1] << 8));
+    if (uplinkCrc16(data, payload) != stored)
+    {
+        return false;
+    }
+    size_t offset = 0;
+    for (uint32_t* field : {&record.timestamp, &record.samples})
+    {
+        *field = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            *field |= static_cast<uint32_t>(data[offset++]) << shift;
+        }
+    }
+    for (auto* values : {&record.minimum, &record.mean, &record.maximum})
+    {
+        for (int16_t& value : *values)
+        {
+            value = static_cast<int16_t>(static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8)));
+            offset += 2;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Свёртка показаний или записей в одну запись интервала
+ * @details Канал, не измеренный ни разу за интервал, записывается как UPLINK_VALUE_MISSING во всех трёх полях.
+ */
+class HistoryAccumulator
+{
+   public:
+    void reset(uint32_t bucketStart)
+    {
+        start = bucketStart;
+        samples = 0;
+        for (Channel& channel : channels)
+        {
+            channel = Channel{};
+        }
+    }
+
+    // Одно показание в квантованном виде
+    void addSample(const std::array<int16_t, UPLINK_CHANNEL_COUNT>& values)
+    {
+        ++samples;
+        for (size_t i = 0; i < UPLINK_CHANNEL_COUNT; ++i)
+        {
+            if (values[i] != UPLINK_VALUE_MISSING)
+            {
+                channels[i].add(values[i], values[i], values[i], 1);
+            }
+        }
+    }
+
+    // Запись более мелкого интервала; её среднее входит с весом числа показаний
+    void addRecord(const HistoryRecord& record)
+    {
+        samples += record.samples;
+        for (size_t i = 0; i < UPLINK_CHANNEL_COUNT; ++i)
+        {
+            if (record.mean[i] != UPLINK_VALUE_MISSING)
+            {
+                channels[i].add(record.minimum[i], record.mean[i], record.maximum[i], record.samples);
+            }
+        }
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return samples == 0;
+    }
+
+    [[nodiscard]] uint32_t bucket() const
+    {
+        return start;
+    }
+
+    [[nodiscard]] HistoryRecord finish() const
+    {
+        HistoryRecord record{};
+        record.timestamp = start;
+        record.samples = samples;
+        for (size_t i = 0; i < UPLINK_CHANNEL_COUNT; ++i)
+        {
+            const Channel& channel = channels[i];
+            if (channel.weight == 0)
+            {
+                record.minimum[i] = record.mean[i] = record.maximum[i] = UPLINK_VALUE_MISSING;
+                continue;
+            }
+            // Деление с округлением половины от нуля, как quantizeUplinkValue()
+            const auto weight = static_cast<int64_t>(channel.weight);
+            const int64_t half = channel.sum >= 0 ? weight / 2 : -(weight / 2);
+            record.minimum[i] = channel.minimum;
+            record.mean[i] = static_cast<int16_t>((channel.sum + half) / weight);
+            record.maximum[i] = channel.maximum;
+        }
+        return record;
+    }
+
+   private:
+    struct Channel
+    {
+        int16_t minimum = INT16_MAX;
+        int16_t maximum = INT16_MIN;
+        int64_t sum = 0;
+        uint64_t weight = 0;
+
+        void add(int16_t low, int16_t average, int16_t high, uint32_t count)
+        {
+            minimum = low < minimum ? low : minimum;
+            maximum = high > maximum ? high : maximum;
+            sum += static_cast<int64_t>(average) * count;
+            weight += count;
+        }
+    };
+
+    uint32_t start = 0;
+    uint32_t samples = 0;
+    std::array<Channel, UPLINK_CHANNEL_COUNT> channels = {};
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file json_delta.h
+ * @brief Разница двух плоских JSON-объектов по полям верхнего уровня
+ * @details Подписчики потока показаний получают только изменившиеся поля: объект текущего ответа
+ * сравнивается с последним отправленным, значения сравниваются побайтно в уже сериализованном виде.
+ * Вложенные объекты и массивы считаются одним значением. Ожидается компактный JSON без пробелов
+ * (вывод JsonWriter и serializeJson).
+ */
+
+#include <cstddef>
+#include <cstring>
+#include "json_writer.h"
+
+namespace json_delta
+{
+// Конец строки JSON, начинающейся с кавычки в позиции start
+inline size_t skipString(const char* json, size_t length, size_t start)
+{
+    size_t position = start + 1;
+    while (position < length && json[position] != '"')
+    {
+        position += json[position] == '\\' ? 2 : 1;
+    }
+    return position < length ? position + 1 : length;
+}
+
+// Конец значения: до запятой или скобки, закрывающей объект верхнего уровня
+inline size_t skipValue(const char* json, size_t length, size_t start)
+{
+    int depth = 0;
+    size_t position = start;
+    while (position < length)
+    {
+        const char symbol = json[position];
+        if (symbol == '"')
+        {
+            position = skipString(json, length, position);
+            continue;
+        }
+        if (symbol == '{' || symbol == '[')
+        {
+            ++depth;
+        }
+        else if (symbol == '}' || symbol == ']')
+        {
+            if (depth == 0)
+            {
+                break;
+            }
+            --depth;
+        }
+        else if (symbol == ',' && depth == 0)
+        {
+            break;
+        }
+        ++position;
+    }
+    return position;
+}
+}  // namespace json_delta
+
+/**
+ * @brief Обход полей верхнего уровня объекта
+ * @param visit Вызывается как visit(member, memberLength, nameLength): member указывает на "имя":значение,
+ * nameLength — длина имени вместе с кавычками
+ */
+template <typename Visitor>
+void forEachJsonMember(const char* json, size_t length, Visitor&& visit)
+{
+    size_t position = 0;
+    while (position < length && json[position] != '{')
+    {
+        ++position;
+    }
+    ++position;
+    while (position < length && json[position] == '"')
+    {
+        const size_t nameEnd = json_delta::skipString(json, length, position);
+        if (nameEnd >= length || json[nameEnd] != ':')
+        {
+            return;
+        }
+        const size_t valueEnd = json_delta::skipValue(json, length, nameEnd + 1);
+        visit(json + position, valueEnd - position, nameEnd - position);
+        position = valueEnd < length && json[valueEnd] == ',' ? valueEnd + 1 : length;
+    }
+}
+
+/**
+ * @brief Записать в текущий объект поля current, которых нет в previous или значение которых изменилось
+ * @return Количество записанных полей (0 — изменений нет)
+ */
+inline size_t writeJsonDelta(JsonWriter& out, const char* previous, size_t previousLength, const char* current,
+                             size_t currentLength)
+{
+    size_t written = 0;
+    forEachJsonMember(current, currentLength,
+                      [&](const char* member, size_t memberLength, size_t nameLength)
+                      {
+                          bool unchanged = false;
+                          forEachJsonMember(previous, previousLength,
+                                            [&](const char* old, size_t oldLength, size_t oldNameLength)
+                                            {
+                                                if (!unchanged && oldNameLength == nameLength &&
+                                                    oldLength == memberLength &&
+                                                    memcmp(old, member, memberLength) == 0)
+                                                {
+                                                    unchanged = true;
+                                                }
+                                            });
+                          if (!unchanged)
+                          {
+                              out.members(member, memberLength);
+                              ++written;
+                          }
+                      });
+    return written;
+}
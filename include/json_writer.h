@@ -0,0 +1,306 @@
+#pragma once
+
+/**
+ * @file json_writer.h
+ * @brief Запись JSON-объекта в буфер фиксированного размера без выделения памяти
+ * @details Поля пишутся сразу в текстовом виде: без промежуточного документа ArduinoJson и без std::string
+ * для каждого числа. Числа с фиксированной точкой форматируются целочисленно, без snprintf, с тем же
+ * результатом, что и прежние format_*(). При нехватке места запись прекращается и выставляется overflowed().
+ * Готовый список полей можно сохранить и вставить в следующий ответ через members().
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+class JsonWriter
+{
+   public:
+    JsonWriter(char* buffer, size_t capacity) : out(buffer), capacity(capacity)
+    {
+        terminate();
+    }
+
+    // Объект верхнего уровня или очередной элемент массива
+    void beginObject()
+    {
+        if (needComma)
+        {
+            put(',');
+        }
+        put('{');
+        needComma = false;
+    }
+
+    void endObject()
+    {
+        put('}');
+        needComma = true;
+    }
+
+    // Массив как значение поля; элементы-объекты открываются beginObject(), простые значения — element()
+    void beginArray(const char* name)
+    {
+        key(name);
+        put('[');
+        needComma = false;
+    }
+
+    void endArray()
+    {
+        put(']');
+        needComma = true;
+    }
+
+    void element(const char* text)
+    {
+        separate();
+        putQuoted(text);
+    }
+
+    void element(uint32_t number)
+    {
+        separate();
+        putUnsigned(number);
+    }
+
+    // Число с фиксированной точкой; NaN и бесконечность — null
+    void elementFixed(float value, uint8_t decimals)
+    {
+        separate();
+        if (!std::isfinite(value) || std::fabs(value) >= MAX_FIXED_MAGNITUDE)
+        {
+            putRaw("null");
+            return;
+        }
+        putFixed(value, decimals);
+    }
+
+    void member(const char* name, const char* text)
+    {
+        key(name);
+        putQuoted(text);
+    }
+
+    void member(const char* name, bool flag)
+    {
+        key(name);
+        putRaw(flag ? "true" : "false");
+    }
+
+    void member(const char* name, uint32_t number)
+    {
+        key(name);
+        putUnsigned(number);
+    }
+
+    void member(const char* name, int32_t number)
+    {
+        key(name);
+        putSigned(number);
+    }
+
+    /**
+     * @brief Число с фиксированным количеством знаков после точки
+     * @param decimals Знаков после точки (0 — целое)
+     * @param quoted Записать строкой ("23.4"), как прежний JSON с format_*()
+     */
+    void memberFixed(const char* name, float value, uint8_t decimals, bool quoted)
+    {
+        key(name);
+        if (!std::isfinite(value) || std::fabs(value) >= MAX_FIXED_MAGNITUDE)
+        {
+            // Как snprintf("%f"): nan/inf; без кавычек в JSON допустим только null
+            putRaw(quoted ? (std::isnan(value) ? "\"nan\"" : (value > 0 ? "\"inf\"" : "\"-inf\"")) : "null");
+            return;
+        }
+        if (quoted)
+        {
+            put('"');
+        }
+        putFixed(value, decimals);
+        if (quoted)
+        {
+            put('"');
+        }
+    }
+
+    // Вставка заранее записанного списка полей ("a":1,"b":2) в текущий объект
+    void members(const char* fragment, size_t length)
+    {
+        if (length == 0)
+        {
+            return;
+        }
+        if (needComma)
+        {
+            put(',');
+        }
+        write(fragment, length);
+        needComma = true;
+    }
+
+    [[nodiscard]] const char* data() const
+    {
+        return out;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return used;
+    }
+
+    [[nodiscard]] bool overflowed() const
+    {
+        return overflow;
+    }
+
+    // Откат к ранее запомненной позиции size()
+    void rewind(size_t position)
+    {
+        if (position <= used)
+        {
+            used = position;
+            overflow = false;
+            needComma = position > 0 && out[position - 1] != '{' && out[position - 1] != '[';
+            terminate();
+        }
+    }
+
+   private:
+    // Больше не помещается в целочисленное представление с 6 знаками после точки
+    static constexpr float MAX_FIXED_MAGNITUDE = 1e12F;
+
+    void key(const char* name)
+    {
+        separate();
+        putQuoted(name);
+        put(':');
+    }
+
+    void separate()
+    {
+        if (needComma)
+        {
+            put(',');
+        }
+        needComma = true;
+    }
+
+    void put(char symbol)
+    {
+        write(&symbol, 1);
+    }
+
+    void putRaw(const char* text)
+    {
+        write(text, strlen(text));
+    }
+
+    void write(const char* data, size_t length)
+    {
+        if (overflow || used + length >= capacity)
+        {
+            overflow = true;
+            return;
+        }
+        memcpy(out + used, data, length);
+        used += length;
+        terminate();
+    }
+
+    void terminate()
+    {
+        if (capacity > 0)
+        {
+            out[used] = '\0';
+        }
+    }
+
+    void putQuoted(const char* text)
+    {
+        put('"');
+        for (const char* cursor = text; *cursor != '\0'; ++cursor)
+        {
+            const auto symbol = static_cast<unsigned char>(*cursor);
+            if (symbol == '"' || symbol == '\\')
+            {
+                put('\\');
+                put(static_cast<char>(symbol));
+            }
+            else if (symbol < 0x20)
+            {
+                static const char HEX[] = "0123456789abcdef";
+                const char escaped[] = {'\\', 'u', '0', '0', HEX[symbol >> 4], HEX[symbol & 0x0F]};
+                write(escaped, sizeof(escaped));
+            }
+            else
+            {
+                put(static_cast<char>(symbol));  // UTF-8 без изменений
+            }
+        }
+        put('"');
+    }
+
+    void putUnsigned(uint64_t number)
+    {
+        std::array<char, 20> digits{};
+        size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + number % 10);
+            number /= 10;
+        } while (number != 0);
+        while (count > 0)
+        {
+            put(digits[--count]);
+        }
+    }
+
+    void putSigned(int64_t number)
+    {
+        if (number < 0)
+        {
+            put('-');
+            putUnsigned(static_cast<uint64_t>(-(number + 1)) + 1);
+            return;
+        }
+        putUnsigned(static_cast<uint64_t>(number));
+    }
+
+    void putFixed(float value, uint8_t decimals)
+    {
+        static constexpr std::array<uint32_t, 7> SCALE = {1, 10, 100, 1000, 10000, 100000, 1000000};
+        const uint8_t places = decimals < SCALE.size() ? decimals : static_cast<uint8_t>(SCALE.size() - 1);
+        const uint32_t scale = SCALE[places];
+
+        // Произведение float на 10^k (k ≤ 6) точно представимо в double, поэтому округление совпадает с прежним:
+        // целые — lround (половина от нуля), дробные — как snprintf("%.*f") (половина к чётному)
+        const double product = std::fabs(static_cast<double>(value)) * scale;
+        const double scaled = places == 0 ? std::round(product) : std::nearbyint(product);
+        const auto units = static_cast<uint64_t>(scaled);
+        if (value < 0.0F && (units != 0 || places > 0))  // snprintf пишет "-0.0", lround даёт просто 0
+        {
+            put('-');
+        }
+        putUnsigned(units / scale);
+        if (places == 0)
+        {
+            return;
+        }
+        put('.');
+        const auto fraction = static_cast<uint32_t>(units % scale);
+        for (uint32_t divisor = scale / 10; divisor > 0; divisor /= 10)
+        {
+            put(static_cast<char>('0' + (fraction / divisor) % 10));
+        }
+    }
+
+    char* out;
+    size_t capacity;
+    size_t used = 0;
+    bool needComma = false;
+    bool overflow = false;
+};
@@ -40,6 +40,7 @@
 
 // Экспорт глобальной конфигурации
 #include <Preferences.h>
+#include "jxct_constants.h"
 
 // Оптимизированная упакованная структура конфигурации
 struct __attribute__((packed)) Config
@@ -56,6 +57,8 @@ struct __attribute__((packed)) Config
     char mqttTopicPrefix[48];  // Сократил с 64 до 48 байт
     char mqttDeviceName[24];   // Сократил с 32 до 24 байт
     uint8_t mqttQos;
+    uint8_t mqttBatchSize;      // Показаний в одном сообщении <prefix>/state/batch (1 — без пакетов)
+    uint8_t mqttPayloadFormat;  // Формат пакета: 0 — JSON, 1 — двоичный (reading_batch_codec.h)
 
     // ThingSpeak настройки
     char thingSpeakApiKey[24];     // Сократил с 32 до 24 байт
@@ -73,6 +76,7 @@ struct __attribute__((packed)) Config
 
     // Датчик настройки
     uint8_t modbusId;
+    uint8_t busProbeCount;  // Количество датчиков на шине RS-485 (адреса modbusId..modbusId+N-1)
 
     // Безопасность веб-интерфейса
     char webPassword[24];  // Пароль для доступа к веб-интерфейсу
@@ -97,7 +101,8 @@ struct __attribute__((packed)) Config
     uint8_t outlierFilterEnabled;  // отключен для минимальной фильтрации
 
     // v2.5.1: Настройки калибровки
-    uint8_t soilProfile;  // 0 = sand, 1 = loam, 2 = peat
+    uint8_t soilProfile;               // 0 = sand, 1 = loam, 2 = peat
+    uint8_t calibrationInterpolation;  // Кривая таблицы калибровки (CalibrationInterpolation): 0=линейная, 1=PCHIP
 
     // v2.6.0: Агро-профили
     float latitude;   // Широта устройства (градусы)
@@ -117,6 +122,9 @@ struct __attribute__((packed)) Config
     float outlierThreshold;     // Порог выбросов (σ)
     uint8_t kalmanEnabled;      // Фильтр Калмана (0=отключен, 1=включен)
     uint8_t adaptiveFiltering;  // Адаптивная фильтрация (0=отключена, 1=включена)
+    // Порядок стадий фильтров по каналам (FilterType): полубайты FilterStage, младший — первая стадия;
+    // 0 — порядок по умолчанию для канала
+    uint32_t filterStageOrder[SENSOR_CHANNEL_COUNT];
 
     // Битовые поля для boolean флагов (экономия 4 байта)
     struct __attribute__((packed))
@@ -140,3 +148,23 @@ void loadConfig();
 void saveConfig();
 void resetConfig();
 bool isConfigValid();
+
+// Поколение конфигурации: растёт, когда saveConfig() записал изменения, и при resetConfig();
+// по нему устаревают закэшированные ответы
+uint32_t getConfigVersion();
+
+// Копия строкового поля config под замком настроек: строку читают сетевые задачи, пока её меняет веб-сервер
+void copyConfigString(char* out, size_t size, const char* field);
+
+// Замок настроек на время жизни объекта: под ним меняют несколько полей config сразу и копируют её строки.
+// Держится только на время копирования или изменения — не через сетевой обмен, запись на флеш или в NVS.
+// loadConfig(), saveConfig() и resetConfig() берут его сами и под ним не вызываются.
+// Порядок захвата: сначала замок веб-сервера, потом замок настроек
+class ConfigLock
+{
+   public:
+    ConfigLock();
+    ~ConfigLock();
+    ConfigLock(const ConfigLock&) = delete;
+    ConfigLock& operator=(const ConfigLock&) = delete;
+};
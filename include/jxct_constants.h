@@ -26,9 +26,11 @@ constexpr unsigned long DEFAULT_NTP_UPDATE_INTERVAL = 3600000;  // 1 час
 // Таймауты и задержки - ОПТИМИЗИРОВАННЫЕ
 constexpr unsigned long MODBUS_CACHE_TIMEOUT = 3000;     // 3 секунды (было 5) - более быстрый инвалидация кэша
 constexpr unsigned long MODBUS_RETRY_DELAY = 500;        // 0.5 секунды (было 1) - быстрые повторы
+constexpr unsigned long SENSOR_BUS_MIN_POLL_GAP = 100;   // Минимальная пауза между опросами датчиков на шине
 constexpr unsigned long DNS_CACHE_TTL = 180000;          // 3 минуты (было 5) - более частые DNS запросы
 constexpr unsigned long MQTT_RECONNECT_INTERVAL = 3000;  // 3 секунды (было 5) - быстрые переподключения
 constexpr unsigned long SENSOR_JSON_CACHE_TTL = 500;     // 0.5 секунды (было 1) - более свежие данные
+constexpr unsigned long WEB_STATUS_CACHE_TTL = 1000;     // Окно кэша /health и /service_status (куча, RSSI, MQTT)
 
 // Системные интервалы
 constexpr unsigned long STATUS_PRINT_INTERVAL = 30000;    // 30 секунд
@@ -157,6 +159,10 @@ constexpr float CALIBRATION_DRIFT_MAX = 0.1F;    // Максимальный д
 constexpr uint8_t STATISTICS_WINDOW_SIZE = 20;   // Окно для статистики
 constexpr float MIN_STANDARD_DEVIATION = 0.01F;  // Минимальное стандартное отклонение
 
+// Конвейер фильтров каналов
+constexpr uint8_t SENSOR_CHANNEL_COUNT = 7;     // Каналы датчика: T, влажность, EC, pH, N, P, K
+constexpr uint8_t FILTER_CHAIN_MAX_STAGES = 8;  // Стадий в цепочке канала (по полубайту в uint32_t)
+
 // ============================================================================
 // СТРОКОВЫЕ КОНСТАНТЫ
 // ============================================================================
@@ -202,16 +208,56 @@ constexpr int MODBUS_RE_PIN = 5;   // GPIO5 - управление приемо
 constexpr size_t SENSOR_TASK_STACK_SIZE = 4096;
 constexpr size_t RESET_BUTTON_TASK_STACK_SIZE = 2048;
 constexpr size_t WEB_SERVER_TASK_STACK_SIZE = 8192;
+constexpr size_t TIME_SERVICE_TASK_STACK_SIZE = 4096;
+constexpr size_t MQTT_CONNECT_TASK_STACK_SIZE = 4096;
 
 // Приоритеты задач
 constexpr UBaseType_t SENSOR_TASK_PRIORITY = 2;
 constexpr UBaseType_t RESET_BUTTON_TASK_PRIORITY = 1;
 constexpr UBaseType_t WEB_SERVER_TASK_PRIORITY = 1;
+constexpr UBaseType_t TIME_SERVICE_TASK_PRIORITY = 1;
+constexpr UBaseType_t MQTT_CONNECT_TASK_PRIORITY = 1;
 
 // Лимиты памяти
-constexpr size_t MAX_CONFIG_JSON_SIZE = 2048;  // 2KB для конфигурации
-constexpr size_t MAX_SENSOR_JSON_SIZE = 512;   // 512B для данных датчика
-constexpr size_t MAX_LOG_MESSAGE_SIZE = 256;   // 256B для лог сообщений
+constexpr size_t MAX_CONFIG_JSON_SIZE = 2048;   // 2KB для конфигурации
+constexpr size_t MAX_SENSOR_JSON_SIZE = 512;    // 512B для данных датчика
+constexpr size_t MAX_LOG_MESSAGE_SIZE = 256;    // 256B для лог сообщений
+constexpr size_t WEB_CHUNK_BUFFER_SIZE = 1024;  // Буфер одного HTTP-чанка при потоковой отдаче страниц
+
+// Поток событий /events/* (Server-Sent Events)
+constexpr size_t LIVE_EVENTS_MAX_CLIENTS = 4;             // Одновременных подписчиков (у каждого снимок 1 KB)
+constexpr unsigned long LIVE_EVENTS_KEEPALIVE_MS = 15000;  // Комментарий-пинг молчащим подписчикам
+constexpr unsigned long LIVE_EVENTS_RETRY_MS = 3000;       // Пауза переподключения EventSource
+constexpr unsigned long LIVE_EVENTS_STALL_MS = 30000;      // Подписчик, не принимающий данные столько, отключается
+
+// Очередь показаний для MQTT и ThingSpeak в LittleFS (запись 20 байт)
+constexpr uint32_t UPLINK_QUEUE_SEGMENT_RECORDS = 128;                // Записей в файле сегмента (2.5 KB)
+constexpr uint32_t UPLINK_QUEUE_MAX_SEGMENTS = 48;                    // ~6100 показаний: 17 часов при опросе раз в 10 с
+constexpr unsigned long UPLINK_CURSOR_SAVE_INTERVAL_MS = 300000;      // Курсоры при штатной отправке — раз в 5 минут
+constexpr size_t UPLINK_BOOT_SPANS = 16;                              // Загрузок, чьё время очередь помнит
+constexpr unsigned long UPLINK_TIME_SYNC_WAIT_MS = 300000;            // MQTT ждёт NTP столько после загрузки
+constexpr size_t UPLINK_MQTT_BATCH_RECORDS = 10;                      // Показаний в JSON-сообщении <prefix>/state/batch
+constexpr size_t UPLINK_MQTT_BINARY_BATCH_RECORDS = 30;               // В двоичном сообщении (до 26 байт на показание)
+constexpr unsigned long UPLINK_MQTT_DRAIN_INTERVAL_MS = 1000;         // Пауза между пакетами MQTT при догонянии
+constexpr size_t UPLINK_MQTT_PAYLOAD_SIZE = 896;                      // С топиком укладывается в MQTT_MAX_PACKET_SIZE
+constexpr size_t UPLINK_THINGSPEAK_BATCH_RECORDS = 50;                // Показаний в одном bulk_update (тело в куче)
+constexpr size_t UPLINK_THINGSPEAK_READ_RECORDS = 25;                 // Кусок очереди, читаемый при догонянии
+constexpr size_t UPLINK_THINGSPEAK_SCAN_RECORDS = 960;                // Записей, просматриваемых за запрос (лимит API)
+constexpr unsigned long UPLINK_THINGSPEAK_DRAIN_INTERVAL_MS = 15000;  // Пауза между пакетами: лимит записи канала
+
+// Архив показаний в LittleFS (запись 52 байта, закрытые сегменты сжимаются): минуты, часы и сутки
+constexpr uint32_t HISTORY_SEGMENT_RECORDS = 600;   // Записей в сегменте: 10 часов минут, 25 суток часов
+constexpr uint32_t HISTORY_MINUTE_SEGMENTS = 17;    // Минутные записи хранятся неделю
+constexpr uint32_t HISTORY_HOUR_SEGMENTS = 7;       // Часовые — 175 суток
+constexpr uint32_t HISTORY_DAY_SEGMENTS = 2;        // Суточные — 1200 суток; весь архив около 220 KB
+constexpr uint32_t HISTORY_UNSYNCED_SEGMENTS = 2;   // Минуты до синхронизации времени — до 30 часов с загрузки
+constexpr uint32_t HISTORY_MAX_POINTS = 1000;       // Точек в одном ответе /api/v1/history
+constexpr uint32_t HISTORY_DEFAULT_SPAN_S = 86400;  // Диапазон /api/v1/history без параметра from
+
+// Запись на флеш (flash_writer.h)
+constexpr size_t FLASH_WRITE_BUFFER_SIZE = 512;       // Буфер BufferedFlashFile: две страницы флеша
+constexpr unsigned long FLASH_WRITE_FLUSH_MS = 2000;  // Данные лежат в буфере не дольше 2 с
+constexpr size_t NVS_ENTRY_SIZE = 32;                 // NVS пишет значения целыми 32-байтовыми ячейками
 
 // ============================================================================
 // ОТЛАДКА И ЛОГИРОВАНИЕ
@@ -254,7 +300,10 @@ constexpr int HTTP_REDIRECT_PERMANENT = 307;
 
 // HTTP статус коды (дополнительные)
 constexpr int HTTP_BAD_REQUEST = 400;
+constexpr int HTTP_INTERNAL_SERVER_ERROR = 500;
 constexpr int HTTP_SEE_OTHER = 303;
+constexpr int HTTP_NOT_MODIFIED = 304;
+constexpr int HTTP_SERVICE_UNAVAILABLE = 503;
 
 // ============================================================================
 // JSON И ДАННЫЕ
@@ -340,6 +389,11 @@ constexpr int CONFIG_AVG_WINDOW_MIN = 5;
 constexpr int CONFIG_AVG_WINDOW_MAX = 15;
 constexpr int CONFIG_FORCE_CYCLES_MIN = 5;
 constexpr int CONFIG_FORCE_CYCLES_MAX = 50;
+constexpr int CONFIG_BUS_PROBES_MIN = 1;
+constexpr int CONFIG_BUS_PROBES_MAX = 16;  // Датчиков на одной шине RS-485
+constexpr int MODBUS_ADDRESS_MAX = 247;    // Старший допустимый адрес ведомого Modbus RTU
+constexpr int CONFIG_MQTT_BATCH_MIN = 1;   // 1 — каждое показание отдельным сообщением <prefix>/state
+constexpr int CONFIG_MQTT_BATCH_MAX = static_cast<int>(UPLINK_MQTT_BINARY_BATCH_RECORDS);
 
 // Шаги для input полей
 constexpr float CONFIG_STEP_HUMIDITY = 0.5F;
@@ -418,9 +472,22 @@ constexpr int SUCCESS_RATE_THRESHOLD = 90;
 // constexpr unsigned long REPORTS_AUTOREFRESH_INTERVAL_MS = 300000; // 5 минут - уже определено выше
 
 // NTP и время
-constexpr unsigned long NTP_TIMESTAMP_2000 = 946684800;  // 2000-01-01 00:00:00 UTC
+constexpr unsigned long NTP_TIMESTAMP_2000 = 946684800;   // 2000-01-01 00:00:00 UTC
+constexpr unsigned long NTP_RETRY_MIN_MS = 2000;          // Первая пауза после неудачной синхронизации
+constexpr unsigned long NTP_RETRY_MAX_MS = 600000;        // Пауза удваивается до 10 минут
+constexpr unsigned long NTP_MIN_UPDATE_INTERVAL = 10000;  // Не чаще, даже если в настройках меньше
+
+// Подключение к MQTT-брокеру (задача MqttConnect)
+constexpr unsigned long MQTT_RETRY_MAX_MS = 120000;     // Пауза после неудач растёт от MQTT_RECONNECT_INTERVAL
+constexpr uint32_t MQTT_CIRCUIT_BREAKER_FAILURES = 8;   // Неудач подряд до размыкания
+constexpr unsigned long MQTT_CIRCUIT_OPEN_MS = 600000;  // Размыкатель открыт 10 минут
+constexpr int32_t MQTT_TCP_CONNECT_TIMEOUT_MS = 5000;   // TCP-подключение в задаче, не в loop()
+constexpr uint16_t MQTT_SOCKET_TIMEOUT_S = 5;           // Ожидание CONNACK и пакетов PubSubClient
 
 // Валидация сенсорных данных - теперь используется единая система выше
 
 // Размеры JSON документов
-constexpr size_t SENSOR_JSON_DOC_SIZE = 512;
+constexpr size_t SENSOR_JSON_DOC_SIZE = 768;
+constexpr size_t SENSOR_JSON_BUFFER_SIZE = 1024;         // Буфер ответа /sensor_json (JsonWriter)
+constexpr size_t WEB_RESPONSE_CACHE_SLOTS = 4;            // Готовых JSON-ответов в кэше (sensor_json, health, статус)
+constexpr size_t WEB_RESPONSE_CACHE_BODY_SIZE = 1024;     // Максимальный размер одного закэшированного ответа
@@ -6,6 +6,7 @@
 
 // Sensor data
 #define API_SENSOR API_ROOT "/sensor"
+#define API_HISTORY API_ROOT "/history"
 
 // System
 #define API_SYSTEM API_ROOT "/system"
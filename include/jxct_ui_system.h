@@ -91,7 +91,7 @@ struct ButtonConfig
 };
 
 // 🎯 ФУНКЦИИ ДЛЯ ГЕНЕРАЦИИ CSS И HTML
-const char* getUnifiedCSS();
+const char* getStylesheetLinkHTML();
 const char* getToastHTML();
 const char* getLoaderHTML();
 String generateButton(ButtonType type, const ButtonConfig& config);
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file moving_average_filter.h
+ * @brief Скользящее среднее / медиана одного канала датчика
+ * @details Кольцевой буфер принадлежит фильтру канала, а не записи показаний SensorData.
+ * Среднее ведётся бегущей суммой, медиана — по отсортированной копии окна, которая обновляется
+ * вставкой/удалением одного элемента. Добавление измерения не пересчитывает окно целиком,
+ * поэтому стоимость не растёт квадратично с размером окна.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+template <size_t Capacity>
+class BasicMovingAverageFilter
+{
+    static_assert(Capacity > 0 && Capacity <= UINT16_MAX, "Недопустимая ёмкость окна");
+
+   public:
+    static constexpr size_t CAPACITY = Capacity;
+
+    void reset()
+    {
+        head = 0;
+        count = 0;
+        window = 0;
+        sum = 0.0F;
+        updatesSinceResync = 0;
+    }
+
+    /**
+     * @brief Добавить измерение и вернуть сглаженное значение
+     * @param value Новое измерение
+     * @param windowSize Размер окна; ограничивается диапазоном 1..CAPACITY. Смена размера сбрасывает окно
+     * @param median true — медиана окна (верхняя при чётном числе), false — среднее арифметическое
+     * @details NaN и бесконечность в окно не попадают: одно такое значение в бегущей сумме испортило бы
+     * все средние до пересчёта суммы. Вместо них возвращается текущее значение окна (само измерение, если окно пусто).
+     */
+    float add(float value, size_t windowSize, bool median)
+    {
+        windowSize = std::max<size_t>(1, std::min(windowSize, Capacity));
+        if (windowSize != window)
+        {
+            reset();
+            window = windowSize;
+        }
+        if (!std::isfinite(value))
+        {
+            return count == 0 ? value : current(median);
+        }
+
+        if (count == window)
+        {
+            // Окно заполнено: вытесняем самое старое измерение
+            const float oldest = ring[head];
+            sum -= oldest;
+            eraseSorted(oldest);
+        }
+        else
+        {
+            count++;
+        }
+
+        ring[head] = value;
+        head = (head + 1) % window;
+        sum += value;
+        insertSorted(value);
+
+        // Бегущая сумма во float накапливает погрешность — периодически пересчитываем её точно
+        if (++updatesSinceResync >= RESYNC_PERIOD)
+        {
+            resyncSum();
+        }
+
+        return current(median);
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return count;
+    }
+
+   private:
+    static constexpr uint16_t RESYNC_PERIOD = 256;
+
+    float current(bool median) const
+    {
+        return median ? sorted[count / 2] : sum / static_cast<float>(count);
+    }
+
+    void insertSorted(float value)
+    {
+        // count уже включает новое значение, в sorted пока count - 1 элементов
+        const size_t used = count - 1;
+        auto pos = std::upper_bound(sorted.begin(), sorted.begin() + used, value);
+        std::move_backward(pos, sorted.begin() + used, sorted.begin() + used + 1);
+        *pos = value;
+    }
+
+    void eraseSorted(float value)
+    {
+        auto pos = std::lower_bound(sorted.begin(), sorted.begin() + count, value);
+        std::move(pos + 1, sorted.begin() + count, pos);
+    }
+
+    void resyncSum()
+    {
+        float exact = 0.0F;
+        for (size_t i = 0; i < count; ++i)
+        {
+            exact += sorted[i];
+        }
+        sum = exact;
+        updatesSinceResync = 0;
+    }
+
+    std::array<float, Capacity> ring{};    // Измерения в порядке поступления
+    std::array<float, Capacity> sorted{};  // Те же измерения по возрастанию
+    size_t head = 0;
+    size_t count = 0;
+    size_t window = 0;
+    float sum = 0.0F;
+    uint16_t updatesSinceResync = 0;
+};
+
+// Окно каналов датчика JXCT (config.movingAverageWindow 5–15)
+using MovingAverageFilter = BasicMovingAverageFilter<15>;
@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file reading_batch_codec.h
+ * @brief Двоичный пакет показаний для MQTT: разностное кодирование квантованных значений
+ * @details Формат версии 1:
+ *   байт 0 — версия формата (READING_BATCH_VERSION), байт 1 — число каналов, байт 2 — число показаний N;
+ *   первое показание: время (varint) и значения каналов (zig-zag varint);
+ *   каждое следующее: разность времени и разности значений с предыдущим показанием (zig-zag varint).
+ * Значения — целые в шагах разрешения канала (UPLINK_CHANNEL_SCALE), «нет значения» — INT16_MIN, как в
+ * очереди отправки. Время 0 означает, что часы ещё не были синхронизированы. При опросе раз в 10 с и
+ * плавно меняющихся показаниях одно показание занимает 8–10 байт против ~75 у JSON.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "uplink_record.h"
+#include "varint.h"
+
+constexpr uint8_t READING_BATCH_VERSION = 1;
+constexpr size_t READING_BATCH_HEADER_SIZE = 3;
+// Худший случай на показание: разность времени 5 байт, разность int16 — до 3 байт на канал
+constexpr size_t READING_BATCH_MAX_RECORD_SIZE = 5 + 3 * UPLINK_CHANNEL_COUNT;
+
+/**
+ * @brief Закодировать count показаний (не больше 255)
+ * @return Размер пакета или 0, если он не помещается в capacity
+ */
+inline size_t encodeReadingBatch(const UplinkRecord* records, size_t count, uint8_t* out, size_t capacity)
+{
+    if (count == 0 || count > UINT8_MAX || capacity < READING_BATCH_HEADER_SIZE)
+    {
+        return 0;
+    }
+    out[0] = READING_BATCH_VERSION;
+    out[1] = static_cast<uint8_t>(UPLINK_CHANNEL_COUNT);
+    out[2] = static_cast<uint8_t>(count);
+    size_t position = READING_BATCH_HEADER_SIZE;
+
+    bool fits = putVarint(records[0].timestamp, out, capacity, position);
+    for (const int16_t value : records[0].values)
+    {
+        fits = fits && putSignedVarint(value, out, capacity, position);
+    }
+    for (size_t i = 1; i < count && fits; ++i)
+    {
+        const UplinkRecord& previous = records[i - 1];
+        const UplinkRecord& current = records[i];
+        fits = putSignedVarint(static_cast<int64_t>(current.timestamp) - previous.timestamp, out, capacity, position);
+        for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+        {
+            fits = fits && putSignedVarint(current.values[channel] - previous.values[channel], out, capacity,
+                                           position);
+        }
+    }
+    return fits ? position : 0;
+}
+
+/**
+ * @brief Разобрать пакет в out
+ * @return Число показаний или 0, если пакет повреждён, другой версии или не помещается в capacity
+ */
+inline size_t decodeReadingBatch(const uint8_t* data, size_t length, UplinkRecord* out, size_t capacity)
+{
+    if (length < READING_BATCH_HEADER_SIZE || data[0] != READING_BATCH_VERSION ||
+        data[1] != UPLINK_CHANNEL_COUNT || data[2] == 0 || data[2] > capacity)
+    {
+        return 0;
+    }
+    const size_t count = data[2];
+    size_t position = READING_BATCH_HEADER_SIZE;
+    int64_t timestamp = 0;
+    std::array<int64_t, UPLINK_CHANNEL_COUNT> values = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        int64_t delta = 0;
+        if (i == 0)
+        {
+            uint64_t first = 0;
+            if (!getVarint(data, length, position, first))
+            {
+                return 0;
+            }
+            delta = static_cast<int64_t>(first);
+        }
+        else if (!getSignedVarint(data, length, position, delta))
+        {
+            return 0;
+        }
+        timestamp += delta;
+
+        for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+        {
+            if (!getSignedVarint(data, length, position, delta))
+            {
+                return 0;
+            }
+            values[channel] += delta;
+            if (values[channel] < INT16_MIN || values[channel] > INT16_MAX)
+            {
+                return 0;
+            }
+            out[i].values[channel] = static_cast<int16_t>(values[channel]);
+        }
+        if (timestamp < 0 || timestamp > static_cast<int64_t>(UINT32_MAX))
+        {
+            return 0;
+        }
+        out[i].timestamp = static_cast<uint32_t>(timestamp);
+    }
+    return position == length ? count : 0;
+}
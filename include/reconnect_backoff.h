@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file reconnect_backoff.h
+ * @brief Пауза между попытками подключения: экспоненциальный рост, случайный разброс и размыкатель
+ * @details После каждой неудачи предел паузы удваивается от baseMs до maxMs, а сама пауза выбирается случайно
+ * из верхней половины предела: устройства, потерявшие брокер одновременно, не приходят к нему все сразу.
+ * После threshold неудач подряд размыкатель открывается — следующая попытка не раньше чем через openMs
+ * (с тем же разбросом). Если и она неудачна, размыкатель открывается снова; успешное подключение всё сбрасывает.
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+class ReconnectBackoff
+{
+   public:
+    ReconnectBackoff(uint32_t baseMs, uint32_t maxMs, uint32_t threshold, uint32_t openMs)
+        : baseMs(baseMs), maxMs(std::max(baseMs, maxMs)), threshold(threshold), openMs(openMs)
+    {
+    }
+
+    /**
+     * @brief Учесть неудачную попытку
+     * @param random Равномерно распределённое 32-битное число (esp_random())
+     * @return Пауза до следующей попытки, мс
+     */
+    uint32_t onFailure(uint32_t random)
+    {
+        if (failures < UINT32_MAX)
+        {
+            ++failures;
+        }
+        if (isOpen())
+        {
+            return jitter(openMs, random);
+        }
+        const uint32_t doublings = std::min<uint32_t>(failures - 1, 31);
+        const uint64_t limit = std::min<uint64_t>(static_cast<uint64_t>(baseMs) << doublings, maxMs);
+        return jitter(static_cast<uint32_t>(limit), random);
+    }
+
+    void onSuccess()
+    {
+        failures = 0;
+    }
+
+    // Размыкатель открыт: попытки идут не чаще раза в openMs
+    bool isOpen() const
+    {
+        return threshold != 0 && failures >= threshold;
+    }
+
+    uint32_t getConsecutiveFailures() const
+    {
+        return failures;
+    }
+
+   private:
+    static uint32_t jitter(uint32_t limit, uint32_t random)
+    {
+        const uint32_t half = limit / 2;
+        return half + random % (limit - half + 1);
+    }
+
+    uint32_t baseMs;
+    uint32_t maxMs;
+    uint32_t threshold;
+    uint32_t openMs;
+    uint32_t failures = 0;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * @file response_cache.h
+ * @brief Кэш готовых HTTP-ответов, помеченных версией данных, из которых они построены
+ * @details Запись хранит байты ответа и метку: маршрут, версию показаний датчика, версию конфигурации,
+ * для ответов с изменчивыми полями — номер временного окна, и случайное число загрузки. Запись не удаляется
+ * при обновлении данных — она просто перестаёт совпадать с новой меткой и перезаписывается следующим ответом
+ * того же маршрута.
+ * Из метки строится сильный ETag, поэтому If-None-Match проверяется без обращения к содержимому.
+ * Версии после перезагрузки начинаются заново, и без числа загрузки браузер получил бы 304 на ETag,
+ * выданный до неё для других данных.
+ * Синхронизации нет: кэшем пользуется только задача веб-сервера.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+struct ResponseTag
+{
+    uint32_t route;       // Маршрут и его параметр (например, номер датчика)
+    uint32_t generation;  // Версия показаний датчика
+    uint32_t config;      // Версия конфигурации
+    uint32_t epoch;       // Временное окно для ответов с изменчивыми полями, иначе 0
+    uint32_t boot;        // Случайное число, выбранное при загрузке
+
+    bool operator==(const ResponseTag& other) const
+    {
+        return route == other.route && generation == other.generation && config == other.config &&
+               epoch == other.epoch && boot == other.boot;
+    }
+};
+
+// "rrrr-gggg-cccc-eeee-bbbb" в кавычках: пять чисел в hex до 8 знаков, четыре дефиса и завершающий ноль
+constexpr size_t RESPONSE_ETAG_SIZE = 2 + 5 * 8 + 4 + 1;
+
+// Сильный ETag метки; длина без завершающего нуля
+inline size_t formatResponseETag(const ResponseTag& tag, char* out)
+{
+    static const char HEX[] = "0123456789abcdef";
+    size_t length = 0;
+    out[length++] = '"';
+    const std::array<uint32_t, 5> parts = {tag.route, tag.generation, tag.config, tag.epoch, tag.boot};
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+        if (i > 0)
+        {
+            out[length++] = '-';
+        }
+        uint32_t value = parts[i];
+        std::array<char, 8> digits{};
+        size_t count = 0;
+        do
+        {
+            digits[count++] = HEX[value & 0x0F];
+            value >>= 4;
+        } while (value != 0);
+        while (count > 0)
+        {
+            out[length++] = digits[--count];
+        }
+    }
+    out[length++] = '"';
+    out[length] = '\0';
+    return length;
+}
+
+// Заголовок If-None-Match: "*" или список тегов, в том числе слабых (W/"...") — при GET они сравниваются слабо
+inline bool responseETagMatches(const char* ifNoneMatch, const char* etag)
+{
+    if (ifNoneMatch == nullptr || *ifNoneMatch == '\0')
+    {
+        return false;
+    }
+    const char* cursor = ifNoneMatch;
+    while (*cursor == ' ')
+    {
+        ++cursor;
+    }
+    if (cursor[0] == '*' && (cursor[1] == '\0' || cursor[1] == ' '))
+    {
+        return true;
+    }
+    // Тег целиком с кавычками: "1-2" не совпадёт с "1-23"
+    return strstr(ifNoneMatch, etag) != nullptr;
+}
+
+template <size_t Slots, size_t Capacity>
+class ResponseCache
+{
+   public:
+    struct Entry
+    {
+        ResponseTag tag;
+        std::array<char, RESPONSE_ETAG_SIZE> etag;
+        std::array<char, Capacity> body;
+        size_t length;
+        bool valid;
+    };
+
+    // Запись с точно такой же меткой или nullptr
+    [[nodiscard]] const Entry* find(const ResponseTag& tag) const
+    {
+        for (const Entry& entry : entries)
+        {
+            if (entry.valid && entry.tag == tag)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Сохранить ответ вместо прежней записи того же маршрута
+     * @details Новый маршрут занимает свободную запись, а если свободных нет — старейшую по порядку вставки.
+     * @return Сохранённая запись или nullptr, если ответ не помещается в запись
+     */
+    const Entry* store(const ResponseTag& tag, const char* body, size_t length)
+    {
+        if (length > Capacity)
+        {
+            return nullptr;
+        }
+        Entry& entry = slotFor(tag.route);
+        entry.tag = tag;
+        formatResponseETag(tag, entry.etag.data());
+        memcpy(entry.body.data(), body, length);
+        entry.length = length;
+        entry.valid = true;
+        return &entry;
+    }
+
+    void clear()
+    {
+        for (Entry& entry : entries)
+        {
+            entry.valid = false;
+        }
+    }
+
+   private:
+    Entry& slotFor(uint32_t route)
+    {
+        for (Entry& entry : entries)
+        {
+            if (entry.valid && entry.tag.route == route)
+            {
+                return entry;
+            }
+        }
+        for (Entry& entry : entries)
+        {
+            if (!entry.valid)
+            {
+                return entry;
+            }
+        }
+        Entry& victim = entries[nextVictim];
+        nextVictim = (nextVictim + 1) % Slots;
+        return victim;
+    }
+
+    std::array<Entry, Slots> entries{};
+    size_t nextVictim = 0;
+};
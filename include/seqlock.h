@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file seqlock.h
+ * @brief Публикация снимка данных между задачами без мьютекса (seqlock)
+ * @details Один писатель копирует новое значение, читатели получают согласованную копию и повторяют чтение,
+ * если запись пришлась на момент копирования. Чётный счётчик — данные стабильны, нечётный — идёт запись.
+ * Номер версии (счётчик / 2) позволяет потребителям понять, изменились ли данные с прошлого чтения.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(ESP32) && !defined(TEST_BUILD)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define JXCT_SEQLOCK_RELAX() taskYIELD()
+#else
+#include <thread>
+#define JXCT_SEQLOCK_RELAX() std::this_thread::yield()
+#endif
+
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock требует тривиально копируемый тип");
+
+   public:
+    /**
+     * @brief Публикация нового значения
+     * @warning Писатель должен быть единственным (задача опроса датчика)
+     */
+    void publish(const T& value)
+    {
+        const uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        data = value;
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Согласованная копия последнего опубликованного значения
+     * @return Версия копии; 0 — значение ещё не публиковалось
+     */
+    uint32_t read(T& out) const
+    {
+        for (;;)
+        {
+            const uint32_t before = sequence.load(std::memory_order_acquire);
+            if ((before & 1U) != 0U)
+            {
+                // Писатель в середине записи — отдаём ему процессор вместо активного ожидания
+                JXCT_SEQLOCK_RELAX();
+                continue;
+            }
+            out = data;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before)
+            {
+                return before >> 1;
+            }
+        }
+    }
+
+    // Версия последней завершённой публикации (без копирования данных)
+    uint32_t version() const
+    {
+        return sequence.load(std::memory_order_acquire) >> 1;
+    }
+
+   private:
+    std::atomic<uint32_t> sequence{0};
+    T data{};
+};
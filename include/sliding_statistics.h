@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file sliding_statistics.h
+ * @brief Среднее и стандартное отклонение по скользящему окну за O(1) на измерение
+ * @details Вариант алгоритма Уэлфорда для окна фиксированного размера: при заполненном окне
+ * самое старое измерение заменяется новым одной формулой, без повторных проходов по буферу.
+ * Накопленная ошибка float периодически сбрасывается точным двухпроходным пересчётом.
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+template <size_t Window>
+class SlidingStatistics
+{
+    static_assert(Window > 1, "Окно статистики должно содержать минимум два измерения");
+
+   public:
+    void reset()
+    {
+        head = 0;
+        count = 0;
+        currentMean = 0.0F;
+        m2 = 0.0F;
+        updatesSinceResync = 0;
+    }
+
+    void add(float value)
+    {
+        if (count < Window)
+        {
+            // Окно ещё заполняется — классический шаг Уэлфорда
+            count++;
+            const float delta = value - currentMean;
+            currentMean += delta / static_cast<float>(count);
+            m2 += delta * (value - currentMean);
+        }
+        else
+        {
+            // Окно заполнено — замена самого старого измерения
+            const float oldest = values[head];
+            const float oldMean = currentMean;
+            currentMean += (value - oldest) / static_cast<float>(Window);
+            m2 += (value - oldest) * (value - currentMean + oldest - oldMean);
+        }
+
+        values[head] = value;
+        head = (head + 1) % Window;
+
+        if (m2 < 0.0F)
+        {
+            m2 = 0.0F;  // Погрешность округления не должна давать отрицательную дисперсию
+        }
+        if (++updatesSinceResync >= RESYNC_PERIOD)
+        {
+            resync();
+        }
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return count;
+    }
+
+    [[nodiscard]] float mean() const
+    {
+        return currentMean;
+    }
+
+    // Дисперсия генеральной совокупности (деление на n), как в прежнем двухпроходном расчёте
+    [[nodiscard]] float variance() const
+    {
+        return count > 0 ? m2 / static_cast<float>(count) : 0.0F;
+    }
+
+    [[nodiscard]] float stddev() const
+    {
+        return std::sqrt(variance());
+    }
+
+    // Последнее добавленное измерение
+    [[nodiscard]] float last() const
+    {
+        return values[(head + Window - 1) % Window];
+    }
+
+   private:
+    static constexpr uint16_t RESYNC_PERIOD = 512;
+
+    void resync()
+    {
+        float sum = 0.0F;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += values[i];
+        }
+        currentMean = sum / static_cast<float>(count);
+
+        float squares = 0.0F;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float diff = values[i] - currentMean;
+            squares += diff * diff;
+        }
+        m2 = squares;
+        updatesSinceResync = 0;
+    }
+
+    std::array<float, Window> values{};
+    size_t head = 0;
+    size_t count = 0;
+    float currentMean = 0.0F;
+    float m2 = 0.0F;  // Сумма квадратов отклонений от среднего
+    uint16_t updatesSinceResync = 0;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file thingspeak_batch.h
+ * @brief Отбор показаний очереди в пакет bulk_update ThingSpeak с прореживанием до интервала отправки
+ * @details Очередь общая с MQTT и пополняется с периодом опроса датчика, а ThingSpeak принимает показания
+ * с интервалом thingSpeakInterval. Догоняние просматривает очередь кусками и берёт в пакет только показания,
+ * отстоящие от предыдущего отправленного не меньше чем на интервал, поэтому один запрос сдвигает курсор на сотни
+ * записей, а в теле остаётся несколько десятков. Кусок читается, только если все его записи поместятся в пакет:
+ * курсор после отправки встаёт за последней просмотренной записью, и ни одна отобранная запись не теряется.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include "uplink_record.h"
+
+class ThingSpeakBatchSelector
+{
+   public:
+    /**
+     * @param lastSent UNIX-время последнего доставленного показания, 0 — неизвестно
+     * @param intervalSeconds Интервал отправки ThingSpeak в секундах
+     * @param maxEntries Показаний в одном запросе (ограничено размером тела в куче)
+     * @param maxScanned Записей очереди, просматриваемых за один запрос
+     */
+    ThingSpeakBatchSelector(uint32_t lastSent, uint32_t intervalSeconds, size_t maxEntries, size_t maxScanned)
+        : lastSent(lastSent), interval(intervalSeconds), maxEntries(maxEntries), maxScanned(maxScanned)
+    {
+    }
+
+    // Можно читать следующий кусок из chunk записей: пакет не переполнится и лимит просмотра не исчерпан
+    [[nodiscard]] bool wantsChunk(size_t chunk) const
+    {
+        return scanned < maxScanned && entries + chunk <= maxEntries;
+    }
+
+    // Учесть просмотренную запись; true — она идёт в пакет
+    bool take(const UplinkRecord& record)
+    {
+        ++scanned;
+        // Без метки времени ThingSpeak записал бы показание временем приёма, то есть не туда. Время неизвестно
+        // только у записей прошивок без пересчёта и у загрузок, забытых очередью (UPLINK_BOOT_SPANS)
+        if (record.timestamp == 0)
+        {
+            return false;
+        }
+        // Часы, переведённые назад, начинают отсчёт интервала заново
+        if (lastSent != 0 && record.timestamp >= lastSent && record.timestamp - lastSent < interval)
+        {
+            return false;
+        }
+        lastSent = record.timestamp;
+        ++entries;
+        return true;
+    }
+
+    [[nodiscard]] size_t entryCount() const
+    {
+        return entries;
+    }
+
+    [[nodiscard]] size_t scannedCount() const
+    {
+        return scanned;
+    }
+
+    // Время последнего отобранного показания; после успешной отправки — новое lastSent
+    [[nodiscard]] uint32_t lastSelected() const
+    {
+        return lastSent;
+    }
+
+   private:
+    uint32_t lastSent;
+    uint32_t interval;
+    size_t maxEntries;
+    size_t maxScanned;
+    size_t entries = 0;
+    size_t scanned = 0;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * @file uplink_record.h
+ * @brief Запись очереди отправки показаний: квантование каналов и двоичный формат с CRC
+ * @details Показание хранится как UNIX-время и семь int16 с шагом разрешения датчика (температура и влажность —
+ * десятые, pH — сотые, EC и NPK — целые), поэтому запись занимает 20 байт вместо ~60 у набора float.
+ * Каждая запись закрыта собственной CRC-16: запись, оборванная при пропадании питания, распознаётся
+ * при чтении и пропускается, не затрагивая соседние. Порядок байт — little-endian независимо от платформы.
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Каналы в порядке полей MQTT: t, h, e, p, n, r, k
+constexpr size_t UPLINK_CHANNEL_COUNT = 7;
+constexpr std::array<float, UPLINK_CHANNEL_COUNT> UPLINK_CHANNEL_SCALE = {10.0F, 10.0F, 1.0F, 100.0F,
+                                                                         1.0F,  1.0F,  1.0F};
+constexpr int16_t UPLINK_VALUE_MISSING = INT16_MIN;  // Канал не измерен (NaN)
+
+// Время (4 байта), семь значений по 2 байта и CRC (2 байта)
+constexpr size_t UPLINK_RECORD_SIZE = 4 + 2 * UPLINK_CHANNEL_COUNT + 2;
+
+struct UplinkRecord
+{
+    uint32_t timestamp;  // UNIX-время; меньше NTP_TIMESTAMP_2000 — секунды с загрузки, 0 — время неизвестно
+    std::array<int16_t, UPLINK_CHANNEL_COUNT> values;
+};
+
+// CRC-16/MODBUS: тот же полином, что и в обмене с датчиком
+inline uint16_t uplinkCrc16(const uint8_t* data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x0001) != 0 ? static_cast<uint16_t>((crc >> 1) ^ 0xA001) : static_cast<uint16_t>(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+// Значение в шагах разрешения канала; выход за int16 ограничивается, NaN — UPLINK_VALUE_MISSING
+inline int16_t quantizeUplinkValue(float value, size_t channel)
+{
+    if (std::isnan(value))
+    {
+        return UPLINK_VALUE_MISSING;
+    }
+    const float scaled = std::round(value * UPLINK_CHANNEL_SCALE[channel]);
+    if (scaled >= static_cast<float>(INT16_MAX))
+    {
+        return INT16_MAX;
+    }
+    if (scaled <= static_cast<float>(INT16_MIN + 1))
+    {
+        return INT16_MIN + 1;
+    }
+    return static_cast<int16_t>(scaled);
+}
+
+inline float restoreUplinkValue(int16_t quantized, size_t channel)
+{
+    return quantized == UPLINK_VALUE_MISSING ? NAN : static_cast<float>(quantized) / UPLINK_CHANNEL_SCALE[channel];
+}
+
+inline void encodeUplinkRecord(const UplinkRecord& record, uint8_t* out)
+{
+    size_t offset = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        out[offset++] = static_cast<uint8_t>(record.timestamp >> shift);
+    }
+    for (const int16_t value : record.values)
+    {
+        const auto bits = static_cast<uint16_t>(value);
+        out[offset++] = static_cast<uint8_t>(bits);
+        out[offset++] = static_cast<uint8_t>(bits >> 8);
+    }
+    const uint16_t crc = uplinkCrc16(out, offset);
+    out[offset++] = static_cast<uint8_t>(crc);
+    out[offset] = static_cast<uint8_t>(crc >> 8);
+}
+
+// false — запись повреждена (не совпала CRC)
+inline bool decodeUplinkRecord(const uint8_t* data, UplinkRecord& record)
+{
+    const size_t payload = UPLINK_RECORD_SIZE - 2;
+    const auto stored = static_cast<uint16_t>(data[payload] | (data[payload + 1] << 8));
+    if (uplinkCrc16(data, payload) != stored)
+    {
+        return false;
+    }
+    record.timestamp = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        record.timestamp |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+    {
+        const size_t offset = 4 + 2 * channel;
+        record.values[channel] = static_cast<int16_t>(static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8)));
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file varint.h
+ * @brief Целые переменной длины (LEB128) и zig-zag для компактных двоичных форматов
+ * @details Малые по модулю разности показаний занимают один байт: zig-zag переводит знаковое число
+ * в беззнаковое (0, -1, 1, -2 … → 0, 1, 2, 3 …), а LEB128 хранит по 7 бит в байте, старший бит — «есть ещё».
+ * Запись и чтение ведутся по позиции в буфере с проверкой границ: при нехватке места или обрыве данных
+ * функции возвращают false и ничего не пишут за пределы буфера.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+// Максимальная длина LEB128 для 64-битного числа
+constexpr size_t VARINT_MAX_BYTES = 10;
+
+inline uint64_t zigzagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline bool putVarint(uint64_t value, uint8_t* out, size_t capacity, size_t& position)
+{
+    do
+    {
+        if (position >= capacity)
+        {
+            return false;
+        }
+        const auto low = static_cast<uint8_t>(value & 0x7F);
+        value >>= 7;
+        out[position++] = static_cast<uint8_t>(value != 0 ? (low | 0x80) : low);
+    } while (value != 0);
+    return true;
+}
+
+inline bool getVarint(const uint8_t* data, size_t length, size_t& position, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 7 * VARINT_MAX_BYTES; shift += 7)
+    {
+        if (position >= length)
+        {
+            return false;
+        }
+        const uint8_t byte = data[position++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;  // Слишком длинная последовательность — данные повреждены
+}
+
+inline bool putSignedVarint(int64_t value, uint8_t* out, size_t capacity, size_t& position)
+{
+    return putVarint(zigzagEncode(value), out, capacity, position);
+}
+
+inline bool getSignedVarint(const uint8_t* data, size_t length, size_t& position, int64_t& value)
+{
+    uint64_t raw = 0;
+    if (!getVarint(data, length, position, raw))
+    {
+        return false;
+    }
+    value = zigzagDecode(raw);
+    return true;
+}
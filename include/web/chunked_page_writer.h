@@ -0,0 +1,61 @@
+/**
+ * @file chunked_page_writer.h
+ * @brief Потоковая отдача HTML-страниц чанками фиксированного размера
+ * @details Страница не собирается целиком в String: фрагменты копируются в буфер на стеке и уходят клиенту
+ * HTTP-чанками по мере заполнения. Крупные константные фрагменты (шаблоны во флеше) отправляются
+ * напрямую, без копирования. Пиковый расход кучи — несколько небольших временных String для вставок.
+ * Интерфейс operator+= повторяет String, поэтому обработчики переводятся на поток заменой объявления.
+ */
+
+#ifndef CHUNKED_PAGE_WRITER_H
+#define CHUNKED_PAGE_WRITER_H
+
+#ifdef TEST_BUILD
+#include "esp32_stubs.h"
+#elif defined(ESP32) || defined(ARDUINO)
+#include <WebServer.h>
+#include "Arduino.h"
+#else
+#include "esp32_stubs.h"
+#endif
+
+#include <array>
+#include "../jxct_constants.h"
+
+class ChunkedPageWriter
+{
+   public:
+    /**
+     * @brief Начать ответ: статус и заголовки уходят сразу, длина тела не указывается (chunked)
+     * @param server Веб-сервер текущего запроса
+     * @param statusCode HTTP-код ответа
+     * @param contentType MIME-тип ответа
+     */
+    ChunkedPageWriter(WebServer& server, int statusCode, const char* contentType = HTTP_CONTENT_TYPE_HTML);
+
+    // Завершает ответ, если end() не был вызван явно
+    ~ChunkedPageWriter();
+
+    ChunkedPageWriter(const ChunkedPageWriter&) = delete;
+    ChunkedPageWriter& operator=(const ChunkedPageWriter&) = delete;
+
+    ChunkedPageWriter& operator+=(const char* text);
+    ChunkedPageWriter& operator+=(const __FlashStringHelper* text);
+    ChunkedPageWriter& operator+=(const String& text);
+    ChunkedPageWriter& operator+=(char symbol);
+
+    void write(const char* data, size_t length);
+
+    // Отправить остаток буфера и завершающий пустой чанк
+    void end();
+
+   private:
+    void flush();
+
+    WebServer& server;
+    std::array<char, WEB_CHUNK_BUFFER_SIZE> buffer{};
+    size_t used = 0;
+    bool finished = false;
+};
+
+#endif  // CHUNKED_PAGE_WRITER_H
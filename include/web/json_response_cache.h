@@ -0,0 +1,41 @@
+/**
+ * @file json_response_cache.h
+ * @brief Кэш JSON-ответов API, построенных по снимку показаний датчика и конфигурации
+ * @details Обработчик сначала строит метку ответа и вызывает sendCachedJson(): при совпадении If-None-Match
+ * уходит 304, при попадании в кэш — сохранённые байты. Иначе ответ строится заново и отправляется через
+ * sendJsonAndCache(). Новая публикация показаний или saveConfig() меняют метку, и старая запись больше не
+ * совпадает. Ответы с изменчивыми полями (куча, RSSI, состояние MQTT) дополнительно привязаны к временному окну.
+ */
+
+#ifndef JSON_RESPONSE_CACHE_H
+#define JSON_RESPONSE_CACHE_H
+
+#include <ArduinoJson.h>
+#include <cstddef>
+#include <cstdint>
+#include "../response_cache.h"
+
+enum class CachedRoute : uint8_t
+{
+    SENSOR_JSON = 1,  // /sensor_json, /api/v1/sensor; параметр — номер датчика шины
+    HEALTH = 2,       // /health, /api/v1/system/health
+    SERVICE_STATUS = 3
+};
+
+/**
+ * @brief Метка ответа по текущей версии конфигурации
+ * @param route Маршрут
+ * @param variant Параметр маршрута (номер датчика), иначе 0
+ * @param generation Версия показаний, из которых строится ответ
+ * @param epochPeriod Длина временного окна в мс для ответов с изменчивыми полями, 0 — без окна
+ */
+ResponseTag makeResponseTag(CachedRoute route, uint8_t variant, uint32_t generation, unsigned long epochPeriod = 0);
+
+// Ответ из кэша или 304; false — ответ нужно построить
+bool sendCachedJson(const ResponseTag& tag);
+
+// Отправить ответ с ETag и сохранить его; слишком большой ответ отправляется без сохранения
+void sendJsonAndCache(const ResponseTag& tag, const char* body, size_t length);
+void sendJsonAndCache(const ResponseTag& tag, const JsonDocument& doc);
+
+#endif  // JSON_RESPONSE_CACHE_H
@@ -0,0 +1,21 @@
+/**
+ * @file live_events.h
+ * @brief Поток изменений показаний и статусов сервисов (Server-Sent Events)
+ * @details Страницы подписываются на /events/readings?probe=N или /events/status и получают событие
+ * только когда данные изменились: при подключении — объект целиком, затем только изменившиеся поля.
+ * Опрос датчика лишь отмечает новую публикацию; сериализация и запись в сокеты выполняются задачей
+ * веб-сервера, которая единственная работает с клиентами.
+ */
+
+#ifndef LIVE_EVENTS_H
+#define LIVE_EVENTS_H
+
+#include <cstdint>
+
+// Опубликованы новые показания датчика шины; вызывается задачей опроса
+void notifyLiveReading(uint8_t probeIndex);
+
+// Рассылка изменений подписчикам; вызывается задачей веб-сервера между опросами клиентов
+void serviceLiveEvents();
+
+#endif  // LIVE_EVENTS_H
@@ -0,0 +1,28 @@
+/**
+ * @file static_assets.h
+ * @brief Статические ресурсы веб-интерфейса (CSS/JS), заранее сжатые gzip
+ * @details Исходники лежат в web_assets/, при сборке scripts/build_web_assets.py сжимает их
+ * в src/web/web_assets_data.cpp и записывает URL с версией в web_assets_manifest.h.
+ * Страницы ссылаются на ресурсы через WEB_ASSET_*_URL вместо встраивания.
+ */
+
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../web_assets_manifest.h"
+
+struct WebAsset
+{
+    const char* path;         // URL без параметров, например /static/app.css
+    const char* contentType;  // MIME-тип несжатого содержимого
+    const char* etag;         // Сильный ETag в кавычках, хэш исходного файла
+    const uint8_t* data;      // Содержимое, сжатое gzip
+    size_t size;              // Размер сжатого содержимого
+};
+
+extern const WebAsset WEB_ASSETS[];
+extern const size_t WEB_ASSET_COUNT;
+
+#endif  // STATIC_ASSETS_H
@@ -0,0 +1,13 @@
+#pragma once
+
+// Auto-generated. DO NOT EDIT MANUALLY.
+// Generated by scripts/build_web_assets.py from web_assets/
+
+// app.css: 5022 B -> 1600 B gzip
+#define WEB_ASSET_APP_CSS_URL "/static/app.css?v=1f45393e3a5252d5"
+// live.js: 1074 B -> 595 B gzip
+#define WEB_ASSET_LIVE_JS_URL "/static/live.js?v=885767482448005e"
+// readings.js: 9783 B -> 2665 B gzip
+#define WEB_ASSET_READINGS_JS_URL "/static/readings.js?v=386195893d373ca5"
+// toast.js: 956 B -> 533 B gzip
+#define WEB_ASSET_TOAST_JS_URL "/static/toast.js?v=0aa91319ef9d3c1f"
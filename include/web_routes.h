@@ -4,9 +4,11 @@
 #include "../src/wifi_manager.h"
 #include "jxct_strings.h"
 #include "logger.h"
+#include "web/chunked_page_writer.h"
 
 // Внешние зависимости
 extern WebServer webServer;
+struct SensorData;
 
 // ============================================================================
 // CSRF ЗАЩИТА - БЕЗОПАСНАЯ РЕАЛИЗАЦИЯ
@@ -106,6 +108,12 @@ void handleApiConfigExport();
  */
 void setupServiceRoutes();
 
+/**
+ * @brief JSON статусов сервисов — тело ответа /service_status
+ * @return Длина JSON в buffer; 0 — не поместился
+ */
+size_t renderServiceStatusJson(char* buffer, size_t capacity);
+
 /**
  * @brief Обработчик сброса системы
  */
@@ -135,6 +143,12 @@ void setupDataRoutes();
  */
 void sendSensorJson();
 
+/**
+ * @brief JSON показаний датчика шины — тело ответа /sensor_json
+ * @return Длина JSON в buffer; 0 — не поместился
+ */
+size_t renderSensorJson(uint8_t probeIndex, const SensorData& data, uint32_t version, char* buffer, size_t capacity);
+
 /**
  * @brief Обработчик главной страницы показаний
  */
@@ -311,6 +325,44 @@ void handleCriticalError(const String& error);
  */
 String generateApModeUnavailablePage(const String& title, const String& icon);
 
+/**
+ * @brief Потоковый заголовок HTML страницы (см. generatePageHeader)
+ * @param out Поток ответа
+ * @param title Заголовок страницы
+ * @param icon Иконка страницы (опционально)
+ */
+void streamPageHeader(ChunkedPageWriter& out, const String& title, const String& icon = "");
+
+/**
+ * @brief Потоковый футер HTML страницы (см. generatePageFooter)
+ */
+void streamPageFooter(ChunkedPageWriter& out);
+
+/**
+ * @brief Отправка базовой страницы с навигацией чанками, без сборки всей страницы в памяти
+ * @param statusCode HTTP-код ответа
+ * @param title Заголовок страницы
+ * @param content Содержимое страницы
+ * @param icon Иконка страницы (опционально)
+ */
+void sendBasePage(int statusCode, const String& title, const String& content, const String& icon = "");
+
+/**
+ * @brief Отправка страницы ошибки (код ответа совпадает с кодом ошибки)
+ */
+void sendErrorPage(int errorCode, const String& errorMessage);
+
+/**
+ * @brief Отправка страницы успеха с кодом 200
+ */
+void sendSuccessPage(const String& title, const String& message, const String& redirectUrl = "",
+                     int redirectDelay = 2);
+
+/**
+ * @brief Отправка страницы "Недоступно в AP режиме"
+ */
+void sendApModeUnavailablePage(int statusCode, const String& title, const String& icon);
+
 // ============================================================================
 // ДОПОЛНИТЕЛЬНЫЕ МАРШРУТЫ
 // ============================================================================
@@ -324,3 +376,13 @@ void setupOtaRoutes();
  * @brief Настройка маршрутов отчетов
  */
 void setupReportsRoutes();
+
+/**
+ * @brief Настройка маршрутов статических ресурсов (/static/*: gzip, ETag, 304)
+ */
+void setupStaticRoutes();
+
+/**
+ * @brief Настройка потоков событий (/events/readings, /events/status: Server-Sent Events)
+ */
+void setupLiveEventRoutes();
@@ -0,0 +1,111 @@
+# Сжатие статических ресурсов веб-интерфейса (web_assets/) в gzip-блоб во флеше.
+# Используется как PlatformIO extra_script (pre) и может запускаться вручную.
+#
+# Генерирует:
+#   include/web_assets_manifest.h — URL ресурсов с версией (?v=ETag) для ссылок со страниц
+#   src/web/web_assets_data.cpp   — сжатые данные и таблица ресурсов для routes_static.cpp
+#
+# Вывод детерминирован (gzip без mtime, без отметки времени в файлах): при неизменных ресурсах
+# файлы не перезаписываются и не вызывают пересборку.
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+try:
+    if '__file__' in globals():
+        PROJECT_DIR = os.path.abspath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+    else:
+        # В PlatformIO контексте найдем проект по наличию каталога web_assets
+        PROJECT_DIR = os.getcwd()
+        while not os.path.isdir(os.path.join(PROJECT_DIR, 'web_assets')) and PROJECT_DIR != os.path.dirname(PROJECT_DIR):
+            PROJECT_DIR = os.path.dirname(PROJECT_DIR)
+
+    ASSETS_DIR = os.path.join(PROJECT_DIR, 'web_assets')
+    MANIFEST_PATH = os.path.join(PROJECT_DIR, 'include', 'web_assets_manifest.h')
+    DATA_PATH = os.path.join(PROJECT_DIR, 'src', 'web', 'web_assets_data.cpp')
+    URL_PREFIX = '/static/'
+
+    CONTENT_TYPES = {
+        '.css': 'text/css; charset=utf-8',
+        '.js': 'application/javascript; charset=utf-8',
+        '.html': 'text/html; charset=utf-8',
+        '.svg': 'image/svg+xml',
+    }
+
+    def identifier(name):
+        return re.sub(r'[^A-Za-z0-9]', '_', name).upper()
+
+    def byte_rows(data, per_row=16):
+        for offset in range(0, len(data), per_row):
+            yield '    ' + ', '.join(f'0x{b:02x}' for b in data[offset:offset + per_row]) + ','
+
+    def write_if_changed(path, text):
+        if os.path.exists(path):
+            with open(path, 'r', encoding='utf-8') as f:
+                if f.read() == text:
+                    return False
+        with open(path, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(text)
+        return True
+
+    assets = []
+    for name in sorted(os.listdir(ASSETS_DIR)):
+        ext = os.path.splitext(name)[1]
+        if ext not in CONTENT_TYPES:
+            continue
+        with open(os.path.join(ASSETS_DIR, name), 'rb') as f:
+            raw = f.read()
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(raw).hexdigest()[:16]
+        assets.append((name, CONTENT_TYPES[ext], packed, etag, len(raw)))
+
+    manifest = [
+        '#pragma once',
+        '',
+        '// Auto-generated. DO NOT EDIT MANUALLY.',
+        '// Generated by scripts/build_web_assets.py from web_assets/',
+        '',
+    ]
+    for name, _, packed, etag, raw_size in assets:
+        ident = identifier(name)
+        manifest.append(f'// {name}: {raw_size} B -> {len(packed)} B gzip')
+        manifest.append(f'#define WEB_ASSET_{ident}_URL "{URL_PREFIX}{name}?v={etag}"')
+    manifest.append('')
+
+    data = [
+        '// Auto-generated. DO NOT EDIT MANUALLY.',
+        '// Generated by scripts/build_web_assets.py from web_assets/',
+        '',
+        '#include "../../include/web/static_assets.h"',
+        '',
+        'namespace',
+        '{',
+    ]
+    for name, _, packed, _, _ in assets:
+        data.append(f'const uint8_t ASSET_{identifier(name)}[] = {{')
+        data.extend(byte_rows(packed))
+        data.append('};')
+        data.append('')
+    data.append('}  // namespace')
+    data.append('')
+    data.append('const WebAsset WEB_ASSETS[] = {')
+    for name, content_type, packed, etag, _ in assets:
+        data.append(f'    {{"{URL_PREFIX}{name}", "{content_type}", "\\"{etag}\\"", ASSET_{identifier(name)}, '
+                    f'sizeof(ASSET_{identifier(name)})}},')
+    data.append('};')
+    data.append('')
+    data.append('const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);')
+    data.append('')
+
+    changed = write_if_changed(MANIFEST_PATH, '\n'.join(manifest))
+    changed = write_if_changed(DATA_PATH, '\n'.join(data)) or changed
+    total_raw = sum(a[4] for a in assets)
+    total_packed = sum(len(a[2]) for a in assets)
+    state = 'regenerated' if changed else 'up to date'
+    print(f"[build_web_assets] {len(assets)} assets, {total_raw} B -> {total_packed} B gzip ({state})")
+except Exception as e:
+    print(f"[build_web_assets] error: {e}")
+    sys.exit(1)
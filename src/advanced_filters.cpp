@@ -3,67 +3,32 @@
  * @brief Улучшенные алгоритмы фильтрации для снижения зашумленности данных
  * @version 3.10.0
  * @author JXCT Development Team
+ * @details Каждый канал датчика обрабатывается своей цепочкой FilterChain, порядок стадий берётся из
+ * config.filterStageOrder. Поканальные стадии (выбросы, всплески, окно) держат состояние в цепочке,
+ * а EMA и Калман всех каналов считаются пакетно в ChannelSmoothingKernel.
  */
 
 #include "advanced_filters.h"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include "channel_smoothing_kernel.h"
 #include "jxct_config_vars.h"
 #include "jxct_constants.h"
 #include "logger.h"
 #include "modbus_sensor.h"
+#include "sliding_statistics.h"
 
 namespace AdvancedFilters
 {
 
-// ============================================================================
-// ЭКСПОНЕНЦИАЛЬНОЕ СГЛАЖИВАНИЕ
-// ============================================================================
-
-struct ExponentialSmoothingState
-{
-    float smoothed_value = 0.0F;
-    bool initialized = false;
-};
-
-namespace
-{
-ExponentialSmoothingState exp_smooth_temp;
-ExponentialSmoothingState exp_smooth_hum;
-ExponentialSmoothingState exp_smooth_ec;
-ExponentialSmoothingState exp_smooth_ph;
-ExponentialSmoothingState exp_smooth_n;
-ExponentialSmoothingState exp_smooth_p;
-ExponentialSmoothingState exp_smooth_k;
-}  // namespace
-
-namespace
-{
-float applyExponentialSmoothing(float new_value, ExponentialSmoothingState& state, float alpha)
-{
-    if (!state.initialized)
-    {
-        state.smoothed_value = new_value;
-        state.initialized = true;
-        return new_value;
-    }
-
-    // Экспоненциальное сглаживание: S_t = α * X_t + (1-α) * S_{t-1}
-    state.smoothed_value = alpha * new_value + (1.0F - alpha) * state.smoothed_value;
-    return state.smoothed_value;
-}
-}  // namespace
-
 // ============================================================================
 // СТАТИСТИЧЕСКИЙ АНАЛИЗ
 // ============================================================================
 
 struct StatisticsBuffer
 {
-    std::array<float, STATISTICS_WINDOW_SIZE> values;
-    uint8_t index = 0;
-    uint8_t filled = 0;
+    SlidingStatistics<STATISTICS_WINDOW_SIZE> window;  // Окно Уэлфорда: O(1) на измерение
     float mean = 0.0F;
     float std_dev = 0.0F;
     bool valid = false;
@@ -71,65 +36,19 @@ struct StatisticsBuffer
     StatisticsBuffer() = default;
 };
 
-// Объявления функций
-namespace
-{
-float applyECSpecializedFilter(float raw_value);
-}
-
-namespace
-{
-StatisticsBuffer stats_temp;
-StatisticsBuffer stats_hum;
-StatisticsBuffer stats_ec;
-StatisticsBuffer stats_ph;
-StatisticsBuffer stats_n;
-StatisticsBuffer stats_p;
-StatisticsBuffer stats_k;
-
-void updateStatistics(float new_value, StatisticsBuffer& buffer);
-bool isOutlier(float value, const StatisticsBuffer& buffer, float threshold_multiplier);
-}  // namespace
-
 namespace
 {
 void updateStatistics(float new_value, StatisticsBuffer& buffer)
 {
-    // Добавляем новое значение
-    buffer.values[buffer.index] = new_value;
-    buffer.index = (buffer.index + 1) % STATISTICS_WINDOW_SIZE;
-
-    if (buffer.filled < STATISTICS_WINDOW_SIZE)
-    {
-        buffer.filled++;
-    }
-
-    // Вычисляем среднее
-    float sum = 0.0F;
-    for (uint8_t i = 0; i < buffer.filled; ++i)
-    {
-        sum += buffer.values[i];
-    }
-    buffer.mean = sum / static_cast<float>(buffer.filled);
-
-    // Вычисляем стандартное отклонение
-    float variance_sum = 0.0F;
-    for (uint8_t i = 0; i < buffer.filled; ++i)
-    {
-        float diff = buffer.values[i] - buffer.mean;
-        variance_sum += diff * diff;
-    }
-    buffer.std_dev = sqrt(variance_sum / static_cast<float>(buffer.filled));
+    buffer.window.add(new_value);
+    buffer.mean = buffer.window.mean();
 
     // Минимальное стандартное отклонение для стабильности
-    buffer.std_dev = std::max(buffer.std_dev, MIN_STANDARD_DEVIATION);
+    buffer.std_dev = std::max(buffer.window.stddev(), MIN_STANDARD_DEVIATION);
 
-    buffer.valid = (buffer.filled >= 5);  // Минимум 5 значений для статистики
+    buffer.valid = (buffer.window.size() >= 5);  // Минимум 5 значений для статистики
 }
-}  // namespace
 
-namespace
-{
 bool isOutlier(float value, const StatisticsBuffer& buffer, float threshold_multiplier)
 {
     if (!buffer.valid)
@@ -145,237 +64,7 @@ bool isOutlier(float value, const StatisticsBuffer& buffer, float threshold_mult
 }  // namespace
 
 // ============================================================================
-// ФИЛЬТР КАЛМАНА
-// ============================================================================
-
-struct KalmanFilter
-{
-    float x = 0.0F;                        // Состояние (оценка)
-    float P = KALMAN_INITIAL_UNCERTAINTY;  // Ковариация ошибки оценки
-    float Q;                               // Шум процесса
-    float R;                               // Шум измерений
-    bool initialized = false;
-
-    // @param process_noise_param - шум процесса (Q)
-    // @param measurement_noise_param - шум измерений (R)
-    // ВНИМАНИЕ: параметры легко перепутать! process_noise_param = Q, measurement_noise_param = R
-    KalmanFilter(float process_noise_param,
-                 float measurement_noise_param)  // NOLINT(bugprone-easily-swappable-parameters)
-        : Q(process_noise_param), R(measurement_noise_param)
-    {
-    }
-
-    float update(float measurement)
-    {
-        if (!initialized)
-        {
-            x = measurement;
-            initialized = true;
-            return measurement;
-        }
-
-        // Предсказание
-        const float P_pred = P + Q;
-
-        // Обновление
-        const float kalman_gain = P_pred / (P_pred + R);  // Коэффициент Калмана
-        x = x + kalman_gain * (measurement - x);
-        P = (1.0F - kalman_gain) * P_pred;
-
-        return x;
-    }
-
-    void reset()
-    {
-        x = 0.0F;
-        P = KALMAN_INITIAL_UNCERTAINTY;
-        initialized = false;
-    }
-};
-
-namespace
-{
-KalmanFilter kalman_temp(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE);
-KalmanFilter kalman_hum(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE);
-KalmanFilter kalman_ec(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE);
-KalmanFilter kalman_ph(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE);
-KalmanFilter kalman_n(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE);
-KalmanFilter kalman_p(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE);
-KalmanFilter kalman_k(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE);
-}  // namespace
-
-// ============================================================================
-// КОМБИНИРОВАННЫЙ ФИЛЬТР
-// ============================================================================
-
-namespace
-{
-float applyCombinedFilter(float raw_value, FilterType type, bool enable_kalman,
-                          bool enable_adaptive)  // NOLINT(bugprone-easily-swappable-parameters)
-{
-    float filtered_value = raw_value;
-
-    // Специализированная фильтрация EC
-    if (type == FilterType::EC)
-    {
-        filtered_value = applyECSpecializedFilter(raw_value);
-    }
-
-    // 1. Обновляем статистику для адаптивных порогов
-    if (enable_adaptive)
-    {  // NOLINT(readability-implicit-bool-conversion)
-        StatisticsBuffer* buffer = nullptr;
-        switch (type)
-        {
-            case FilterType::TEMPERATURE:
-                buffer = &stats_temp;
-                break;
-            case FilterType::HUMIDITY:
-                buffer = &stats_hum;
-                break;
-            case FilterType::EC:
-                buffer = &stats_ec;
-                break;
-            case FilterType::PH:
-                buffer = &stats_ph;
-                break;
-            case FilterType::NITROGEN:
-                buffer = &stats_n;
-                break;
-            case FilterType::PHOSPHORUS:
-                buffer = &stats_p;
-                break;
-            case FilterType::POTASSIUM:
-                buffer = &stats_k;
-                break;
-        }
-
-        if (buffer != nullptr)
-        {
-            updateStatistics(filtered_value, *buffer);
-
-            // Проверяем на выбросы
-            float threshold = config.outlierThreshold;
-
-            // Специальная обработка для EC - более строгие пороги
-            if (type == FilterType::EC)
-            {
-                threshold = config.outlierThreshold * 0.7F;  // Более строгий порог для EC
-
-                // Дополнительная проверка для EC - если значение слишком сильно отличается от предыдущего
-                if (buffer->filled >= 5U)
-                {  // Нужно минимум 5 измерений
-                    const float last_value =
-                        buffer->values[(buffer->index - 1 + STATISTICS_WINDOW_SIZE) % STATISTICS_WINDOW_SIZE];
-                    const float change_percent = abs(filtered_value - last_value) / last_value * 100.0F;
-
-                    // Если изменение больше 20% - считаем выбросом
-                    if (change_percent > 20.0F)
-                    {
-                        return buffer->mean;
-                    }
-                }
-            }
-
-            if (isOutlier(filtered_value, *buffer, threshold))
-            {  // NOLINT(readability-implicit-bool-conversion)
-                // Возвращаем предыдущее значение вместо выброса
-                return buffer->mean;
-            }
-        }
-    }
-
-    // 2. Применяем экспоненциальное сглаживание
-    ExponentialSmoothingState* exp_state = nullptr;
-    float alpha = config.exponentialAlpha;  // Базовый коэффициент
-
-    // Дифференцированные настройки для шумных параметров
-    switch (type)
-    {
-        case FilterType::EC:
-            alpha = config.exponentialAlpha * 0.5F;  // Очень агрессивное сглаживание для EC
-            break;
-        case FilterType::NITROGEN:
-        case FilterType::PHOSPHORUS:
-        case FilterType::POTASSIUM:
-            alpha = config.exponentialAlpha * 0.8F;  // Умеренное сглаживание для NPK
-            break;
-        default:
-            alpha = config.exponentialAlpha;  // Обычное сглаживание для остальных
-            break;
-    }
-
-    switch (type)
-    {
-        case FilterType::TEMPERATURE:
-            exp_state = &exp_smooth_temp;
-            break;
-        case FilterType::HUMIDITY:
-            exp_state = &exp_smooth_hum;
-            break;
-        case FilterType::EC:
-            exp_state = &exp_smooth_ec;
-            break;
-        case FilterType::PH:
-            exp_state = &exp_smooth_ph;
-            break;
-        case FilterType::NITROGEN:
-            exp_state = &exp_smooth_n;
-            break;
-        case FilterType::PHOSPHORUS:
-            exp_state = &exp_smooth_p;
-            break;
-        case FilterType::POTASSIUM:
-            exp_state = &exp_smooth_k;
-            break;
-    }
-
-    if (exp_state != nullptr)
-    {
-        filtered_value = applyExponentialSmoothing(filtered_value, *exp_state, alpha);
-    }
-
-    // 3. Применяем фильтр Калмана (если включен)
-    if (enable_kalman)
-    {  // NOLINT(readability-implicit-bool-conversion)
-        KalmanFilter* kalman = nullptr;
-        switch (type)
-        {
-            case FilterType::TEMPERATURE:
-                kalman = &kalman_temp;
-                break;
-            case FilterType::HUMIDITY:
-                kalman = &kalman_hum;
-                break;
-            case FilterType::EC:
-                kalman = &kalman_ec;
-                break;
-            case FilterType::PH:
-                kalman = &kalman_ph;
-                break;
-            case FilterType::NITROGEN:
-                kalman = &kalman_n;
-                break;
-            case FilterType::PHOSPHORUS:
-                kalman = &kalman_p;
-                break;
-            case FilterType::POTASSIUM:
-                kalman = &kalman_k;
-                break;
-        }
-
-        if (kalman != nullptr)
-        {
-            filtered_value = kalman->update(filtered_value);
-        }
-    }
-
-    return filtered_value;
-}
-}  // namespace
-
-// ============================================================================
-// СПЕЦИАЛИЗИРОВАННАЯ ФИЛЬТРАЦИЯ EC
+// СПЕЦИАЛИЗИРОВАННАЯ ФИЛЬТРАЦИЯ ВСПЛЕСКОВ (EC)
 // ============================================================================
 
 struct ECFilterState
@@ -391,11 +80,6 @@ struct ECFilterState
     ECFilterState() = default;
 };
 
-namespace
-{
-ECFilterState ec_filter_state;
-}
-
 // Анализ паттерна выбросов EC
 namespace
 {
@@ -434,53 +118,47 @@ bool isECSpikePattern(ECFilterState& state)
 
     return false;
 }
-}  // namespace
 
-namespace
-{
 // Обновление базового значения EC
-void updateECBaseline(float new_value)
+void updateECBaseline(ECFilterState& state, float new_value)
 {
-    if (!ec_filter_state.baseline_valid)
+    if (!state.baseline_valid)
     {
-        ec_filter_state.baseline = new_value;
-        ec_filter_state.baseline_valid = true;
+        state.baseline = new_value;
+        state.baseline_valid = true;
         return;
     }
 
     // Медленное обновление базового значения (α = 0.1)
-    ec_filter_state.baseline = ec_filter_state.baseline * 0.9F + new_value * 0.1F;
+    state.baseline = state.baseline * 0.9F + new_value * 0.1F;
 }
-}  // end anonymous namespace
 
-namespace
-{
 // Специализированная фильтрация EC
-float applyECSpecializedFilter(float raw_value)
+float applyECSpecializedFilter(ECFilterState& state, float raw_value)
 {
     // Обновляем историю значений
-    ec_filter_state.recent_values[ec_filter_state.index] = raw_value;
-    ec_filter_state.index = (ec_filter_state.index + 1) % 10;
-    if (ec_filter_state.filled < 10U)
+    state.recent_values[state.index] = raw_value;
+    state.index = (state.index + 1) % 10;
+    if (state.filled < 10U)
     {
-        ec_filter_state.filled++;
+        state.filled++;
     }
 
     // Обновляем базовое значение
-    updateECBaseline(raw_value);
+    updateECBaseline(state, raw_value);
 
     // Проверяем паттерн выбросов
-    if (isECSpikePattern(ec_filter_state))
+    if (isECSpikePattern(state))
     {  // NOLINT(readability-implicit-bool-conversion)
-        logSystemSafe("[EC_FILTER] Обнаружен паттерн выбросов: %.1f -> %.1f (база: %.1f)", ec_filter_state.baseline,
-                      raw_value, ec_filter_state.baseline);
-        return ec_filter_state.baseline;  // Возвращаем базовое значение
+        logSystemSafe("[EC_FILTER] Обнаружен паттерн выбросов: %.1f -> %.1f (база: %.1f)", state.baseline, raw_value,
+                      state.baseline);
+        return state.baseline;  // Возвращаем базовое значение
     }
 
     // Дополнительная проверка на аномальные скачки
-    if (ec_filter_state.filled >= 3U)
+    if (state.filled >= 3U)
     {
-        float prev_value = ec_filter_state.recent_values[(ec_filter_state.index - 2 + 10) % 10];
+        float prev_value = state.recent_values[(state.index - 2 + 10) % 10];
         const float change_percent = (abs(raw_value - prev_value) / prev_value) * 100.0F;
 
         // Если изменение больше 25% - считаем выбросом
@@ -496,67 +174,288 @@ float applyECSpecializedFilter(float raw_value)
 }
 }  // namespace
 
+// ============================================================================
+// КОНВЕЙЕР ФИЛЬТРОВ КАНАЛА
+// ============================================================================
+
+namespace
+{
+// Порядок по умолчанию: выбросы → EMA → Калман → окно; для EC впереди подавление всплесков
+constexpr uint32_t DEFAULT_STAGE_ORDER = 0x5431;
+constexpr uint32_t DEFAULT_EC_STAGE_ORDER = 0x54312;
+
+// Неизменяемые параметры канала
+struct ChannelProfile
+{
+    const char* name;
+    float SensorData::*value;  // Поле показаний канала
+    float alphaScale;          // Множитель α экспоненциального сглаживания
+    float thresholdScale;      // Множитель порога выбросов
+    float maxJumpPercent;      // Скачок относительно предыдущего измерения, считающийся выбросом (0 — нет)
+    uint32_t defaultStages;    // Порядок стадий, если в конфигурации 0
+};
+
+// Индекс совпадает с FilterType
+constexpr std::array<ChannelProfile, SENSOR_CHANNEL_COUNT> CHANNEL_PROFILES = {{
+    {"Температура", &SensorData::temperature, 1.0F, 1.0F, 0.0F, DEFAULT_STAGE_ORDER},
+    {"Влажность", &SensorData::humidity, 1.0F, 1.0F, 0.0F, DEFAULT_STAGE_ORDER},
+    // EC: очень агрессивное сглаживание, более строгий порог и контроль скачков > 20%
+    {"EC", &SensorData::ec, 0.5F, 0.7F, 20.0F, DEFAULT_EC_STAGE_ORDER},
+    {"pH", &SensorData::ph, 1.0F, 1.0F, 0.0F, DEFAULT_STAGE_ORDER},
+    // NPK: умеренное сглаживание
+    {"Nitrogen", &SensorData::nitrogen, 0.8F, 1.0F, 0.0F, DEFAULT_STAGE_ORDER},
+    {"Phosphorus", &SensorData::phosphorus, 0.8F, 1.0F, 0.0F, DEFAULT_STAGE_ORDER},
+    {"Potassium", &SensorData::potassium, 0.8F, 1.0F, 0.0F, DEFAULT_STAGE_ORDER},
+}};
+
+// Настройки, общие для всех каналов; считываются из config один раз за обработку показаний
+struct PipelineSettings
+{
+    bool adaptive;           // Выполнять стадии кроме MOVING_WINDOW
+    bool outlierGate;        // config.adaptiveFiltering
+    bool kalman;             // config.kalmanEnabled
+    float alpha;             // config.exponentialAlpha
+    float outlierThreshold;  // config.outlierThreshold
+    uint8_t window;          // Размер окна скользящего среднего (5–15)
+    bool median;             // Медиана вместо среднего в окне
+};
+
+class FilterChain
+{
+   public:
+    // Разобрать порядок стадий, если он изменился; 0 — порядок канала по умолчанию
+    void prepare(const ChannelProfile& profile, uint32_t packedStages)
+    {
+        if (packedStages == 0)
+        {
+            packedStages = profile.defaultStages;
+        }
+        if (packedStages != configuredStages)
+        {
+            configure(packedStages);
+        }
+    }
+
+    [[nodiscard]] uint8_t getStageCount() const
+    {
+        return stageCount;
+    }
+
+    [[nodiscard]] FilterStage getStage(uint8_t position) const
+    {
+        return position < stageCount ? stages[position] : FilterStage::NONE;
+    }
+
+    /**
+     * @brief Поканальная стадия (выбросы, всплески, окно); EMA и Калман считаются пакетно для всех каналов
+     * @details Выброс заменяется средним окна статистики и не попадает в EMA/Калман,
+     * но всё равно проходит через окно скользящего среднего, как и раньше.
+     */
+    float applyStage(FilterStage stage, float value, const ChannelProfile& profile, const PipelineSettings& settings,
+                     MovingAverageFilter& window)
+    {
+        switch (stage)
+        {
+            case FilterStage::OUTLIER_GATE:
+                if (settings.adaptive && settings.outlierGate && !rejected)
+                {
+                    value = gateOutlier(value, profile, settings);
+                }
+                break;
+            case FilterStage::EC_SPIKE:
+                if (settings.adaptive && !rejected)
+                {
+                    value = applyECSpecializedFilter(spikeState, value);
+                }
+                break;
+            case FilterStage::MOVING_WINDOW:
+                value = window.add(value, settings.window, settings.median);
+                break;
+            case FilterStage::EMA:
+            case FilterStage::KALMAN:
+            case FilterStage::NONE:
+                break;
+        }
+        return value;
+    }
+
+    // Выброс текущего измерения отсекает последующие EMA/Калман канала
+    [[nodiscard]] bool isRejected() const
+    {
+        return rejected;
+    }
+
+    void beginSample()
+    {
+        rejected = false;
+    }
+
+    void reset()
+    {
+        statistics = StatisticsBuffer();
+        spikeState = ECFilterState();
+    }
+
+    [[nodiscard]] const StatisticsBuffer& getStatistics() const
+    {
+        return statistics;
+    }
+
+    [[nodiscard]] const ECFilterState& getSpikeState() const
+    {
+        return spikeState;
+    }
+
+   private:
+    // Разбор полубайтов; неизвестные коды пропускаются, NONE завершает список
+    void configure(uint32_t packedStages)
+    {
+        configuredStages = packedStages;
+        stageCount = 0;
+        for (uint8_t i = 0; i < FILTER_CHAIN_MAX_STAGES; ++i)
+        {
+            const uint8_t code = (packedStages >> (i * 4U)) & 0x0FU;
+            if (code == static_cast<uint8_t>(FilterStage::NONE))
+            {
+                break;
+            }
+            if (code <= static_cast<uint8_t>(FilterStage::MOVING_WINDOW))
+            {
+                stages[stageCount++] = static_cast<FilterStage>(code);
+            }
+        }
+    }
+
+    float gateOutlier(float value, const ChannelProfile& profile, const PipelineSettings& settings)
+    {
+        // Предыдущее измерение канала — до того, как окно примет новое
+        const size_t previous_count = statistics.window.size();
+        const float last_value = statistics.window.last();
+        updateStatistics(value, statistics);
+
+        // Если значение слишком сильно отличается от предыдущего (EC)
+        if (profile.maxJumpPercent > 0.0F && previous_count >= 5U && last_value > 0.0F)
+        {
+            const float change_percent = abs(value - last_value) / last_value * 100.0F;
+            if (change_percent > profile.maxJumpPercent)
+            {
+                rejected = true;
+                return statistics.mean;
+            }
+        }
+
+        if (isOutlier(value, statistics, settings.outlierThreshold * profile.thresholdScale))
+        {  // NOLINT(readability-implicit-bool-conversion)
+            // Возвращаем среднее вместо выброса
+            rejected = true;
+            return statistics.mean;
+        }
+        return value;
+    }
+
+    std::array<FilterStage, FILTER_CHAIN_MAX_STAGES> stages{};
+    uint8_t stageCount = 0;
+    uint32_t configuredStages = 0;  // 0 — стадии ещё не разобраны
+    bool rejected = false;
+
+    StatisticsBuffer statistics;
+    ECFilterState spikeState;
+};
+
+std::array<FilterChain, SENSOR_CHANNEL_COUNT> channelChains;
+
+// Состояние EMA и Калмана всех каналов — структура массивов для пакетного шага
+using SmoothingKernel = ChannelSmoothingKernel<SENSOR_CHANNEL_COUNT>;
+SmoothingKernel smoothingKernel(KALMAN_PROCESS_NOISE, KALMAN_MEASUREMENT_NOISE, KALMAN_INITIAL_UNCERTAINTY);
+}  // namespace
+
 // ============================================================================
 // ПУБЛИЧНЫЕ ФУНКЦИИ
 // ============================================================================
 
-void applyAdvancedFiltering(SensorData& data)  // NOLINT(misc-use-internal-linkage)
+void applyAdvancedFiltering(SensorData& data, SensorFilterState& windows,
+                            bool adaptive)  // NOLINT(misc-use-internal-linkage)
 {
-    if (!static_cast<bool>(config.adaptiveFiltering) && !static_cast<bool>(config.kalmanEnabled))
+    PipelineSettings settings{};
+    // Без адаптивной фильтрации и Калмана остаётся только окно скользящего среднего
+    settings.adaptive =
+        adaptive && (static_cast<bool>(config.adaptiveFiltering) || static_cast<bool>(config.kalmanEnabled));
+    settings.outlierGate = static_cast<bool>(config.adaptiveFiltering);
+    settings.kalman = static_cast<bool>(config.kalmanEnabled);
+    settings.alpha = config.exponentialAlpha;
+    settings.outlierThreshold = config.outlierThreshold;
+    settings.window =
+        std::max(static_cast<uint8_t>(5), std::min(static_cast<uint8_t>(15), config.movingAverageWindow));
+    settings.median = config.filterAlgorithm == 1;
+
+    std::array<float, SENSOR_CHANNEL_COUNT> values{};
+    uint8_t depth = 0;
+    for (uint8_t channel = 0; channel < SENSOR_CHANNEL_COUNT; ++channel)
+    {
+        const ChannelProfile& profile = CHANNEL_PROFILES[channel];
+        FilterChain& chain = channelChains[channel];
+        chain.prepare(profile, config.filterStageOrder[channel]);
+        chain.beginSample();
+        depth = std::max(depth, chain.getStageCount());
+        values[channel] = data.*profile.value;
+        smoothingKernel.setAlpha(channel, settings.alpha * profile.alphaScale);
+    }
+
+    // Стадии идут по позициям: каждый канал сохраняет свой порядок, а EMA и Калман на одной позиции
+    // выполняются одним пакетным шагом по маске каналов
+    for (uint8_t position = 0; position < depth; ++position)
     {
-        return;  // Фильтрация отключена
+        std::array<uint32_t, SENSOR_CHANNEL_COUNT> emaMask{};
+        std::array<uint32_t, SENSOR_CHANNEL_COUNT> kalmanMask{};
+        bool anyEma = false;
+        bool anyKalman = false;
+
+        for (uint8_t channel = 0; channel < SENSOR_CHANNEL_COUNT; ++channel)
+        {
+            FilterChain& chain = channelChains[channel];
+            const FilterStage stage = chain.getStage(position);
+            const bool smoothingAllowed = settings.adaptive && !chain.isRejected();
+            if (stage == FilterStage::EMA)
+            {
+                emaMask[channel] = smoothingAllowed ? SmoothingKernel::LANE_ACTIVE : SmoothingKernel::LANE_IDLE;
+                anyEma = anyEma || smoothingAllowed;
+            }
+            else if (stage == FilterStage::KALMAN)
+            {
+                const bool kalmanAllowed = smoothingAllowed && settings.kalman;
+                kalmanMask[channel] = kalmanAllowed ? SmoothingKernel::LANE_ACTIVE : SmoothingKernel::LANE_IDLE;
+                anyKalman = anyKalman || kalmanAllowed;
+            }
+            else
+            {
+                values[channel] = chain.applyStage(stage, values[channel], CHANNEL_PROFILES[channel], settings,
+                                                   windows.channels[channel]);
+            }
+        }
+
+        if (anyEma)
+        {
+            smoothingKernel.smooth(values.data(), emaMask.data());
+        }
+        if (anyKalman)
+        {
+            smoothingKernel.kalman(values.data(), kalmanMask.data());
+        }
     }
 
-    // Применяем комбинированный фильтр ко всем параметрам
-    data.temperature =
-        applyCombinedFilter(data.temperature, FilterType::TEMPERATURE, static_cast<bool>(config.kalmanEnabled),
-                            static_cast<bool>(config.adaptiveFiltering));
-    data.humidity = applyCombinedFilter(data.humidity, FilterType::HUMIDITY, static_cast<bool>(config.kalmanEnabled),
-                                        static_cast<bool>(config.adaptiveFiltering));
-    data.ec = applyCombinedFilter(data.ec, FilterType::EC, static_cast<bool>(config.kalmanEnabled),
-                                  static_cast<bool>(config.adaptiveFiltering));
-    data.ph = applyCombinedFilter(data.ph, FilterType::PH, static_cast<bool>(config.kalmanEnabled),
-                                  static_cast<bool>(config.adaptiveFiltering));
-    data.nitrogen = applyCombinedFilter(data.nitrogen, FilterType::NITROGEN, static_cast<bool>(config.kalmanEnabled),
-                                        static_cast<bool>(config.adaptiveFiltering));
-    data.phosphorus =
-        applyCombinedFilter(data.phosphorus, FilterType::PHOSPHORUS, static_cast<bool>(config.kalmanEnabled),
-                            static_cast<bool>(config.adaptiveFiltering));
-    data.potassium = applyCombinedFilter(data.potassium, FilterType::POTASSIUM, static_cast<bool>(config.kalmanEnabled),
-                                         static_cast<bool>(config.adaptiveFiltering));
+    for (uint8_t channel = 0; channel < SENSOR_CHANNEL_COUNT; ++channel)
+    {
+        data.*CHANNEL_PROFILES[channel].value = values[channel];
+    }
 }
 
 void resetAllFilters()  // NOLINT(misc-use-internal-linkage)
 {
-    // Сбрасываем экспоненциальное сглаживание
-    exp_smooth_temp.initialized = false;
-    exp_smooth_hum.initialized = false;
-    exp_smooth_ec.initialized = false;
-    exp_smooth_ph.initialized = false;
-    exp_smooth_n.initialized = false;
-    exp_smooth_p.initialized = false;
-    exp_smooth_k.initialized = false;
-
-    // Сбрасываем статистические буферы
-    stats_temp = StatisticsBuffer();
-    stats_hum = StatisticsBuffer();
-    stats_ec = StatisticsBuffer();
-    stats_ph = StatisticsBuffer();
-    stats_n = StatisticsBuffer();
-    stats_p = StatisticsBuffer();
-    stats_k = StatisticsBuffer();
-
-    // Сбрасываем фильтры Калмана
-    kalman_temp.reset();
-    kalman_hum.reset();
-    kalman_ec.reset();
-    kalman_ph.reset();
-    kalman_n.reset();
-    kalman_p.reset();
-    kalman_k.reset();
-
-    // Сбрасываем специализированный фильтр EC
-    ec_filter_state = ECFilterState();
+    for (auto& chain : channelChains)
+    {
+        chain.reset();
+    }
+    smoothingKernel.reset();
 
     logSystem("[ADVANCED_FILTERS] Все фильтры сброшены");
 }
@@ -569,18 +468,21 @@ void logFilterStatistics()  // NOLINT(misc-use-internal-linkage)
     }
 
     logSystem("=== СТАТИСТИКА ФИЛЬТРОВ ===");
-    logSystemSafe("Температура: μ=%.2f, σ=%.2f", stats_temp.mean, stats_temp.std_dev);
-    logSystemSafe("Влажность: μ=%.2f, σ=%.2f", stats_hum.mean, stats_hum.std_dev);
-    logSystemSafe("EC: μ=%.2f, σ=%.2f", stats_ec.mean, stats_ec.std_dev);
-    logSystemSafe("pH: μ=%.2f, σ=%.2f", stats_ph.mean, stats_ph.std_dev);
-    logSystemSafe("Nitrogen: μ=%.2f, σ=%.2f", stats_n.mean, stats_n.std_dev);
-    logSystemSafe("Phosphorus: μ=%.2f, σ=%.2f", stats_p.mean, stats_p.std_dev);
-    logSystemSafe("Potassium: μ=%.2f, σ=%.2f", stats_k.mean, stats_k.std_dev);
-
-    // Диагностика специализированного фильтра EC
-    if (ec_filter_state.baseline_valid)
-    {  // NOLINT(readability-implicit-bool-conversion)
-        logSystemSafe("EC Фильтр: база=%.1f, выбросов=%d", ec_filter_state.baseline, ec_filter_state.spike_count);
+    for (uint8_t channel = 0; channel < SENSOR_CHANNEL_COUNT; ++channel)
+    {
+        const StatisticsBuffer& stats = channelChains[channel].getStatistics();
+        logSystemSafe("%s: μ=%.2f, σ=%.2f", CHANNEL_PROFILES[channel].name, stats.mean, stats.std_dev);
+    }
+
+    // Диагностика фильтров всплесков
+    for (uint8_t channel = 0; channel < SENSOR_CHANNEL_COUNT; ++channel)
+    {
+        const ECFilterState& spike = channelChains[channel].getSpikeState();
+        if (spike.baseline_valid)
+        {  // NOLINT(readability-implicit-bool-conversion)
+            logSystemSafe("%s Фильтр: база=%.1f, выбросов=%d", CHANNEL_PROFILES[channel].name, spike.baseline,
+                          spike.spike_count);
+        }
     }
 }
 
@@ -41,74 +41,20 @@ void SensorCalibrationService::applyCalibration(SensorData& data, SoilProfile pr
     data.raw_phosphorus = data.phosphorus;
     data.raw_potassium = data.potassium;
 
-    // Применяем калибровку к каждому параметру
-    if (hasCalibrationTable(profile))
-    {
-        const CalibrationTable& table = getCalibrationTables()[profile];
-
-        if (!table.temperaturePoints.empty())
-        {
-            data.temperature = applyCalibrationWithInterpolation(data.temperature, table.temperaturePoints);
-        }
-
-        if (!table.humidityPoints.empty())
-        {
-            data.humidity = applyCalibrationWithInterpolation(data.humidity, table.humidityPoints);
-        }
-
-        if (!table.ecPoints.empty())
-        {
-            data.ec = applyCalibrationWithInterpolation(data.ec, table.ecPoints);
-        }
-
-        if (!table.phPoints.empty())
-        {
-            data.ph = applyCalibrationWithInterpolation(data.ph, table.phPoints);
-        }
-
-        if (!table.nitrogenPoints.empty())
-        {
-            data.nitrogen = applyCalibrationWithInterpolation(data.nitrogen, table.nitrogenPoints);
-        }
-
-        if (!table.phosphorusPoints.empty())
-        {
-            data.phosphorus = applyCalibrationWithInterpolation(data.phosphorus, table.phosphorusPoints);
-        }
-
-        if (!table.potassiumPoints.empty())
-        {
-            data.potassium = applyCalibrationWithInterpolation(data.potassium, table.potassiumPoints);
-        }
-    }
-    else
-    {
-        // Используем старую логику для совместимости
-        data.temperature = CalibrationManager::applyCalibration(data.temperature, profile);
-        data.humidity = CalibrationManager::applyCalibration(data.humidity, profile);
-        data.ec = CalibrationManager::applyCalibration(data.ec, profile);
-        data.ph = CalibrationManager::applyCalibration(data.ph, profile);
-        data.nitrogen = CalibrationManager::applyCalibration(data.nitrogen, profile);
-        data.phosphorus = CalibrationManager::applyCalibration(data.phosphorus, profile);
-        data.potassium = CalibrationManager::applyCalibration(data.potassium, profile);
-    }
+    // Кривая коэффициентов строится в CalibrationManager::reloadTable() из /calibration/custom.csv
+    data.temperature = CalibrationManager::applyCalibration(data.temperature, profile);
+    data.humidity = CalibrationManager::applyCalibration(data.humidity, profile);
+    data.ec = CalibrationManager::applyCalibration(data.ec, profile);
+    data.ph = CalibrationManager::applyCalibration(data.ph, profile);
+    data.nitrogen = CalibrationManager::applyCalibration(data.nitrogen, profile);
+    data.phosphorus = CalibrationManager::applyCalibration(data.phosphorus, profile);
+    data.potassium = CalibrationManager::applyCalibration(data.potassium, profile);
 
     logDebugSafe("SensorCalibrationService: Калибровка применена");
 }
 
 float SensorCalibrationService::applySingleCalibration(float rawValue, SoilProfile profile)
 {
-    if (hasCalibrationTable(profile))
-    {
-        const CalibrationTable& table = getCalibrationTables()[profile];
-        // Для простоты используем первую доступную таблицу
-        if (!table.temperaturePoints.empty())
-        {
-            return applyCalibrationWithInterpolation(rawValue, table.temperaturePoints);
-        }
-    }
-
-    // Fallback к старой логике
     return CalibrationManager::applyCalibration(rawValue, profile);
 }
 
@@ -300,52 +246,6 @@ void SensorCalibrationService::resetCalibration()
     getCalibrationTables().clear();
 }
 
-float SensorCalibrationService::applyCalibrationWithInterpolation(
-    float rawValue,
-    const std::vector<CalibrationPoint>& points) const  // NOLINT(readability-convert-member-functions-to-static)
-{
-    if (points.empty())
-    {
-        return rawValue;
-    }
-
-    if (points.size() == 1)
-    {
-        return points[0].referenceValue;
-    }
-
-    // Находим ближайшие точки для интерполяции
-    for (size_t i = 0; i < points.size() - 1; ++i)
-    {
-        float raw1 = points[i].rawValue;
-        float ref1 = points[i].referenceValue;
-        float raw2 = points[i + 1].rawValue;
-        float ref2 = points[i + 1].referenceValue;
-        if (rawValue >= raw1 && rawValue <= raw2)
-        {
-            return linearInterpolation(rawValue, raw1, ref1, raw2, ref2);
-        }
-    }
-
-    // Если значение вне диапазона, используем экстраполяцию
-    if (rawValue < points[0].rawValue)
-    {
-        return points[0].referenceValue;
-    }
-    return points[points.size() - 1].referenceValue;
-}
-
-float SensorCalibrationService::linearInterpolation(
-    float value, float x1_coord, float y1_coord, float x2_coord,
-    float y2_coord) const  // NOLINT(readability-convert-member-functions-to-static)
-{
-    if (x2_coord == x1_coord)
-    {
-        return y1_coord;
-    }
-    return y1_coord + (((y2_coord - y1_coord) * (value - x1_coord)) / (x2_coord - x1_coord));
-}
-
 bool SensorCalibrationService::parseCalibrationCSV(const String& csvData, CalibrationTable& table)
 {  // NOLINT(readability-convert-member-functions-to-static)
     // Простая реализация парсинга CSV
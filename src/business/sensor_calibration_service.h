@@ -64,12 +64,6 @@ class SensorCalibrationService : public ISensorCalibrationService
     // Менеджер калибровки (для совместимости с существующим кодом)
     // CalibrationManager& calibrationManager; // Убрано - используем namespace
 
-    // Применение калибровки к значению с интерполяцией
-    float applyCalibrationWithInterpolation(float rawValue, const std::vector<CalibrationPoint>& points) const;
-
-    // Линейная интерполяция между двумя точками
-    float linearInterpolation(float value, float x1, float y1, float x2, float y2) const;
-
     // Парсинг CSV данных калибровочной таблицы
     bool parseCalibrationCSV(const String& csvData, CalibrationTable& table);
 
@@ -1,5 +1,12 @@
 #include "calibration_manager.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include "calibration_curve.h"
+#include "flash_writer.h"
+#include "jxct_config_vars.h"
 #include "logger.h"
+#include "rtos_mutex.h"
 #include "sensor_compensation.h"
 
 namespace CalibrationManager
@@ -7,7 +14,65 @@ namespace CalibrationManager
 namespace
 {
 bool _initialized = false;
-}
+constexpr size_t CALIBRATION_COPY_CHUNK = 64;
+
+// Кривая коэффициента коррекции (raw → corrected), построенная по таблице калибровки
+struct LoadedTable
+{
+    CalibrationCurve coefficients;
+};
+
+// Двойной буфер: веб-задача разбирает файл в неактивную копию и атомарно переключает индекс,
+// задача датчика читает активную копию без блокировок и без обращений к LittleFS.
+// Читатель отмечается в счётчике своей копии; перезагрузка не трогает копию, пока в ней есть читатели,
+// иначе две перезагрузки подряд могли бы переписать копию, которую датчик ещё не дочитал
+std::array<LoadedTable, 2> loadedTables;
+std::atomic<uint8_t> activeTable{0};
+std::array<std::atomic<uint32_t>, 2> tableReaders{};
+RtosMutex reloadMutex;  // Перезагрузки идут по одной: из setup() и из обработчиков веб-сервера
+
+// Строки файла и их разбивка на оси кривой; используются только под reloadMutex
+std::array<CalibrationEntry, MAX_CALIBRATION_ENTRIES> parsedEntries;
+std::array<float, MAX_CALIBRATION_ENTRIES> parsedRaw;
+std::array<float, MAX_CALIBRATION_ENTRIES> parsedCoefficients;
+
+constexpr TickType_t READER_WAIT_TICKS = 1;
+
+// Активная копия таблицы на время жизни объекта
+class TableReader
+{
+   public:
+    TableReader()
+    {
+        // Отметка ставится до повторной проверки индекса: перезагрузка, увидевшая ноль читателей,
+        // переключит индекс раньше, чем читатель начнёт читать, и он уйдёт на другую копию
+        for (;;)
+        {
+            index = activeTable.load();
+            tableReaders[index].fetch_add(1);
+            if (activeTable.load() == index)
+            {
+                break;
+            }
+            tableReaders[index].fetch_sub(1);
+        }
+    }
+    ~TableReader()
+    {
+        tableReaders[index].fetch_sub(1);
+    }
+    TableReader(const TableReader&) = delete;
+    TableReader& operator=(const TableReader&) = delete;
+
+    const LoadedTable& table() const
+    {
+        return loadedTables[index];
+    }
+
+   private:
+    uint8_t index = 0;
+};
+}  // namespace
 
 const char* profileToFilename(SoilProfile /*profile*/)  // NOLINT(misc-use-internal-linkage)
 {
@@ -46,22 +111,39 @@ bool saveCsv(SoilProfile profile, Stream& fileStream)  // NOLINT(misc-use-intern
     }
     const char* path = profileToFilename(profile);
 
-    auto calibrationFile = LittleFS.open(path, "w");
-    if (!calibrationFile)
+    // Поток копируется кусками через буфер: раньше каждый байт был отдельной записью в LittleFS
+    BufferedFlashFile calibrationFile;
+    if (!calibrationFile.open(path, "w"))
     {
         logErrorSafe("\1", path);
         return false;
     }
 
+    std::array<uint8_t, CALIBRATION_COPY_CHUNK> chunk;
+    size_t size = 0;
     while (fileStream.available() > 0)  // NOLINT(readability-implicit-bool-conversion)
     {
-        const uint8_t dataByte = fileStream.read();
-        calibrationFile.write(dataByte);
+        // Не больше, чем уже пришло: readBytes() иначе ждёт таймаута потока
+        const size_t wanted = std::min(chunk.size(), static_cast<size_t>(fileStream.available()));
+        const size_t length = fileStream.readBytes(chunk.data(), wanted);
+        if (length == 0 || !calibrationFile.write(chunk.data(), length))
+        {
+            break;
+        }
+        size += length;
     }
 
-    calibrationFile.close();
-    logSuccessSafe("\1", path, calibrationFile.size());
-    return calibrationFile.size() > 0U;
+    const bool saved = calibrationFile.close() && size > 0U;
+    if (!saved)
+    {
+        // Недописанный файл не должен попасть в таблицу после перезагрузки; в памяти остаётся прежняя таблица
+        logErrorSafe("\1", path, size);
+        LittleFS.remove(path);
+        return false;
+    }
+    logSuccessSafe("\1", path, size);
+    reloadTable();
+    return true;
 }
 
 bool loadTable(SoilProfile profile, CalibrationEntry* outBuffer, size_t maxEntries,
@@ -134,66 +216,58 @@ bool deleteTable(SoilProfile profile)  // NOLINT(misc-use-internal-linkage)
     const char* path = profileToFilename(profile);
     if (LittleFS.exists(path))
     {
-        return LittleFS.remove(path);
+        const bool removed = LittleFS.remove(path);
+        reloadTable();
+        return removed;
     }
     return false;
 }
 
-float applyCalibration(float rawValue,
-                       SoilProfile profile)  // NOLINT(misc-use-internal-linkage, bugprone-easily-swappable-parameters)
+bool reloadTable()  // NOLINT(misc-use-internal-linkage)
 {
-    // Если калибровочная таблица не загружена, возвращаем исходное значение
-    if (!hasTable(profile))
+    const std::lock_guard<RtosMutex> lock(reloadMutex);
+    const uint8_t next = activeTable.load() ^ 1U;
+    // Читатели, начавшие до прошлого переключения, ещё могут быть в неактивной копии
+    while (tableReaders[next].load() != 0)
     {
-        return rawValue;
+        vTaskDelay(READER_WAIT_TICKS);
     }
+    LoadedTable& table = loadedTables[next];
 
-    // Загружаем калибровочную таблицу
-    constexpr size_t MAX_ENTRIES = 100;
-    std::array<CalibrationEntry, MAX_ENTRIES> entries;
-    size_t entryCount;
-
-    if (!loadTable(profile, entries.data(), MAX_ENTRIES, entryCount) || entryCount == 0)
+    // Файл один для всех профилей (см. profileToFilename)
+    size_t count = 0;
+    if (!hasTable(SoilProfile::SAND) ||
+        !loadTable(SoilProfile::SAND, parsedEntries.data(), parsedEntries.size(), count))
     {
-        return rawValue;
+        count = 0;
     }
-
-    // Ищем ближайшие значения для интерполяции
-    const float lowerRaw = entries[0].raw;
-    const float lowerCorr = entries[0].corrected;
-    const float upperRaw = entries[entryCount - 1].raw;
-    const float upperCorr = entries[entryCount - 1].corrected;
-
-    // Ищем точное совпадение или ближайшие значения
-    for (size_t i = 0; i < entryCount; ++i)
+    for (size_t i = 0; i < count; ++i)
     {
-        if (entries[i].raw == rawValue)
-        {
-            // Точное совпадение - применяем коэффициент
-            return rawValue * entries[i].corrected;
-        }
-
-        if (entries[i].raw < rawValue)
-        {
-            // lowerRaw = entries[i].raw; // Уже const
-            // lowerCorr = entries[i].corrected; // Уже const
-        }
-        else if (entries[i].raw > rawValue)
-        {
-            // upperRaw = entries[i].raw; // Уже const
-            // upperCorr = entries[i].corrected; // Уже const
-            break;
-        }
+        parsedRaw[i] = parsedEntries[i].raw;
+        parsedCoefficients[i] = parsedEntries[i].corrected;
     }
+    // Способ интерполяции выбирается в настройках; после его смены таблицу нужно перечитать
+    const bool pchip = config.calibrationInterpolation == static_cast<uint8_t>(CalibrationInterpolation::PCHIP);
+    const auto interpolation = pchip ? CalibrationInterpolation::PCHIP : CalibrationInterpolation::LINEAR;
+    table.coefficients.build(parsedRaw.data(), parsedCoefficients.data(), count, interpolation);
+
+    activeTable.store(next);
+    return !table.coefficients.empty();
+}
 
-    // Линейная интерполяция между ближайшими значениями
-    if (upperRaw > lowerRaw)
+float applyCalibration(float rawValue,
+                       SoilProfile /*profile*/)  // NOLINT(misc-use-internal-linkage, bugprone-easily-swappable-parameters)
+{
+    const TableReader reader;
+    const CalibrationCurve& coefficients = reader.table().coefficients;
+
+    // Если калибровочная таблица не загружена, возвращаем исходное значение
+    if (coefficients.empty())
     {
-        const float ratio = (rawValue - lowerRaw) / (upperRaw - lowerRaw);
-        const float interpolatedCoeff = lowerCorr + (ratio * (upperCorr - lowerCorr));
-        return rawValue * interpolatedCoeff;
+        return rawValue;
     }
-    // Если нет интервала, используем ближайший коэффициент
-    return rawValue * lowerCorr;
+
+    // Коэффициент интерполируется между точками таблицы, за её пределами берётся коэффициент крайней точки
+    return rawValue * coefficients.evaluate(rawValue);
 }
 }  // namespace CalibrationManager
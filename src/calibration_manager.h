@@ -20,6 +20,9 @@ struct CalibrationEntry
 
 namespace CalibrationManager
 {
+// Максимум строк таблицы, держащихся в оперативной памяти
+constexpr size_t MAX_CALIBRATION_ENTRIES = 100;
+
 // Инициализация файловой системы (LittleFS) и каталога /calibration
 bool init();
 
@@ -38,6 +41,14 @@ bool deleteTable(SoilProfile profile);
 // Преобразование профиля в имя файла
 const char* profileToFilename(SoilProfile profile);
 
-// Применение калибровочной таблицы к значению датчика
+/**
+ * @brief Перечитать таблицу из LittleFS в оперативную память
+ * @details Вызывается при загрузке и после каждого изменения файла (upload, удаление).
+ * Таблица сортируется по сырому значению; applyCalibration() к файлу больше не обращается.
+ * @return true — таблица загружена и не пуста
+ */
+bool reloadTable();
+
+// Применение калибровочной таблицы к значению датчика (из таблицы в памяти)
 float applyCalibration(float rawValue, SoilProfile profile);
 }  // namespace CalibrationManager
@@ -1,16 +1,25 @@
 /**
  * @file config.cpp
  * @brief Работа с конфигурацией устройства
- * @details Загрузка, сохранение, сброс и валидация настроек устройства через NVS (Preferences).
+ * @details Загрузка, сохранение, сброс и валидация настроек устройства через NVS (Preferences). Поля и их
+ * значения по умолчанию берутся из таблиц config_schema.h. Сохранение сравнивает настройки с последними
+ * записанными и пишет одной сессией NVS только изменённые ключи.
  */
 #include "config.h"
 #include <WiFi.h>
 #include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include "config_schema.h"
 #include "debug.h"  // ✅ Добавляем систему условной компиляции
+#include "flash_writer.h"
 #include "jxct_config_vars.h"
 #include "jxct_constants.h"
 #include "jxct_device_info.h"
 #include "logger.h"
+#include "rtos_mutex.h"
+#include "sensor_bus.h"
 #include "version.h"  // ✅ Централизованное управление версией
 
 // Firmware version definition - теперь берется из централизованного файла version.h
@@ -38,296 +47,306 @@ String getDefaultTopic()  // NOLINT(misc-use-internal-linkage)
 Config config;            // NOLINT(misc-use-internal-linkage)
 Preferences preferences;  // NOLINT(misc-use-internal-linkage)
 
-#define KEY_NTP_INTERVAL "ntpIntvl"  // ≤15 bytes, иначе NVS выдаёт KEY_TOO_LONG
+namespace
+{
+// Растёт при каждом изменении сохранённой конфигурации; читается задачей веб-сервера
+std::atomic<uint32_t> configVersion{1};
+
+// Значения, которые лежат в NVS: saveConfig() пишет только ключи, отличающиеся от них
+Config storedConfig;
+bool storedConfigValid = false;  // До loadConfig() и после resetConfig() сохраняется всё
+
+// Замок самой config (ConfigLock): держится только на время копирования и изменения полей
+RtosMutex configMutex;
+
+// loadConfig(), saveConfig() и resetConfig() вызываются из loop() (команды MQTT) и из задачи веб-сервера;
+// этот замок держится всю функцию: открытая сессия Preferences и storedConfig у них общие.
+// Порядок захвата: сначала он, потом configMutex — поэтому эти функции не вызываются под ConfigLock
+RtosMutex nvsMutex;
+
+// Учесть запись ключа NVS: put*() возвращает размер записанного значения, 0 — ошибка; false — ключ не записан
+bool countNvsWrite(size_t length)
+{
+    if (length > 0)
+    {
+        noteFlashWrite(FlashPartition::NVS, 0, length);
+    }
+    return length > 0;
+}
+
+// Побайтовое сравнение: у float так различаются и NaN, и ±0
+template <typename T>
+bool differs(const T& value, const T& stored)
+{
+    return memcmp(&value, &stored, sizeof(T)) != 0;
+}
+
+/**
+ * @brief Запись изменённых ключей конфигурации одной сессией NVS
+ * @details Сессия открывается на первом изменённом ключе и закрывается в close(); без изменений NVS не трогается.
+ */
+class ConfigWriter
+{
+   public:
+    explicit ConfigWriter(bool writeAll) : writeAll(writeAll) {}
+
+    void putString(const char* key, const char* value, const char* stored)
+    {
+        if (begin(strcmp(value, stored) != 0))
+        {
+            // Пустая строка записывается с нулевым размером: ошибку по ответу не отличить
+            check(countNvsWrite(preferences.putString(key, value)) || value[0] == '\0');
+        }
+    }
+
+    template <ConfigKind Kind>
+    void put(const char* key, typename ConfigField<Kind>::Type value, typename ConfigField<Kind>::Type stored)
+    {
+        if (begin(differs(value, stored)))
+        {
+            check(countNvsWrite(ConfigField<Kind>::store(preferences, key, value)));
+        }
+    }
+
+    void putBytes(const char* key, const void* value, const void* stored, size_t size)
+    {
+        if (begin(memcmp(value, stored, size) != 0))
+        {
+            check(countNvsWrite(preferences.putBytes(key, value, size)));
+        }
+    }
+
+    // Записано ключей с начала сохранения
+    size_t changes() const
+    {
+        return changed;
+    }
+
+    // Ключей, которые NVS не приняло
+    size_t failures() const
+    {
+        return failed;
+    }
+
+    void close()
+    {
+        if (changed > 0)
+        {
+            preferences.end();
+        }
+    }
+
+   private:
+    // true — ключ нужно записать; первая запись открывает сессию
+    bool begin(bool modified)
+    {
+        if (!modified && !writeAll)
+        {
+            return false;
+        }
+        if (changed++ == 0)
+        {
+            preferences.begin("jxct-sensor", false);
+        }
+        return true;
+    }
+
+    void check(bool written)
+    {
+        if (!written)
+        {
+            ++failed;
+        }
+    }
+
+    bool writeAll;
+    size_t changed = 0;
+    size_t failed = 0;
+};
+
+// Строка из NVS; ключа нет — значение по умолчанию
+void loadString(const char* key, const char* fallback, char* value, size_t size)
+{
+    if (preferences.getString(key, value, size) == 0)
+    {
+        strlcpy(value, fallback, size);
+    }
+}
+}  // namespace
 
 void loadConfig()  // NOLINT(misc-use-internal-linkage)
 {
+    const std::lock_guard<RtosMutex> lock(nvsMutex);
+    Config loaded;
+    {
+        const ConfigLock settingsLock;
+        loaded = config;
+    }
     preferences.begin("jxct-sensor", false);
 
-    // WiFi настройки
-    preferences.getString("ssid", config.ssid, sizeof(config.ssid));
-    preferences.getString("password", config.password, sizeof(config.password));
-
-    // MQTT настройки
-    preferences.getString("mqttServer", config.mqttServer, sizeof(config.mqttServer));
-    config.mqttPort = preferences.getUShort("mqttPort", 1883);
-    preferences.getString("mqttUser", config.mqttUser, sizeof(config.mqttUser));
-    preferences.getString("mqttPassword", config.mqttPassword, sizeof(config.mqttPassword));
-    preferences.getString("mqttTopicPrefix", config.mqttTopicPrefix, sizeof(config.mqttTopicPrefix));
-    preferences.getString("mqttDeviceName", config.mqttDeviceName, sizeof(config.mqttDeviceName));
-    // Битовые поля boolean флагов
-    config.flags.hassEnabled = preferences.getBool("hassEnabled", false);
-    config.flags.useRealSensor =
-        preferences.getBool("useRealSensor", true);  // ИСПРАВЛЕНО: по умолчанию используем реальный датчик
-    config.flags.mqttEnabled = preferences.getBool("mqttEnabled", false);
-    config.flags.thingSpeakEnabled = preferences.getBool("tsEnabled", false);
-    config.flags.calibrationEnabled = preferences.getBool("calEnabled", false);
-
-    config.mqttQos = preferences.getUChar("mqttQos", 0);
-    config.thingspeakInterval = preferences.getUShort("tsInterval", 60);
-    preferences.getString("manufacturer", config.manufacturer, sizeof(config.manufacturer));
-    preferences.getString("model", config.model, sizeof(config.model));
-    preferences.getString("swVersion", config.swVersion, sizeof(config.swVersion));
-
-    // ThingSpeak настройки
-    preferences.getString("tsApiKey", config.thingSpeakApiKey, sizeof(config.thingSpeakApiKey));
-    preferences.getString("tsChannelId", config.thingSpeakChannelId, sizeof(config.thingSpeakChannelId));
-
-    // Настройка датчика
-    config.modbusId = preferences.getUChar("modbusId", JXCT_MODBUS_ID);
-
-    config.webPassword[0] = '\0';
-
-    // NTP настройки
-    const String ntpServer = preferences.getString("ntpServer", "pool.ntp.org");
-    ntpServer.toCharArray(config.ntpServer, sizeof(config.ntpServer));
-    config.ntpUpdateInterval = preferences.getUInt(KEY_NTP_INTERVAL, 60000);
-
-    // v2.3.0: Настраиваемые интервалы (с дефолтными значениями из v2.2.1)
-    config.sensorReadInterval = preferences.getUInt("sensorInterval", SENSOR_READ_INTERVAL);
-    config.mqttPublishInterval = preferences.getUInt("mqttInterval", MQTT_PUBLISH_INTERVAL);
-    config.thingSpeakInterval = preferences.getUInt("tsInterval", THINGSPEAK_INTERVAL);
-    config.webUpdateInterval = preferences.getUInt("webInterval", WEB_UPDATE_INTERVAL);
-
-    // v2.3.0: Настраиваемые пороги дельта-фильтра
-    config.deltaTemperature = preferences.getFloat("deltaTemp", DELTA_TEMPERATURE);
-    config.deltaHumidity = preferences.getFloat("deltaHum", DELTA_HUMIDITY);
-    config.deltaPh = preferences.getFloat("deltaPh", DELTA_PH);
-    config.deltaEc = preferences.getFloat("deltaEc", DELTA_EC);
-    config.deltaNpk = preferences.getFloat("deltaNpk", DELTA_NPK);
-
-    // v2.3.0: Настройки скользящего среднего (МИНИМАЛЬНАЯ ФИЛЬТРАЦИЯ)
-    config.movingAverageWindow = preferences.getUChar("avgWindow", 5);  // минимальное окно
-    config.forcePublishCycles = preferences.getUChar("forceCycles", FORCE_PUBLISH_CYCLES);
-    config.filterAlgorithm = preferences.getUChar("filterAlgo", 0);          // 0=среднее
-    config.outlierFilterEnabled = preferences.getUChar("outlierFilter", 0);  // отключен для минимальной фильтрации
-
-    // v3.10.0: УЛУЧШЕННАЯ СИСТЕМА ФИЛЬТРАЦИИ
-    config.exponentialAlpha = preferences.getFloat("expAlpha", EXPONENTIAL_ALPHA_DEFAULT);
-    config.outlierThreshold = preferences.getFloat("outlierThresh", OUTLIER_THRESHOLD_DEFAULT);
-    config.kalmanEnabled = preferences.getUChar("kalmanEnabled", 0);       // 0=отключен по умолчанию
-    config.adaptiveFiltering = preferences.getUChar("adaptiveFilter", 0);  // 0=отключена по умолчанию
-
-    // Soil profile и агро-поля
-    config.soilProfile = preferences.getUChar("soilProfile", 0);
-    config.latitude = preferences.getFloat("lat", 0.0F);
-    config.longitude = preferences.getFloat("lon", 0.0F);
-    preferences.getString("cropId", config.cropId, sizeof(config.cropId));
-    config.flags.isGreenhouse = preferences.getBool("greenhouse", false);
-    config.irrigationSpikeThreshold = preferences.getFloat("irrigTh", 8.0F);
-    config.irrigationHoldMinutes = preferences.getUShort("irrigHold", 5);
-
-    // v2.6.1: сезонные коэффициенты и тип среды
-    config.environmentType = preferences.getUChar("envType", 0);  // 0=outdoor по умолчанию
-    config.flags.seasonalAdjustEnabled = preferences.getBool("seasonAdj", true);
-    config.flags.autoOtaEnabled = preferences.getBool("autoOTA", false);
+#define CONFIG_LOAD_VALUE(kind, member, key, fallback, low, high, group, name) \
+    loaded.member = ConfigField<ConfigKind::kind>::load(preferences, key, fallback);
+#define CONFIG_LOAD_STRING(member, key, fallback, group, name, placeholder) \
+    loadString(key, fallback, loaded.member, sizeof(loaded.member));
+    CONFIG_VALUE_FIELDS(CONFIG_LOAD_VALUE)
+    CONFIG_STRING_FIELDS(CONFIG_LOAD_STRING)
+#undef CONFIG_LOAD_VALUE
+#undef CONFIG_LOAD_STRING
+
+    // Устаревшее 16-битное поле под тем же ключом, что и thingSpeakInterval: NVS отдаёт его только по типу u16
+    loaded.thingspeakInterval = preferences.getUShort("tsInterval", 60);
+    loaded.webPassword[0] = '\0';
+    // Порядок стадий по каналам; отсутствующий или старый блок — порядок по умолчанию (нули)
+    if (preferences.getBytes("stageOrder", loaded.filterStageOrder, sizeof(loaded.filterStageOrder)) !=
+        sizeof(loaded.filterStageOrder))
+    {
+        for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; ++i)
+        {
+            loaded.filterStageOrder[i] = 0;
+        }
+    }
 
     preferences.end();
-    // Значения по умолчанию для новых полей
-    if (strlen(config.mqttDeviceName) == 0)
+    storedConfig = loaded;
+    storedConfigValid = true;
+    // Значения по умолчанию, зависящие от MAC-адреса
+    if (strlen(loaded.mqttDeviceName) == 0)
     {
-        strlcpy(config.mqttDeviceName, getDeviceId().c_str(), sizeof(config.mqttDeviceName));
+        strlcpy(loaded.mqttDeviceName, getDeviceId().c_str(), sizeof(loaded.mqttDeviceName));
     }
-    if (strlen(config.thingSpeakChannelId) == 0)
+    if (strlen(loaded.mqttTopicPrefix) == 0)
     {
-        strlcpy(config.thingSpeakChannelId, "", sizeof(config.thingSpeakChannelId));
+        strlcpy(loaded.mqttTopicPrefix, getDefaultTopic().c_str(), sizeof(loaded.mqttTopicPrefix));
     }
-    if (strlen(config.mqttTopicPrefix) == 0)
     {
-        strlcpy(config.mqttTopicPrefix, getDefaultTopic().c_str(), sizeof(config.mqttTopicPrefix));
+        const ConfigLock settingsLock;
+        config = loaded;
     }
 
     logSuccess("Конфигурация загружена");
-    logDebugSafe("SSID: %s, MQTT: %s:%d, ThingSpeak: %s", config.ssid, config.mqttServer,
-                 static_cast<int>(config.mqttPort), config.flags.thingSpeakEnabled ? "включен" : "выключен");
+    logDebugSafe("SSID: %s, MQTT: %s:%d, ThingSpeak: %s", loaded.ssid, loaded.mqttServer,
+                 static_cast<int>(loaded.mqttPort), loaded.flags.thingSpeakEnabled ? "включен" : "выключен");
 }
 
 void saveConfig()  // NOLINT(misc-use-internal-linkage)
 {
-    preferences.begin("jxct-sensor", false);
-
-    // WiFi настройки
-    preferences.putString("ssid", config.ssid);
-    preferences.putString("password", config.password);
-
-    // MQTT настройки
-    preferences.putString("mqttServer", config.mqttServer);
-    preferences.putUShort("mqttPort", config.mqttPort);
-    preferences.putString("mqttUser", config.mqttUser);
-    preferences.putString("mqttPassword", config.mqttPassword);
-    preferences.putString("mqttTopicPrefix", config.mqttTopicPrefix);
-    preferences.putString("mqttDeviceName", config.mqttDeviceName);
-
-    // Битовые поля boolean флагов
-    preferences.putBool("hassEnabled", config.flags.hassEnabled);
-    preferences.putBool("useRealSensor", config.flags.useRealSensor);
-    preferences.putBool("mqttEnabled", config.flags.mqttEnabled);
-    preferences.putBool("tsEnabled", config.flags.thingSpeakEnabled);
-    preferences.putBool("calEnabled", config.flags.calibrationEnabled);
-
-    preferences.putUChar("mqttQos", config.mqttQos);
-    preferences.putUShort("tsInterval", config.thingspeakInterval);
-    preferences.putString("manufacturer", config.manufacturer);
-    preferences.putString("model", config.model);
-    preferences.putString("swVersion", config.swVersion);
-
-    // ThingSpeak настройки
-    preferences.putString("tsApiKey", config.thingSpeakApiKey);
-    preferences.putString("tsChannelId", config.thingSpeakChannelId);
-
-    // Настройка датчика
-    preferences.putUChar("modbusId", config.modbusId);
-
-    preferences.putString("webPassword", "");
-
-    // NTP настройки
-    preferences.putString("ntpServer", config.ntpServer);
-    preferences.putUInt(KEY_NTP_INTERVAL, config.ntpUpdateInterval);
-
-    // v2.3.0: Настраиваемые интервалы
-    preferences.putUInt("sensorInterval", config.sensorReadInterval);
-    preferences.putUInt("mqttInterval", config.mqttPublishInterval);
-    preferences.putUInt("tsInterval", config.thingSpeakInterval);
-    preferences.putUInt("webInterval", config.webUpdateInterval);
-
-    // v2.3.0: Настраиваемые пороги дельта-фильтра
-    preferences.putFloat("deltaTemp", config.deltaTemperature);
-    preferences.putFloat("deltaHum", config.deltaHumidity);
-    preferences.putFloat("deltaPh", config.deltaPh);
-    preferences.putFloat("deltaEc", config.deltaEc);
-    preferences.putFloat("deltaNpk", config.deltaNpk);
-
-    // v2.3.0: Настройки скользящего среднего
-    preferences.putUChar("avgWindow", config.movingAverageWindow);
-    preferences.putUChar("forceCycles", config.forcePublishCycles);
-    preferences.putUChar("filterAlgo", config.filterAlgorithm);
-    preferences.putUChar("outlierFilter", config.outlierFilterEnabled);
-
-    // v3.10.0: УЛУЧШЕННАЯ СИСТЕМА ФИЛЬТРАЦИИ
-    preferences.putFloat("expAlpha", config.exponentialAlpha);
-    preferences.putFloat("outlierThresh", config.outlierThreshold);
-    preferences.putUChar("kalmanEnabled", config.kalmanEnabled);
-    preferences.putUChar("adaptiveFilter", config.adaptiveFiltering);
-
-    // Soil profile и агро-поля
-    preferences.putUChar("soilProfile", config.soilProfile);
-    preferences.putFloat("lat", config.latitude);
-    preferences.putFloat("lon", config.longitude);
-    preferences.putString("cropId", config.cropId);
-    preferences.putBool("greenhouse", config.flags.isGreenhouse);
-    preferences.putFloat("irrigTh", config.irrigationSpikeThreshold);
-    preferences.putUShort("irrigHold", config.irrigationHoldMinutes);
-
-    // v2.6.1: сохранение новых полей
-    preferences.putUChar("envType", config.environmentType);
-    preferences.putBool("seasonAdj", config.flags.seasonalAdjustEnabled);
-    preferences.putBool("autoOTA", config.flags.autoOtaEnabled);
-
-    preferences.end();
+    const std::lock_guard<RtosMutex> lock(nvsMutex);
+    // Запись в NVS идёт по копии: config не заперта, пока флеш занят
+    Config pending;
+    {
+        const ConfigLock settingsLock;
+        // Адреса датчиков шины не выходят за 247, как бы ни было задано их число
+        config.busProbeCount = clampBusProbeCount(config.modbusId, config.busProbeCount);
+        pending = config;
+    }
+    const Config& stored = storedConfig;
+    ConfigWriter writer(!storedConfigValid);
+
+    // Кэш Home Assistant строится из префикса топиков и имени устройства
+    const bool haChanged = !storedConfigValid || strcmp(pending.mqttTopicPrefix, stored.mqttTopicPrefix) != 0 ||
+                           strcmp(pending.mqttDeviceName, stored.mqttDeviceName) != 0;
+
+#define CONFIG_SAVE_VALUE(kind, member, key, fallback, low, high, group, name) \
+    writer.put<ConfigKind::kind>(key, pending.member, stored.member);
+#define CONFIG_SAVE_STRING(member, key, fallback, group, name, placeholder) \
+    writer.putString(key, pending.member, stored.member);
+    CONFIG_VALUE_FIELDS(CONFIG_SAVE_VALUE)
+    CONFIG_STRING_FIELDS(CONFIG_SAVE_STRING)
+#undef CONFIG_SAVE_VALUE
+#undef CONFIG_SAVE_STRING
+
+    writer.putBytes("stageOrder", pending.filterStageOrder, stored.filterStageOrder, sizeof(pending.filterStageOrder));
+    // Пароль веб-интерфейса в NVS не хранится: ключ очищается только при полной записи
+    writer.putString("webPassword", "", "");
+
+    writer.close();
+    if (writer.changes() == 0)
+    {
+        logDebug("Конфигурация не изменилась");
+        return;
+    }
+    storedConfig = pending;
+    // Незаписанный ключ в NVS расходится с копией: следующее сохранение перепишет все ключи
+    storedConfigValid = writer.failures() == 0;
+    if (!storedConfigValid)
+    {
+        logErrorSafe("Конфигурация: NVS не приняло ключей %u, они будут записаны при следующем сохранении",
+                     static_cast<unsigned>(writer.failures()));
+    }
 
-    // ✅ Инвалидируем кэш MQTT конфигураций при изменении настроек
-    extern void invalidateHAConfigCache();
-    invalidateHAConfigCache();
+    if (haChanged)
+    {
+        extern void invalidateHAConfigCache();
+        invalidateHAConfigCache();
+    }
+    configVersion.fetch_add(1, std::memory_order_release);
 
-    logSuccess("Конфигурация сохранена");
+    logSuccessSafe("Конфигурация сохранена: изменено ключей %u", static_cast<unsigned>(writer.changes()));
 }
 
 void resetConfig()  // NOLINT(misc-use-internal-linkage)
 {
+    const std::lock_guard<RtosMutex> lock(nvsMutex);
     logWarn("Сброс конфигурации...");
     preferences.begin("jxct-sensor", false);
     preferences.clear();
     preferences.end();
-    // ✅ Безопасный сброс структуры config без memset для упакованных структур
-    // Wi-Fi
-    config.ssid[0] = '\0';
-    config.password[0] = '\0';
-    // MQTT
-    config.mqttPort = 1883;
-    config.modbusId = JXCT_MODBUS_ID;
-    strlcpy(config.mqttTopicPrefix, getDefaultTopic().c_str(), sizeof(config.mqttTopicPrefix));
-    strlcpy(config.mqttDeviceName, getDeviceId().c_str(), sizeof(config.mqttDeviceName));
-
-    // ✅ Явный сброс битовых полей
-    config.flags.mqttEnabled = 0;
-    config.flags.thingSpeakEnabled = 0;
-    config.flags.hassEnabled = 0;
-    config.flags.useRealSensor = 0;
-    config.flags.calibrationEnabled = 0;
-
-    // ✅ Очистка всех строковых полей
-    strlcpy(config.thingSpeakChannelId, "", sizeof(config.thingSpeakChannelId));
-    strlcpy(config.mqttServer, "", sizeof(config.mqttServer));
-    strlcpy(config.mqttUser, "", sizeof(config.mqttUser));
-    strlcpy(config.mqttPassword, "", sizeof(config.mqttPassword));
-    strlcpy(config.thingSpeakApiKey, "", sizeof(config.thingSpeakApiKey));
-    strlcpy(config.manufacturer, "", sizeof(config.manufacturer));
-    strlcpy(config.model, "", sizeof(config.model));
-    strlcpy(config.swVersion, "", sizeof(config.swVersion));
-
-    // ✅ Сброс числовых полей
-    config.mqttQos = 0;
-    config.thingspeakInterval = 60;
-
-    // ✅ Безопасность веб-интерфейса
-    strlcpy(config.webPassword, "", sizeof(config.webPassword));
-
-    // NTP
-    strlcpy(config.ntpServer, "pool.ntp.org", sizeof(config.ntpServer));
-    config.ntpUpdateInterval = 60000;
-
-    // v2.3.0: Сброс настраиваемых интервалов к оптимизированным значениям v2.2.1
-    config.sensorReadInterval = SENSOR_READ_INTERVAL;
-    config.mqttPublishInterval = MQTT_PUBLISH_INTERVAL;
-    config.thingSpeakInterval = THINGSPEAK_INTERVAL;
-    config.webUpdateInterval = WEB_UPDATE_INTERVAL;
-
-    // v2.3.0: Сброс порогов дельта-фильтра
-    config.deltaTemperature = DELTA_TEMPERATURE;
-    config.deltaHumidity = DELTA_HUMIDITY;
-    config.deltaPh = DELTA_PH;
-    config.deltaEc = DELTA_EC;
-    config.deltaNpk = DELTA_NPK;
-
-    // v2.3.0: Сброс настроек скользящего среднего (МИНИМАЛЬНАЯ ФИЛЬТРАЦИЯ)
-    config.movingAverageWindow = 5;  // минимальное окно
-    config.forcePublishCycles = FORCE_PUBLISH_CYCLES;
-    config.filterAlgorithm = 0;       // среднее
-    config.outlierFilterEnabled = 0;  // отключен для минимальной фильтрации
-
-    // v3.10.0: Сброс настроек улучшенной фильтрации
-    config.exponentialAlpha = EXPONENTIAL_ALPHA_DEFAULT;
-    config.outlierThreshold = OUTLIER_THRESHOLD_DEFAULT;
-    config.kalmanEnabled = 0;      // отключен по умолчанию
-    config.adaptiveFiltering = 0;  // отключена по умолчанию
-
-    // Soil profile и агро-поля
-    config.soilProfile = 0;
-    config.latitude = 0.0F;
-    config.longitude = 0.0F;
-    strlcpy(config.cropId, "", sizeof(config.cropId));
-    config.flags.isGreenhouse = false;
-    config.irrigationSpikeThreshold = 8.0F;
-    config.irrigationHoldMinutes = 5;
-
-    // v2.6.1: сезонные коэффициенты и тип среды
-    config.environmentType = 0;  // 0=outdoor по умолчанию
-    config.flags.seasonalAdjustEnabled = 0;
-    config.flags.autoOtaEnabled = 0;
+    storedConfigValid = false;  // NVS пуст: следующее сохранение пишет все ключи
+
+    // Те же значения по умолчанию, что подставляет loadConfig() при пустом NVS
+    Config defaults;
+    {
+        const ConfigLock settingsLock;
+        defaults = config;
+    }
+#define CONFIG_RESET_VALUE(kind, member, key, fallback, low, high, group, name) defaults.member = fallback;
+#define CONFIG_RESET_STRING(member, key, fallback, group, name, placeholder) \
+    strlcpy(defaults.member, fallback, sizeof(defaults.member));
+    CONFIG_VALUE_FIELDS(CONFIG_RESET_VALUE)
+    CONFIG_STRING_FIELDS(CONFIG_RESET_STRING)
+#undef CONFIG_RESET_VALUE
+#undef CONFIG_RESET_STRING
+
+    strlcpy(defaults.mqttTopicPrefix, getDefaultTopic().c_str(), sizeof(defaults.mqttTopicPrefix));
+    strlcpy(defaults.mqttDeviceName, getDeviceId().c_str(), sizeof(defaults.mqttDeviceName));
+    defaults.thingspeakInterval = 60;
+    defaults.webPassword[0] = '\0';
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; ++i)
+    {
+        defaults.filterStageOrder[i] = 0;  // порядок стадий по умолчанию
+    }
+    {
+        const ConfigLock settingsLock;
+        config = defaults;
+    }
+    configVersion.fetch_add(1, std::memory_order_release);
 
     logSuccess("Все настройки сброшены к значениям по умолчанию");
-    DEBUG_PRINT("[resetConfig] config.thingspeakInterval: ");
-    DEBUG_PRINTLN(config.thingspeakInterval);
-    DEBUG_PRINT("[resetConfig] config.manufacturer: ");
-    DEBUG_PRINTLN(config.manufacturer);
-    DEBUG_PRINT("[resetConfig] config.model: ");
-    DEBUG_PRINTLN(config.model);
-    DEBUG_PRINT("[resetConfig] config.swVersion: ");
-    DEBUG_PRINTLN(config.swVersion);
     DEBUG_PRINT("[resetConfig] config.ntpServer: ");
-    DEBUG_PRINTLN(config.ntpServer);
+    DEBUG_PRINTLN(defaults.ntpServer);
     DEBUG_PRINT("[resetConfig] config.ntpUpdateInterval: ");
-    DEBUG_PRINTLN(config.ntpUpdateInterval);
+    DEBUG_PRINTLN(defaults.ntpUpdateInterval);
+}
+
+ConfigLock::ConfigLock()
+{
+    configMutex.lock();
+}
+
+ConfigLock::~ConfigLock()
+{
+    configMutex.unlock();
+}
+
+void copyConfigString(char* out, size_t size, const char* field)  // NOLINT(misc-use-internal-linkage)
+{
+    const ConfigLock settingsLock;
+    strlcpy(out, field, size);
+}
+
+uint32_t getConfigVersion()  // NOLINT(misc-use-internal-linkage)
+{
+    return configVersion.load(std::memory_order_acquire);
 }
 
 bool isConfigValid()  // NOLINT(misc-use-internal-linkage)
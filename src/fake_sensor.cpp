@@ -92,6 +92,7 @@ void fakeSensorTask(void* parameters)
                 sensorData.potassium = npk.potassium;
             }
 
+            commitSensorReading();
             DEBUG_PRINTLN("[fakeSensorTask] Сгенерированы тестовые данные датчика");
             iterationCounter = 0;  // Сброс счетчика
         }
@@ -0,0 +1,150 @@
+/**
+ * @file flash_writer.cpp
+ * @brief Счётчики записи на флеш и буферизованный файл LittleFS
+ */
+#include "flash_writer.h"
+#include <Arduino.h>
+#include <array>
+#include <atomic>
+
+namespace
+{
+constexpr size_t NVS_PRIMITIVE_SIZE = 8;  // Числа и флаги помещаются в ячейку вместе с ключом
+
+struct PartitionCounters
+{
+    std::atomic<uint32_t> requests{0};
+    std::atomic<uint32_t> writes{0};
+    std::atomic<uint32_t> bytes{0};
+    std::atomic<uint32_t> units{0};
+};
+
+std::array<PartitionCounters, FLASH_PARTITION_COUNT> counters;
+
+size_t unitSize(FlashPartition partition)
+{
+    return partition == FlashPartition::NVS ? NVS_ENTRY_SIZE : FLASH_PAGE_SIZE;
+}
+
+// Строка или массив в NVS — ячейка заголовка и ячейки данных
+uint32_t unitsTouched(FlashPartition partition, size_t offset, size_t length)
+{
+    if (partition == FlashPartition::LITTLEFS)
+    {
+        return flashPagesTouched(offset, length);
+    }
+    if (length <= NVS_PRIMITIVE_SIZE)
+    {
+        return 1;
+    }
+    return static_cast<uint32_t>(1 + (length + NVS_ENTRY_SIZE - 1) / NVS_ENTRY_SIZE);
+}
+
+void countWrite(FlashPartition partition, size_t offset, size_t length)
+{
+    PartitionCounters& counter = counters[static_cast<size_t>(partition)];
+    counter.writes.fetch_add(1, std::memory_order_relaxed);
+    counter.bytes.fetch_add(static_cast<uint32_t>(length), std::memory_order_relaxed);
+    counter.units.fetch_add(unitsTouched(partition, offset, length), std::memory_order_relaxed);
+}
+
+void countRequest(FlashPartition partition)
+{
+    counters[static_cast<size_t>(partition)].requests.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace
+
+void noteFlashWrite(FlashPartition partition, size_t offset, size_t length)
+{
+    countRequest(partition);
+    countWrite(partition, offset, length);
+}
+
+void getFlashWearStats(FlashPartition partition, FlashWearStats& stats)
+{
+    const PartitionCounters& counter = counters[static_cast<size_t>(partition)];
+    stats.requests = counter.requests.load(std::memory_order_relaxed);
+    stats.writes = counter.writes.load(std::memory_order_relaxed);
+    stats.bytes = counter.bytes.load(std::memory_order_relaxed);
+    stats.units = counter.units.load(std::memory_order_relaxed);
+}
+
+float getFlashWriteAmplification(FlashPartition partition)
+{
+    FlashWearStats stats{};
+    getFlashWearStats(partition, stats);
+    if (stats.bytes == 0)
+    {
+        return 0.0F;
+    }
+    return static_cast<float>(stats.units) * static_cast<float>(unitSize(partition)) /
+           static_cast<float>(stats.bytes);
+}
+
+bool BufferedFlashFile::open(const char* path, const char* mode)
+{
+    file = LittleFS.open(path, mode);
+    failed = false;
+    buffer.reset(file && mode[0] == 'a' ? file.size() : 0);
+    return static_cast<bool>(file);
+}
+
+bool BufferedFlashFile::write(const uint8_t* data, size_t length)
+{
+    countRequest(FlashPartition::LITTLEFS);
+    if (!file)
+    {
+        return false;
+    }
+    const unsigned long now = millis();
+    const bool written = buffer.flushIfStale(now, FLASH_WRITE_FLUSH_MS, writeChunk, this) &&
+                         buffer.write(data, length, now, writeChunk, this);
+    failed = failed || !written;
+    return written;
+}
+
+bool BufferedFlashFile::flushIfStale()
+{
+    if (!file)
+    {
+        return true;
+    }
+    const size_t pending = buffer.pending();
+    const bool written = buffer.flushIfStale(millis(), FLASH_WRITE_FLUSH_MS, writeChunk, this);
+    if (pending > 0 && buffer.pending() == 0)
+    {
+        file.flush();  // Без фиксации LittleFS потеряет сброшенное при перезагрузке, пока файл открыт
+    }
+    failed = failed || !written;
+    return written;
+}
+
+bool BufferedFlashFile::flush()
+{
+    if (!file)
+    {
+        return false;
+    }
+    const bool written = buffer.flush(writeChunk, this);
+    file.flush();
+    failed = failed || !written;
+    return written;
+}
+
+bool BufferedFlashFile::close()
+{
+    if (!file)
+    {
+        return false;
+    }
+    failed = !buffer.flush(writeChunk, this) || failed;
+    file.close();
+    return !failed;
+}
+
+bool BufferedFlashFile::writeChunk(const uint8_t* data, size_t length, size_t offset, void* context)
+{
+    auto* self = static_cast<BufferedFlashFile*>(context);
+    countWrite(FlashPartition::LITTLEFS, offset, length);
+    return self->file.write(data, length) == length;
+}
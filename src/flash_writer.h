@@ -0,0 +1,76 @@
+/**
+ * @file flash_writer.h
+ * @brief Запись на флеш с учётом износа: буферизованный файл LittleFS и счётчики записи по разделам
+ * @details Всё, что пишет прошивка в LittleFS и NVS, учитывается здесь: сколько раз прикладной код просил записать,
+ * сколько операций дошло до раздела, сколько байт и сколько единиц программирования флеша они затронули
+ * (страниц по 256 байт в LittleFS, 32-байтовых ячеек в NVS). Отношение затронутого к записанному — оценка
+ * усиления записи, видна в /health. Файлы, которые пишутся потоком мелких кусков, открываются через
+ * BufferedFlashFile. Счётчики можно обновлять и читать из любой задачи.
+ */
+#ifndef FLASH_WRITER_H
+#define FLASH_WRITER_H
+
+#include <LittleFS.h>
+#include <cstddef>
+#include <cstdint>
+#include "../include/flash_write_buffer.h"
+#include "jxct_constants.h"
+
+enum class FlashPartition : uint8_t
+{
+    LITTLEFS,
+    NVS
+};
+
+constexpr size_t FLASH_PARTITION_COUNT = 2;
+
+struct FlashWearStats
+{
+    uint32_t requests;  // Обращений прикладного кода
+    uint32_t writes;    // Операций записи, дошедших до раздела
+    uint32_t bytes;     // Записано байт
+    uint32_t units;     // Затронуто страниц LittleFS или ячеек NVS
+};
+
+// Учесть запись length байт, переданную разделу одной операцией; offset — позиция в файле (для NVS не важна)
+void noteFlashWrite(FlashPartition partition, size_t offset, size_t length);
+
+void getFlashWearStats(FlashPartition partition, FlashWearStats& stats);
+
+// Затронуто байт флеша на байт данных; 0 — записей ещё не было
+float getFlashWriteAmplification(FlashPartition partition);
+
+/**
+ * @brief Файл LittleFS, запись в который копится в буфере и уходит кусками по границам страниц
+ * @details Буфер сбрасывается, когда заполнен, когда данные в нём старше FLASH_WRITE_FLUSH_MS (проверяется
+ * при следующей записи и в flushIfStale()) и при close(). Данные в буфере до сброса теряются при перезагрузке,
+ * поэтому для записей, которые нельзя потерять, файл закрывают сразу. Файл, который дописывается долго,
+ * держат открытым и периодически вызывают flushIfStale(): сброшенное им фиксируется в LittleFS, как при
+ * закрытии. Перед чтением того же файла другим дескриптором нужен flush().
+ */
+class BufferedFlashFile
+{
+   public:
+    // mode — "w" или "a"
+    bool open(const char* path, const char* mode);
+    bool write(const uint8_t* data, size_t length);
+    bool flushIfStale();
+    // Сбросить буфер и зафиксировать файл в LittleFS, не закрывая его
+    bool flush();
+    // false — хотя бы одна запись с момента открытия не удалась
+    bool close();
+
+    explicit operator bool() const
+    {
+        return static_cast<bool>(file);
+    }
+
+   private:
+    static bool writeChunk(const uint8_t* data, size_t length, size_t offset, void* context);
+
+    File file;
+    FlashWriteBuffer<FLASH_WRITE_BUFFER_SIZE> buffer;
+    bool failed = false;
+};
+
+#endif  // FLASH_WRITER_H
@@ -0,0 +1,663 @@
+/**
+ * @file history_store.cpp
+ * @brief Архив показаний в LittleFS: сегменты по времени и каскадная свёртка минут в часы и сутки
+ * @details Сегмент с номером s уровня с интервалом P хранит записи с началом в [s·N·P, (s+1)·N·P).
+ * Текущий сегмент — файл /history/<уровень>/<s в hex>.seg из записей фиксированной длины: они только
+ * дописываются и идут по возрастанию времени, поэтому нужная запись находится двоичным поиском без индекса,
+ * а запись, оборванная сбоем, отбрасывается по размеру файла или CRC. Когда начинается следующий сегмент,
+ * закрытый переписывается сжатым блоком <s в hex>.blk (history_block_codec.h) — примерно вшестеро меньше.
+ * Пока несжатый файл существует, читается он: сбой посреди сжатия ничего не теряет. Текущий сегмент уровня
+ * держится открытым через BufferedFlashFile, записи уходят на флеш не позже чем через FLASH_WRITE_FLUSH_MS.
+ * До синхронизации времени минутные записи идут в отдельный уровень /history/u с временем от загрузки; при
+ * синхронизации они переводятся в UNIX-время и дописываются в минуты, как если бы время было известно сразу.
+ * Сжатие, удаление старых сегментов и чтение идут под одним мьютексом: читатель из веб-задачи не застанет
+ * сегмент, который главный цикл в этот момент удаляет.
+ */
+#include "history_store.h"
+#include <LittleFS.h>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include "../include/history_block_codec.h"
+#include "flash_writer.h"
+#include "jxct_constants.h"
+#include "logger.h"
+#include "modbus_sensor.h"
+#include "rtos_mutex.h"
+#include "time_service.h"
+
+namespace
+{
+constexpr const char* HISTORY_DIR = "/history";
+constexpr uint32_t SEGMENT_RECORDS = HISTORY_SEGMENT_RECORDS;
+constexpr const char* RAW_EXTENSION = ".seg";
+constexpr const char* BLOCK_EXTENSION = ".blk";
+
+struct TierLayout
+{
+    const char* directory;
+    uint32_t period;       // Интервал записи, с
+    uint32_t maxSegments;  // Хранится полных сегментов помимо текущего
+};
+
+// Уровни HistoryTier и за ними — минуты до синхронизации времени, которые ни во что не сворачиваются
+constexpr size_t UNSYNCED_TIER = HISTORY_TIER_COUNT;
+constexpr std::array<TierLayout, HISTORY_TIER_COUNT + 1> TIERS = {{
+    {"/history/m", SECONDS_IN_MINUTE, HISTORY_MINUTE_SEGMENTS},
+    {"/history/h", SECONDS_IN_MINUTE * MINUTES_IN_HOUR, HISTORY_HOUR_SEGMENTS},
+    {"/history/d", SECONDS_IN_MINUTE * MINUTES_IN_HOUR * HOURS_IN_DAY, HISTORY_DAY_SEGMENTS},
+    {"/history/u", SECONDS_IN_MINUTE, HISTORY_UNSYNCED_SEGMENTS},
+}};
+
+using RawRecord = std::array<uint8_t, HISTORY_RECORD_SIZE>;
+using PathBuffer = std::array<char, 32>;
+
+std::array<HistoryAccumulator, TIERS.size()> openBuckets = {};
+std::array<uint32_t, TIERS.size()> lastStored = {};  // Начало последнего записанного интервала, 0 — нет
+bool storeReady = false;
+bool recovered = false;
+bool unsyncedPending = false;  // Есть минуты до синхронизации, ещё не переведённые в UNIX-время
+RtosMutex historyMutex;        // Запись из главного цикла, чтение из веб-задачи
+
+// Дописываемый сегмент каждого уровня; номер UINT32_MAX — файл закрыт (заполняется в setupHistoryStore)
+std::array<BufferedFlashFile, TIERS.size()> tierFiles;
+std::array<uint32_t, TIERS.size()> tierFileSegments = {};
+
+uint32_t segmentOf(size_t tier, uint32_t timestamp)
+{
+    return timestamp / (TIERS[tier].period * SEGMENT_RECORDS);
+}
+
+void segmentPath(size_t tier, uint32_t segment, const char* extension, PathBuffer& path)
+{
+    snprintf(path.data(), path.size(), "%s/%08lx%s", TIERS[tier].directory, static_cast<unsigned long>(segment),
+             extension);
+}
+
+struct SegmentFile
+{
+    uint32_t segment;
+    bool block;  // Сжатый блок, иначе несжатые записи
+};
+
+// false — файл не сегмент архива
+bool parseSegmentName(const char* name, SegmentFile& file)
+{
+    char* suffix = nullptr;
+    file.segment = static_cast<uint32_t>(strtoul(name, &suffix, 16));
+    if (suffix == nullptr || suffix == name)
+    {
+        return false;
+    }
+    file.block = strcmp(suffix, BLOCK_EXTENSION) == 0;
+    return file.block || strcmp(suffix, RAW_EXTENSION) == 0;
+}
+
+/**
+ * @brief Сегменты уровня, подходящие под условие, — не больше found.size() за вызов
+ * @details LittleFS не поддерживает изменение каталога во время обхода: сначала собираем, потом удаляем или сжимаем
+ */
+template <typename Filter>
+size_t listSegments(size_t tier, Filter filter, std::array<SegmentFile, 8>& found)
+{
+    size_t count = 0;
+    File dir = LittleFS.open(TIERS[tier].directory);
+    for (File file = dir.openNextFile(); file && count < found.size(); file = dir.openNextFile())
+    {
+        SegmentFile segment{};
+        if (parseSegmentName(file.name(), segment) && filter(segment))
+        {
+            found[count++] = segment;
+        }
+    }
+    dir.close();
+    return count;
+}
+
+uint32_t rawTimestamp(const RawRecord& raw)
+{
+    uint32_t timestamp = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        timestamp |= static_cast<uint32_t>(raw[i]) << (8 * i);
+    }
+    return timestamp;
+}
+
+// Первая запись сегмента с началом интервала не раньше from (по сырому времени, без проверки CRC)
+size_t lowerBound(File& file, size_t count, uint32_t from)
+{
+    size_t low = 0;
+    size_t high = count;
+    while (low < high)
+    {
+        const size_t middle = (low + high) / 2;
+        RawRecord raw{};
+        if (!file.seek(middle * HISTORY_RECORD_SIZE) || file.read(raw.data(), raw.size()) != raw.size())
+        {
+            return count;
+        }
+        if (rawTimestamp(raw) < from)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Самый новый сегмент уровня; false — уровень пуст
+bool findNewestSegment(size_t tier, SegmentFile& newest)
+{
+    bool found = false;
+    File dir = LittleFS.open(TIERS[tier].directory);
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile())
+    {
+        SegmentFile segment{};
+        if (parseSegmentName(file.name(), segment) &&
+            (!found || segment.segment > newest.segment || (segment.segment == newest.segment && !segment.block)))
+        {
+            newest = segment;
+            found = true;
+        }
+    }
+    dir.close();
+    return found;
+}
+
+// Удалить сегменты уровня, подходящие под условие
+template <typename Filter>
+void removeSegments(size_t tier, Filter filter)
+{
+    std::array<SegmentFile, 8> expired{};
+    size_t found = 0;
+    do
+    {
+        found = listSegments(tier, filter, expired);
+        for (size_t i = 0; i < found; ++i)
+        {
+            PathBuffer path;
+            segmentPath(tier, expired[i].segment, expired[i].block ? BLOCK_EXTENSION : RAW_EXTENSION, path);
+            LittleFS.remove(path.data());
+        }
+    } while (found == expired.size());
+}
+
+// Удалить сегменты старше срока хранения относительно текущего сегмента
+void pruneSegments(size_t tier, uint32_t current)
+{
+    if (current < TIERS[tier].maxSegments)
+    {
+        return;
+    }
+    const uint32_t oldestKept = current - TIERS[tier].maxSegments;
+    removeSegments(tier, [oldestKept](const SegmentFile& file) { return file.segment < oldestKept; });
+}
+
+void closeTierFile(size_t tier)
+{
+    if (tierFileSegments[tier] != UINT32_MAX)
+    {
+        tierFiles[tier].close();
+        tierFileSegments[tier] = UINT32_MAX;
+    }
+}
+
+// Записи из буфера должны быть видны перед чтением сегмента с флеша
+void flushTierFile(size_t tier, uint32_t segment)
+{
+    if (tierFiles[tier] && tierFileSegments[tier] == segment && !tierFiles[tier].flush())
+    {
+        logWarnSafe("Архив показаний: не удалось дописать сегмент %s", TIERS[tier].directory);
+        closeTierFile(tier);
+    }
+}
+
+template <typename Handler>
+void forEachRawRecord(File& file, Handler handler)
+{
+    RawRecord raw{};
+    HistoryRecord record{};
+    while (file.read(raw.data(), raw.size()) == raw.size())
+    {
+        if (decodeHistoryRecord(raw.data(), record))
+        {
+            handler(record);
+        }
+    }
+}
+
+// Закрытый сегмент переписывается сжатым блоком; если не вышло, он остаётся несжатым и читается как раньше
+void sealSegment(size_t tier, uint32_t segment)
+{
+    PathBuffer rawPath;
+    segmentPath(tier, segment, RAW_EXTENSION, rawPath);
+    if (!LittleFS.exists(rawPath.data()))
+    {
+        return;
+    }
+    // Два прохода по файлу: размеры столбцов, затем сами столбцы — в памяти только готовый блок
+    File file = LittleFS.open(rawPath.data(), "r");
+    HistoryBlockEncoder encoder;
+    forEachRawRecord(file, [&encoder](const HistoryRecord& record) { encoder.measure(record); });
+    const size_t size = encoder.size();
+    const std::unique_ptr<uint8_t[]> block(size > 0 ? new (std::nothrow) uint8_t[size] : nullptr);
+    bool packed = block && file.seek(0) && encoder.begin(block.get(), size);
+    if (packed)
+    {
+        forEachRawRecord(file, [&encoder](const HistoryRecord& record) { encoder.write(record); });
+        packed = encoder.finish() == size;
+    }
+    file.close();
+
+    PathBuffer blockPath;
+    segmentPath(tier, segment, BLOCK_EXTENSION, blockPath);
+    File out = packed ? LittleFS.open(blockPath.data(), "w") : File();
+    if (out)
+    {
+        noteFlashWrite(FlashPartition::LITTLEFS, 0, size);
+    }
+    const bool written = out && out.write(block.get(), size) == size;
+    out.close();
+    if (!written)
+    {
+        if (packed)
+        {
+            LittleFS.remove(blockPath.data());
+        }
+        logWarnSafe("Архив показаний: не удалось сжать %s", rawPath.data());
+        return;
+    }
+    LittleFS.remove(rawPath.data());
+    logDebugSafe("Архив показаний: %s сжат до %lu байт", blockPath.data(), static_cast<unsigned long>(size));
+}
+
+// false — интервал не новее уже записанного (перезагрузка внутри интервала или время ушло назад)
+bool appendRecord(size_t tier, const HistoryRecord& record)
+{
+    if (lastStored[tier] != 0 && record.timestamp <= lastStored[tier])
+    {
+        return false;
+    }
+    const uint32_t segment = segmentOf(tier, record.timestamp);
+    const uint32_t previous = lastStored[tier];
+    const bool newSegment = previous == 0 || segment != segmentOf(tier, previous);
+    lastStored[tier] = record.timestamp;
+
+    RawRecord raw{};
+    encodeHistoryRecord(record, raw.data());
+    PathBuffer path;
+    segmentPath(tier, segment, RAW_EXTENSION, path);
+    if (tierFileSegments[tier] != segment)
+    {
+        closeTierFile(tier);  // Закрытый сегмент целиком на флеше до сжатия
+        if (tierFiles[tier].open(path.data(), "a"))
+        {
+            tierFileSegments[tier] = segment;
+        }
+    }
+    if (tierFileSegments[tier] == UINT32_MAX || !tierFiles[tier].write(raw.data(), raw.size()))
+    {
+        // Запись потеряна только на этом уровне: свёртка в следующий продолжается
+        logWarnSafe("Архив показаний: не удалось записать %s", path.data());
+        closeTierFile(tier);
+    }
+    if (newSegment)
+    {
+        if (previous != 0)
+        {
+            sealSegment(tier, segmentOf(tier, previous));
+        }
+        pruneSegments(tier, segment);
+    }
+    return true;
+}
+
+void closeBucket(size_t tier);
+
+// Запись уровня tier входит в открытый интервал следующего уровня
+void rollUp(size_t tier, const HistoryRecord& record)
+{
+    const size_t parent = tier + 1;
+    if (parent >= HISTORY_TIER_COUNT)
+    {
+        return;
+    }
+    const uint32_t bucket = record.timestamp - record.timestamp % TIERS[parent].period;
+    if (openBuckets[parent].empty() || openBuckets[parent].bucket() != bucket)
+    {
+        closeBucket(parent);
+        openBuckets[parent].reset(bucket);
+    }
+    openBuckets[parent].addRecord(record);
+}
+
+void closeBucket(size_t tier)
+{
+    if (openBuckets[tier].empty())
+    {
+        return;
+    }
+    const HistoryRecord record = openBuckets[tier].finish();
+    openBuckets[tier].reset(0);
+    if (appendRecord(tier, record))
+    {
+        rollUp(tier, record);
+    }
+}
+
+void visitSegments(size_t level, uint32_t from, uint32_t to, HistoryVisitor visit, void* context);
+
+bool replayRecord(const HistoryRecord& record, void* context)
+{
+    rollUp(*static_cast<const size_t*>(context), record);
+    return true;
+}
+
+// Свернуть записи уровня tier, ещё не вошедшие в записанный интервал следующего уровня
+void replayTier(size_t tier, uint32_t now)
+{
+    const size_t parent = tier + 1;
+    const uint32_t from = lastStored[parent] == 0 ? 0 : lastStored[parent] + TIERS[parent].period;
+    visitSegments(tier, from, now, replayRecord, &tier);
+}
+
+// Секунды с загрузки: время минут, записанных до синхронизации
+uint32_t uptimeSeconds()
+{
+    return millis() / MILLISECONDS_IN_SECOND;
+}
+
+// Минута до синхронизации, переведённая в UNIX-время, дописывается в минуты и сворачивается дальше
+bool rebaseRecord(const HistoryRecord& record, void* context)
+{
+    HistoryRecord rebased = record;
+    const uint32_t epoch = record.timestamp + *static_cast<const uint32_t*>(context);
+    const auto minute = static_cast<size_t>(HistoryTier::MINUTE);
+    rebased.timestamp = epoch - epoch % TIERS[minute].period;
+    if (appendRecord(minute, rebased))
+    {
+        rollUp(minute, rebased);
+    }
+    return true;
+}
+
+// Время синхронизировано: минуты с загрузки переходят в архив, их уровень очищается
+void rebaseUnsynced(uint32_t now)
+{
+    closeBucket(UNSYNCED_TIER);
+    const uint32_t uptime = uptimeSeconds();
+    uint32_t offset = now - uptime;
+    visitSegments(UNSYNCED_TIER, 0, uptime + 1, rebaseRecord, &offset);
+    closeTierFile(UNSYNCED_TIER);
+    removeSegments(UNSYNCED_TIER, [](const SegmentFile& /*file*/) { return true; });
+    lastStored[UNSYNCED_TIER] = 0;
+    unsyncedPending = false;
+    logSystemSafe("Архив показаний: записи до синхронизации времени переведены в UNIX-время (сдвиг %lu с)",
+                  static_cast<unsigned long>(offset));
+}
+
+// Несжатый сегмент: двоичный поиск начала диапазона и чтение подряд; false — обход закончен
+bool visitRawSegment(File& file, uint32_t from, uint32_t to, HistoryVisitor visit, void* context)
+{
+    const size_t stored = file.size() / HISTORY_RECORD_SIZE;  // Оборванная запись в конце не считается
+    size_t index = lowerBound(file, stored, from);
+    if (!file.seek(index * HISTORY_RECORD_SIZE))
+    {
+        return true;
+    }
+    for (; index < stored; ++index)
+    {
+        RawRecord raw{};
+        if (file.read(raw.data(), raw.size()) != raw.size())
+        {
+            return true;  // Сегмент укоротился: дальше в нём читать нечего
+        }
+        HistoryRecord record{};
+        if (!decodeHistoryRecord(raw.data(), record) || record.timestamp < from)
+        {
+            continue;
+        }
+        if (record.timestamp >= to || !visit(record, context))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Сжатый сегмент читается в память, только если пересекается с диапазоном
+bool visitBlockSegment(File& file, uint32_t from, uint32_t to, HistoryVisitor visit, void* context)
+{
+    std::array<uint8_t, HISTORY_BLOCK_RANGE_SIZE> header{};
+    uint32_t first = 0;
+    uint32_t last = 0;
+    if (file.read(header.data(), header.size()) != header.size() ||
+        !peekHistoryBlockRange(header.data(), header.size(), first, last) || last < from)
+    {
+        return true;
+    }
+    if (first >= to)
+    {
+        return false;
+    }
+    const size_t size = file.size();
+    const std::unique_ptr<uint8_t[]> block(new (std::nothrow) uint8_t[size]);
+    HistoryBlockReader reader;
+    if (!block || !file.seek(0) || file.read(block.get(), size) != size || !reader.open(block.get(), size))
+    {
+        logWarnSafe("Архив показаний: сжатый сегмент не прочитан (%lu байт)", static_cast<unsigned long>(size));
+        return true;
+    }
+    HistoryRecord record{};
+    while (reader.next(record))
+    {
+        if (record.timestamp < from)
+        {
+            continue;
+        }
+        if (record.timestamp >= to || !visit(record, context))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Записи уровня с началом в [from, to) по возрастанию времени; каждый сегмент читается под мьютексом архива
+void visitSegments(size_t level, uint32_t from, uint32_t to, HistoryVisitor visit, void* context)
+{
+    if (from >= to)
+    {
+        return;
+    }
+    // Сегменты старше срока хранения уже удалены: их не перебираем
+    const uint32_t lastSegment = segmentOf(level, to - 1);
+    const uint32_t oldestKept = lastSegment > TIERS[level].maxSegments ? lastSegment - TIERS[level].maxSegments : 0;
+    for (uint32_t segment = std::max(segmentOf(level, from), oldestKept); segment <= lastSegment; ++segment)
+    {
+        const std::lock_guard<RtosMutex> lock(historyMutex);
+        flushTierFile(level, segment);
+        PathBuffer rawPath;
+        PathBuffer blockPath;
+        segmentPath(level, segment, RAW_EXTENSION, rawPath);
+        segmentPath(level, segment, BLOCK_EXTENSION, blockPath);
+        const bool raw = LittleFS.exists(rawPath.data());
+        if (!raw && !LittleFS.exists(blockPath.data()))
+        {
+            continue;
+        }
+        File file = LittleFS.open(raw ? rawPath.data() : blockPath.data(), "r");
+        const bool more = raw ? visitRawSegment(file, from, to, visit, context)
+                              : visitBlockSegment(file, from, to, visit, context);
+        file.close();
+        if (!more)
+        {
+            return;
+        }
+    }
+}
+}  // namespace
+
+void setupHistoryStore()
+{
+    const std::lock_guard<RtosMutex> lock(historyMutex);
+    tierFileSegments.fill(UINT32_MAX);
+    if (!LittleFS.exists(HISTORY_DIR) && !LittleFS.mkdir(HISTORY_DIR))
+    {
+        logError("Архив показаний: не удалось создать каталог /history");
+        return;
+    }
+    for (size_t tier = 0; tier < TIERS.size(); ++tier)
+    {
+        if (!LittleFS.exists(TIERS[tier].directory) && !LittleFS.mkdir(TIERS[tier].directory))
+        {
+            logErrorSafe("Архив показаний: не удалось создать каталог %s", TIERS[tier].directory);
+            return;
+        }
+
+        // Время с загрузки прошлого запуска в UNIX-время уже не перевести
+        if (tier == UNSYNCED_TIER)
+        {
+            removeSegments(tier, [](const SegmentFile& /*file*/) { return true; });
+            continue;
+        }
+
+        // Время последней записи уровня — по последней записи самого нового сегмента
+        SegmentFile newest{};
+        if (!findNewestSegment(tier, newest))
+        {
+            continue;
+        }
+        PathBuffer path;
+        segmentPath(tier, newest.segment, newest.block ? BLOCK_EXTENSION : RAW_EXTENSION, path);
+        File file = LittleFS.open(path.data(), "r");
+        if (newest.block)
+        {
+            std::array<uint8_t, HISTORY_BLOCK_RANGE_SIZE> header{};
+            uint32_t first = 0;
+            if (file.read(header.data(), header.size()) == header.size())
+            {
+                peekHistoryBlockRange(header.data(), header.size(), first, lastStored[tier]);
+            }
+        }
+        else
+        {
+            const size_t count = file.size() / HISTORY_RECORD_SIZE;
+            RawRecord raw{};
+            if (count > 0 && file.seek((count - 1) * HISTORY_RECORD_SIZE) &&
+                file.read(raw.data(), raw.size()) == raw.size())
+            {
+                lastStored[tier] = rawTimestamp(raw);
+            }
+        }
+        file.close();
+        pruneSegments(tier, newest.segment);
+
+        // Сжатие, прерванное перезагрузкой, доводится до конца
+        std::array<SegmentFile, 8> unsealed{};
+        const size_t found = listSegments(
+            tier, [&newest](const SegmentFile& file) { return !file.block && file.segment < newest.segment; },
+            unsealed);
+        for (size_t i = 0; i < found; ++i)
+        {
+            sealSegment(tier, unsealed[i].segment);
+        }
+    }
+    storeReady = true;
+
+    logSystemSafe("Архив показаний: последние записи минут %lu, часов %lu, суток %lu",
+                  static_cast<unsigned long>(lastStored[0]), static_cast<unsigned long>(lastStored[1]),
+                  static_cast<unsigned long>(lastStored[2]));
+}
+
+void recordHistoryReading(const SensorData& reading)
+{
+    const std::lock_guard<RtosMutex> lock(historyMutex);
+    if (!storeReady)
+    {
+        return;
+    }
+    const uint32_t epoch = getTimeEpoch();
+    if (epoch != 0 && !recovered)
+    {
+        // Сначала сутки из часов, затем часы из минут: закрытые при этом часы войдут в восстановленные сутки
+        replayTier(static_cast<size_t>(HistoryTier::HOUR), epoch);
+        replayTier(static_cast<size_t>(HistoryTier::MINUTE), epoch);
+        recovered = true;
+    }
+    if (epoch != 0 && unsyncedPending)
+    {
+        rebaseUnsynced(epoch);
+    }
+    // Без времени показание копится в минутах с загрузки и попадёт в архив после синхронизации
+    const size_t tier = epoch != 0 ? static_cast<size_t>(HistoryTier::MINUTE) : UNSYNCED_TIER;
+    const uint32_t now = epoch != 0 ? epoch : uptimeSeconds();
+    unsyncedPending = unsyncedPending || epoch == 0;
+
+    std::array<int16_t, UPLINK_CHANNEL_COUNT> values{};
+    const std::array<float, UPLINK_CHANNEL_COUNT> readings = {reading.temperature, reading.humidity,
+                                                              reading.ec,          reading.ph,
+                                                              reading.nitrogen,    reading.phosphorus,
+                                                              reading.potassium};
+    for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+    {
+        values[channel] = quantizeUplinkValue(readings[channel], channel);
+    }
+
+    HistoryAccumulator& minute = openBuckets[tier];
+    const uint32_t bucket = now - now % TIERS[tier].period;
+    if (minute.empty() || minute.bucket() != bucket)
+    {
+        closeBucket(tier);
+        minute.reset(bucket);
+    }
+    minute.addSample(values);
+}
+
+void flushHistoryStore()
+{
+    const std::lock_guard<RtosMutex> lock(historyMutex);
+    for (size_t tier = 0; tier < TIERS.size(); ++tier)
+    {
+        if (!tierFiles[tier].flushIfStale())
+        {
+            logWarnSafe("Архив показаний: не удалось дописать сегмент %s", TIERS[tier].directory);
+            closeTierFile(tier);
+        }
+    }
+}
+
+uint32_t getHistoryTierPeriod(HistoryTier tier)
+{
+    return TIERS[static_cast<size_t>(tier)].period;
+}
+
+uint32_t getHistoryTierRetention(HistoryTier tier)
+{
+    const TierLayout& layout = TIERS[static_cast<size_t>(tier)];
+    return layout.period * SEGMENT_RECORDS * layout.maxSegments;
+}
+
+void visitHistoryRecords(HistoryTier tier, uint32_t from, uint32_t to, HistoryVisitor visit, void* context)
+{
+    visitSegments(static_cast<size_t>(tier), from, to, visit, context);
+}
+
+uint32_t getHistoryUptime()
+{
+    return uptimeSeconds();
+}
+
+void visitUnsyncedHistory(uint32_t from, uint32_t to, HistoryVisitor visit, void* context)
+{
+    visitSegments(UNSYNCED_TIER, from, to, visit, context);
+}
@@ -0,0 +1,60 @@
+/**
+ * @file history_store.h
+ * @brief Архив показаний на флеше: минутные, часовые и суточные записи с ограниченным сроком хранения
+ * @details Каждое показание входит в запись текущей минуты. Закрытая минута
+ * дописывается в файл и сворачивается в запись часа, закрытый час — в запись суток (границы суток по UTC).
+ * Уровни хранятся раздельно, каждый — в сегментах фиксированной длительности; старые сегменты удаляются
+ * целиком, закрытые сжимаются. Минуты хранятся неделю, часы — около полугода, сутки — несколько лет, поэтому
+ * даже без связи с сервером устройство показывает подробные данные за неделю. После перезагрузки
+ * незавершённые часы и сутки восстанавливаются из записей нижнего уровня. Пока время не синхронизировано,
+ * минуты хранятся со временем от загрузки и переводятся в UNIX-время при синхронизации; часы и сутки из них
+ * складываются уже после перевода. Пишет в архив главный цикл, читать можно из любой задачи.
+ */
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../include/history_record.h"
+
+struct SensorData;
+
+enum class HistoryTier : uint8_t
+{
+    MINUTE,
+    HOUR,
+    DAY
+};
+
+constexpr size_t HISTORY_TIER_COUNT = 3;
+
+// Открыть архив после монтирования LittleFS
+void setupHistoryStore();
+
+// Учесть показание; до синхронизации времени — в минутах со временем от загрузки
+void recordHistoryReading(const SensorData& reading);
+
+// Сбросить на флеш записи, которые лежат в буфере дольше FLASH_WRITE_FLUSH_MS (вызывать в loop)
+void flushHistoryStore();
+
+// Длительность интервала записи уровня и срок хранения, с
+uint32_t getHistoryTierPeriod(HistoryTier tier);
+uint32_t getHistoryTierRetention(HistoryTier tier);
+
+// Обработчик записи при обходе архива; false — остановить обход
+using HistoryVisitor = bool (*)(const HistoryRecord& record, void* context);
+
+/**
+ * @brief Передать visit записи уровня с началом интервала в [from, to) по возрастанию времени
+ * @details Повреждённые записи пропускаются. Сжатый сегмент распаковывается один раз за обход и только если
+ * пересекается с диапазоном.
+ */
+void visitHistoryRecords(HistoryTier tier, uint32_t from, uint32_t to, HistoryVisitor visit, void* context);
+
+// Секунды с загрузки — время записей, сделанных до синхронизации
+uint32_t getHistoryUptime();
+
+// Как visitHistoryRecords, но для минут до синхронизации времени; from и to — секунды с загрузки
+void visitUnsyncedHistory(uint32_t from, uint32_t to, HistoryVisitor visit, void* context);
+
+#endif  // HISTORY_STORE_H
@@ -7,18 +7,18 @@
 // *** ЕСЛИ ВЫ ВИДИТЕ ЭТО СООБЩЕНИЕ, ПРОШИВКА ОБНОВИЛАСЬ ***
 
 #include <Arduino.h>
-#include <NTPClient.h>
 #include <WiFiClient.h>
 #include <WiFiClientSecure.h>
-#include <WiFiUdp.h>
 #include <esp_ota_ops.h>
 #include <esp_task_wdt.h>
 #include "advanced_filters.h"  // ✅ Улучшенная система фильтрации
+#include "calibration_manager.h"
 #include "business/crop_recommendation_engine.h"
 #include "business/sensor_calibration_service.h"
 #include "business/sensor_compensation_service.h"
 #include "debug.h"  // ✅ Добавляем систему условной компиляции
 #include "fake_sensor.h"
+#include "history_store.h"
 #include "jxct_config_vars.h"
 #include "jxct_constants.h"  // ✅ Константы системы
 #include "logger.h"
@@ -27,6 +27,8 @@
 #include "ota_manager.h"
 #include "sensor_factory.h"
 #include "thingspeak_client.h"
+#include "time_service.h"
+#include "uplink_queue.h"
 #include "version.h"     // ✅ Централизованное управление версией
 #include "web_routes.h"  // ✅ CSRF защита
 #include "wifi_manager.h"
@@ -50,7 +52,7 @@ extern SensorCompensationService gCompensationService;
 namespace
 {
 unsigned long lastDataPublish = 0;
-unsigned long lastNtpUpdate = 0;
+uint32_t lastDataVersion = 0;  // Версия показаний, уже помеченных для отправки
 
 unsigned long lastStatusPrint = 0;
 unsigned long mqttBatchTimer = 0;
@@ -65,9 +67,6 @@ bool pendingThingspeakPublish = false;
 // startFakeSensorTask() - в fake_sensor.h
 // handleMQTT() - в mqtt_client.h
 
-WiFiUDP ntpUDP;                   // NOLINT(misc-use-internal-linkage)
-NTPClient* timeClient = nullptr;  // NOLINT(misc-use-internal-linkage)
-
 // Константы определены в jxct_constants.h
 
 namespace
@@ -203,10 +202,23 @@ void setup()  // NOLINT(misc-use-internal-linkage)
     loadConfig();
     logSuccess("Конфигурация загружена");
 
+    // Калибровочная таблица разбирается один раз и дальше используется из памяти;
+    // после loadConfig(), потому что способ интерполяции задаётся в настройках
+    CalibrationManager::reloadTable();
+
+    // Очередь неотправленных показаний переживает перезагрузку: курсоры MQTT и ThingSpeak читаются с флеша
+    setupUplinkQueue();
+
+    // Архив минут, часов и суток на флеше: история доступна и без связи с сервером
+    setupHistoryStore();
+
     // Информация о режиме работы
     logSystemSafe("\1", config.flags.useRealSensor ? "РЕАЛЬНЫЙ" : "ЭМУЛЯЦИЯ");
     logSystemSafe("\1", static_cast<unsigned int>(config.sensorReadInterval));
 
+    // Синхронизация времени по NTP в отдельной задаче (ждёт подключения WiFi сама)
+    startTimeService();
+
     // Инициализация WiFi
     setupWiFi();
 
@@ -216,8 +228,9 @@ void setup()  // NOLINT(misc-use-internal-linkage)
     // Инициализация ThingSpeak
     if (config.flags.thingSpeakEnabled)
     {
-        // extern WiFiClient espClient;  // объявлен в mqtt_client.h
-        setupThingSpeak(espClient);
+        // Свой сокет: espClient занят сессией MQTT, которую открывает задача MqttConnect
+        static WiFiClient thingSpeakClient;
+        setupThingSpeak(thingSpeakClient);
         logSuccess("ThingSpeak инициализирован");
     }
 
@@ -283,14 +296,6 @@ void loop()  // NOLINT(misc-use-internal-linkage)
     const unsigned long currentTime = millis();
     esp_task_wdt_reset();
 
-    // Обновление NTP каждые 6 часов
-    if (timeClient != nullptr && millis() - lastNtpUpdate > 6 * 3600 * 1000)
-    {
-        timeClient->forceUpdate();
-        lastNtpUpdate = millis();
-        logSystemSafe("\1", timeClient->isTimeSet() ? "OK" : "не удалось");
-    }
-
     // ✅ Вывод статуса системы каждые 30 секунд (неблокирующий)
     if (currentTime - lastStatusPrint >= STATUS_PRINT_INTERVAL)
     {
@@ -302,9 +307,11 @@ void loop()  // NOLINT(misc-use-internal-linkage)
         logSystemSafe("\1", config.flags.useRealSensor ? "РЕАЛЬНЫЙ" : "ЭМУЛЯЦИЯ");
 
         // Статус данных датчика
-        if (sensorData.valid)
+        SensorData reading{};
+        getSensorReading(reading);
+        if (reading.valid)
         {
-            logDataSafe("\1", (currentTime - sensorData.last_update) / 1000.0);
+            logDataSafe("\1", (currentTime - reading.last_update) / 1000.0);
         }
         else
         {
@@ -319,13 +326,26 @@ void loop()  // NOLINT(misc-use-internal-linkage)
     }
 
     // === Проверяем наличие новых данных датчика (НАСТРАИВАЕМО v2.3.0) ===
-    if (sensorData.valid && (currentTime - lastDataPublish >= config.sensorReadInterval))
+    // Новые данные = сменилась версия опубликованных показаний; показания копируются только при её смене
+    const uint32_t readingVersion = getSensorReadingVersion();
+    if (readingVersion != lastDataVersion && (currentTime - lastDataPublish >= config.sensorReadInterval))
     {
-        pendingMqttPublish = true;
-        pendingThingspeakPublish = true;
-        lastDataPublish = currentTime;
-        DEBUG_PRINTLN("[BATCH] Новые данные помечены для групповой отправки");
+        SensorData latest{};
+        getSensorReading(latest);
+        lastDataVersion = readingVersion;
+        if (latest.valid)
+        {
+            enqueueUplinkReading(latest);  // Сохраняется до доставки, даже если связи сейчас нет
+            recordHistoryReading(latest);
+            pendingMqttPublish = true;
+            pendingThingspeakPublish = true;
+            lastDataPublish = currentTime;
+            DEBUG_PRINTLN("[BATCH] Новые данные помечены для групповой отправки");
+        }
     }
+    // Очередь и архив держат дописываемые файлы открытыми: буферы уходят на флеш не позже FLASH_WRITE_FLUSH_MS
+    flushUplinkQueue();
+    flushHistoryStore();
 
     // ✅ Групповая отправка MQTT (настраиваемо v2.3.0)
     if (pendingMqttPublish && (currentTime - mqttBatchTimer >= config.mqttPublishInterval))
@@ -351,6 +371,8 @@ void loop()  // NOLINT(misc-use-internal-linkage)
         }
         pendingThingspeakPublish = false;
     }
+    // Очередь после перерыва связи уходит пакетами по своему таймеру, независимо от новых показаний
+    handleThingSpeakBacklog();
 
     // ✅ Управление MQTT (каждые 100мс)
     static unsigned long lastMqttCheck = 0;
@@ -360,7 +382,7 @@ void loop()  // NOLINT(misc-use-internal-linkage)
         lastMqttCheck = currentTime;
     }
 
-    // ✅ Управление WiFi (каждые 20 мс для более высокой отзывчивости веб-интерфейса)
+    // ✅ Управление WiFi (каждые 20 мс); HTTP-клиентов обслуживает отдельная задача веб-сервера
     static unsigned long lastWiFiCheck = 0;
     if (currentTime - lastWiFiCheck >= 20)
     {
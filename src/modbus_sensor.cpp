@@ -7,6 +7,7 @@
 #include "modbus_sensor.h"
 #include <Arduino.h>
 #include <algorithm>           // для std::min
+#include <array>
 #include "advanced_filters.h"  // ✅ Улучшенная система фильтрации
 #include "business_services.h"
 #include "calibration_manager.h"
@@ -15,7 +16,9 @@
 #include "jxct_constants.h"  // ✅ Централизованные константы
 #include "jxct_device_info.h"
 #include "logger.h"
+#include "sensor_bus.h"
 #include "sensor_compensation.h"
+#include "seqlock.h"
 #include "validation_utils.h"  // Для централизованной валидации
 
 // Глобальные переменные (должны быть доступны через extern)
@@ -25,6 +28,19 @@ namespace
 // Внутренние переменные с внутренней связностью
 ModbusMaster modbus;
 String sensorLastError;
+uint8_t currentSlaveId = JXCT_MODBUS_ID;  // Адрес, на который сейчас настроен ModbusMaster
+SeqLock<SensorData> publishedReading;      // Последние показания основного датчика для читателей
+
+// Переключение ведомого на общей шине: ModbusMaster хранит один адрес, begin() лишь перезаписывает его
+void selectSlave(uint8_t slaveId)
+{
+    if (slaveId == currentSlaveId)
+    {
+        return;
+    }
+    modbus.begin(slaveId, Serial2);  // NOLINT(readability-static-accessed-through-instance)
+    currentSlaveId = slaveId;
+}
 
 // Структура для устранения проблемы с легко перепутываемыми параметрами
 struct RegisterConversion
@@ -233,87 +249,87 @@ bool readSingleRegister(uint16_t reg_addr, const char* reg_name, float multiplie
     return false;
 }
 
-int readBasicParameters()
+// Описание поля SensorData, которое заполняется из регистра датчика
+struct RegisterField
 {
-    int success_count = 0;
-    if (readSingleRegister(REG_PH, "pH", 0.01F, &sensorData.ph, true))
-    {
-        success_count++;
-    }
-    if (readSingleRegister(REG_SOIL_MOISTURE, "Влажность", 0.1F, &sensorData.humidity, true))
-    {
-        success_count++;
-    }
-    if (readSingleRegister(REG_SOIL_TEMP, "Температура", 0.1F, &sensorData.temperature, true))
+    uint16_t address;
+    const char* name;
+    float multiplier;
+    float SensorData::*target;
+};
+
+// Смежные регистры читаются одной транзакцией: 0x0012–0x0015 и 0x001E–0x0020.
+// Регистр 0x0014 внутри первого блока не используется, но читается ради единого запроса.
+constexpr std::array<RegisterField, 3> BASIC_BLOCK_FIELDS = {{
+    {REG_SOIL_MOISTURE, "Влажность", 0.1F, &SensorData::humidity},
+    {REG_SOIL_TEMP, "Температура", 0.1F, &SensorData::temperature},
+    {REG_CONDUCTIVITY, "EC", 1.0F, &SensorData::ec},
+}};
+
+constexpr std::array<RegisterField, 3> NPK_BLOCK_FIELDS = {{
+    {REG_NITROGEN, "Азот", 1.0F, &SensorData::nitrogen},
+    {REG_PHOSPHORUS, "Фосфор", 1.0F, &SensorData::phosphorus},
+    {REG_POTASSIUM, "Калий", 1.0F, &SensorData::potassium},
+}};
+
+/**
+ * @brief Чтение блока смежных регистров одним запросом Modbus
+ * @details Поля должны быть упорядочены по возрастанию адреса. При ошибке блочного чтения
+ * выполняется поштучное чтение каждого регистра, чтобы частичный ответ датчика не терялся.
+ * @return Количество успешно прочитанных полей
+ */
+template <size_t N>
+int readRegisterBlock(const std::array<RegisterField, N>& fields, SensorData& data)
+{
+    const uint16_t start = fields.front().address;
+    const uint16_t count = fields.back().address - start + 1;
+
+    logDebugSafe("Блочное чтение регистров 0x%04X..0x%04X", start, fields.back().address);
+    const uint8_t result = modbus.readHoldingRegisters(start, count);
+
+    if (result == ModbusMaster::ku8MBSuccess)
     {
-        success_count++;
+        for (const auto& field : fields)
+        {
+            const uint16_t raw_value = modbus.getResponseBuffer(field.address - start);
+            data.*(field.target) = convertRegisterToFloat(RegisterConversion::builder()
+                                                              .setRegisterValue(raw_value)
+                                                              .setScaleMultiplier(field.multiplier)
+                                                              .build());
+            logDebugSafe("%s: %.2f", field.name, data.*(field.target));
+        }
+        return static_cast<int>(N);
     }
-    if (readSingleRegister(REG_CONDUCTIVITY, "EC", 1.0F, &sensorData.ec, true))
+
+    logWarnSafe("Блочное чтение 0x%04X..0x%04X не удалось (код %d), читаем регистры по одному", start,
+                fields.back().address, result);
+
+    int success_count = 0;
+    for (const auto& field : fields)
     {
-        success_count++;
+        if (readSingleRegister(field.address, field.name, field.multiplier, &(data.*(field.target)), true))
+        {
+            success_count++;
+        }
     }
     return success_count;
 }
 
-int readNPKParameters()
+int readBasicParameters(SensorData& data)
 {
     int success_count = 0;
-    if (readSingleRegister(REG_NITROGEN, "Азот", 1.0F, &sensorData.nitrogen, true))
-    {
-        success_count++;
-    }
-    if (readSingleRegister(REG_PHOSPHORUS, "Фосфор", 1.0F, &sensorData.phosphorus, true))
-    {
-        success_count++;
-    }
-    if (readSingleRegister(REG_POTASSIUM, "Калий", 1.0F, &sensorData.potassium, true))
+    // pH лежит отдельно от остальных регистров, поэтому читается отдельным запросом
+    if (readSingleRegister(REG_PH, "pH", 0.01F, &data.ph, true))
     {
         success_count++;
     }
+    success_count += readRegisterBlock(BASIC_BLOCK_FIELDS, data);
     return success_count;
 }
 
-struct MovingAverageParams
+int readNPKParameters(SensorData& data)
 {
-    uint8_t window_size;
-    uint8_t filled;
-};
-
-float calculateMovingAverage(const float* buffer, MovingAverageParams params)
-{
-    if (params.filled == 0)
-    {
-        return 0.0F;
-    }
-    const uint8_t elements_to_use = std::min(params.filled, params.window_size);
-    if (config.filterAlgorithm == 1)
-    {
-        std::array<float, 15> temp_values{};
-        for (int i = 0; i < elements_to_use; ++i)
-        {
-            temp_values.at(i) = buffer[i];
-        }
-        for (int i = 0; i < elements_to_use - 1; ++i)
-        {
-            for (int j = 0; j < elements_to_use - i - 1; ++j)
-            {
-                if (temp_values[j] > temp_values[j + 1])
-                {
-                    std::swap(temp_values[j], temp_values[j + 1]);
-                }
-            }
-        }
-        return temp_values[elements_to_use / 2];
-    }
-    else
-    {
-        float sum = 0.0F;
-        for (int i = 0; i < elements_to_use; ++i)
-        {
-            sum += buffer[i];
-        }
-        return sum / elements_to_use;
-    }
+    return readRegisterBlock(NPK_BLOCK_FIELDS, data);
 }
 
 }  // namespace
@@ -381,11 +397,13 @@ void setupModbus()
                   MODBUS_TX_PIN);  // NOLINT(readability-static-accessed-through-instance)
 
     // Настройка Modbus с обработчиками переключения режима
-    modbus.begin(JXCT_MODBUS_ID, Serial2);      // NOLINT(readability-static-accessed-through-instance)
+    modbus.begin(config.modbusId, Serial2);     // NOLINT(readability-static-accessed-through-instance)
+    currentSlaveId = config.modbusId;
     modbus.preTransmission(preTransmission);    // Вызывается перед передачей
     modbus.postTransmission(postTransmission);  // Вызывается после передачи
 
     logSuccess("Modbus инициализирован");
+    setupSensorBus();
     logPrintHeader("MODBUS ГОТОВ ДЛЯ ПОЛНОГО ТЕСТИРОВАНИЯ", LogColor::GREEN);
 }
 
@@ -523,12 +541,16 @@ namespace
 {
 /**
  * @brief Финализация данных датчика (валидация, кэширование, скользящее среднее)
+ * @param data Данные опрошенного датчика
+ * @param cache Кэш этого датчика
+ * @param filters Состояние скользящего среднего этого датчика
  * @param success Флаг успешности чтения всех параметров
+ * @param primary Основной датчик: детектор полива и улучшенные фильтры хранят состояние в единственном экземпляре
  */
-void finalizeSensorData(bool success)
+void finalizeSensorData(SensorData& data, SensorCache& cache, SensorFilterState& filters, bool success, bool primary)
 {
-    sensorData.valid = success;
-    sensorData.last_update = millis();
+    data.valid = success;
+    data.last_update = millis();
 
     if (!success)
     {
@@ -536,24 +558,25 @@ void finalizeSensorData(bool success)
         return;
     }
 
-    saveRawSnapshot(sensorData);
-    updateIrrigationFlag(sensorData);
-    applyCompensationIfEnabled(sensorData);
-
-    // ✅ v3.10.0: Применяем улучшенную фильтрацию
-    AdvancedFilters::applyAdvancedFiltering(sensorData);
+    saveRawSnapshot(data);
+    if (primary)
+    {
+        updateIrrigationFlag(data);
+    }
+    applyCompensationIfEnabled(data);
 
-    addToMovingAverage(sensorData, sensorData);
+    // Конвейер фильтров каналов: адаптивные стадии — только для основного датчика, окно — для каждого
+    AdvancedFilters::applyAdvancedFiltering(data, filters, primary);
 
-    if (validateSensorData(sensorData))
+    if (validateSensorData(data))
     {
         logSuccess("✅ Все параметры прочитаны и валидны с улучшенной фильтрацией");
-        sensorCache = {sensorData, true, millis()};
+        cache = {data, true, millis()};
     }
     else
     {
         logWarn("⚠️ Данные прочитаны, но не прошли валидацию");
-        sensorData.valid = false;
+        data.valid = false;
     }
 }
 }  // namespace
@@ -562,21 +585,45 @@ void finalizeSensorData(bool success)
 // ОСНОВНАЯ ФУНКЦИЯ ЧТЕНИЯ ДАТЧИКА (РЕФАКТОРИНГ)
 // ============================================================================
 
-void readSensorData()
+bool readSensorProbe(uint8_t slaveId, SensorData& data, SensorCache& cache, SensorFilterState& filters,
+                     bool primary)
 {
-    logSensor("Чтение всех параметров JXCT 7-в-1 датчика...");
+    logSensorSafe("Чтение всех параметров JXCT 7-в-1 датчика (адрес %u)...", slaveId);
+    selectSlave(slaveId);
 
     // Читаем основные параметры (4 параметра)
-    const int basic_success = readBasicParameters();
+    const int basic_success = readBasicParameters(data);
 
     // Читаем NPK параметры (3 параметра)
-    const int npk_success = readNPKParameters();
+    const int npk_success = readNPKParameters(data);
 
     // Общий успех - все 7 параметров прочитаны
     const bool total_success = (basic_success == 4) && (npk_success == 3);
 
     // Финализируем данные
-    finalizeSensorData(total_success);
+    finalizeSensorData(data, cache, filters, total_success, primary);
+    return data.valid;
+}
+
+void readSensorData()
+{
+    readSensorProbe(config.modbusId, sensorData, sensorCache, sensorFilterState, true);
+    commitSensorReading();
+}
+
+void commitSensorReading()
+{
+    publishedReading.publish(sensorData);
+}
+
+uint32_t getSensorReading(SensorData& out)
+{
+    return publishedReading.read(out);
+}
+
+uint32_t getSensorReadingVersion()
+{
+    return publishedReading.version();
 }
 
 /**
@@ -607,16 +654,17 @@ void postTransmission()
 static void realSensorTask(void* /*pvParameters*/)  // NOLINT(misc-use-internal-linkage,misc-use-anonymous-namespace)
 {
     logPrintHeader("ПРОСТОЕ ЧТЕНИЕ ДАТЧИКА JXCT", LogColor::CYAN);
-    logSystem("🔥 Использую РАБОЧИЕ параметры: 9600 bps, 8N1, адрес 1");
-    logSystem("📊 Функция: периодическое чтение всех регистров датчика");
+    logSystemSafe("🔥 Использую РАБОЧИЕ параметры: 9600 bps, 8N1, адреса %u..%u", config.modbusId,
+                  config.modbusId + getSensorBusProbeCount() - 1);
+    logSystem("📊 Функция: поочерёдный опрос всех датчиков шины");
 
     for (;;)
     {
-        // Простое чтение всех параметров датчика с рабочими настройками
-        readSensorData();
+        // За один шаг опрашивается один датчик, чтобы медленный адрес не задерживал остальных
+        pollNextSensorBusProbe();
 
-        // Пауза между чтениями (настраиваемая в config в миллисекундах)
-        vTaskDelay(pdMS_TO_TICKS(config.sensorReadInterval));
+        // Интервал опроса из config делится между всеми датчиками шины
+        vTaskDelay(pdMS_TO_TICKS(getSensorBusPollInterval()));
     }
 }
 
@@ -664,73 +712,11 @@ void printModbusError(uint8_t errNum)  // NOLINT(misc-use-internal-linkage)
     }
 }
 
-// ========================================
-// v2.3.0: РЕАЛИЗАЦИЯ СКОЛЬЗЯЩЕГО СРЕДНЕГО
-// ========================================
-
-void initMovingAverageBuffers(SensorData& data)
-{
-    // Инициализируем буферы нулями
-    for (int i = 0; i < 15; ++i)
-    {
-        data.temp_buffer[i] = 0.0;
-        data.hum_buffer[i] = 0.0;
-        data.ec_buffer[i] = 0.0;
-        data.ph_buffer[i] = 0.0;
-        data.n_buffer[i] = 0.0;
-        data.p_buffer[i] = 0.0;
-        data.k_buffer[i] = 0.0;
-    }
-    data.buffer_index = 0;
-    data.buffer_filled = 0;
-    DEBUG_PRINTLN("[MOVING_AVG] Буферы скользящего среднего инициализированы");
-}
-
-void addToMovingAverage(SensorData& data, const SensorData& newReading)
-{
-    uint8_t window_size =
-        std::max(static_cast<uint8_t>(5), std::min(static_cast<uint8_t>(15), config.movingAverageWindow));
-
-    // Обновляем буферы
-    data.temp_buffer[data.buffer_index] = newReading.temperature;
-    data.hum_buffer[data.buffer_index] = newReading.humidity;
-    data.ec_buffer[data.buffer_index] = newReading.ec;
-    data.ph_buffer[data.buffer_index] = newReading.ph;
-    data.n_buffer[data.buffer_index] = newReading.nitrogen;
-    data.p_buffer[data.buffer_index] = newReading.phosphorus;
-    data.k_buffer[data.buffer_index] = newReading.potassium;
-
-    // Обновляем индекс
-    data.buffer_index = (data.buffer_index + 1) % window_size;
-    if (data.buffer_filled < window_size)
-    {
-        data.buffer_filled++;
-    }
-
-    // Вычисляем скользящее среднее
-    data.temperature = calculateMovingAverage(data.temp_buffer, {window_size, data.buffer_filled});
-    data.humidity = calculateMovingAverage(data.hum_buffer, {window_size, data.buffer_filled});
-    data.ec = calculateMovingAverage(data.ec_buffer, {window_size, data.buffer_filled});
-    data.ph = calculateMovingAverage(data.ph_buffer, {window_size, data.buffer_filled});
-    data.nitrogen = calculateMovingAverage(data.n_buffer, {window_size, data.buffer_filled});
-    data.phosphorus = calculateMovingAverage(data.p_buffer, {window_size, data.buffer_filled});
-    data.potassium = calculateMovingAverage(data.k_buffer, {window_size, data.buffer_filled});
-}
-
 // Функция для получения текущих данных датчика
 SensorData getSensorData()
 {
-    // Возвращаем копию текущих данных датчика
-    SensorData result = sensorData;
-
-    // Обновляем поле isValid для совместимости с веб-интерфейсом
-    result.isValid = result.valid;
-    result.timestamp = result.last_update;
-
-    // Копируем значения в поля с правильными именами для веб-интерфейса
-    result.conductivity = result.ec;
-    result.moisture = result.humidity;
-
+    SensorData result{};
+    getSensorReading(result);
     return result;
 }
 
@@ -757,3 +743,4 @@ SensorCache& getSensorCache()
 // Определение глобальных переменных
 SensorData sensorData;
 SensorCache sensorCache;
+SensorFilterState sensorFilterState;
@@ -25,7 +25,9 @@
 #define REG_DEVICE_ADDRESS 0x0C    // Адрес устройства
 
 // Допустимые пределы измерений (используем единые константы из jxct_constants.h)
+#include <array>
 #include "jxct_constants.h"
+#include "moving_average_filter.h"
 #define MIN_TEMPERATURE SENSOR_TEMP_MIN
 #define MAX_TEMPERATURE SENSOR_TEMP_MAX
 #define MIN_HUMIDITY SENSOR_HUMIDITY_MIN
@@ -37,45 +39,17 @@
 #define MIN_NPK SENSOR_NPK_MIN
 #define MAX_NPK SENSOR_NPK_MAX
 
-// Структура для хранения данных с датчика
+// Запись показаний датчика: значения, RAW до компенсации, флаги и время.
+// Состояние фильтров хранится отдельно (SensorFilterState), дельта-фильтр MQTT — в mqtt_client.cpp.
 struct SensorData
 {
-    float temperature;          // Температура почвы в °C (делится на 10)
-    float humidity;             // Влажность почвы в % (делится на 10)
-    float ec;                   // Электропроводность почвы в µS/cm
-    float ph;                   // pH почвы (делится на 100)
-    float nitrogen;             // Содержание азота в мг/кг
-    float phosphorus;           // Содержание фосфора в мг/кг
-    float potassium;            // Содержание калия в мг/кг
-    float moisture;             // Добавляем поле для влажности
-    float conductivity;         // Добавляем поле для электропроводности
-    uint16_t firmware_version;  // Версия прошивки
-    uint8_t error_status;       // Статус ошибок
-    bool valid;                 // Флаг валидности данных
-    bool isValid;               // Альтернативное поле валидности для веб-интерфейса
-    unsigned long last_update;  // Время последнего обновления
-    unsigned long timestamp;    // Альтернативное поле времени для веб-интерфейса
-
-    // ДЕЛЬТА-ФИЛЬТР v2.2.1: Поля для хранения предыдущих значений
-    float prev_temperature;           // Предыдущая температура для дельта-фильтра
-    float prev_humidity;              // Предыдущая влажность для дельта-фильтра
-    float prev_ec;                    // Предыдущая EC для дельта-фильтра
-    float prev_ph;                    // Предыдущий pH для дельта-фильтра
-    float prev_nitrogen;              // Предыдущий азот для дельта-фильтра
-    float prev_phosphorus;            // Предыдущий фосфор для дельта-фильтра
-    float prev_potassium;             // Предыдущий калий для дельта-фильтра
-    unsigned long last_mqtt_publish;  // Время последней публикации MQTT
-
-    // СКОЛЬЗЯЩЕЕ СРЕДНЕЕ v2.3.0: Кольцевые буферы для усреднения
-    float temp_buffer[15];  // Буфер температуры (макс 15 значений)
-    float hum_buffer[15];   // Буфер влажности
-    float ec_buffer[15];    // Буфер EC
-    float ph_buffer[15];    // Буфер pH
-    float n_buffer[15];     // Буфер азота
-    float p_buffer[15];     // Буфер фосфора
-    float k_buffer[15];     // Буфер калия
-    uint8_t buffer_index;   // Текущий индекс в буферах
-    uint8_t buffer_filled;  // Количество заполненных элементов (0-15)
+    float temperature;  // Температура почвы в °C (делится на 10)
+    float humidity;     // Влажность почвы в % (делится на 10)
+    float ec;           // Электропроводность почвы в µS/cm
+    float ph;           // pH почвы (делится на 100)
+    float nitrogen;     // Содержание азота в мг/кг
+    float phosphorus;   // Содержание фосфора в мг/кг
+    float potassium;    // Содержание калия в мг/кг
 
     // RAW значения до компенсации (v2.5.1)
     float raw_temperature;
@@ -85,7 +59,27 @@ struct SensorData
     float raw_nitrogen;
     float raw_phosphorus;
     float raw_potassium;
-    bool recentIrrigation;
+
+    unsigned long last_update;  // Время последнего обновления (millis)
+    uint16_t firmware_version;  // Версия прошивки
+    uint8_t error_status;       // Статус ошибок
+    bool valid;                 // Чтение успешно и прошло валидацию по пределам датчика
+    bool recentIrrigation;      // Недавно обнаружен полив
+};
+
+// Состояние скользящего среднего по каналам; принадлежит опрашиваемому датчику, а не записи показаний.
+// Индекс канала совпадает с AdvancedFilters::FilterType (температура, влажность, EC, pH, N, P, K)
+struct SensorFilterState
+{
+    std::array<MovingAverageFilter, SENSOR_CHANNEL_COUNT> channels;
+
+    void reset()
+    {
+        for (auto& channel : channels)
+        {
+            channel.reset();
+        }
+    }
 };
 
 // Структура для кэширования данных
@@ -98,9 +92,10 @@ struct SensorCache
 
 extern SensorData sensorData;
 extern SensorCache sensorCache;
+extern SensorFilterState sensorFilterState;
 String& getSensorLastError();
 
-// Получение текущих данных датчика
+// Получение текущих данных датчика (согласованный снимок, см. getSensorReading)
 SensorData getSensorData();
 
 // Инициализация Modbus
@@ -109,6 +104,19 @@ void setupModbus();
 // Чтение данных с датчика
 void readSensorData();
 
+// Публикация sensorData для читателей; вызывается только задачей, которая пишет sensorData
+void commitSensorReading();
+
+// Согласованная копия последних показаний основного датчика без блокировок; возвращает версию (0 — данных ещё нет)
+uint32_t getSensorReading(SensorData& out);
+
+// Версия последних опубликованных показаний — дешёвая проверка «появились ли новые данные»
+uint32_t getSensorReadingVersion();
+
+// Чтение датчика с заданным адресом на общей шине; primary — основной датчик (глобальные sensorData/sensorCache)
+bool readSensorProbe(uint8_t slaveId, SensorData& data, SensorCache& cache, SensorFilterState& filters,
+                     bool primary);
+
 // Чтение версии прошивки
 bool readFirmwareVersion();
 
@@ -138,11 +146,6 @@ void printModbusError(uint8_t errNum);
 
 void startRealSensorTask();
 
-// v2.3.0: Функции скользящего среднего
-void addToMovingAverage(SensorData& data, const SensorData& newReading);
-float calculateMovingAverage(const float* buffer, uint8_t window_size, uint8_t filled);
-void initMovingAverageBuffers(SensorData& data);
-
 // Тестовые функции
 void testSP3485E();               // Тест драйвера SP3485E
 bool testModbusConnection();      // Диагностика Modbus связи
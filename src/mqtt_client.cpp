@@ -6,20 +6,24 @@
 #include "mqtt_client.h"  // 🆕 Подключаем собственный заголовок, убираем дубли объявлений
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include <NTPClient.h>
 #include <PubSubClient.h>
 #include <WiFiClient.h>
+#include <algorithm>
 #include <array>
 #include "debug.h"  // ✅ Добавляем систему условной компиляции
 #include "jxct_config_vars.h"
 #include "jxct_constants.h"  // ✅ Централизованные константы
 #include "jxct_device_info.h"
 #include "jxct_format_utils.h"
+#include "json_writer.h"
 #include "logger.h"
 #include "modbus_sensor.h"
+#include "mqtt_connection.h"
 #include "ota_manager.h"
+#include "reading_batch_codec.h"
+#include "time_service.h"
+#include "uplink_queue.h"
 #include "wifi_manager.h"
-extern NTPClient* timeClient;
 
 // Глобальные переменные (глобальное пространство имён)
 WiFiClient espClient;                // NOLINT(misc-use-internal-linkage)
@@ -30,9 +34,13 @@ namespace
 // Forward declarations для всех внутренних функций
 void publishAvailabilityInternal(bool online);
 void setupMQTTInternal();
-bool connectMQTTInternal();
+bool sendMqttConnectInternal(const char*& error);
+void startMqttSessionInternal();
 void handleMQTTInternal();
 void publishSensorDataInternal();
+bool publishStateInternal(const SensorData& reading, uint32_t version);
+void publishReadingBatchInternal();
+void publishBatchMetaInternal();
 void publishHomeAssistantConfigInternal();
 void removeHomeAssistantConfigInternal();
 void handleMqttCommandInternal(const String& cmd);
@@ -54,15 +62,6 @@ struct HomeAssistantConfigCache
     std::array<char, 64> cachedTopicPrefix = {""};
 } haConfigCache;
 
-// Кэш для DNS запросов
-struct DNSCache
-{
-    std::array<char, HOSTNAME_BUFFER_SIZE> hostname = {""};
-    IPAddress cachedIP;
-    unsigned long cacheTime;
-    bool isValid;
-} dnsCacheMqtt = {{""}, IPAddress(0, 0, 0, 0), 0, false};
-
 // Кэш для топиков публикации
 std::array<std::array<char, 64>, 7> pubTopicCache = {{}};
 bool pubTopicCacheValid = false;
@@ -76,43 +75,31 @@ std::array<char, 128> statusTopicBuffer = {""};
 std::array<char, 128> commandTopicBuffer = {""};
 std::array<char, 128> otaStatusTopicBuffer = {""};
 std::array<char, 128> otaCommandTopicBuffer = {""};
+std::array<char, sizeof(Config::mqttServer)> serverBuffer = {""};  // PubSubClient хранит указатель на имя сервера
 
 // Кэш JSON датчиков
 std::array<char, 256> cachedSensorJson = {""};
 unsigned long lastCachedSensorTime = 0;
 bool sensorJsonCacheValid = false;
+uint32_t cachedSensorVersion = 0;  // Версия показаний, из которых собран cachedSensorJson
 
-// Функция получения IP с кэшированием
-IPAddress getCachedIP(const char* hostname)
-{
-    const unsigned long currentTime = millis();
-
-    // Проверяем кэш
-    if (dnsCacheMqtt.isValid && strcmp(dnsCacheMqtt.hostname.data(), hostname) == 0 &&
-        (currentTime - dnsCacheMqtt.cacheTime < DNS_CACHE_TTL))
-    {
-        DEBUG_PRINTF("[DNS] Используем кэшированный IP %s для %s\n", dnsCacheMqtt.cachedIP.toString().c_str(),
-                     hostname);
-        return dnsCacheMqtt.cachedIP;
-    }
+// ДЕЛЬТА-ФИЛЬТР: последние опубликованные значения принадлежат MQTT-клиенту, а не данным датчика
+SensorData lastPublishedReading = {};
+unsigned long lastMqttPublish = 0;
 
-    // DNS запрос
-    IPAddress resolvedIP;
-    if (WiFi.hostByName(hostname, resolvedIP) != 0)  // NOLINT(readability-static-accessed-through-instance)
-    {
-        // Кэшируем результат
-        strlcpy(dnsCacheMqtt.hostname.data(), hostname, dnsCacheMqtt.hostname.size());
-        dnsCacheMqtt.cachedIP = resolvedIP;
-        dnsCacheMqtt.cacheTime = currentTime;
-        dnsCacheMqtt.isValid = true;
-        DEBUG_PRINTF("[DNS] Новый IP %s для %s кэширован\n", resolvedIP.toString().c_str(), hostname);
-        return resolvedIP;
-    }
+// Ключи каналов в пакетах показаний — как в <prefix>/state, порядок — как в UplinkRecord
+constexpr std::array<const char*, UPLINK_CHANNEL_COUNT> BATCH_KEYS = {"t", "h", "e", "p", "n", "r", "k"};
 
-    return IPAddress{0, 0, 0, 0};  // Ошибка резолвинга
+// Префикс топиков: копия под замком настроек, веб-сервер может менять его во время публикации
+std::array<char, sizeof(Config::mqttTopicPrefix)> topicPrefix()
+{
+    std::array<char, sizeof(Config::mqttTopicPrefix)> prefix;
+    copyConfigString(prefix.data(), prefix.size(), topicPrefix().data());
+    return prefix;
 }
 
-String getClientId()
+// Ссылка на статическую строку: имя читает и задача MqttConnect, копия с c_str() жила бы до конца выражения
+const String& getClientId()
 {
     static String clientId;
     if (clientId.length() == 0)
@@ -132,7 +119,7 @@ const char* getOtaStatusTopic()
 {
     if (otaStatusTopicBuffer[0] == '\0')
     {
-        snprintf(otaStatusTopicBuffer.data(), otaStatusTopicBuffer.size(), "%s/ota/status", config.mqttTopicPrefix);
+        snprintf(otaStatusTopicBuffer.data(), otaStatusTopicBuffer.size(), "%s/ota/status", topicPrefix().data());
     }
     return otaStatusTopicBuffer.data();
 }
@@ -141,7 +128,7 @@ const char* getOtaCommandTopic()
 {
     if (otaCommandTopicBuffer[0] == '\0')
     {
-        snprintf(otaCommandTopicBuffer.data(), otaCommandTopicBuffer.size(), "%s/ota/command", config.mqttTopicPrefix);
+        snprintf(otaCommandTopicBuffer.data(), otaCommandTopicBuffer.size(), "%s/ota/command", topicPrefix().data());
     }
     return otaCommandTopicBuffer.data();
 }
@@ -149,11 +136,15 @@ const char* getOtaCommandTopic()
 // ✅ Оптимизированная функция getMqttClientName
 const char* getMqttClientName()
 {
-    if (strlen(config.mqttDeviceName) > 0)
+    if (clientIdBuffer[0] == '\0')
     {
-        return config.mqttDeviceName;
+        copyConfigString(clientIdBuffer.data(), clientIdBuffer.size(), config.mqttDeviceName);
+        if (clientIdBuffer[0] == '\0')
+        {
+            strlcpy(clientIdBuffer.data(), getClientId().c_str(), clientIdBuffer.size());
+        }
     }
-    return getClientId().c_str();
+    return clientIdBuffer.data();
 }
 
 // ✅ Оптимизированная функция getStatusTopic с буфером
@@ -161,7 +152,7 @@ const char* getStatusTopic()
 {
     if (statusTopicBuffer[0] == '\0')
     {  // Кэшируем результат
-        snprintf(statusTopicBuffer.data(), statusTopicBuffer.size(), "%s/status", config.mqttTopicPrefix);
+        snprintf(statusTopicBuffer.data(), statusTopicBuffer.size(), "%s/status", topicPrefix().data());
     }
     return statusTopicBuffer.data();
 }
@@ -171,7 +162,7 @@ const char* getCommandTopic()
 {
     if (commandTopicBuffer[0] == '\0')
     {  // Кэшируем результат
-        snprintf(commandTopicBuffer.data(), commandTopicBuffer.size(), "%s/command", config.mqttTopicPrefix);
+        snprintf(commandTopicBuffer.data(), commandTopicBuffer.size(), "%s/command", topicPrefix().data());
     }
     return commandTopicBuffer.data();
 }
@@ -211,155 +202,127 @@ void setupMQTTInternal()
     DEBUG_PRINTF("Маска подсети: %s\n", WiFi.subnetMask().toString().c_str());
     DEBUG_PRINTF("Шлюз: %s\n", WiFi.gatewayIP().toString().c_str());
 
+    copyConfigString(serverBuffer.data(), serverBuffer.size(), config.mqttServer);
     DEBUG_PRINTLN("[MQTT Debug] Параметры:");
     DEBUG_PRINTF("MQTT включен: %d\n", config.flags.mqttEnabled);
-    DEBUG_PRINTF("Сервер: %s\n", config.mqttServer);
+    DEBUG_PRINTF("Сервер: %s\n", serverBuffer.data());
     DEBUG_PRINTF("Порт: %d\n", config.mqttPort);
-    DEBUG_PRINTF("Префикс топика: %s\n", config.mqttTopicPrefix);
-    DEBUG_PRINTF("Пользователь: %s\n", config.mqttUser);
+    DEBUG_PRINTF("Префикс топика: %s\n", topicPrefix().data());
 
-    if (!config.flags.mqttEnabled || strlen(config.mqttServer) == 0)
+    if (!config.flags.mqttEnabled || serverBuffer[0] == '\0')
     {
         ERROR_PRINTLN("[ОШИБКА] MQTT не может быть инициализирован");
         return;
     }
 
-    // ✅ ОПТИМИЗАЦИЯ 3.3: Используем кэшированный DNS резолвинг
-    const IPAddress mqttServerIP = getCachedIP(config.mqttServer);
-    if (mqttServerIP == IPAddress(0, 0, 0, 0))
-    {
-        ERROR_PRINTF("[DNS] Не удалось разрешить DNS для %s\n", config.mqttServer);
-        strlcpy(mqttLastErrorBuffer.data(), "Ошибка DNS резолвинга", mqttLastErrorBuffer.size() - 1);
-        return;
-    }
-
-    DEBUG_PRINTF("[DNS] MQTT сервер %s -> %s\n", config.mqttServer, mqttServerIP.toString().c_str());
-    mqttClient.setServer(mqttServerIP, config.mqttPort);  // Используем IP вместо hostname
+    // DNS, TCP-подключение и обмен CONNECT/CONNACK выполняет задача MqttConnect: на время рукопожатия
+    // mqttClient принадлежит ей, главный цикл начинает сессию (подписки, discovery) после перехода в CONNECTED
+    mqttClient.setServer(serverBuffer.data(), config.mqttPort);
     mqttClient.setCallback(mqttCallback);
     mqttClient.setKeepAlive(30);
-    mqttClient.setSocketTimeout(30);
+    mqttClient.setSocketTimeout(MQTT_SOCKET_TIMEOUT_S);
+    // Имя клиента и топик статуса кэшируются при первом обращении; CONNECT из задачи их только читает
+    getMqttClientName();
+    getStatusTopic();
+    startMqttConnection();
 
-    INFO_PRINTLN("[MQTT] Инициализация завершена с DNS кэшированием");
+    INFO_PRINTLN("[MQTT] Инициализация завершена, подключение в фоновой задаче");
 }
 
-bool connectMQTTInternal()
+// MQTT CONNECT по сокету, который открыла задача MqttConnect; выполняется в ней же (состояние HANDSHAKE)
+bool sendMqttConnectInternal(const char*& error)
 {
-    DEBUG_PRINTLN("[КРИТИЧЕСКАЯ ОТЛАДКА] Попытка подключения к MQTT");
-
-    // Проверка WiFi
-    if (WiFi.status() != WL_CONNECTED)  // NOLINT(readability-static-accessed-through-instance)
-    {
-        ERROR_PRINTLN("[ОШИБКА] WiFi не подключен!");
-        return false;
-    }
-
-    // Расширенная проверка параметров
-    if (strlen(config.mqttServer) == 0)
-    {
-        ERROR_PRINTLN("[ОШИБКА] Не указан MQTT-сервер");
-        return false;
-    }
-
-    // Попытка подключения с максимальной детализацией
     const char* const clientId = getMqttClientName();
-    DEBUG_PRINTF("[MQTT] Сервер: %s\n", config.mqttServer);
-    DEBUG_PRINTF("[MQTT] Порт: %d\n", config.mqttPort);
-    DEBUG_PRINTF("[MQTT] ID клиента: %s\n", clientId);
-    DEBUG_PRINTF("[MQTT] Пользователь: %s\n", config.mqttUser);
-    DEBUG_PRINTF("[MQTT] Пароль: %s\n", config.mqttPassword);
-
-    mqttClient.setServer(config.mqttServer, config.mqttPort);
-
-    // Попытка подключения с максимально подробной информацией
+    std::array<char, sizeof(Config::mqttUser)> user;
+    std::array<char, sizeof(Config::mqttPassword)> password;
+    copyConfigString(user.data(), user.size(), config.mqttUser);
+    copyConfigString(password.data(), password.size(), config.mqttPassword);
+    DEBUG_PRINTF("[MQTT] Сервер: %s:%d, ID клиента: %s, пользователь: %s\n", serverBuffer.data(), config.mqttPort,
+                 clientId, user.data());
+
+    // PubSubClient не переподключает уже открытый сокет: ждёт только CONNACK, не дольше MQTT_SOCKET_TIMEOUT_S
     const bool result = mqttClient.connect(clientId,
-                                           config.mqttUser,      // может быть пустым
-                                           config.mqttPassword,  // может быть пустым
+                                           user.data(),      // может быть пустым
+                                           password.data(),  // может быть пустым
                                            getStatusTopic(),
                                            1,         // QoS
                                            true,      // retain
                                            "offline"  // will message
     );
 
-    DEBUG_PRINTF("[MQTT] Результат подключения: %d\n", result);
-
     // Расшифровка кодов состояния
     const int state = mqttClient.state();
-    DEBUG_PRINTF("[MQTT] Состояние клиента: %d - ", state);
-
-    // Сохраняем ошибку в буфер для доступа извне
+    const char* stateText = "Неизвестная ошибка";
     switch (state)
     {
         case -4:
-            DEBUG_PRINTLN("Тайм-аут подключения");
-            strncpy(mqttLastErrorBuffer.data(), "Тайм-аут подключения", mqttLastErrorBuffer.size() - 1);
+            stateText = "Тайм-аут подключения";
             break;
         case -3:
-            DEBUG_PRINTLN("Соединение потеряно");
-            strncpy(mqttLastErrorBuffer.data(), "Соединение потеряно", mqttLastErrorBuffer.size() - 1);
+            stateText = "Соединение потеряно";
             break;
         case -2:
-            DEBUG_PRINTLN("Ошибка подключения");
-            strncpy(mqttLastErrorBuffer.data(), "Ошибка подключения", mqttLastErrorBuffer.size() - 1);
+            stateText = "Ошибка подключения";
             break;
         case -1:
-            DEBUG_PRINTLN("Отключено");
-            strncpy(mqttLastErrorBuffer.data(), "Отключено", mqttLastErrorBuffer.size() - 1);
+            stateText = "Отключено";
             break;
         case 0:
-            DEBUG_PRINTLN("Подключено");
-            strncpy(mqttLastErrorBuffer.data(), "Подключено", mqttLastErrorBuffer.size() - 1);
+            stateText = "Подключено";
             break;
         case 1:
-            DEBUG_PRINTLN("Неверный протокол");
-            strncpy(mqttLastErrorBuffer.data(), "Неверный протокол", mqttLastErrorBuffer.size() - 1);
+            stateText = "Неверный протокол";
             break;
         case 2:
-            DEBUG_PRINTLN("Неверный ID клиента");
-            strncpy(mqttLastErrorBuffer.data(), "Неверный ID клиента", mqttLastErrorBuffer.size() - 1);
+            stateText = "Неверный ID клиента";
             break;
         case 3:
-            DEBUG_PRINTLN("Сервер недоступен");
-            strncpy(mqttLastErrorBuffer.data(), "Сервер недоступен", mqttLastErrorBuffer.size() - 1);
+            stateText = "Сервер недоступен";
             break;
         case 4:
-            DEBUG_PRINTLN("Неверные учетные данные");
-            strncpy(mqttLastErrorBuffer.data(), "Неверные учетные данные", mqttLastErrorBuffer.size() - 1);
+            stateText = "Неверные учетные данные";
             break;
         case 5:
-            DEBUG_PRINTLN("Не авторизован");
-            strncpy(mqttLastErrorBuffer.data(), "Не авторизован", mqttLastErrorBuffer.size() - 1);
+            stateText = "Не авторизован";
             break;
         default:
-            DEBUG_PRINTLN("Неизвестная ошибка");
-            strncpy(mqttLastErrorBuffer.data(), "Неизвестная ошибка", mqttLastErrorBuffer.size() - 1);
             break;
     }
+    DEBUG_PRINTF("[MQTT] Результат подключения: %d, состояние клиента: %d - %s\n", result, state, stateText);
 
-    // Если подключились успешно
-    if (result)
+    // Сохраняем ошибку в буфер для доступа извне
+    strlcpy(mqttLastErrorBuffer.data(), stateText, mqttLastErrorBuffer.size());
+    if (!result)
     {
-        INFO_PRINTLN("[MQTT] Подключение успешно!");
+        espClient.stop();
+    }
+    error = stateText;
+    return result;
+}
 
-        // Подписываемся на топик команд
-        const char* commandTopic = getCommandTopic();
-        mqttClient.subscribe(commandTopic);
-        DEBUG_PRINTF("[MQTT] Подписались на топик команд: %s\n", commandTopic);
+// Сессия, которую установила задача MqttConnect: подписки и публикации после подключения — из главного цикла
+void startMqttSessionInternal()
+{
+    INFO_PRINTLN("[MQTT] Подключение успешно!");
 
-        const char* otaCmdTopic = getOtaCommandTopic();
-        mqttClient.subscribe(otaCmdTopic);
-        DEBUG_PRINTF("[MQTT] Подписались на OTA команды: %s\n", otaCmdTopic);
+    // Подписываемся на топик команд
+    const char* commandTopic = getCommandTopic();
+    mqttClient.subscribe(commandTopic);
+    DEBUG_PRINTF("[MQTT] Подписались на топик команд: %s\n", commandTopic);
 
-        // Публикуем статус availability
-        publishAvailabilityInternal(true);
+    const char* otaCmdTopic = getOtaCommandTopic();
+    mqttClient.subscribe(otaCmdTopic);
+    DEBUG_PRINTF("[MQTT] Подписались на OTA команды: %s\n", otaCmdTopic);
 
-        // Публикуем конфигурацию Home Assistant discovery если включено
-        if (config.flags.hassEnabled)
-        {
-            publishHomeAssistantConfigInternal();
-        }
-    }
+    // Публикуем статус availability
+    publishAvailabilityInternal(true);
+    publishBatchMetaInternal();
 
-    return result;
+    // Публикуем конфигурацию Home Assistant discovery если включено
+    if (config.flags.hassEnabled)
+    {
+        publishHomeAssistantConfigInternal();
+    }
 }
 
 void handleMQTTInternal()
@@ -369,33 +332,24 @@ void handleMQTTInternal()
         return;
     }
 
-    static bool wasConnected = false;
-    const bool isConnected = mqttClient.connected();
-
-    // Логирование изменений состояния подключения
-    if (wasConnected && !isConnected)
-    {
-        logWarn("MQTT подключение потеряно!");
-    }
-    else if (!wasConnected && isConnected)
-    {
-        logSuccess("MQTT переподключение успешно");
-    }
-    wasConnected = isConnected;
-
-    if (!isConnected)
+    // Пока задача MqttConnect ищет брокер, открывает сокет и ждёт CONNACK, главный цикл его не трогает
+    if (getMqttLinkState() == MqttLinkState::CONNECTED)
     {
-        static unsigned long lastReconnectAttempt = 0;
-        if (millis() - lastReconnectAttempt > 5000)
+        if (!mqttClient.connected())
         {
-            lastReconnectAttempt = millis();
-            logMQTT("Попытка переподключения...");
-            connectMQTTInternal();
+            logWarn("MQTT подключение потеряно!");
+            espClient.stop();
+            reportMqttLinkLost();
+            return;
         }
-    }
-    else
-    {
+        if (takeMqttSessionStart())
+        {
+            startMqttSessionInternal();
+            logSuccess("MQTT подключение установлено");
+        }
+
         mqttClient.loop();
+        publishReadingBatchInternal();
 
         // Публикуем статус OTA, если изменился (не чаще 5 сек)
         static std::array<char, 64> lastOtaStatus = {""};
@@ -415,12 +369,12 @@ void handleMQTTInternal()
 }
 
 // ДЕЛЬТА-ФИЛЬТР v2.2.1: Проверка необходимости публикации
-bool shouldPublishMqtt()
+bool shouldPublishMqtt(const SensorData& reading)
 {
     static int skipCounter = 0;
 
     // Первая публикация - всегда публикуем
-    if (sensorData.last_mqtt_publish == 0)
+    if (lastMqttPublish == 0)
     {
         DEBUG_PRINTLN("[MQTT DEBUG] Первая публикация - разрешено");
         return true;
@@ -440,52 +394,52 @@ bool shouldPublishMqtt()
     // Проверяем дельта изменения
     bool hasSignificantChange = false;
 
-    if (abs(sensorData.temperature - sensorData.prev_temperature) >= config.deltaTemperature)
+    if (abs(reading.temperature - lastPublishedReading.temperature) >= config.deltaTemperature)
     {
-        DEBUG_PRINTF("[DELTA] Температура изменилась: %.1f -> %.1f (дельта=%.1f)\n", sensorData.prev_temperature,
-                     sensorData.temperature, config.deltaTemperature);
+        DEBUG_PRINTF("[DELTA] Температура изменилась: %.1f -> %.1f (дельта=%.1f)\n", lastPublishedReading.temperature,
+                     reading.temperature, config.deltaTemperature);
         hasSignificantChange = true;
     }
 
-    if (abs(sensorData.humidity - sensorData.prev_humidity) >= config.deltaHumidity)
+    if (abs(reading.humidity - lastPublishedReading.humidity) >= config.deltaHumidity)
     {
-        DEBUG_PRINTF("[DELTA] Влажность изменилась: %.1f -> %.1f (дельта=%.1f)\n", sensorData.prev_humidity,
-                     sensorData.humidity, config.deltaHumidity);
+        DEBUG_PRINTF("[DELTA] Влажность изменилась: %.1f -> %.1f (дельта=%.1f)\n", lastPublishedReading.humidity,
+                     reading.humidity, config.deltaHumidity);
         hasSignificantChange = true;
     }
 
-    if (abs(sensorData.ph - sensorData.prev_ph) >= config.deltaPh)
+    if (abs(reading.ph - lastPublishedReading.ph) >= config.deltaPh)
     {
-        DEBUG_PRINTF("[DELTA] pH изменился: %.1f -> %.1f (дельта=%.1f)\n", sensorData.prev_ph, sensorData.ph,
+        DEBUG_PRINTF("[DELTA] pH изменился: %.1f -> %.1f (дельта=%.1f)\n", lastPublishedReading.ph, reading.ph,
                      config.deltaPh);
         hasSignificantChange = true;
     }
 
-    if (abs(sensorData.ec - sensorData.prev_ec) >= config.deltaEc)
+    if (abs(reading.ec - lastPublishedReading.ec) >= config.deltaEc)
     {
-        DEBUG_PRINTF("[DELTA] EC изменилась: %.0f -> %.0f (дельта=%.0f)\n", sensorData.prev_ec, sensorData.ec,
+        DEBUG_PRINTF("[DELTA] EC изменилась: %.0f -> %.0f (дельта=%.0f)\n", lastPublishedReading.ec, reading.ec,
                      config.deltaEc);
         hasSignificantChange = true;
     }
 
-    if (abs(sensorData.nitrogen - sensorData.prev_nitrogen) >= config.deltaNpk)
+    if (abs(reading.nitrogen - lastPublishedReading.nitrogen) >= config.deltaNpk)
     {
-        DEBUG_PRINTF("[DELTA] Азот изменился: %.0f -> %.0f (дельта=%.0f)\n", sensorData.prev_nitrogen,
-                     sensorData.nitrogen, config.deltaNpk);
+        DEBUG_PRINTF("[DELTA] Азот изменился: %.0f -> %.0f (дельта=%.0f)\n", lastPublishedReading.nitrogen,
+                     reading.nitrogen, config.deltaNpk);
         hasSignificantChange = true;
     }
 
-    if (abs(sensorData.phosphorus - sensorData.prev_phosphorus) >= config.deltaNpk)
+    if (abs(reading.phosphorus - lastPublishedReading.phosphorus) >= config.deltaNpk)
     {
-        DEBUG_PRINTF("[DELTA] Фосфор изменился: %.0f -> %.0f (дельта=%.0f)\n", sensorData.prev_phosphorus,
-                     sensorData.phosphorus, config.deltaNpk);
+        DEBUG_PRINTF("[DELTA] Фосфор изменился: %.0f -> %.0f (дельта=%.0f)\n", lastPublishedReading.phosphorus,
+                     reading.phosphorus, config.deltaNpk);
         hasSignificantChange = true;
     }
 
-    if (abs(sensorData.potassium - sensorData.prev_potassium) >= config.deltaNpk)
+    if (abs(reading.potassium - lastPublishedReading.potassium) >= config.deltaNpk)
     {
-        DEBUG_PRINTF("[DELTA] Калий изменился: %.0f -> %.0f (дельта=%.0f)\n", sensorData.prev_potassium,
-                     sensorData.potassium, config.deltaNpk);
+        DEBUG_PRINTF("[DELTA] Калий изменился: %.0f -> %.0f (дельта=%.0f)\n", lastPublishedReading.potassium,
+                     reading.potassium, config.deltaNpk);
         hasSignificantChange = true;
     }
 
@@ -498,43 +452,83 @@ bool shouldPublishMqtt()
     {
         DEBUG_PRINTLN("[DELTA] Изменения незначительные, пропускаем публикацию");
         DEBUG_PRINTF("[DELTA] Текущие значения: T=%.1f, H=%.1f, pH=%.1f, EC=%.0f, N=%.0f, P=%.0f, K=%.0f\n",
-                     sensorData.temperature, sensorData.humidity, sensorData.ph, sensorData.ec, sensorData.nitrogen,
-                     sensorData.phosphorus, sensorData.potassium);
+                     reading.temperature, reading.humidity, reading.ph, reading.ec, reading.nitrogen,
+                     reading.phosphorus, reading.potassium);
         DEBUG_PRINTF("[DELTA] Предыдущие значения: T=%.1f, H=%.1f, pH=%.1f, EC=%.0f, N=%.0f, P=%.0f, K=%.0f\n",
-                     sensorData.prev_temperature, sensorData.prev_humidity, sensorData.prev_ph, sensorData.prev_ec,
-                     sensorData.prev_nitrogen, sensorData.prev_phosphorus, sensorData.prev_potassium);
+                     lastPublishedReading.temperature, lastPublishedReading.humidity, lastPublishedReading.ph, lastPublishedReading.ec,
+                     lastPublishedReading.nitrogen, lastPublishedReading.phosphorus, lastPublishedReading.potassium);
     }
 
     return hasSignificantChange;
 }
 
+// Показаний в одном сообщении <prefix>/state/batch; 1 — пакетный режим выключен
+size_t getBatchRecords()
+{
+    if (!isUplinkQueueReady())
+    {
+        return 1;  // Без очереди копить нечего: публикуем каждое показание
+    }
+    const size_t messageRecords =
+        config.mqttPayloadFormat == 1 ? UPLINK_MQTT_BINARY_BATCH_RECORDS : UPLINK_MQTT_BATCH_RECORDS;
+    return std::max<size_t>(1, std::min<size_t>(config.mqttBatchSize, messageRecords));
+}
+
 void publishSensorDataInternal()
 {
-    DEBUG_PRINTF("[MQTT DEBUG] mqttEnabled=%d, connected=%d, valid=%d\n", config.flags.mqttEnabled,
-                 mqttClient.connected(), sensorData.valid);
+    SensorData reading{};
+    const uint32_t version = getSensorReading(reading);
 
-    if (!config.flags.mqttEnabled || !mqttClient.connected() || !sensorData.valid)
+    DEBUG_PRINTF("[MQTT DEBUG] mqttEnabled=%d, connected=%d, valid=%d\n", config.flags.mqttEnabled, isMqttLinkUp(),
+                 reading.valid);
+
+    if (config.flags.mqttEnabled && !isMqttLinkUp())
+    {
+        reportUplinkFailure(UplinkSink::MQTT);  // Показания дождутся подключения в очереди
+    }
+    if (!config.flags.mqttEnabled || !isMqttLinkUp() || !reading.valid)
     {
         DEBUG_PRINTLN("[MQTT DEBUG] Условия не выполнены, публикация отменена");
         return;
     }
 
+    // В пакетном режиме каждое показание уходит из очереди, а <prefix>/state обновляется после пакета.
+    // Без очереди (LittleFS не смонтирован) пакетов не будет — публикуется одно показание, как при mqttBatchSize 1
+    if (getBatchRecords() > 1 && isUplinkQueueReady())
+    {
+        return;
+    }
+
     // ДЕЛЬТА-ФИЛЬТР v2.2.1: Проверяем необходимость публикации
-    if (!shouldPublishMqtt())
+    if (!shouldPublishMqtt(reading))
     {
         DEBUG_PRINTLN("[MQTT DEBUG] Дельты не изменились, публикация отменена");
+        acknowledgeUplinkLatest(UplinkSink::MQTT);  // Отфильтрованное показание не догоняется из очереди
         return;
     }
 
     DEBUG_PRINTLN("[MQTT DEBUG] Начинаем публикацию данных...");
 
+    if (publishStateInternal(reading, version))
+    {
+        acknowledgeUplinkLatest(UplinkSink::MQTT);
+    }
+    else
+    {
+        reportUplinkFailure(UplinkSink::MQTT);
+    }
+}
+
+// Последнее показание в <prefix>/state (retained)
+bool publishStateInternal(const SensorData& reading, uint32_t version)
+{
     // ✅ ОПТИМИЗАЦИЯ: Кэшируем JSON данных датчика
     const unsigned long currentTime = millis();
     bool needToRebuildJson = false;
 
     // Проверяем, нужно ли пересоздать JSON (данные обновились или кэш устарел)
     if (!sensorJsonCacheValid || (currentTime - lastCachedSensorTime > 1000) ||  // Кэш на 1 секунду
-        (currentTime - sensorData.last_update < 100))                            // Свежие данные
+        (version != cachedSensorVersion))                                        // Новые данные
     {
         needToRebuildJson = true;
     }
@@ -545,19 +539,20 @@ void publishSensorDataInternal()
         StaticJsonDocument<256> doc;  // ✅ Уменьшен размер с 512 до 256
 
         // ✅ ОПТИМИЗАЦИЯ 3.1: Сокращенные ключи для экономии трафика
-        doc["t"] = round(sensorData.temperature * 10) / 10.0;                        // temperature → t (-10 байт)
-        doc["h"] = round(sensorData.humidity * 10) / 10.0;                           // humidity → h (-7 байт)
-        doc["e"] = (int)round(sensorData.ec);                                        // ec → e (стабильно)
-        doc["p"] = round(sensorData.ph * 10) / 10.0;                                 // ph → p (стабильно)
-        doc["n"] = (int)round(sensorData.nitrogen);                                  // nitrogen → n (-7 байт)
-        doc["r"] = (int)round(sensorData.phosphorus);                                // phosphorus → r (-9 байт)
-        doc["k"] = (int)round(sensorData.potassium);                                 // potassium → k (-8 байт)
-        doc["ts"] = (long)(timeClient != nullptr ? timeClient->getEpochTime() : 0);  // timestamp → ts (-7 байт)
+        doc["t"] = round(reading.temperature * 10) / 10.0;                        // temperature → t (-10 байт)
+        doc["h"] = round(reading.humidity * 10) / 10.0;                           // humidity → h (-7 байт)
+        doc["e"] = (int)round(reading.ec);                                        // ec → e (стабильно)
+        doc["p"] = round(reading.ph * 10) / 10.0;                                 // ph → p (стабильно)
+        doc["n"] = (int)round(reading.nitrogen);                                  // nitrogen → n (-7 байт)
+        doc["r"] = (int)round(reading.phosphorus);                                // phosphorus → r (-9 байт)
+        doc["k"] = (int)round(reading.potassium);                                 // potassium → k (-8 байт)
+        doc["ts"] = getTimeEpoch();                                               // timestamp → ts (-7 байт)
 
         // ✅ Кэшируем результат
         serializeJson(doc, cachedSensorJson.data(), cachedSensorJson.size());
         lastCachedSensorTime = currentTime;
         sensorJsonCacheValid = true;
+        cachedSensorVersion = version;
 
         DEBUG_PRINTLN("[MQTT] Компактный JSON датчика пересоздан и закэширован");
     }
@@ -567,7 +562,7 @@ void publishSensorDataInternal()
     static bool stateTopicCached = false;
     if (!stateTopicCached)
     {
-        snprintf(stateTopicBuffer.data(), stateTopicBuffer.size(), "%s/state", config.mqttTopicPrefix);
+        snprintf(stateTopicBuffer.data(), stateTopicBuffer.size(), "%s/state", topicPrefix().data());
         stateTopicCached = true;
     }
 
@@ -579,14 +574,8 @@ void publishSensorDataInternal()
         mqttLastErrorBuffer.fill('\0');
 
         // ДЕЛЬТА-ФИЛЬТР v2.2.1: Сохраняем текущие значения как предыдущие
-        sensorData.prev_temperature = sensorData.temperature;
-        sensorData.prev_humidity = sensorData.humidity;
-        sensorData.prev_ec = sensorData.ec;
-        sensorData.prev_ph = sensorData.ph;
-        sensorData.prev_nitrogen = sensorData.nitrogen;
-        sensorData.prev_phosphorus = sensorData.phosphorus;
-        sensorData.prev_potassium = sensorData.potassium;
-        sensorData.last_mqtt_publish = millis();
+        lastPublishedReading = reading;
+        lastMqttPublish = millis();
 
         DEBUG_PRINTLN("[MQTT] Данные опубликованы, предыдущие значения обновлены");
     }
@@ -594,12 +583,140 @@ void publishSensorDataInternal()
     {
         strlcpy(mqttLastErrorBuffer.data(), "Ошибка публикации MQTT", mqttLastErrorBuffer.size());
     }
+    return res;
+}
+
+// Показания из очереди уходят пакетами в <prefix>/state/batch, у каждого своя метка времени: после перерыва
+// связи — всё накопленное, в пакетном режиме — по mqttBatchSize показаний. Формат описан в <prefix>/state/meta
+void publishReadingBatchInternal()
+{
+    static unsigned long lastBatchPublish = 0;
+    const size_t batchRecords = getBatchRecords();
+    const bool batchReady = batchRecords > 1 && getUplinkPending(UplinkSink::MQTT) >= batchRecords;
+    if ((!batchReady && !hasUplinkBacklog(UplinkSink::MQTT)) ||
+        millis() - lastBatchPublish < UPLINK_MQTT_DRAIN_INTERVAL_MS)
+    {
+        return;
+    }
+    // Показания до синхронизации получают время, когда она случится; без NTP в сети они уходят без "ts"
+    if (!isTimeSynced() && millis() < UPLINK_TIME_SYNC_WAIT_MS)
+    {
+        return;
+    }
+    lastBatchPublish = millis();
+
+    const bool binary = config.mqttPayloadFormat == 1;
+    static std::array<UplinkRecord, UPLINK_MQTT_BINARY_BATCH_RECORDS> records;
+    const uint32_t cursor = getUplinkCursor(UplinkSink::MQTT);
+    uint32_t position = cursor;
+    const size_t count = readUplinkRecords(position, records.data(),
+                                           binary ? UPLINK_MQTT_BINARY_BATCH_RECORDS : UPLINK_MQTT_BATCH_RECORDS);
+    if (count == 0)
+    {
+        if (position != cursor)
+        {
+            commitUplinkCursor(UplinkSink::MQTT, position);  // Только повреждённые записи
+        }
+        return;
+    }
+
+    static std::array<char, UPLINK_MQTT_PAYLOAD_SIZE> payload;
+    size_t payloadSize = 0;
+    if (binary)
+    {
+        payloadSize = encodeReadingBatch(records.data(), count, reinterpret_cast<uint8_t*>(payload.data()),  // NOLINT
+                                         payload.size());
+    }
+    else
+    {
+        // Точность — как в <prefix>/state
+        static constexpr std::array<uint8_t, UPLINK_CHANNEL_COUNT> DECIMALS = {1, 1, 0, 1, 0, 0, 0};
+        JsonWriter json(payload.data(), payload.size());
+        json.beginObject();
+        json.beginArray("b");
+        for (size_t i = 0; i < count; ++i)
+        {
+            json.beginObject();
+            if (records[i].timestamp != 0)
+            {
+                json.member("ts", records[i].timestamp);
+            }
+            for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+            {
+                json.memberFixed(BATCH_KEYS[channel], restoreUplinkValue(records[i].values[channel], channel),
+                                 DECIMALS[channel], false);
+            }
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+        payloadSize = json.overflowed() ? 0 : json.size();
+    }
+    if (payloadSize == 0)
+    {
+        logError("MQTT: пакет показаний не помещается в буфер");
+        return;
+    }
+
+    std::array<char, 128> topic;
+    snprintf(topic.data(), topic.size(), "%s/state/batch", topicPrefix().data());
+    if (!mqttClient.publish(topic.data(), reinterpret_cast<const uint8_t*>(payload.data()),  // NOLINT
+                            static_cast<unsigned int>(payloadSize), false))
+    {
+        reportUplinkFailure(UplinkSink::MQTT);
+        return;
+    }
+    commitUplinkCursor(UplinkSink::MQTT, position);
+    DEBUG_PRINTF("[MQTT] Отправлен пакет показаний: %u, в очереди ещё %lu\n", static_cast<unsigned>(count),
+                 static_cast<unsigned long>(getUplinkPending(UplinkSink::MQTT)));
+
+    if (batchRecords > 1)
+    {
+        SensorData reading{};
+        const uint32_t version = getSensorReading(reading);
+        if (reading.valid)
+        {
+            publishStateInternal(reading, version);
+        }
+    }
+}
+
+// Описание пакетов для подписчиков (retained): формат, размер, каналы и их масштаб в двоичном виде
+void publishBatchMetaInternal()
+{
+    std::array<char, 128> topic;
+    snprintf(topic.data(), topic.size(), "%s/state/batch", topicPrefix().data());
+
+    std::array<char, 384> payload;
+    JsonWriter json(payload.data(), payload.size());
+    json.beginObject();
+    json.member("topic", topic.data());
+    json.member("format", config.mqttPayloadFormat == 1 ? "binary" : "json");
+    json.member("batch", static_cast<uint32_t>(getBatchRecords()));
+    json.member("encoding", "jxct-delta");
+    json.member("version", static_cast<uint32_t>(READING_BATCH_VERSION));
+    json.beginArray("channels");
+    for (const char* key : BATCH_KEYS)
+    {
+        json.element(key);
+    }
+    json.endArray();
+    json.beginArray("scale");
+    for (const float scale : UPLINK_CHANNEL_SCALE)
+    {
+        json.element(static_cast<uint32_t>(scale));
+    }
+    json.endArray();
+    json.endObject();
+
+    snprintf(topic.data(), topic.size(), "%s/state/meta", topicPrefix().data());
+    mqttClient.publish(topic.data(), payload.data(), true);
 }
 
 void publishHomeAssistantConfigInternal()
 {
     DEBUG_PRINTLN("[publishHomeAssistantConfig] Публикация discovery-конфигов Home Assistant...");
-    if (!config.flags.mqttEnabled || !mqttClient.connected() || !config.flags.hassEnabled)
+    if (!config.flags.mqttEnabled || !isMqttLinkUp() || !config.flags.hassEnabled)
     {
         DEBUG_PRINTLN("[publishHomeAssistantConfig] Условия не выполнены, публикация отменена");
         return;
@@ -607,11 +724,13 @@ void publishHomeAssistantConfigInternal()
 
     const String deviceIdStr = getDeviceId();
     const char* deviceId = deviceIdStr.c_str();
+    const auto prefixBuffer = topicPrefix();
+    const String prefix(prefixBuffer.data());
 
     // ✅ ОПТИМИЗАЦИЯ: Проверяем кэш конфигураций
     bool needToRebuildConfigs = false;
     if (!haConfigCache.isValid || strcmp(haConfigCache.cachedDeviceId.data(), deviceId) != 0 ||
-        strcmp(haConfigCache.cachedTopicPrefix.data(), config.mqttTopicPrefix) != 0)
+        strcmp(haConfigCache.cachedTopicPrefix.data(), prefixBuffer.data()) != 0)
     {
         needToRebuildConfigs = true;
         DEBUG_PRINTLN("[HA] Кэш конфигураций устарел, пересоздаем...");
@@ -621,7 +740,7 @@ void publishHomeAssistantConfigInternal()
     {
         // Обновляем кэшированные значения
         strlcpy(haConfigCache.cachedDeviceId.data(), deviceId, haConfigCache.cachedDeviceId.size());
-        strlcpy(haConfigCache.cachedTopicPrefix.data(), config.mqttTopicPrefix, haConfigCache.cachedTopicPrefix.size());
+        strlcpy(haConfigCache.cachedTopicPrefix.data(), prefixBuffer.data(), haConfigCache.cachedTopicPrefix.size());
 
         // ✅ Создаем JSON конфигурации один раз и кэшируем их
         StaticJsonDocument<256> deviceInfo;
@@ -635,74 +754,74 @@ void publishHomeAssistantConfigInternal()
         StaticJsonDocument<512> tempConfig;
         tempConfig["name"] = "JXCT Temperature";
         tempConfig["device_class"] = "temperature";
-        tempConfig["state_topic"] = String(config.mqttTopicPrefix) + "/state";
+        tempConfig["state_topic"] = prefix + "/state";
         tempConfig["unit_of_measurement"] = "°C";
         tempConfig["value_template"] = "{{ value_json.t }}";  // ✅ temperature → t
         tempConfig["unique_id"] = String(deviceId) + "_temp";
-        tempConfig["availability_topic"] = String(config.mqttTopicPrefix) + "/status";
+        tempConfig["availability_topic"] = prefix + "/status";
         tempConfig["device"] = deviceInfo;
         serializeJson(tempConfig, haConfigCache.tempConfig.data(), haConfigCache.tempConfig.size());
 
         StaticJsonDocument<512> humConfig;
         humConfig["name"] = "JXCT Humidity";
         humConfig["device_class"] = "humidity";
-        humConfig["state_topic"] = String(config.mqttTopicPrefix) + "/state";
+        humConfig["state_topic"] = prefix + "/state";
         humConfig["unit_of_measurement"] = "%";
         humConfig["value_template"] = "{{ value_json.h }}";  // ✅ humidity → h
         humConfig["unique_id"] = String(deviceId) + "_hum";
-        humConfig["availability_topic"] = String(config.mqttTopicPrefix) + "/status";
+        humConfig["availability_topic"] = prefix + "/status";
         humConfig["device"] = deviceInfo;
         serializeJson(humConfig, haConfigCache.humConfig.data(), haConfigCache.humConfig.size());
 
         StaticJsonDocument<512> ecConfig;
         ecConfig["name"] = "JXCT EC";
         ecConfig["device_class"] = "conductivity";
-        ecConfig["state_topic"] = String(config.mqttTopicPrefix) + "/state";
+        ecConfig["state_topic"] = prefix + "/state";
         ecConfig["unit_of_measurement"] = "µS/cm";
         ecConfig["value_template"] = "{{ value_json.e }}";  // ✅ ec → e
         ecConfig["unique_id"] = String(deviceId) + "_ec";
-        ecConfig["availability_topic"] = String(config.mqttTopicPrefix) + "/status";
+        ecConfig["availability_topic"] = prefix + "/status";
         ecConfig["device"] = deviceInfo;
         serializeJson(ecConfig, haConfigCache.ecConfig.data(), haConfigCache.ecConfig.size());
 
         StaticJsonDocument<512> phConfig;
         phConfig["name"] = "JXCT pH";
         phConfig["device_class"] = "ph";
-        phConfig["state_topic"] = String(config.mqttTopicPrefix) + "/state";
+        phConfig["state_topic"] = prefix + "/state";
         phConfig["unit_of_measurement"] = "pH";
         phConfig["value_template"] = "{{ value_json.p }}";  // ✅ ph → p
         phConfig["unique_id"] = String(deviceId) + "_ph";
-        phConfig["availability_topic"] = String(config.mqttTopicPrefix) + "/status";
+        phConfig["availability_topic"] = prefix + "/status";
         phConfig["device"] = deviceInfo;
         serializeJson(phConfig, haConfigCache.phConfig.data(), haConfigCache.phConfig.size());
 
         StaticJsonDocument<512> nitrogenConfig;
         nitrogenConfig["name"] = "JXCT Nitrogen";
-        nitrogenConfig["state_topic"] = String(config.mqttTopicPrefix) + "/state";
+        nitrogenConfig["state_topic"] = prefix + "/state";
         nitrogenConfig["unit_of_measurement"] = "mg/kg";
         nitrogenConfig["value_template"] = "{{ value_json.n }}";  // ✅ nitrogen → n
         nitrogenConfig["unique_id"] = String(deviceId) + "_nitrogen";
-        nitrogenConfig["availability_topic"] = String(config.mqttTopicPrefix) + "/status";
+        nitrogenConfig["availability_topic"] = prefix + "/status";
         nitrogenConfig["device"] = deviceInfo;
         serializeJson(nitrogenConfig, haConfigCache.nitrogenConfig.data(), haConfigCache.nitrogenConfig.size());
 
         StaticJsonDocument<512> phosphorusConfig;
         phosphorusConfig["name"] = "JXCT Phosphorus";
-        phosphorusConfig["state_topic"] = String(config.mqttTopicPrefix) + "/state";
+        phosphorusConfig["state_topic"] = prefix + "/state";
         phosphorusConfig["unit_of_measurement"] = "mg/kg";
         phosphorusConfig["value_template"] = "{{ value_json.r }}";  // ✅ phosphorus → r
         phosphorusConfig["unique_id"] = String(deviceId) + "_phosphorus";
-        phosphorusConfig["availability_topic"] = String(config.mqttTopicPrefix) + "/status";
+        phosphorusConfig["availability_topic"] = prefix + "/status";
         phosphorusConfig["device"] = deviceInfo;
         serializeJson(phosphorusConfig, haConfigCache.phosphorusConfig.data(), haConfigCache.phosphorusConfig.size());
 
         StaticJsonDocument<512> potassiumConfig;
         potassiumConfig["name"] = "JXCT Potassium";
-        potassiumConfig["state_topic"] = String(config.mqttTopicPrefix) + "/state";
+        potassiumConfig["state_topic"] = prefix + "/state";
         potassiumConfig["unit_of_measurement"] = "mg/kg";
         potassiumConfig["value_template"] = "{{ value_json.k }}";  // ✅ potassium → k
         potassiumConfig["unique_id"] = String(deviceId) + "_potassium";
-        potassiumConfig["availability_topic"] = String(config.mqttTopicPrefix) + "/status";
+        potassiumConfig["availability_topic"] = prefix + "/status";
         potassiumConfig["device"] = deviceInfo;
         serializeJson(potassiumConfig, haConfigCache.potassiumConfig.data(), haConfigCache.potassiumConfig.size());
 
@@ -784,7 +903,10 @@ void handleMqttCommandInternal(const String& cmd)
     }
     else if (cmd == "ota_auto_on" || cmd == "ota_auto_off")
     {
-        config.flags.autoOtaEnabled = (cmd == "ota_auto_on") ? 1 : 0;
+        {
+            const ConfigLock settingsLock;  // Битовые поля flags меняет и веб-сервер
+            config.flags.autoOtaEnabled = (cmd == "ota_auto_on") ? 1 : 0;
+        }
         saveConfig();
         publishAvailabilityInternal(true);
     }
@@ -824,9 +946,15 @@ void setupMQTT()
     setupMQTTInternal();
 }
 
+bool sendMqttConnect(const char*& error)
+{
+    return sendMqttConnectInternal(error);
+}
+
 bool connectMQTT()
 {
-    return connectMQTTInternal();
+    requestMqttReconnect();
+    return isMqttLinkUp();
 }
 
 void handleMQTT()
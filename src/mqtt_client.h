@@ -23,9 +23,13 @@ const char* getMqttLastError();
 // Инициализация MQTT клиента
 void setupMQTT();
 
-// Подключение к MQTT брокеру
+// Подключиться к брокеру при первой возможности, без ожидания; true — сессия уже установлена
 bool connectMQTT();
 
+// Задача MqttConnect: CONNECT по открытому ею сокету и ожидание CONNACK (не дольше MQTT_SOCKET_TIMEOUT_S);
+// при неудаче сокет закрыт, error — причина
+bool sendMqttConnect(const char*& error);
+
 // Обработка MQTT (вызывать в loop)
 void handleMQTT();
 
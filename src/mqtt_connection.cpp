@@ -0,0 +1,251 @@
+/**
+ * @file mqtt_connection.cpp
+ * @brief Задача подключения к MQTT-брокеру: DNS, TCP-соединение, CONNECT и паузы между попытками
+ * @details Имя брокера разрешается, соединение открывается и CONNACK ожидается в задаче, поэтому
+ * WiFi.hostByName(), WiFiClient::connect() и PubSubClient::connect() ждут сеть там, а не в loop().
+ * Состояние и счётчики — атомарные переменные, паузу считает ReconnectBackoff; его меняет только текущий
+ * владелец сокета, так что блокировки не нужны.
+ */
+#include "mqtt_connection.h"
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include <esp_random.h>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include "jxct_config_vars.h"
+#include "jxct_constants.h"
+#include "logger.h"
+#include "mqtt_client.h"
+#include "reconnect_backoff.h"
+
+namespace
+{
+constexpr TickType_t MQTT_CONNECT_TICK = pdMS_TO_TICKS(100);  // Шаг задачи: проверка WiFi и сроков
+
+std::atomic<MqttLinkState> linkState{MqttLinkState::DISABLED};
+std::atomic<bool> reconnectRequested{false};
+std::atomic<uint32_t> nextAttemptAt{0};
+std::atomic<uint32_t> attemptStartedAt{0};
+std::atomic<uint32_t> attemptCount{0};
+std::atomic<uint32_t> failureCount{0};
+std::atomic<uint32_t> consecutiveFailureCount{0};
+std::atomic<uint32_t> disconnectCount{0};
+std::atomic<uint32_t> lastAttemptDuration{0};
+std::atomic<bool> circuitOpen{false};
+std::atomic<const char*> lastError{""};
+std::atomic<bool> sessionStartPending{false};  // Сессия установлена, главный цикл ещё не подписался
+TaskHandle_t connectTaskHandle = nullptr;
+
+ReconnectBackoff backoff(MQTT_RECONNECT_INTERVAL, MQTT_RETRY_MAX_MS, MQTT_CIRCUIT_BREAKER_FAILURES,
+                         MQTT_CIRCUIT_OPEN_MS);
+
+// Кэш DNS: используется только задачей
+struct DNSCache
+{
+    std::array<char, HOSTNAME_BUFFER_SIZE> hostname = {""};
+    IPAddress cachedIP;
+    unsigned long cacheTime = 0;
+    bool isValid = false;
+} dnsCache;
+
+IPAddress resolveBroker(const char* hostname)
+{
+    const unsigned long currentTime = millis();
+    if (dnsCache.isValid && strcmp(dnsCache.hostname.data(), hostname) == 0 &&
+        (currentTime - dnsCache.cacheTime < DNS_CACHE_TTL))
+    {
+        return dnsCache.cachedIP;
+    }
+
+    IPAddress resolvedIP;
+    if (WiFi.hostByName(hostname, resolvedIP) == 0)  // NOLINT(readability-static-accessed-through-instance)
+    {
+        dnsCache.isValid = false;
+        return IPAddress{0, 0, 0, 0};
+    }
+    strlcpy(dnsCache.hostname.data(), hostname, dnsCache.hostname.size());
+    dnsCache.cachedIP = resolvedIP;
+    dnsCache.cacheTime = currentTime;
+    dnsCache.isValid = true;
+    logDebugSafe("MQTT: %s -> %s", hostname, resolvedIP.toString().c_str());
+    return resolvedIP;
+}
+
+// Назначить следующую попытку после неудачи или обрыва; вызывает текущий владелец сокета
+void scheduleRetry()
+{
+    const bool wasOpen = backoff.isOpen();
+    const uint32_t delay = backoff.onFailure(esp_random());
+    consecutiveFailureCount.store(backoff.getConsecutiveFailures());
+    circuitOpen.store(backoff.isOpen());
+    nextAttemptAt.store(millis() + delay);
+    linkState.store(MqttLinkState::WAITING);
+
+    if (backoff.isOpen() && !wasOpen)
+    {
+        logWarnSafe("MQTT: %lu неудачных подключений подряд, следующая попытка через %lu с",
+                    static_cast<unsigned long>(backoff.getConsecutiveFailures()),
+                    static_cast<unsigned long>(delay / MILLISECONDS_IN_SECOND));
+    }
+    else
+    {
+        logDebugSafe("MQTT: повтор подключения через %lu мс", static_cast<unsigned long>(delay));
+    }
+}
+
+void failAttempt(const char* error)
+{
+    lastError.store(error);
+    lastAttemptDuration.store(millis() - attemptStartedAt.load());
+    failureCount.fetch_add(1);
+    scheduleRetry();
+}
+
+// Одна попытка до установленной сессии; ожидание сети — здесь, в задаче
+void runAttempt()
+{
+    attemptStartedAt.store(millis());
+    attemptCount.fetch_add(1);
+    linkState.store(MqttLinkState::RESOLVING);
+
+    std::array<char, sizeof(Config::mqttServer)> host;
+    copyConfigString(host.data(), host.size(), config.mqttServer);
+    const uint16_t port = config.mqttPort;
+    const IPAddress brokerIP = resolveBroker(host.data());
+    if (brokerIP == IPAddress(0, 0, 0, 0))
+    {
+        failAttempt("Ошибка DNS резолвинга");
+        return;
+    }
+
+    linkState.store(MqttLinkState::CONNECTING);
+    espClient.stop();
+    if (espClient.connect(brokerIP, port, MQTT_TCP_CONNECT_TIMEOUT_MS) == 0)
+    {
+        dnsCache.isValid = false;  // Брокер мог сменить адрес
+        failAttempt("Брокер недоступен");
+        return;
+    }
+
+    linkState.store(MqttLinkState::HANDSHAKE);
+    const char* error = "";
+    if (!sendMqttConnect(error))
+    {
+        failAttempt(error);
+        return;
+    }
+    backoff.onSuccess();
+    consecutiveFailureCount.store(0);
+    circuitOpen.store(false);
+    lastError.store("");
+    lastAttemptDuration.store(millis() - attemptStartedAt.load());
+    sessionStartPending.store(true);
+    linkState.store(MqttLinkState::CONNECTED);  // Дальше сокетом владеет главный цикл
+}
+
+void mqttConnectTask(void* /*parameters*/)
+{
+    for (;;)
+    {
+        const MqttLinkState state = linkState.load();
+        if (state == MqttLinkState::DISABLED || state == MqttLinkState::WAITING)
+        {
+            if (!config.flags.mqttEnabled || config.mqttServer[0] == '\0')
+            {
+                linkState.store(MqttLinkState::DISABLED);
+            }
+            else
+            {
+                if (state == MqttLinkState::DISABLED || reconnectRequested.exchange(false))
+                {
+                    backoff.onSuccess();
+                    consecutiveFailureCount.store(0);
+                    circuitOpen.store(false);
+                    nextAttemptAt.store(millis());
+                    linkState.store(MqttLinkState::WAITING);
+                }
+                if (WiFi.status() == WL_CONNECTED && static_cast<int32_t>(millis() - nextAttemptAt.load()) >= 0)
+                {
+                    runAttempt();
+                }
+            }
+        }
+        vTaskDelay(MQTT_CONNECT_TICK);
+    }
+}
+}  // namespace
+
+void startMqttConnection()
+{
+    if (connectTaskHandle == nullptr)
+    {
+        xTaskCreate(mqttConnectTask, "MqttConnect", MQTT_CONNECT_TASK_STACK_SIZE, nullptr, MQTT_CONNECT_TASK_PRIORITY,
+                    &connectTaskHandle);
+    }
+}
+
+MqttLinkState getMqttLinkState()
+{
+    return linkState.load();
+}
+
+const char* getMqttLinkStateName(MqttLinkState state)
+{
+    switch (state)
+    {
+        case MqttLinkState::DISABLED:
+            return "disabled";
+        case MqttLinkState::WAITING:
+            return "waiting";
+        case MqttLinkState::RESOLVING:
+            return "resolving";
+        case MqttLinkState::CONNECTING:
+            return "connecting";
+        case MqttLinkState::HANDSHAKE:
+            return "handshake";
+        case MqttLinkState::CONNECTED:
+            return "connected";
+    }
+    return "unknown";
+}
+
+void getMqttLinkStats(MqttLinkStats& out)
+{
+    out.state = linkState.load();
+    out.attempts = attemptCount.load();
+    out.failures = failureCount.load();
+    out.consecutiveFailures = consecutiveFailureCount.load();
+    out.disconnects = disconnectCount.load();
+    const auto untilNext = static_cast<int32_t>(nextAttemptAt.load() - millis());
+    out.retryInMs = out.state == MqttLinkState::WAITING && untilNext > 0 ? static_cast<uint32_t>(untilNext) : 0;
+    out.lastAttemptMs = lastAttemptDuration.load();
+    out.circuitOpen = circuitOpen.load();
+    out.lastError = lastError.load();
+}
+
+bool isMqttLinkUp()
+{
+    return linkState.load() == MqttLinkState::CONNECTED;
+}
+
+void requestMqttReconnect()
+{
+    reconnectRequested.store(true);
+}
+
+bool takeMqttSessionStart()
+{
+    return sessionStartPending.exchange(false);
+}
+
+void reportMqttLinkLost()
+{
+    if (linkState.load() != MqttLinkState::CONNECTED)
+    {
+        return;
+    }
+    disconnectCount.fetch_add(1);
+    lastError.store("Соединение потеряно");
+    scheduleRetry();
+}
@@ -0,0 +1,58 @@
+/**
+ * @file mqtt_connection.h
+ * @brief Подключение к MQTT-брокеру без ожидания сети в главном цикле
+ * @details Задача MqttConnect разрешает имя брокера, открывает TCP-соединение espClient и отправляет по нему
+ * CONNECT (PubSubClient переиспользует соединение), ожидая CONNACK не дольше MQTT_SOCKET_TIMEOUT_S, — всё,
+ * что при недоступном брокере ждёт сеть секундами. Главный цикл получает уже установленную сессию, подписывается
+ * на команды и дальше её обслуживает. Сокетом владеет одна сторона: задача — в состояниях RESOLVING, CONNECTING
+ * и HANDSHAKE, главный цикл — в CONNECTED.
+ * Паузы между неудачными попытками задаёт ReconnectBackoff; состояние и счётчики можно читать из любой задачи.
+ */
+#ifndef MQTT_CONNECTION_H
+#define MQTT_CONNECTION_H
+
+#include <cstdint>
+
+enum class MqttLinkState : uint8_t
+{
+    DISABLED,    // MQTT выключен или не задан сервер
+    WAITING,     // Пауза до следующей попытки или нет WiFi
+    RESOLVING,   // Задача разрешает имя брокера
+    CONNECTING,  // Задача открывает TCP-соединение
+    HANDSHAKE,   // Сокет открыт, задача отправила CONNECT и ждёт CONNACK
+    CONNECTED
+};
+
+struct MqttLinkStats
+{
+    MqttLinkState state;
+    uint32_t attempts;             // Попыток подключения с момента загрузки
+    uint32_t failures;             // Из них неудачных
+    uint32_t consecutiveFailures;  // Неудач подряд
+    uint32_t disconnects;          // Обрывов установленной сессии
+    uint32_t retryInMs;            // До следующей попытки (в состоянии WAITING)
+    uint32_t lastAttemptMs;        // Длительность последней попытки
+    bool circuitOpen;              // Размыкатель открыт: попытки не чаще MQTT_CIRCUIT_OPEN_MS
+    const char* lastError;         // Причина последней неудачи ("" — не было)
+};
+
+// Запуск задачи подключения (однократно, из setupMQTT)
+void startMqttConnection();
+
+MqttLinkState getMqttLinkState();
+const char* getMqttLinkStateName(MqttLinkState state);
+void getMqttLinkStats(MqttLinkStats& out);
+
+// Сессия с брокером установлена
+bool isMqttLinkUp();
+
+// Подключиться при первой возможности, сбросив паузу после неудач
+void requestMqttReconnect();
+
+// Главный цикл: true один раз после каждой новой сессии — пора подписаться и опубликовать статус
+bool takeMqttSessionStart();
+
+// Главный цикл: сессия оборвалась, сокет закрыт
+void reportMqttLinkLost();
+
+#endif  // MQTT_CONNECTION_H
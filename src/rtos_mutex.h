@@ -0,0 +1,38 @@
+/**
+ * @file rtos_mutex.h
+ * @brief Мьютекс FreeRTOS для данных, которые делят loop(), задача веб-сервера и фоновые задачи
+ * @details Семафор создаётся конструктором в статической памяти ещё до запуска задач, поэтому глобальный
+ * RtosMutex можно захватывать из любой задачи без отдельной инициализации и без гонки при первом обращении.
+ * Мьютекс рекурсивный: функции, захватывающие один и тот же замок, могут вызывать друг друга.
+ * Захват — через std::lock_guard<RtosMutex>.
+ */
+#ifndef RTOS_MUTEX_H
+#define RTOS_MUTEX_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+class RtosMutex
+{
+   public:
+    RtosMutex() : handle(xSemaphoreCreateRecursiveMutexStatic(&storage)) {}
+
+    RtosMutex(const RtosMutex&) = delete;
+    RtosMutex& operator=(const RtosMutex&) = delete;
+
+    void lock()
+    {
+        xSemaphoreTakeRecursive(handle, portMAX_DELAY);
+    }
+
+    void unlock()
+    {
+        xSemaphoreGiveRecursive(handle);
+    }
+
+   private:
+    StaticSemaphore_t storage;
+    SemaphoreHandle_t handle;
+};
+
+#endif  // RTOS_MUTEX_H
@@ -0,0 +1,187 @@
+/**
+ * @file sensor_bus.cpp
+ * @brief Поочерёдный опрос датчиков JXCT на общей шине RS-485
+ * @details За один шаг опрашивается ровно один датчик. Датчик, который несколько раз подряд не ответил,
+ * пропускает растущее число кругов, чтобы таймауты Modbus не съедали время опроса остальных.
+ */
+#include "sensor_bus.h"
+#include <algorithm>
+#include <array>
+#include "jxct_config_vars.h"
+#include "jxct_constants.h"
+#include "logger.h"
+#include "seqlock.h"
+#include "web/live_events.h"
+
+namespace
+{
+constexpr uint8_t BACKOFF_THRESHOLD = 3;  // После скольких неудач подряд датчик начинает пропускать круги
+constexpr uint8_t MAX_SKIP_ROUNDS = 8;    // Не реже одного опроса за 9 кругов
+
+struct ProbeSlot
+{
+    uint8_t address;
+    SensorData* data;
+    SensorCache* cache;
+    SensorFilterState* filters;
+    ProbeCounters counters;                  // Рабочая копия задачи опроса
+    SeqLock<ProbeCounters> countersSnapshot;  // Копия для веб-задачи
+    SeqLock<SensorData> published;            // Для основного датчика не используется: он публикуется через sensorData
+};
+
+// Основной датчик использует глобальные sensorData/sensorCache, остальным нужны собственные хранилища
+std::array<SensorData, CONFIG_BUS_PROBES_MAX - 1> secondaryData = {};
+std::array<SensorCache, CONFIG_BUS_PROBES_MAX - 1> secondaryCache = {};
+std::array<SensorFilterState, CONFIG_BUS_PROBES_MAX - 1> secondaryFilters = {};
+std::array<ProbeSlot, CONFIG_BUS_PROBES_MAX> slots = {};
+uint8_t probeCount = 0;
+uint8_t nextProbe = 0;
+
+// backoff=false — одиночный датчик опрашивается на каждом шаге, пропуск кругов ему не нужен
+void registerResult(ProbeSlot& slot, bool success, bool backoff)
+{
+    ProbeCounters& counters = slot.counters;
+    counters.polls++;
+    if (success)
+    {
+        counters.consecutiveFailures = 0;
+        counters.skipRounds = 0;
+        counters.lastSuccess = millis();
+        slot.countersSnapshot.publish(counters);
+        return;
+    }
+
+    counters.failures++;
+    if (counters.consecutiveFailures < UINT16_MAX)
+    {
+        counters.consecutiveFailures++;
+    }
+    if (backoff && counters.consecutiveFailures >= BACKOFF_THRESHOLD)
+    {
+        // 1, 2, 4, 8 кругов пропуска по мере накопления неудач
+        const uint8_t shift = std::min<uint16_t>(counters.consecutiveFailures - BACKOFF_THRESHOLD, 3);
+        counters.skipRounds = std::min<uint8_t>(static_cast<uint8_t>(1U << shift), MAX_SKIP_ROUNDS);
+        logWarnSafe("Датчик шины %u не отвечает %u раз подряд, пропуск %u кругов", slot.address,
+                    counters.consecutiveFailures, counters.skipRounds);
+    }
+    slot.countersSnapshot.publish(counters);
+}
+}  // namespace
+
+uint8_t clampBusProbeCount(uint8_t firstAddress, uint8_t requested)
+{
+    const int available = std::max(CONFIG_BUS_PROBES_MIN, MODBUS_ADDRESS_MAX - static_cast<int>(firstAddress) + 1);
+    const int limit = std::min(CONFIG_BUS_PROBES_MAX, available);
+    return static_cast<uint8_t>(std::max(CONFIG_BUS_PROBES_MIN, std::min(limit, static_cast<int>(requested))));
+}
+
+void setupSensorBus()
+{
+    probeCount = clampBusProbeCount(config.modbusId, config.busProbeCount);
+    nextProbe = 0;
+
+    for (uint8_t i = 0; i < probeCount; ++i)
+    {
+        ProbeSlot& slot = slots[i];
+        slot.address = config.modbusId + i;
+        slot.data = (i == 0) ? &sensorData : &secondaryData[i - 1];
+        slot.cache = (i == 0) ? &sensorCache : &secondaryCache[i - 1];
+        slot.filters = (i == 0) ? &sensorFilterState : &secondaryFilters[i - 1];
+        slot.counters = {};
+        slot.countersSnapshot.publish(slot.counters);
+        if (i > 0)
+        {
+            *slot.data = {};
+            *slot.cache = {};
+            slot.filters->reset();
+        }
+    }
+
+    logSystemSafe("Шина RS-485: %u датчик(ов), адреса %u..%u", probeCount, config.modbusId,
+                  config.modbusId + probeCount - 1);
+}
+
+uint8_t getSensorBusProbeCount()
+{
+    return probeCount == 0 ? 1 : probeCount;
+}
+
+uint8_t getSensorBusProbeAddress(uint8_t index)
+{
+    return index < probeCount ? slots[index].address : config.modbusId;
+}
+
+void pollNextSensorBusProbe()
+{
+    if (probeCount <= 1)
+    {
+        // Одиночный датчик: прежнее поведение без учёта пропусков.
+        // Счётчики обновляются до публикации: ответы API кэшируются по версии показаний
+        const bool success = readSensorProbe(config.modbusId, sensorData, sensorCache, sensorFilterState, true);
+        if (probeCount == 1)
+        {
+            registerResult(slots[0], success, false);
+        }
+        commitSensorReading();
+        notifyLiveReading(0);
+        return;
+    }
+
+    // Ищем ближайший датчик, не находящийся в паузе; при обходе уменьшаем паузы пропущенных
+    for (uint8_t attempt = 0; attempt < probeCount; ++attempt)
+    {
+        ProbeSlot& slot = slots[nextProbe];
+        const uint8_t index = nextProbe;
+        nextProbe = (nextProbe + 1) % probeCount;
+
+        if (slot.counters.skipRounds > 0)
+        {
+            slot.counters.skipRounds--;
+            slot.countersSnapshot.publish(slot.counters);
+            continue;
+        }
+
+        const bool success = readSensorProbe(slot.address, *slot.data, *slot.cache, *slot.filters, index == 0);
+        registerResult(slot, success, true);
+        if (index == 0)
+        {
+            commitSensorReading();
+        }
+        else
+        {
+            slot.published.publish(*slot.data);
+        }
+        notifyLiveReading(index);
+        return;
+    }
+}
+
+unsigned long getSensorBusPollInterval()
+{
+    const uint8_t count = getSensorBusProbeCount();
+    return std::max(SENSOR_BUS_MIN_POLL_GAP, static_cast<unsigned long>(config.sensorReadInterval) / count);
+}
+
+uint32_t getSensorBusProbeReading(uint8_t index, SensorData& out)
+{
+    if (index == 0)
+    {
+        return getSensorReading(out);
+    }
+    if (index >= probeCount)
+    {
+        out = {};
+        return 0;
+    }
+    return slots[index].published.read(out);
+}
+
+bool getSensorBusProbeCounters(uint8_t index, ProbeCounters& out)
+{
+    if (index >= probeCount)
+    {
+        return false;
+    }
+    slots[index].countersSnapshot.read(out);
+    return true;
+}
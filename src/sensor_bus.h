@@ -0,0 +1,47 @@
+/**
+ * @file sensor_bus.h
+ * @brief Опрос нескольких датчиков JXCT на одной шине RS-485
+ * @details Датчики занимают подряд идущие адреса config.modbusId..modbusId+busProbeCount-1 на общем Serial2.
+ * Датчик с индексом 0 — основной: его данные по-прежнему лежат в глобальных sensorData/sensorCache.
+ */
+#ifndef SENSOR_BUS_H
+#define SENSOR_BUS_H
+
+#include <cstdint>
+#include "modbus_sensor.h"
+
+// Счётчики опроса отдельного датчика шины
+struct ProbeCounters
+{
+    uint32_t polls;                // Всего опросов
+    uint32_t failures;             // Неудачных опросов
+    uint16_t consecutiveFailures;  // Неудачных опросов подряд
+    uint8_t skipRounds;            // Сколько кругов датчик пропускает из-за неответа
+    unsigned long lastSuccess;     // millis() последнего успешного опроса
+};
+
+// Допустимое число датчиков с адресами от firstAddress: CONFIG_BUS_PROBES_MIN..MAX и не дальше адреса 247
+uint8_t clampBusProbeCount(uint8_t firstAddress, uint8_t requested);
+
+// Инициализация слотов датчиков по текущей конфигурации (вызывается из setupModbus)
+void setupSensorBus();
+
+// Количество датчиков на шине
+uint8_t getSensorBusProbeCount();
+
+// Modbus-адрес датчика по индексу
+uint8_t getSensorBusProbeAddress(uint8_t index);
+
+// Опрос следующего по кругу датчика (один датчик за вызов)
+void pollNextSensorBusProbe();
+
+// Пауза между шагами опроса: интервал чтения делится между всеми датчиками
+unsigned long getSensorBusPollInterval();
+
+// Согласованная копия последних показаний датчика; возвращает версию (0 — данных нет или неверный индекс)
+uint32_t getSensorBusProbeReading(uint8_t index, SensorData& out);
+
+// Счётчики опроса датчика; false при неверном индексе
+bool getSensorBusProbeCounters(uint8_t index, ProbeCounters& out);
+
+#endif  // SENSOR_BUS_H
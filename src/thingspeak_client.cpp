@@ -1,24 +1,36 @@
 #include "thingspeak_client.h"
-#include <NTPClient.h>
+#include <HTTPClient.h>
 #include <ThingSpeak.h>
 #include <WiFiClient.h>
 #include <array>
 #include <cctype>
+#include <ctime>
+#include <memory>
+#include <new>
 #include "jxct_config_vars.h"
+#include "jxct_constants.h"
 #include "jxct_device_info.h"
 #include "jxct_format_utils.h"
+#include "json_writer.h"
 #include "logger.h"
 #include "modbus_sensor.h"
+#include "thingspeak_batch.h"
+#include "time_service.h"
+#include "uplink_queue.h"
 #include "wifi_manager.h"
-extern NTPClient* timeClient;
 
 namespace
 {
 // URL для отправки данных в ThingSpeak
 const char* THINGSPEAK_API_URL = "https://api.thingspeak.com/update";
+// Пакетная запись: до 960 показаний за запрос, лимит частоты тот же, что у /update
+const char* THINGSPEAK_BULK_URL_FORMAT = "http://api.thingspeak.com/channels/%lu/bulk_update.json";
+constexpr size_t THINGSPEAK_BULK_ENTRY_SIZE = 192;  // created_at и семь полей одного показания в JSON
+constexpr int THINGSPEAK_BULK_ACCEPTED = 202;
 
 unsigned long lastTsPublish = 0;
-int consecutiveFailCount = 0;  // счётчик подряд неудач
+int consecutiveFailCount = 0;    // счётчик подряд неудач
+uint32_t lastSentTimestamp = 0;  // UNIX-время последнего доставленного показания: от него прореживается очередь
 
 // Утилита для обрезки пробелов в начале/конце строки C
 void trim(char* str)
@@ -49,6 +61,159 @@ void trim(char* str)
 // ✅ Заменяем String на статические буферы
 std::array<char, 32> thingSpeakLastPublishBuffer = {"0"};
 std::array<char, 64> thingSpeakLastErrorBuffer = {""};
+
+void registerSuccess()
+{
+    lastTsPublish = millis();
+    snprintf(thingSpeakLastPublishBuffer.data(), thingSpeakLastPublishBuffer.size(), "%lu", lastTsPublish);
+    thingSpeakLastErrorBuffer[0] = '\0';  // Очистка ошибки
+    consecutiveFailCount = 0;             // обнуляем при успехе
+}
+
+void registerFailure()
+{
+    reportUplinkFailure(UplinkSink::THINGSPEAK);  // Пропущенное уйдёт пакетом из очереди
+    consecutiveFailCount++;
+
+    // Если слишком много ошибок подряд, временно отключаем на 1 час
+    if (consecutiveFailCount >= 10)
+    {
+        logWarnSafe("\1", consecutiveFailCount);
+        lastTsPublish = millis();  // устанавливаем время последней попытки
+        consecutiveFailCount = 0;  // сбрасываем счётчик
+        strlcpy(thingSpeakLastErrorBuffer.data(), "Отключён на 1 час (много ошибок)", thingSpeakLastErrorBuffer.size());
+    }
+}
+
+// Канал и ключ записи из настроек; неверные настройки отмечаются в ошибке один раз, без лога на каждую попытку
+bool readCredentials(unsigned long& channelId, std::array<char, 25>& apiKey)
+{
+    std::array<char, 16> channelBuf;
+    copyConfigString(apiKey.data(), apiKey.size(), config.thingSpeakApiKey);
+    copyConfigString(channelBuf.data(), channelBuf.size(), config.thingSpeakChannelId);
+    trim(apiKey.data());
+    trim(channelBuf.data());
+
+    channelId = strtoul(channelBuf.data(), nullptr, 10);
+    if (channelId == 0 || strlen(apiKey.data()) < 16)
+    {
+        if (strlen(thingSpeakLastErrorBuffer.data()) == 0)  // логируем только первый раз
+        {
+            logWarnSafe("\1", channelBuf.data(), strlen(apiKey.data()));
+            strlcpy(thingSpeakLastErrorBuffer.data(), "Настройки не заданы", thingSpeakLastErrorBuffer.size());
+        }
+        return false;
+    }
+    return true;
+}
+
+// Показание очереди в массиве updates запроса bulk_update
+void appendBulkEntry(JsonWriter& json, const UplinkRecord& record)
+{
+    static constexpr std::array<uint8_t, UPLINK_CHANNEL_COUNT> DECIMALS = {1, 1, 0, 1, 0, 0, 0};  // Как format_*()
+    const auto timestamp = static_cast<time_t>(record.timestamp);
+    struct tm timeInfo = {};
+    gmtime_r(&timestamp, &timeInfo);
+    std::array<char, 32> createdAt;
+    strftime(createdAt.data(), createdAt.size(), "%Y-%m-%d %H:%M:%S +0000", &timeInfo);
+
+    json.beginObject();
+    json.member("created_at", createdAt.data());
+    for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+    {
+        if (record.values[channel] == UPLINK_VALUE_MISSING)
+        {
+            continue;
+        }
+        std::array<char, 8> field;
+        snprintf(field.data(), field.size(), "field%u", static_cast<unsigned>(channel + 1));
+        json.memberFixed(field.data(), restoreUplinkValue(record.values[channel], channel), DECIMALS[channel], true);
+    }
+    json.endObject();
+}
+
+// Показания, накопленные в очереди без связи, уходят одним запросом bulk_update, у каждого своё время (UTC).
+// Очередь прореживается до интервала ThingSpeak: запрос просматривает до UPLINK_THINGSPEAK_SCAN_RECORDS записей
+bool sendBacklog(unsigned long channelId, const char* apiKey)
+{
+    // Тело запроса нужно только на время отправки: берём из кучи и сразу освобождаем
+    const size_t capacity = 64 + UPLINK_THINGSPEAK_BATCH_RECORDS * THINGSPEAK_BULK_ENTRY_SIZE;
+    const std::unique_ptr<char[]> body(new (std::nothrow) char[capacity]);
+    if (!body)
+    {
+        strlcpy(thingSpeakLastErrorBuffer.data(), "Нет памяти для пакета", thingSpeakLastErrorBuffer.size());
+        return false;
+    }
+
+    JsonWriter json(body.get(), capacity);
+    json.beginObject();
+    json.member("write_api_key", apiKey);
+    json.beginArray("updates");
+
+    static std::array<UplinkRecord, UPLINK_THINGSPEAK_READ_RECORDS> records;
+    const uint32_t cursor = getUplinkCursor(UplinkSink::THINGSPEAK);
+    uint32_t position = cursor;
+    ThingSpeakBatchSelector selector(lastSentTimestamp, config.thingSpeakInterval / MILLISECONDS_IN_SECOND,
+                                     UPLINK_THINGSPEAK_BATCH_RECORDS, UPLINK_THINGSPEAK_SCAN_RECORDS);
+    while (selector.wantsChunk(records.size()))
+    {
+        const size_t count = readUplinkRecords(position, records.data(), records.size());
+        if (count == 0)
+        {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (selector.take(records[i]))
+            {
+                appendBulkEntry(json, records[i]);
+            }
+        }
+    }
+    json.endArray();
+    json.endObject();
+    const size_t entries = selector.entryCount();
+
+    if (entries == 0)
+    {
+        commitUplinkCursor(UplinkSink::THINGSPEAK, position);  // Отправлять нечего
+        return position != cursor;
+    }
+    if (json.overflowed())
+    {
+        logError("ThingSpeak: пакет накопленных показаний не помещается в буфер");
+        return false;
+    }
+
+    std::array<char, 96> url;
+    snprintf(url.data(), url.size(), THINGSPEAK_BULK_URL_FORMAT, channelId);
+    WiFiClient client;
+    HTTPClient http;
+    if (!http.begin(client, url.data()))
+    {
+        strlcpy(thingSpeakLastErrorBuffer.data(), "Ошибка подключения", thingSpeakLastErrorBuffer.size());
+        registerFailure();
+        return false;
+    }
+    http.addHeader("Content-Type", "application/json");
+    const int status = http.POST(reinterpret_cast<uint8_t*>(body.get()), json.size());  // NOLINT
+    http.end();
+
+    if (status == THINGSPEAK_BULK_ACCEPTED)
+    {
+        commitUplinkCursor(UplinkSink::THINGSPEAK, position);
+        lastSentTimestamp = selector.lastSelected();
+        registerSuccess();
+        logSuccessSafe("ThingSpeak: отправлено накопленных показаний: %u, в очереди ещё %lu",
+                       static_cast<unsigned>(entries),
+                       static_cast<unsigned long>(getUplinkPending(UplinkSink::THINGSPEAK)));
+        return true;
+    }
+    logWarnSafe("ThingSpeak: пакетная отправка не удалась (HTTP %d)", status);
+    snprintf(thingSpeakLastErrorBuffer.data(), thingSpeakLastErrorBuffer.size(), "Пакет: ошибка %d", status);
+    registerFailure();
+    return false;
+}
 }  // namespace
 
 // Геттеры для совместимости с внешним кодом
@@ -75,9 +240,12 @@ bool sendDataToThingSpeak()
     }
     if (!wifiConnected)
     {
+        reportUplinkFailure(UplinkSink::THINGSPEAK);
         return false;
     }
-    if (!sensorData.valid)
+    SensorData reading{};
+    getSensorReading(reading);
+    if (!reading.valid)
     {
         return false;
     }
@@ -89,46 +257,37 @@ bool sendDataToThingSpeak()
     }
 
     std::array<char, 25> apiKeyBuf;
-    std::array<char, 16> channelBuf;
-    strlcpy(apiKeyBuf.data(), config.thingSpeakApiKey, apiKeyBuf.size());
-    strlcpy(channelBuf.data(), config.thingSpeakChannelId, channelBuf.size());
-    trim(apiKeyBuf.data());
-    trim(channelBuf.data());
-
-    const unsigned long channelId = strtoul(channelBuf.data(), nullptr, 10);
+    unsigned long channelId = 0;
+    if (!readCredentials(channelId, apiKeyBuf))
+    {
+        return false;
+    }
 
-    // Проверяем корректность ID и API ключа - если неверные, молча пропускаем
-    if (channelId == 0 || strlen(apiKeyBuf.data()) < 16)
+    // Во время догоняния последнее показание уже лежит в очереди и уйдёт пакетом (handleThingSpeakBacklog)
+    if (hasUplinkBacklog(UplinkSink::THINGSPEAK))
     {
-        // Не логируем ошибку каждый раз, просто пропускаем отправку
-        if (strlen(thingSpeakLastErrorBuffer.data()) == 0)  // логируем только первый раз
-        {
-            logWarnSafe("\1", channelBuf.data(), strlen(apiKeyBuf.data()));
-            strlcpy(thingSpeakLastErrorBuffer.data(), "Настройки не заданы", thingSpeakLastErrorBuffer.size());
-        }
         return false;
     }
 
     // Отправка данных
-    ThingSpeak.setField(1, format_temperature(sensorData.temperature).c_str());
-    ThingSpeak.setField(2, format_moisture(sensorData.humidity).c_str());
-    ThingSpeak.setField(3, format_ec(sensorData.ec).c_str());
-    ThingSpeak.setField(4, format_ph(sensorData.ph).c_str());
-    ThingSpeak.setField(5, format_npk(sensorData.nitrogen).c_str());
-    ThingSpeak.setField(6, format_npk(sensorData.phosphorus).c_str());
-    ThingSpeak.setField(7, format_npk(sensorData.potassium).c_str());
+    ThingSpeak.setField(1, format_temperature(reading.temperature).c_str());
+    ThingSpeak.setField(2, format_moisture(reading.humidity).c_str());
+    ThingSpeak.setField(3, format_ec(reading.ec).c_str());
+    ThingSpeak.setField(4, format_ph(reading.ph).c_str());
+    ThingSpeak.setField(5, format_npk(reading.nitrogen).c_str());
+    ThingSpeak.setField(6, format_npk(reading.phosphorus).c_str());
+    ThingSpeak.setField(7, format_npk(reading.potassium).c_str());
 
-    logDataSafe("\1", sensorData.temperature, sensorData.humidity, sensorData.ph);
+    logDataSafe("\1", reading.temperature, reading.humidity, reading.ph);
 
     int res = ThingSpeak.writeFields(channelId, apiKeyBuf.data());
 
     if (res == 200)
     {
         logSuccess("ThingSpeak: данные отправлены");
-        lastTsPublish = millis();
-        snprintf(thingSpeakLastPublishBuffer.data(), thingSpeakLastPublishBuffer.size(), "%lu", lastTsPublish);
-        thingSpeakLastErrorBuffer[0] = '\0';  // Очистка ошибки
-        consecutiveFailCount = 0;             // обнуляем при успехе
+        registerSuccess();
+        acknowledgeUplinkLatest(UplinkSink::THINGSPEAK);
+        lastSentTimestamp = getTimeEpoch();
         return true;
     }
     if (res == -301)
@@ -169,16 +328,33 @@ bool sendDataToThingSpeak()
         snprintf(thingSpeakLastErrorBuffer.data(), thingSpeakLastErrorBuffer.size(), "Ошибка %d", res);
     }
 
-    consecutiveFailCount++;
+    registerFailure();
+    return false;
+}
 
-    // Если слишком много ошибок подряд, временно отключаем на 1 час
-    if (consecutiveFailCount >= 10)
+void handleThingSpeakBacklog()
+{
+    static unsigned long lastDrainAttempt = 0;
+    // Без времени показания, снятые до синхронизации, ещё нельзя поставить на своё место в канале
+    if (!config.flags.thingSpeakEnabled || !wifiConnected || !isTimeSynced() ||
+        !hasUplinkBacklog(UplinkSink::THINGSPEAK))
     {
-        logWarnSafe("\1", consecutiveFailCount);
-        lastTsPublish = millis();  // устанавливаем время последней попытки
-        consecutiveFailCount = 0;  // сбрасываем счётчик
-        strlcpy(thingSpeakLastErrorBuffer.data(), "Отключён на 1 час (много ошибок)", thingSpeakLastErrorBuffer.size());
+        return;
+    }
+    // Канал принимает запись не чаще раза в 15 с, пакетную тоже; после неудачи — повтор с интервалом отправки
+    const unsigned long retryPause = config.thingSpeakInterval;
+    const unsigned long pause = consecutiveFailCount == 0 ? UPLINK_THINGSPEAK_DRAIN_INTERVAL_MS : retryPause;
+    const unsigned long now = millis();
+    if (now - lastTsPublish < UPLINK_THINGSPEAK_DRAIN_INTERVAL_MS || now - lastDrainAttempt < pause)
+    {
+        return;
     }
+    lastDrainAttempt = now;
 
-    return false;
+    std::array<char, 25> apiKeyBuf;
+    unsigned long channelId = 0;
+    if (readCredentials(channelId, apiKeyBuf))
+    {
+        sendBacklog(channelId, apiKeyBuf.data());
+    }
 }
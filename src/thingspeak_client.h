@@ -14,7 +14,11 @@ const char* getThingSpeakLastError();
 // Инициализация ThingSpeak клиента (передаём WiFiClient)
 void setupThingSpeak(WiFiClient& client);
 
-// Отправка данных в ThingSpeak (с учётом интервала)
+// Отправка данных в ThingSpeak (с учётом интервала); во время догоняния очереди не отправляет ничего
 bool sendDataToThingSpeak();
 
+// Догоняние очереди после перерыва связи: пакет bulk_update не чаще UPLINK_THINGSPEAK_DRAIN_INTERVAL_MS,
+// показания прорежены до интервала отправки (вызывать в loop)
+void handleThingSpeakBacklog();
+
 #endif  // THINGSPEAK_CLIENT_H
@@ -0,0 +1,213 @@
+/**
+ * @file time_service.cpp
+ * @brief Задача синхронизации времени по NTP и публикация снимка времени
+ * @details Снимок публикуется через SeqLock: читатели получают согласованную копию за несколько
+ * инструкций. Текущее время считается от момента синхронизации по millis(), месяц пересчитывается задачей
+ * раз в TIME_MONTH_REFRESH_MS, поэтому обработчикам не нужны ни сеть, ни localtime().
+ */
+#include "time_service.h"
+#include <NTPClient.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include "jxct_config_vars.h"
+#include "jxct_constants.h"
+#include "logger.h"
+#include "seqlock.h"
+
+namespace
+{
+constexpr TickType_t TIME_SERVICE_TICK = pdMS_TO_TICKS(1000);  // Шаг задачи: проверка WiFi и сроков
+constexpr unsigned long TIME_MONTH_REFRESH_MS = 60000;         // Смена месяца замечается не позже чем через минуту
+constexpr const char* DEFAULT_NTP_SERVER = "pool.ntp.org";
+
+struct TimeState
+{
+    uint32_t syncEpoch;   // UNIX-время на момент синхронизации
+    uint32_t syncMillis;  // millis() на момент синхронизации
+    uint8_t month;        // 1..12, 0 — время неизвестно
+    bool synced;
+};
+
+SeqLock<TimeState> publishedTime;
+std::atomic<bool> syncRequested{true};
+TaskHandle_t timeServiceTaskHandle = nullptr;
+
+WiFiUDP ntpUDP;
+NTPClient* ntpClient = nullptr;
+std::array<char, sizeof(Config::ntpServer)> ntpServer = {};  // NTPClient хранит указатель на имя сервера
+
+uint32_t epochFrom(const TimeState& state)
+{
+    return state.synced ? state.syncEpoch + (millis() - state.syncMillis) / MILLISECONDS_IN_SECOND : 0;
+}
+
+uint8_t monthOf(uint32_t epoch)
+{
+    const auto now = static_cast<time_t>(epoch);
+    struct tm timeInfo = {};
+    if (gmtime_r(&now, &timeInfo) == nullptr)
+    {
+        return 0;
+    }
+    return static_cast<uint8_t>(timeInfo.tm_mon + 1);
+}
+
+// Копия имени из настроек: веб-интерфейс может менять config.ntpServer во время запроса
+const char* ntpServerName()
+{
+    copyConfigString(ntpServer.data(), ntpServer.size(), config.ntpServer);
+    if (ntpServer[0] == '\0')
+    {
+        strlcpy(ntpServer.data(), DEFAULT_NTP_SERVER, ntpServer.size());
+    }
+    return ntpServer.data();
+}
+
+// Один запрос к NTP-серверу (NTPClient ждёт ответ до секунды); системные часы тоже выставляются
+bool syncOnce()
+{
+    const char* server = ntpServerName();
+    if (ntpClient == nullptr)
+    {
+        ntpClient = new NTPClient(ntpUDP, server, 0, DEFAULT_NTP_UPDATE_INTERVAL);
+        ntpClient->begin();
+    }
+    ntpClient->setPoolServerName(server);
+    if (!ntpClient->forceUpdate() || ntpClient->getEpochTime() < NTP_TIMESTAMP_2000)
+    {
+        return false;
+    }
+
+    const auto epoch = static_cast<uint32_t>(ntpClient->getEpochTime());
+    struct timeval now = {static_cast<time_t>(epoch), 0};
+    settimeofday(&now, nullptr);
+
+    TimeState state{};
+    state.syncEpoch = epoch;
+    state.syncMillis = millis();
+    state.month = monthOf(epoch);
+    state.synced = true;
+    publishedTime.publish(state);
+    return true;
+}
+
+void timeServiceTask(void* /*parameters*/)
+{
+    unsigned long nextSyncAt = 0;
+    unsigned long retryDelay = NTP_RETRY_MIN_MS;
+    unsigned long lastMonthRefresh = 0;
+
+    for (;;)
+    {
+        const unsigned long now = millis();
+        if (syncRequested.exchange(false))
+        {
+            nextSyncAt = now;
+            retryDelay = NTP_RETRY_MIN_MS;
+        }
+
+        if (WiFi.status() == WL_CONNECTED && static_cast<long>(now - nextSyncAt) >= 0)
+        {
+            const bool wasSynced = isTimeSynced();
+            if (syncOnce())
+            {
+                nextSyncAt = millis() + std::max<unsigned long>(config.ntpUpdateInterval, NTP_MIN_UPDATE_INTERVAL);
+                retryDelay = NTP_RETRY_MIN_MS;
+                lastMonthRefresh = millis();
+                if (!wasSynced)
+                {
+                    logSystemSafe("Время синхронизировано по NTP (%s)", ntpServer.data());
+                }
+            }
+            else
+            {
+                nextSyncAt = millis() + retryDelay;
+                logDebugSafe("NTP: нет ответа от %s, повтор через %lu мс", ntpServer.data(), retryDelay);
+                retryDelay = std::min(retryDelay * 2, NTP_RETRY_MAX_MS);
+            }
+        }
+
+        // Месяц меняется без новой синхронизации — пересчитываем по текущему времени
+        if (isTimeSynced() && millis() - lastMonthRefresh >= TIME_MONTH_REFRESH_MS)
+        {
+            lastMonthRefresh = millis();
+            TimeState state{};
+            publishedTime.read(state);
+            const uint8_t month = monthOf(epochFrom(state));
+            if (month != state.month)
+            {
+                state.month = month;
+                publishedTime.publish(state);
+            }
+        }
+
+        vTaskDelay(TIME_SERVICE_TICK);
+    }
+}
+}  // namespace
+
+void startTimeService()
+{
+    if (timeServiceTaskHandle == nullptr)
+    {
+        xTaskCreate(timeServiceTask, "TimeService", TIME_SERVICE_TASK_STACK_SIZE, nullptr, TIME_SERVICE_TASK_PRIORITY,
+                    &timeServiceTaskHandle);
+    }
+}
+
+void requestTimeSync()
+{
+    syncRequested.store(true);
+}
+
+bool isTimeSynced()
+{
+    TimeState state{};
+    publishedTime.read(state);
+    return state.synced;
+}
+
+uint32_t getTimeEpoch()
+{
+    TimeState state{};
+    publishedTime.read(state);
+    return epochFrom(state);
+}
+
+uint8_t getTimeMonth()
+{
+    TimeState state{};
+    publishedTime.read(state);
+    return state.month;
+}
+
+const char* getTimeSeasonName()
+{
+    switch (getTimeMonth())
+    {
+        case 12:
+        case 1:
+        case 2:
+            return "Зима";
+        case 3:
+        case 4:
+        case 5:
+            return "Весна";
+        case 6:
+        case 7:
+        case 8:
+            return "Лето";
+        case 9:
+        case 10:
+        case 11:
+            return "Осень";
+        default:
+            return "Н/Д";
+    }
+}
@@ -0,0 +1,31 @@
+/**
+ * @file time_service.h
+ * @brief Сетевое время: синхронизация NTP в отдельной задаче и чтение без ожидания сети
+ * @details Задача владеет NTP-клиентом, синхронизируется с экспоненциальной паузой при неудачах и публикует
+ * снимок (epoch на момент синхронизации, месяц, признак синхронизации). Обработчики веб-сервера и MQTT
+ * только читают снимок и никогда не ждут ответа NTP-сервера.
+ */
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <cstdint>
+
+// Запуск задачи синхронизации времени (однократно, из setup)
+void startTimeService();
+
+// Синхронизироваться при первой возможности, сбросив паузу после неудач (например, после подключения WiFi)
+void requestTimeSync();
+
+// Время получено от NTP хотя бы раз
+bool isTimeSynced();
+
+// Текущее UNIX-время в секундах; 0 — время ещё не синхронизировано
+uint32_t getTimeEpoch();
+
+// Текущий месяц 1..12; 0 — время ещё не синхронизировано
+uint8_t getTimeMonth();
+
+// Сезон по текущему месяцу: "Зима", "Весна", "Лето", "Осень"; "Н/Д" до синхронизации
+const char* getTimeSeasonName();
+
+#endif  // TIME_SERVICE_H
@@ -0,0 +1,618 @@
+/**
+ * @file uplink_queue.cpp
+ * @brief Кольцевая очередь показаний в LittleFS: сегменты фиксированной длины и курсоры получателей
+ * @details Записи нумеруются сквозным номером, сегмент с номером s хранит записи s·N … s·N+N−1 в файле
+ * /uplink/<s в hex>.seg, поэтому позиция записи вычисляется без индекса. Сегменты только дописываются;
+ * запись, оборванная сбоем, закрывает сегмент, и очередь продолжается со следующего. Дописываемый сегмент
+ * держится открытым через BufferedFlashFile: показания копятся в буфере не дольше FLASH_WRITE_FLUSH_MS
+ * и уходят на флеш одной записью вместо открытия, записи и закрытия файла на каждое показание.
+ * Пока время не синхронизировано, запись получает секунды с загрузки. Загрузки различаются по номеру первой
+ * записи (/uplink/boots.bin); при синхронизации у загрузки появляется сдвиг до UNIX-времени, и при чтении
+ * время записи пересчитывается. Загрузке, которая так и не дождалась времени, сдвиг назначается по следующей:
+ * считается, что она закончилась перед началом следующей (ошибка — длительность перезагрузки).
+ */
+#include "uplink_queue.h"
+#include <LittleFS.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "jxct_config_vars.h"
+#include "flash_writer.h"
+#include "jxct_constants.h"
+#include "logger.h"
+#include "modbus_sensor.h"
+#include "time_service.h"
+
+namespace
+{
+constexpr const char* QUEUE_DIR = "/uplink";
+constexpr const char* CURSORS_PATH = "/uplink/cursors.bin";
+constexpr const char* BOOTS_PATH = "/uplink/boots.bin";
+constexpr uint32_t SEGMENT_RECORDS = UPLINK_QUEUE_SEGMENT_RECORDS;
+
+using RawRecord = std::array<uint8_t, UPLINK_RECORD_SIZE>;
+using PathBuffer = std::array<char, 32>;
+
+// Курсоры на флеше: по uint32 на получателя и CRC-16
+constexpr size_t CURSORS_FILE_SIZE = 4 * UPLINK_SINK_COUNT + 2;
+
+// Загрузка, записи которой начинаются с firstSequence; offset — сдвиг секунд с загрузки до UNIX-времени
+struct BootSpan
+{
+    uint32_t firstSequence;
+    uint32_t offset;      // 0 — ещё неизвестен
+    uint32_t lastUptime;  // Время последней записи загрузки (известно со следующей загрузки)
+};
+
+// Загрузки на флеше: число загрузок, по три uint32 на загрузку и CRC-16
+constexpr size_t BOOTS_FILE_SIZE = 1 + 12 * UPLINK_BOOT_SPANS + 2;
+
+std::atomic<uint32_t> headSequence{0};  // Самая старая запись на флеше
+std::atomic<uint32_t> tailSequence{0};  // Номер следующей записи
+std::array<std::atomic<uint32_t>, UPLINK_SINK_COUNT> cursors = {};
+std::atomic<uint32_t> droppedRecords{0};
+std::array<bool, UPLINK_SINK_COUNT> interrupted = {};  // Была неудачная отправка, очередь ещё не догнана
+bool queueReady = false;
+unsigned long lastCursorSave = 0;
+BufferedFlashFile tailFile;             // Дописываемый сегмент
+uint32_t tailFileSegment = UINT32_MAX;  // Номер открытого сегмента, UINT32_MAX — закрыт
+std::array<BootSpan, UPLINK_BOOT_SPANS> bootSpans = {};
+size_t bootSpanCount = 0;  // Последняя загрузка — текущая
+
+uint32_t segmentOf(uint32_t sequence)
+{
+    return sequence / SEGMENT_RECORDS;
+}
+
+void segmentPath(uint32_t segment, PathBuffer& path)
+{
+    snprintf(path.data(), path.size(), "%s/%08lx.seg", QUEUE_DIR, static_cast<unsigned long>(segment));
+}
+
+size_t sinkIndex(UplinkSink sink)
+{
+    return static_cast<size_t>(sink);
+}
+
+bool isSinkEnabled(size_t sink)
+{
+    return sink == sinkIndex(UplinkSink::MQTT) ? config.flags.mqttEnabled : config.flags.thingSpeakEnabled;
+}
+
+void saveCursors()
+{
+    std::array<uint8_t, CURSORS_FILE_SIZE> raw{};
+    size_t offset = 0;
+    for (const auto& cursor : cursors)
+    {
+        const uint32_t value = cursor.load();
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            raw[offset++] = static_cast<uint8_t>(value >> shift);
+        }
+    }
+    const uint16_t crc = uplinkCrc16(raw.data(), offset);
+    raw[offset++] = static_cast<uint8_t>(crc);
+    raw[offset] = static_cast<uint8_t>(crc >> 8);
+
+    BufferedFlashFile file;
+    const bool written = file.open(CURSORS_PATH, "w") && file.write(raw.data(), raw.size());
+    if (!file.close() || !written)
+    {
+        logWarn("Очередь отправки: не удалось сохранить курсоры");
+    }
+    lastCursorSave = millis();
+}
+
+void closeTailFile()
+{
+    if (tailFileSegment != UINT32_MAX)
+    {
+        tailFile.close();
+        tailFileSegment = UINT32_MAX;
+    }
+}
+
+// Сбой записи: недописанная запись сбила бы смещения сегмента, следующие пойдут в новый
+void abandonTailSegment()
+{
+    logWarn("Очередь отправки: запись показания не удалась");
+    closeTailFile();
+    tailSequence.store((segmentOf(tailSequence.load()) + 1) * SEGMENT_RECORDS);
+}
+
+// false — файла нет или он повреждён
+bool loadCursors(std::array<uint32_t, UPLINK_SINK_COUNT>& values)
+{
+    File file = LittleFS.open(CURSORS_PATH, "r");
+    if (!file)
+    {
+        return false;
+    }
+    std::array<uint8_t, CURSORS_FILE_SIZE> raw{};
+    const size_t length = file.read(raw.data(), raw.size());
+    file.close();
+    const size_t payload = raw.size() - 2;
+    if (length != raw.size() || uplinkCrc16(raw.data(), payload) != (raw[payload] | (raw[payload + 1] << 8)))
+    {
+        return false;
+    }
+    for (size_t sink = 0; sink < values.size(); ++sink)
+    {
+        values[sink] = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            values[sink] |= static_cast<uint32_t>(raw[sink * 4 + i]) << (8 * i);
+        }
+    }
+    return true;
+}
+
+void putUint32(uint8_t* out, uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        *out++ = static_cast<uint8_t>(value >> shift);
+    }
+}
+
+uint32_t getUint32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+void saveBootSpans()
+{
+    std::array<uint8_t, BOOTS_FILE_SIZE> raw{};
+    raw[0] = static_cast<uint8_t>(bootSpanCount);
+    for (size_t i = 0; i < bootSpanCount; ++i)
+    {
+        uint8_t* entry = raw.data() + 1 + 12 * i;
+        putUint32(entry, bootSpans[i].firstSequence);
+        putUint32(entry + 4, bootSpans[i].offset);
+        putUint32(entry + 8, bootSpans[i].lastUptime);
+    }
+    const size_t payload = raw.size() - 2;
+    const uint16_t crc = uplinkCrc16(raw.data(), payload);
+    raw[payload] = static_cast<uint8_t>(crc);
+    raw[payload + 1] = static_cast<uint8_t>(crc >> 8);
+
+    BufferedFlashFile file;
+    const bool written = file.open(BOOTS_PATH, "w") && file.write(raw.data(), raw.size());
+    if (!file.close() || !written)
+    {
+        logWarn("Очередь отправки: не удалось сохранить время загрузок");
+    }
+}
+
+// false — файла нет или он повреждён; тогда записи прошлых загрузок без времени остаются без него
+bool loadBootSpans()
+{
+    File file = LittleFS.open(BOOTS_PATH, "r");
+    if (!file)
+    {
+        return false;
+    }
+    std::array<uint8_t, BOOTS_FILE_SIZE> raw{};
+    const size_t length = file.read(raw.data(), raw.size());
+    file.close();
+    const size_t payload = raw.size() - 2;
+    if (length != raw.size() || raw[0] > UPLINK_BOOT_SPANS ||
+        uplinkCrc16(raw.data(), payload) != (raw[payload] | (raw[payload + 1] << 8)))
+    {
+        return false;
+    }
+    bootSpanCount = raw[0];
+    for (size_t i = 0; i < bootSpanCount; ++i)
+    {
+        const uint8_t* entry = raw.data() + 1 + 12 * i;
+        bootSpans[i] = {getUint32(entry), getUint32(entry + 4), getUint32(entry + 8)};
+    }
+    return true;
+}
+
+// Время от загрузки для записи, сделанной до синхронизации; 0 в первую секунду значило бы «неизвестно»
+uint32_t uptimeSeconds()
+{
+    return std::max<uint32_t>(1, millis() / MILLISECONDS_IN_SECOND);
+}
+
+// Время записи с номером sequence как оно лежит на флеше; 0 — записи нет или она повреждена
+uint32_t storedTimestamp(uint32_t sequence)
+{
+    PathBuffer path;
+    segmentPath(segmentOf(sequence), path);
+    File file = LittleFS.open(path.data(), "r");
+    RawRecord raw{};
+    UplinkRecord record{};
+    const bool found = file && file.seek((sequence % SEGMENT_RECORDS) * UPLINK_RECORD_SIZE) &&
+                       file.read(raw.data(), raw.size()) == raw.size() && decodeUplinkRecord(raw.data(), record);
+    file.close();
+    return found ? record.timestamp : 0;
+}
+
+// Новая загрузка начинается с хвоста очереди; загрузки, чьих записей в очереди не осталось, забываются
+void startBootSpan()
+{
+    loadBootSpans();
+    const uint32_t head = headSequence.load();
+    const uint32_t tail = tailSequence.load();
+    if (bootSpanCount > 0)
+    {
+        BootSpan& previous = bootSpans[bootSpanCount - 1];
+        if (previous.firstSequence >= tail)
+        {
+            --bootSpanCount;  // Прошлая загрузка ничего не записала
+        }
+        else if (previous.offset == 0)
+        {
+            const uint32_t last = storedTimestamp(tail - 1);
+            previous.lastUptime = last < NTP_TIMESTAMP_2000 ? last : 0;
+        }
+    }
+    size_t expired = 0;
+    while (expired + 1 < bootSpanCount && bootSpans[expired + 1].firstSequence <= head)
+    {
+        ++expired;
+    }
+    if (bootSpanCount == UPLINK_BOOT_SPANS && expired == 0)
+    {
+        expired = 1;  // Самая старая загрузка теряет пересчёт времени
+    }
+    std::copy(bootSpans.begin() + expired, bootSpans.begin() + bootSpanCount, bootSpans.begin());
+    bootSpanCount -= expired;
+    bootSpans[bootSpanCount++] = {tail, 0, 0};
+    saveBootSpans();
+}
+
+// Время синхронизировано: у текущей загрузки и у предыдущих, так его и не дождавшихся, появляется сдвиг
+void resolveBootSpans()
+{
+    const uint32_t epoch = getTimeEpoch();
+    if (bootSpanCount == 0 || bootSpans[bootSpanCount - 1].offset != 0 || epoch == 0)
+    {
+        return;
+    }
+    bootSpans[bootSpanCount - 1].offset = epoch - millis() / MILLISECONDS_IN_SECOND;
+    size_t estimated = 0;
+    for (size_t i = bootSpanCount - 1; i > 0 && bootSpans[i - 1].offset == 0; --i)
+    {
+        // Загрузка закончилась не позже начала следующей
+        const uint32_t next = bootSpans[i].offset;
+        bootSpans[i - 1].offset = next > bootSpans[i - 1].lastUptime + 1 ? next - bootSpans[i - 1].lastUptime - 1 : 1;
+        ++estimated;
+    }
+    saveBootSpans();
+    logSystemSafe("Очередь отправки: время показаний до синхронизации восстановлено (оценено загрузок: %u)",
+                  static_cast<unsigned>(estimated));
+}
+
+// Время записи с номером sequence: секунды с загрузки переводятся в UNIX-время, если сдвиг загрузки известен
+void resolveTimestamp(uint32_t sequence, UplinkRecord& record)
+{
+    if (record.timestamp == 0 || record.timestamp >= NTP_TIMESTAMP_2000)
+    {
+        return;
+    }
+    for (size_t i = bootSpanCount; i > 0; --i)
+    {
+        if (bootSpans[i - 1].firstSequence <= sequence)
+        {
+            const uint32_t offset = bootSpans[i - 1].offset;
+            record.timestamp = offset != 0 ? record.timestamp + offset : 0;
+            return;
+        }
+    }
+    record.timestamp = 0;  // Загрузка старше самой старой известной
+}
+
+// Курсор не может указывать за пределы очереди; отставший от головы теряет вытесненные записи
+void clampCursors()
+{
+    const uint32_t head = headSequence.load();
+    const uint32_t tail = tailSequence.load();
+    for (auto& cursor : cursors)
+    {
+        cursor.store(std::min(std::max(cursor.load(), head), tail));
+    }
+}
+
+void removeSegment(uint32_t segment)
+{
+    PathBuffer path;
+    segmentPath(segment, path);
+    LittleFS.remove(path.data());
+}
+
+// Удаление головного сегмента; недоставленные записи из него учитываются как потерянные
+void evictHeadSegment()
+{
+    const uint32_t head = headSequence.load();
+    const uint32_t nextHead = (segmentOf(head) + 1) * SEGMENT_RECORDS;
+    uint32_t lost = 0;
+    for (auto& cursor : cursors)
+    {
+        if (cursor.load() < nextHead)
+        {
+            lost = std::max(lost, nextHead - cursor.load());
+            cursor.store(nextHead);
+        }
+    }
+    removeSegment(segmentOf(head));
+    headSequence.store(nextHead);
+    if (lost > 0)
+    {
+        droppedRecords.fetch_add(lost);
+        logWarnSafe("Очередь отправки переполнена: потеряно %lu недоставленных показаний",
+                    static_cast<unsigned long>(lost));
+    }
+}
+
+// Сегменты, которые забрали все получатели, освобождают место сразу (текущий дописываемый не трогаем)
+void releaseDeliveredSegments()
+{
+    uint32_t slowest = tailSequence.load();
+    for (const auto& cursor : cursors)
+    {
+        slowest = std::min(slowest, cursor.load());
+    }
+    while (segmentOf(headSequence.load()) < segmentOf(slowest))
+    {
+        removeSegment(segmentOf(headSequence.load()));
+        headSequence.store((segmentOf(headSequence.load()) + 1) * SEGMENT_RECORDS);
+    }
+}
+
+// Выключенный получатель ничего не ждёт: при включении он начнёт с новых показаний
+void skipDisabledSinks()
+{
+    for (size_t sink = 0; sink < cursors.size(); ++sink)
+    {
+        if (!isSinkEnabled(sink))
+        {
+            cursors[sink].store(tailSequence.load());
+        }
+    }
+}
+}  // namespace
+
+void setupUplinkQueue()
+{
+    if (!LittleFS.exists(QUEUE_DIR) && !LittleFS.mkdir(QUEUE_DIR))
+    {
+        logError("Очередь отправки: не удалось создать каталог /uplink");
+        return;
+    }
+
+    // Границы очереди восстанавливаются по именам сегментов и размеру последнего из них
+    uint32_t firstSegment = UINT32_MAX;
+    uint32_t lastSegment = 0;
+    size_t lastSegmentSize = 0;
+    File dir = LittleFS.open(QUEUE_DIR);
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile())
+    {
+        char* suffix = nullptr;
+        const auto segment = static_cast<uint32_t>(strtoul(file.name(), &suffix, 16));
+        if (suffix == nullptr || strcmp(suffix, ".seg") != 0)
+        {
+            continue;
+        }
+        firstSegment = std::min(firstSegment, segment);
+        if (segment >= lastSegment)
+        {
+            lastSegment = segment;
+            lastSegmentSize = file.size();
+        }
+    }
+    dir.close();
+
+    std::array<uint32_t, UPLINK_SINK_COUNT> saved{};
+    const bool cursorsLoaded = loadCursors(saved);
+    if (firstSegment == UINT32_MAX)
+    {
+        // Пустая очередь продолжает нумерацию с сохранённых курсоров
+        const uint32_t resume = cursorsLoaded ? *std::max_element(saved.begin(), saved.end()) : 0;
+        headSequence.store(resume);
+        tailSequence.store(resume);
+    }
+    else
+    {
+        headSequence.store(firstSegment * SEGMENT_RECORDS);
+        const bool torn = lastSegmentSize % UPLINK_RECORD_SIZE != 0;
+        tailSequence.store(torn ? (lastSegment + 1) * SEGMENT_RECORDS
+                                : lastSegment * SEGMENT_RECORDS +
+                                      static_cast<uint32_t>(lastSegmentSize / UPLINK_RECORD_SIZE));
+    }
+    for (size_t sink = 0; sink < cursors.size(); ++sink)
+    {
+        // Без курсоров очередь отправляется заново целиком: лучше повтор, чем пропуск
+        cursors[sink].store(cursorsLoaded ? saved[sink] : headSequence.load());
+    }
+    clampCursors();
+    skipDisabledSinks();
+    startBootSpan();
+    for (size_t sink = 0; sink < cursors.size(); ++sink)
+    {
+        // Что было не отправлено до перезагрузки, отправляется из очереди
+        interrupted[sink] = cursors[sink].load() != tailSequence.load();
+    }
+    queueReady = true;
+
+    logSystemSafe("Очередь отправки: %lu показаний, MQTT ждёт %lu, ThingSpeak ждёт %lu",
+                  static_cast<unsigned long>(getUplinkStoredCount()),
+                  static_cast<unsigned long>(getUplinkPending(UplinkSink::MQTT)),
+                  static_cast<unsigned long>(getUplinkPending(UplinkSink::THINGSPEAK)));
+}
+
+bool isUplinkQueueReady()
+{
+    return queueReady;
+}
+
+void enqueueUplinkReading(const SensorData& reading)
+{
+    if (!queueReady)
+    {
+        return;
+    }
+
+    resolveBootSpans();
+    UplinkRecord record{};
+    const uint32_t epoch = getTimeEpoch();
+    record.timestamp = epoch != 0 ? epoch : uptimeSeconds();
+    const std::array<float, UPLINK_CHANNEL_COUNT> values = {reading.temperature, reading.humidity,
+                                                            reading.ec,          reading.ph,
+                                                            reading.nitrogen,    reading.phosphorus,
+                                                            reading.potassium};
+    for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+    {
+        record.values[channel] = quantizeUplinkValue(values[channel], channel);
+    }
+    RawRecord raw{};
+    encodeUplinkRecord(record, raw.data());
+
+    const uint32_t tail = tailSequence.load();
+    if (segmentOf(tail) != tailFileSegment)
+    {
+        closeTailFile();
+        PathBuffer path;
+        segmentPath(segmentOf(tail), path);
+        if (tailFile.open(path.data(), "a"))
+        {
+            tailFileSegment = segmentOf(tail);
+        }
+    }
+    if (tailFileSegment == UINT32_MAX || !tailFile.write(raw.data(), raw.size()))
+    {
+        abandonTailSegment();
+        return;
+    }
+    tailSequence.store(tail + 1);
+
+    skipDisabledSinks();
+    if (segmentOf(tail) - segmentOf(headSequence.load()) >= UPLINK_QUEUE_MAX_SEGMENTS)
+    {
+        evictHeadSegment();
+    }
+    releaseDeliveredSegments();
+}
+
+uint32_t getUplinkPending(UplinkSink sink)
+{
+    return tailSequence.load() - cursors[sinkIndex(sink)].load();
+}
+
+void reportUplinkFailure(UplinkSink sink)
+{
+    interrupted[sinkIndex(sink)] = true;
+}
+
+bool hasUplinkBacklog(UplinkSink sink)
+{
+    return queueReady && interrupted[sinkIndex(sink)] && getUplinkPending(sink) > 0;
+}
+
+uint32_t getUplinkCursor(UplinkSink sink)
+{
+    return cursors[sinkIndex(sink)].load();
+}
+
+void flushUplinkQueue()
+{
+    if (!tailFile.flushIfStale())
+    {
+        abandonTailSegment();
+    }
+}
+
+size_t readUplinkRecords(uint32_t& position, UplinkRecord* out, size_t capacity)
+{
+    resolveBootSpans();
+    // Показания из буфера дописываемого сегмента должны быть видны при чтении файла
+    if (tailFileSegment != UINT32_MAX && !tailFile.flush())
+    {
+        abandonTailSegment();
+    }
+    const uint32_t tail = tailSequence.load();
+    position = std::max(position, headSequence.load());
+    size_t count = 0;
+    File file;
+    uint32_t openSegment = UINT32_MAX;
+    while (position < tail && count < capacity)
+    {
+        const uint32_t segment = segmentOf(position);
+        if (segment != openSegment)
+        {
+            file.close();
+            PathBuffer path;
+            segmentPath(segment, path);
+            file = LittleFS.open(path.data(), "r");
+            openSegment = segment;
+            if (!file || !file.seek((position % SEGMENT_RECORDS) * UPLINK_RECORD_SIZE))
+            {
+                position = (segment + 1) * SEGMENT_RECORDS;
+                continue;
+            }
+        }
+
+        RawRecord raw{};
+        if (file.read(raw.data(), raw.size()) != raw.size())
+        {
+            position = (segment + 1) * SEGMENT_RECORDS;  // Сегмент закрыт оборванной записью
+            continue;
+        }
+        if (decodeUplinkRecord(raw.data(), out[count]))
+        {
+            resolveTimestamp(position, out[count]);
+            ++count;
+        }
+        ++position;
+    }
+    file.close();
+    position = std::min(position, tail);
+    return count;
+}
+
+void commitUplinkCursor(UplinkSink sink, uint32_t position)
+{
+    cursors[sinkIndex(sink)].store(position);
+    clampCursors();
+    if (getUplinkPending(sink) == 0)
+    {
+        interrupted[sinkIndex(sink)] = false;  // Догнали: дальше снова обычная публикация
+    }
+    releaseDeliveredSegments();
+    saveCursors();
+}
+
+void acknowledgeUplinkLatest(UplinkSink sink)
+{
+    if (!queueReady || interrupted[sinkIndex(sink)])
+    {
+        return;  // Последнее показание уйдёт ещё раз вместе с накопленными
+    }
+    cursors[sinkIndex(sink)].store(tailSequence.load());
+    releaseDeliveredSegments();
+    if (millis() - lastCursorSave >= UPLINK_CURSOR_SAVE_INTERVAL_MS)
+    {
+        saveCursors();
+    }
+}
+
+uint32_t getUplinkStoredCount()
+{
+    return tailSequence.load() - headSequence.load();
+}
+
+uint32_t getUplinkDroppedCount()
+{
+    return droppedRecords.load();
+}
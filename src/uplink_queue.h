@@ -0,0 +1,75 @@
+/**
+ * @file uplink_queue.h
+ * @brief Очередь показаний на флеше для MQTT и ThingSpeak (store-and-forward)
+ * @details Каждое новое показание дописывается в кольцевую очередь из файлов-сегментов LittleFS. У каждого
+ * получателя свой курсор — номер следующей недоставленной записи, поэтому MQTT и ThingSpeak догоняют
+ * пропущенное независимо. Пока связь есть, получатель публикует последнее показание со своим интервалом и
+ * сдвигает курсор в конец очереди; после неудачной отправки курсор замирает, и всё накопленное с последней
+ * доставки уходит пакетами. При переполнении удаляется самый старый сегмент, даже если его ещё не отправили.
+ * Курсоры сохраняются на флеш после пакетной отправки и не реже UPLINK_CURSOR_SAVE_INTERVAL_MS, так что после
+ * перезагрузки часть записей может уйти повторно (доставка «хотя бы один раз», метка времени у записи своя).
+ * Очередью пользуется только главный цикл; счётчики для /health можно читать из любой задачи.
+ */
+#ifndef UPLINK_QUEUE_H
+#define UPLINK_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../include/uplink_record.h"
+
+struct SensorData;
+
+enum class UplinkSink : uint8_t
+{
+    MQTT,
+    THINGSPEAK
+};
+
+constexpr size_t UPLINK_SINK_COUNT = 2;
+
+// Открыть очередь после монтирования LittleFS и загрузки конфигурации
+void setupUplinkQueue();
+
+// Очередь открыта; без неё получатели публикуют только последнее показание
+bool isUplinkQueueReady();
+
+// Дописать показание с текущим UNIX-временем (до синхронизации — с секундами от загрузки);
+// на флеш оно уходит не позже чем через FLASH_WRITE_FLUSH_MS
+void enqueueUplinkReading(const SensorData& reading);
+
+// Сбросить на флеш показания, которые лежат в буфере дольше FLASH_WRITE_FLUSH_MS (вызывать в loop)
+void flushUplinkQueue();
+
+// Записей, которые получатель ещё не забрал
+uint32_t getUplinkPending(UplinkSink sink);
+
+// Отправка не удалась: показания с последней доставки будут догоняться из очереди
+void reportUplinkFailure(UplinkSink sink);
+
+// Был перерыв связи и очередь ещё не догнана
+bool hasUplinkBacklog(UplinkSink sink);
+
+// Номер следующей записи для получателя
+uint32_t getUplinkCursor(UplinkSink sink);
+
+/**
+ * @brief Прочитать до capacity записей, начиная с position
+ * @details Повреждённые записи и пропавшие сегменты пропускаются; position сдвигается за последнюю
+ * просмотренную запись и передаётся в commitUplinkCursor() после успешной отправки. Время записей, сделанных
+ * до синхронизации, пересчитывается в UNIX-время; пока пересчитать нельзя, у них timestamp 0.
+ * @return Количество прочитанных записей
+ */
+size_t readUplinkRecords(uint32_t& position, UplinkRecord* out, size_t capacity);
+
+// Записи до position доставлены получателю
+void commitUplinkCursor(UplinkSink sink, uint32_t position);
+
+// Последнее показание отправлено напрямую; без перерыва связи промежуточные показания пропущены намеренно
+// (интервал публикации), и курсор сдвигается в конец очереди. Во время догоняния курсор не трогается
+void acknowledgeUplinkLatest(UplinkSink sink);
+
+// Записей в очереди и записей, вытесненных до доставки хотя бы одному получателю
+uint32_t getUplinkStoredCount();
+uint32_t getUplinkDroppedCount();
+
+#endif  // UPLINK_QUEUE_H
@@ -0,0 +1,88 @@
+/**
+ * @file chunked_page_writer.cpp
+ * @brief Потоковая отдача HTML-страниц чанками фиксированного размера
+ */
+
+#include "../../include/web/chunked_page_writer.h"
+#include <cstring>
+
+ChunkedPageWriter::ChunkedPageWriter(WebServer& server, int statusCode, const char* contentType) : server(server)
+{
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(statusCode, contentType, "");
+}
+
+ChunkedPageWriter::~ChunkedPageWriter()
+{
+    end();
+}
+
+ChunkedPageWriter& ChunkedPageWriter::operator+=(const char* text)
+{
+    if (text != nullptr)
+    {
+        write(text, strlen(text));
+    }
+    return *this;
+}
+
+ChunkedPageWriter& ChunkedPageWriter::operator+=(const __FlashStringHelper* text)
+{
+    // На ESP32 флеш отображён в адресное пространство, строку можно читать напрямую
+    return *this += reinterpret_cast<const char*>(text);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+ChunkedPageWriter& ChunkedPageWriter::operator+=(const String& text)
+{
+    write(text.c_str(), text.length());
+    return *this;
+}
+
+ChunkedPageWriter& ChunkedPageWriter::operator+=(char symbol)
+{
+    write(&symbol, 1);
+    return *this;
+}
+
+void ChunkedPageWriter::write(const char* data, size_t length)
+{
+    if (finished || length == 0)
+    {
+        return;
+    }
+
+    // Крупный фрагмент (CSS, шаблон) уходит отдельным чанком без копирования в буфер
+    if (length >= buffer.size())
+    {
+        flush();
+        server.sendContent(data, length);
+        return;
+    }
+
+    if (used + length > buffer.size())
+    {
+        flush();
+    }
+    memcpy(buffer.data() + used, data, length);
+    used += length;
+}
+
+void ChunkedPageWriter::flush()
+{
+    if (used > 0)
+    {
+        server.sendContent(buffer.data(), used);
+        used = 0;
+    }
+}
+
+void ChunkedPageWriter::end()
+{
+    if (finished)
+    {
+        return;
+    }
+    flush();
+    server.sendContent("");  // Пустой чанк — конец ответа
+    finished = true;
+}
@@ -117,8 +117,7 @@ void setupErrorHandlers()
 
             logWarnSafe("\1", method.c_str(), uri.c_str());
 
-            const String html = generateErrorPage(404, "Страница не найдена");
-            webServer.send(404, "text/html; charset=utf-8", html);
+            sendErrorPage(404, "Страница не найдена");
         });
 
     // Общий обработчик ошибок для внутренних ошибок сервера
@@ -199,8 +198,7 @@ void handleUploadError(const String& error)
 {
     logErrorSafe("\1", error.c_str());
 
-    const String html = generateErrorPage(400, "Ошибка загрузки файла: " + error);
-    webServer.send(400, "text/html; charset=utf-8", html);
+    sendErrorPage(400, "Ошибка загрузки файла: " + error);
 }
 }  // namespace
 
@@ -254,8 +252,7 @@ void handleCriticalError(
 {
     logErrorSafe("\1", error.c_str());
 
-    const String html = generateErrorPage(500, "Внутренняя ошибка сервера: " + error);
-    webServer.send(500, "text/html; charset=utf-8", html);
+    sendErrorPage(500, "Внутренняя ошибка сервера: " + error);
 }
 
 /**
@@ -285,8 +282,7 @@ bool checkRouteAccess(const String& routeName, const String& icon)  // NOLINT(bu
 {
     if (!isRouteAvailable(webServer.uri()))
     {
-        const String html = generateApModeUnavailablePage(routeName, icon);
-        webServer.send(403, "text/html; charset=utf-8", html);
+        sendApModeUnavailablePage(403, routeName, icon);
         return false;
     }
     return true;
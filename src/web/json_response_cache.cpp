@@ -0,0 +1,98 @@
+/**
+ * @file json_response_cache.cpp
+ * @brief Кэш JSON-ответов API с ETag по версии показаний и конфигурации
+ * @details Кэш общий для всех маршрутов и используется только из задачи веб-сервера.
+ * В ETag входит случайное число загрузки: версии показаний и конфигурации после перезагрузки начинаются заново.
+ */
+
+#include "../../include/web/json_response_cache.h"
+#include <esp_random.h>
+#include <array>
+#include "../../include/jxct_config_vars.h"
+#include "../../include/jxct_constants.h"
+#include "../../include/web_routes.h"
+
+namespace
+{
+ResponseCache<WEB_RESPONSE_CACHE_SLOTS, WEB_RESPONSE_CACHE_BODY_SIZE> responseCache;
+
+// Выбирается при первом ответе: к этому времени WiFi включён и esp_random() даёт аппаратно случайное число
+uint32_t bootNonce()
+{
+    static const uint32_t nonce = esp_random();
+    return nonce;
+}
+
+// Клиент обязан перепроверять ответ: данные меняются с каждым опросом датчика
+void sendValidators(const char* etag)
+{
+    webServer.sendHeader("ETag", etag);
+    webServer.sendHeader("Cache-Control", "no-cache");
+}
+}  // namespace
+
+ResponseTag makeResponseTag(CachedRoute route, uint8_t variant, uint32_t generation, unsigned long epochPeriod)
+{
+    ResponseTag tag{};
+    tag.route = (static_cast<uint32_t>(route) << 8) | variant;
+    tag.generation = generation;
+    tag.config = getConfigVersion();
+    tag.epoch = epochPeriod > 0 ? static_cast<uint32_t>(millis() / epochPeriod) : 0;
+    tag.boot = bootNonce();
+    return tag;
+}
+
+bool sendCachedJson(const ResponseTag& tag)
+{
+    std::array<char, RESPONSE_ETAG_SIZE> etag{};
+    formatResponseETag(tag, etag.data());
+    if (webServer.hasHeader("If-None-Match") &&
+        responseETagMatches(webServer.header("If-None-Match").c_str(), etag.data()))
+    {
+        sendValidators(etag.data());
+        webServer.send(HTTP_NOT_MODIFIED);
+        return true;
+    }
+
+    const auto* entry = responseCache.find(tag);
+    if (entry == nullptr)
+    {
+        return false;
+    }
+    sendValidators(entry->etag.data());
+    webServer.send_P(HTTP_OK, HTTP_CONTENT_TYPE_JSON, entry->body.data(), entry->length);
+    return true;
+}
+
+void sendJsonAndCache(const ResponseTag& tag, const char* body, size_t length)
+{
+    std::array<char, RESPONSE_ETAG_SIZE> etag{};
+    formatResponseETag(tag, etag.data());
+    if (responseCache.store(tag, body, length) == nullptr)
+    {
+        logWarnSafe("Ответ %u байт не помещается в кэш (%u)", static_cast<unsigned>(length),
+                    static_cast<unsigned>(WEB_RESPONSE_CACHE_BODY_SIZE));
+    }
+    sendValidators(etag.data());
+    webServer.send_P(HTTP_OK, HTTP_CONTENT_TYPE_JSON, body, length);
+}
+
+void sendJsonAndCache(const ResponseTag& tag, const JsonDocument& doc)
+{
+    std::array<char, WEB_RESPONSE_CACHE_BODY_SIZE> buffer;
+    const size_t length = measureJson(doc);
+    if (length < buffer.size())
+    {
+        serializeJson(doc, buffer.data(), buffer.size());
+        sendJsonAndCache(tag, buffer.data(), length);
+        return;
+    }
+
+    // Не помещается в запись кэша — отдаём как раньше, ETag остаётся верным для следующего If-None-Match
+    String json;
+    serializeJson(doc, json);
+    std::array<char, RESPONSE_ETAG_SIZE> etag{};
+    formatResponseETag(tag, etag.data());
+    sendValidators(etag.data());
+    webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_JSON, json);
+}
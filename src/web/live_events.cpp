@@ -0,0 +1,319 @@
+/**
+ * @file live_events.cpp
+ * @brief Рассылка изменений показаний и статусов подписчикам Server-Sent Events
+ * @details Синхронный WebServer не держит долгие ответы, поэтому обработчик подписки отправляет заголовки
+ * сам и сохраняет копию сокета клиента: соединение остаётся открытым, пока жива копия. Каждый подписчик
+ * хранит последний отправленный объект, и следующее событие содержит только отличающиеся от него поля.
+ * Запись в сокет идёт только когда он готов её принять: медленный клиент пропускает события (следующее
+ * содержит все накопившиеся изменения) и отключается, если не принимает данные LIVE_EVENTS_STALL_MS.
+ */
+
+#include "../../include/web/live_events.h"
+#include <WiFi.h>
+#include <lwip/sockets.h>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include "../../include/json_delta.h"
+#include "../../include/json_writer.h"
+#include "../../include/jxct_config_vars.h"
+#include "../../include/jxct_constants.h"
+#include "../../include/logger.h"
+#include "../../include/web_routes.h"
+#include "../modbus_sensor.h"
+#include "../sensor_bus.h"
+
+namespace
+{
+using LiveBuffer = std::array<char, SENSOR_JSON_BUFFER_SIZE>;
+
+enum class LiveStream : uint8_t
+{
+    READINGS,
+    STATUS
+};
+
+struct LiveSubscriber
+{
+    WiFiClient client;
+    LiveStream stream;
+    uint8_t probe;
+    bool active;
+    unsigned long lastWrite;
+    LiveBuffer snapshot;  // Последний отправленный объект целиком
+    size_t snapshotLength;
+};
+
+static_assert(CONFIG_BUS_PROBES_MAX <= 32, "pendingProbes — битовая маска датчиков шины");
+
+std::array<LiveSubscriber, LIVE_EVENTS_MAX_CLIENTS> subscribers = {};
+std::atomic<uint32_t> pendingProbes{0};  // Датчики с новой публикацией; выставляет задача опроса
+unsigned long lastStatusCheck = 0;
+
+void dropSubscriber(LiveSubscriber& subscriber)
+{
+    subscriber.client.stop();
+    subscriber.active = false;
+    subscriber.snapshotLength = 0;
+}
+
+// lwIP отмечает сокет готовым к записи, когда в буфере отправки свободно не меньше TCP_SNDLOWAT байт
+// (несколько килобайт) — этого хватает на событие, и write() не ждёт подтверждений от клиента
+bool socketWritable(WiFiClient& client)
+{
+    const int socket = client.fd();
+    if (socket < 0)
+    {
+        return false;
+    }
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(socket, &writeSet);
+    timeval noWait = {0, 0};
+    return select(socket + 1, nullptr, &writeSet, nullptr, &noWait) > 0;
+}
+
+// Блокирующая запись задержала бы весь веб-сервер: неготовый сокет пропускает событие
+bool writeToSubscriber(LiveSubscriber& subscriber, const char* data, size_t length)
+{
+    if (!socketWritable(subscriber.client))
+    {
+        if (millis() - subscriber.lastWrite >= LIVE_EVENTS_STALL_MS)
+        {
+            logDebug("Подписчик потока событий не принимает данные, отключаем");
+            dropSubscriber(subscriber);
+        }
+        return false;
+    }
+    if (subscriber.client.write(reinterpret_cast<const uint8_t*>(data), length) != length)  // NOLINT
+    {
+        logDebug("Подписчик потока событий отключился");
+        dropSubscriber(subscriber);
+        return false;
+    }
+    subscriber.lastWrite = millis();
+    return true;
+}
+
+// Событие с полями current, отличающимися от снимка подписчика; после отправки снимок обновляется
+void sendDelta(LiveSubscriber& subscriber, const char* eventName, const char* current, size_t length)
+{
+    std::array<char, SENSOR_JSON_BUFFER_SIZE + 32> event;
+    const auto prefix = static_cast<size_t>(snprintf(event.data(), event.size(), "event: %s\ndata: ", eventName));
+    JsonWriter json(event.data() + prefix, event.size() - prefix - 2);  // Место под завершающий "\n\n"
+    json.beginObject();
+    const size_t changed =
+        writeJsonDelta(json, subscriber.snapshot.data(), subscriber.snapshotLength, current, length);
+    json.endObject();
+    if (changed == 0 || json.overflowed() || length > subscriber.snapshot.size())
+    {
+        return;
+    }
+
+    size_t total = prefix + json.size();
+    event[total++] = '\n';
+    event[total++] = '\n';
+    if (writeToSubscriber(subscriber, event.data(), total))
+    {
+        memcpy(subscriber.snapshot.data(), current, length);
+        subscriber.snapshotLength = length;
+    }
+}
+
+bool isSubscribed(const LiveSubscriber& subscriber, LiveStream stream, uint8_t probe)
+{
+    return subscriber.active && subscriber.stream == stream &&
+           (stream != LiveStream::READINGS || subscriber.probe == probe);
+}
+
+// Показания датчика строятся один раз на рассылку; target — только одному (новому) подписчику
+void publishReadings(uint8_t probe, LiveSubscriber* target = nullptr)
+{
+    bool subscribed = false;
+    for (const LiveSubscriber& subscriber : subscribers)
+    {
+        subscribed = subscribed || isSubscribed(subscriber, LiveStream::READINGS, probe);
+    }
+    if (!subscribed)
+    {
+        return;
+    }
+
+    SensorData data{};
+    const uint32_t version = getSensorBusProbeReading(probe, data);
+    LiveBuffer current;
+    const size_t length = renderSensorJson(probe, data, version, current.data(), current.size());
+    if (length == 0)
+    {
+        return;
+    }
+    for (LiveSubscriber& subscriber : subscribers)
+    {
+        if (isSubscribed(subscriber, LiveStream::READINGS, probe) && (target == nullptr || target == &subscriber))
+        {
+            sendDelta(subscriber, "reading", current.data(), length);
+        }
+    }
+}
+
+void publishStatus(LiveSubscriber* target = nullptr)
+{
+    bool subscribed = false;
+    for (const LiveSubscriber& subscriber : subscribers)
+    {
+        subscribed = subscribed || isSubscribed(subscriber, LiveStream::STATUS, 0);
+    }
+    if (!subscribed)
+    {
+        return;
+    }
+
+    LiveBuffer current;
+    const size_t length = renderServiceStatusJson(current.data(), current.size());
+    if (length == 0)
+    {
+        return;
+    }
+    for (LiveSubscriber& subscriber : subscribers)
+    {
+        if (isSubscribed(subscriber, LiveStream::STATUS, 0) && (target == nullptr || target == &subscriber))
+        {
+            sendDelta(subscriber, "status", current.data(), length);
+        }
+    }
+}
+
+// Свободный слот; слоты отключившихся клиентов освобождаются здесь же
+LiveSubscriber* findFreeSlot()
+{
+    for (LiveSubscriber& subscriber : subscribers)
+    {
+        if (subscriber.active && !subscriber.client.connected())
+        {
+            dropSubscriber(subscriber);
+        }
+        if (!subscriber.active)
+        {
+            return &subscriber;
+        }
+    }
+    return nullptr;
+}
+
+void subscribe(LiveStream stream)
+{
+    logWebRequest("GET", webServer.uri(), webServer.client().remoteIP().toString());
+    if (currentWiFiMode != WiFiMode::STA)
+    {
+        webServer.send(HTTP_FORBIDDEN, HTTP_CONTENT_TYPE_JSON, R"({"error":"AP mode"})");
+        return;
+    }
+
+    uint8_t probe = 0;
+    if (stream == LiveStream::READINGS && webServer.hasArg("probe"))
+    {
+        const long requested = webServer.arg("probe").toInt();
+        if (requested < 0 || requested >= getSensorBusProbeCount())
+        {
+            webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_JSON, R"({"error":"probe out of range"})");
+            return;
+        }
+        probe = static_cast<uint8_t>(requested);
+    }
+
+    LiveSubscriber* subscriber = findFreeSlot();
+    if (subscriber == nullptr)
+    {
+        // EventSource закроется, и страница вернётся к периодическим запросам
+        webServer.send(HTTP_SERVICE_UNAVAILABLE, HTTP_CONTENT_TYPE_JSON, R"({"error":"too many subscribers"})");
+        return;
+    }
+
+    subscriber->client = webServer.client();
+    subscriber->stream = stream;
+    subscriber->probe = probe;
+    subscriber->active = true;
+    subscriber->lastWrite = millis();
+    subscriber->snapshotLength = 0;
+
+    std::array<char, 160> headers;
+    const int length = snprintf(headers.data(), headers.size(),
+                                "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n"
+                                "Connection: keep-alive\r\n\r\nretry: %lu\n\n",
+                                LIVE_EVENTS_RETRY_MS);
+    if (!writeToSubscriber(*subscriber, headers.data(), static_cast<size_t>(length)))
+    {
+        return;
+    }
+
+    // Снимок нового подписчика пуст, поэтому первое событие содержит объект целиком
+    if (stream == LiveStream::READINGS)
+    {
+        publishReadings(probe, subscriber);
+    }
+    else
+    {
+        publishStatus(subscriber);
+    }
+}
+}  // namespace
+
+void notifyLiveReading(uint8_t probeIndex)
+{
+    if (probeIndex < CONFIG_BUS_PROBES_MAX)
+    {
+        pendingProbes.fetch_or(1U << probeIndex, std::memory_order_release);
+    }
+}
+
+void serviceLiveEvents()
+{
+    const uint32_t pending = pendingProbes.exchange(0, std::memory_order_acquire);
+    bool anyActive = false;
+    for (const LiveSubscriber& subscriber : subscribers)
+    {
+        anyActive = anyActive || subscriber.active;
+    }
+    if (!anyActive)
+    {
+        return;
+    }
+
+    for (uint8_t probe = 0; probe < CONFIG_BUS_PROBES_MAX; ++probe)
+    {
+        if ((pending & (1U << probe)) != 0)
+        {
+            publishReadings(probe);
+        }
+    }
+
+    // Статусы сервисов не привязаны к опросу датчика: проверяются с периодом обновления веб-интерфейса
+    const unsigned long now = millis();
+    if (now - lastStatusCheck >= config.webUpdateInterval)
+    {
+        lastStatusCheck = now;
+        publishStatus();
+    }
+
+    // Пинг не даёт промежуточным узлам закрыть молчащее соединение и выявляет ушедших клиентов
+    for (LiveSubscriber& subscriber : subscribers)
+    {
+        if (subscriber.active && now - subscriber.lastWrite >= LIVE_EVENTS_KEEPALIVE_MS)
+        {
+            if (!subscriber.client.connected())
+            {
+                dropSubscriber(subscriber);
+                continue;
+            }
+            writeToSubscriber(subscriber, ":\n\n", 3);
+        }
+    }
+}
+
+void setupLiveEventRoutes()
+{
+    webServer.on("/events/readings", HTTP_GET, []() { subscribe(LiveStream::READINGS); });
+    webServer.on("/events/status", HTTP_GET, []() { subscribe(LiveStream::STATUS); });
+    logDebug("Маршруты потоков событий настроены: /events/readings, /events/status");
+}
@@ -5,6 +5,9 @@
  */
 
 #include <ArduinoJson.h>
+#include <optional>
+#include "../../include/calibration_manager.h"
+#include "../../include/config_schema.h"
 #include "../../include/jxct_config_vars.h"
 #include "../../include/jxct_constants.h"
 #include "../../include/jxct_device_info.h"
@@ -20,6 +23,123 @@ namespace
 {
 String importedJson;
 
+// Поле таблицы в экспорт; поля без группы в JSON не попадают
+template <typename T>
+void exportConfigValue(JsonDocument& root, const char* group, const char* name, T value)
+{
+    if (group != nullptr)
+    {
+        root[group][name] = value;
+    }
+}
+
+// Строковое поле в экспорт; секрет заменяется заглушкой
+void exportConfigString(JsonDocument& root, const char* group, const char* name, const char* placeholder,
+                        const char* value)
+{
+    exportConfigValue(root, group, name, placeholder != nullptr ? placeholder : value);
+}
+
+// Значение поля из импортируемого JSON; false — значение есть, но не того типа или вне [low, high]
+template <ConfigKind Kind>
+bool importConfigValue(JsonVariantConst value, double low, double high, typename ConfigField<Kind>::Type& target)
+{
+    if (value.isNull())
+    {
+        return true;
+    }
+    if constexpr (Kind == ConfigKind::FLAG)
+    {
+        if (!value.is<bool>())
+        {
+            return false;
+        }
+        target = value.as<bool>();
+    }
+    else
+    {
+        // Диапазон проверяется до приведения к типу поля, иначе 300 для uint8_t превратилось бы в 44
+        if (!value.is<double>() || value.as<double>() < low || value.as<double>() > high)
+        {
+            return false;
+        }
+        target = static_cast<typename ConfigField<Kind>::Type>(value.as<double>());
+    }
+    return true;
+}
+
+// Строка из импортируемого JSON; заглушка секрета из экспорта оставляет текущее значение
+bool importConfigString(JsonVariantConst value, const char* placeholder, char* target, size_t size)
+{
+    if (value.isNull())
+    {
+        return true;
+    }
+    const char* text = value.as<const char*>();
+    if (text == nullptr || strlen(text) >= size)
+    {
+        return false;
+    }
+    if (placeholder == nullptr || strcmp(text, placeholder) != 0)
+    {
+        strlcpy(target, text, size);
+    }
+    return true;
+}
+
+// Поле импорта по группе и имени из таблицы; поля без группы не импортируются
+JsonVariantConst importedField(JsonObjectConst root, const char* group, const char* name)
+{
+    if (group == nullptr)
+    {
+        return JsonVariantConst();
+    }
+    return root[group][name];
+}
+
+/**
+ * @brief Применить импортируемый JSON к копии настроек
+ * @return nullptr — всё применено, иначе ключ NVS первого поля с неверным типом или значением вне диапазона;
+ * target тогда заполнен частично и применять его нельзя
+ */
+const char* importConfig(JsonObjectConst root, Config& target)
+{
+#define CONFIG_IMPORT_VALUE(kind, member, key, fallback, low, high, group, name)                                       \
+    {                                                                                                                  \
+        auto value = static_cast<ConfigField<ConfigKind::kind>::Type>(target.member);                                  \
+        if (!importConfigValue<ConfigKind::kind>(importedField(root, group, name), low, high, value))                  \
+        {                                                                                                              \
+            return key;                                                                                                \
+        }                                                                                                              \
+        target.member = value;                                                                                         \
+    }
+#define CONFIG_IMPORT_STRING(member, key, fallback, group, name, placeholder)                                          \
+    if (!importConfigString(importedField(root, group, name), placeholder, target.member, sizeof(target.member)))      \
+    {                                                                                                                  \
+        return key;                                                                                                    \
+    }
+    CONFIG_VALUE_FIELDS(CONFIG_IMPORT_VALUE)
+    CONFIG_STRING_FIELDS(CONFIG_IMPORT_STRING)
+#undef CONFIG_IMPORT_VALUE
+#undef CONFIG_IMPORT_STRING
+
+    JsonVariantConst payloadFormat = root["mqtt"]["payload_format"];
+    if (!payloadFormat.isNull())
+    {
+        target.mqttPayloadFormat = strcmp(payloadFormat | "json", "binary") == 0 ? 1 : 0;
+    }
+    if (root["filters"]["stage_order"].is<JsonArrayConst>())
+    {
+        // Порядок стадий фильтров по каналам; отсутствующие элементы — порядок по умолчанию
+        JsonArrayConst stageOrder = root["filters"]["stage_order"];
+        for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; ++i)
+        {
+            target.filterStageOrder[i] = stageOrder[i] | 0U;
+        }
+    }
+    return nullptr;
+}
+
 void sendConfigExportJson()
 {
     logWebRequest("GET", webServer.uri(), webServer.client().remoteIP().toString());
@@ -32,48 +152,21 @@ void sendConfigExportJson()
 
     StaticJsonDocument<CONFIG_JSON_ROOT_SIZE> root;
 
-    // MQTT
-    JsonObject mqtt = root.createNestedObject("mqtt");
-    mqtt["enabled"] = (bool)config.flags.mqttEnabled;  // NOLINT(readability-misplaced-array-index)
-    mqtt["server"] = "YOUR_MQTT_SERVER_HERE";          // NOLINT(readability-misplaced-array-index)
-    mqtt["port"] = config.mqttPort;                    // NOLINT(readability-misplaced-array-index)
-    mqtt["user"] = "YOUR_MQTT_USER_HERE";              // NOLINT(readability-misplaced-array-index)
-    mqtt["password"] = "YOUR_MQTT_PASSWORD_HERE";      // NOLINT(readability-misplaced-array-index)
-
-    // ThingSpeak
-    JsonObject thingSpeakJson = root.createNestedObject("thingspeak");
-    thingSpeakJson["enabled"] = (bool)config.flags.thingSpeakEnabled;  // NOLINT(readability-misplaced-array-index)
-    thingSpeakJson["channel_id"] = "YOUR_CHANNEL_ID_HERE";             // NOLINT(readability-misplaced-array-index)
-    thingSpeakJson["api_key"] = "YOUR_API_KEY_HERE";                   // NOLINT(readability-misplaced-array-index)
-
-    // Intervals
-    JsonObject intervals = root.createNestedObject("intervals");
-    intervals["sensor_read"] = config.sensorReadInterval;    // NOLINT(readability-misplaced-array-index)
-    intervals["mqtt_publish"] = config.mqttPublishInterval;  // NOLINT(readability-misplaced-array-index)
-    intervals["thingspeak"] = config.thingSpeakInterval;     // NOLINT(readability-misplaced-array-index)
-    intervals["web_update"] = config.webUpdateInterval;      // NOLINT(readability-misplaced-array-index)
-
-    // Filters
-    JsonObject filters = root.createNestedObject("filters");
-    filters["delta_temperature"] = config.deltaTemperature;           // NOLINT(readability-misplaced-array-index)
-    filters["delta_humidity"] = config.deltaHumidity;                 // NOLINT(readability-misplaced-array-index)
-    filters["delta_ph"] = config.deltaPh;                             // NOLINT(readability-misplaced-array-index)
-    filters["delta_ec"] = config.deltaEc;                             // NOLINT(readability-misplaced-array-index)
-    filters["delta_npk"] = config.deltaNpk;                           // NOLINT(readability-misplaced-array-index)
-    filters["moving_average_window"] = config.movingAverageWindow;    // NOLINT(readability-misplaced-array-index)
-    filters["force_publish_cycles"] = config.forcePublishCycles;      // NOLINT(readability-misplaced-array-index)
-    filters["filter_algorithm"] = config.filterAlgorithm;             // NOLINT(readability-misplaced-array-index)
-    filters["outlier_filter_enabled"] = config.outlierFilterEnabled;  // NOLINT(readability-misplaced-array-index)
-    filters["adaptive_filtering"] = config.adaptiveFiltering;         // NOLINT(readability-misplaced-array-index)
-    filters["kalman_enabled"] = config.kalmanEnabled;                 // NOLINT(readability-misplaced-array-index)
-    filters["exponential_alpha"] = config.exponentialAlpha;           // NOLINT(readability-misplaced-array-index)
-    filters["outlier_threshold"] = config.outlierThreshold;           // NOLINT(readability-misplaced-array-index)
-
-    // Device flags
-    JsonObject device = root.createNestedObject("device");
-    device["use_real_sensor"] = (bool)config.flags.useRealSensor;  // NOLINT(readability-misplaced-array-index)
-    device["hass_enabled"] = (bool)config.flags.hassEnabled;       // NOLINT(readability-misplaced-array-index)
-
+#define CONFIG_EXPORT_VALUE(kind, member, key, fallback, low, high, group, name)                                       \
+    exportConfigValue(root, group, name, static_cast<ConfigField<ConfigKind::kind>::Type>(config.member));
+#define CONFIG_EXPORT_STRING(member, key, fallback, group, name, placeholder)                                          \
+    exportConfigString(root, group, name, placeholder, config.member);
+    CONFIG_VALUE_FIELDS(CONFIG_EXPORT_VALUE)
+    CONFIG_STRING_FIELDS(CONFIG_EXPORT_STRING)
+#undef CONFIG_EXPORT_VALUE
+#undef CONFIG_EXPORT_STRING
+
+    root["mqtt"]["payload_format"] = config.mqttPayloadFormat == 1 ? "binary" : "json";  // NOLINT
+    JsonArray stageOrder = root["filters"].createNestedArray("stage_order");  // Полубайты FilterStage по каналам
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; ++i)
+    {
+        stageOrder.add(config.filterStageOrder[i]);
+    }
     root["export_timestamp"] = millis();  // NOLINT(readability-misplaced-array-index)
 
     String json;
@@ -96,12 +189,12 @@ void setupConfigRoutes()
 
             if (currentWiFiMode == WiFiMode::AP)
             {
-                webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_HTML,
-                               generateApModeUnavailablePage("Интервалы", UI_ICON_INTERVALS));
+                sendApModeUnavailablePage(HTTP_OK, "Интервалы", UI_ICON_INTERVALS);
                 return;
             }
 
-            String html = generatePageHeader("Интервалы и фильтры", UI_ICON_INTERVALS);
+            ChunkedPageWriter html(webServer, HTTP_OK);
+            streamPageHeader(html, "Интервалы и фильтры", UI_ICON_INTERVALS);
             html += navHtml();
             html += "<h1>" UI_ICON_INTERVALS " Настройка интервалов и фильтров</h1>";
             html += "<form action='/save_intervals' method='post'>";
@@ -280,9 +373,7 @@ void setupConfigRoutes()
             html += "});";
             html += "</script>";
 
-            html += generatePageFooter();
-
-            webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_HTML, html);
+            streamPageFooter(html);
         });
 
     // Обработчик сохранения настроек интервалов
@@ -295,9 +386,7 @@ void setupConfigRoutes()
                      if (!checkCSRFSafety())
                      {
                          logWarnSafe("\1", webServer.client().remoteIP().toString().c_str());
-                         const String html =
-                             generateErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
-                         webServer.send(HTTP_FORBIDDEN, HTTP_CONTENT_TYPE_HTML, html);
+                         sendErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
                          return;
                      }
 
@@ -332,12 +421,14 @@ void setupConfigRoutes()
                          {
                              errorMessage += valTs.message;
                          }
-                         const String html = generateErrorPage(HTTP_BAD_REQUEST, errorMessage);
-                         webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_HTML, html);
+                         sendErrorPage(HTTP_BAD_REQUEST, errorMessage);
                          return;
                      }
 
                      // ======= СОХРАНЯЕМ НАСТРОЙКИ =======
+                     // Другие задачи не видят интервалы и пороги наполовину изменёнными
+                     std::optional<ConfigLock> settingsLock;
+                     settingsLock.emplace();
                      config.sensorReadInterval = sensorMs;
                      config.mqttPublishInterval = mqttMs;
                      config.thingSpeakInterval = tsMs;
@@ -363,14 +454,15 @@ void setupConfigRoutes()
                      config.exponentialAlpha = webServer.arg("exp_alpha").toFloat();
                      config.outlierThreshold = webServer.arg("outlier_threshold").toFloat();
 
-                     // Сохраняем в NVS
+                     // Сохраняем в NVS уже без замка: saveConfig() копирует config сама
+                     settingsLock.reset();
                      saveConfig();
 
                      String html =
                          "<!DOCTYPE html><html><head><meta charset='UTF-8'><meta http-equiv='refresh' "
                          "content='3;url=/intervals'>";
                      html += "<title>" UI_ICON_SUCCESS " Настройки сохранены</title>";
-                     html += "<style>" + String(getUnifiedCSS()) + "</style></head><body><div class='container'>";
+                     html += String(getStylesheetLinkHTML()) + "</head><body><div class='container'>";
                      html += "<h1>" UI_ICON_SUCCESS " Настройки интервалов сохранены!</h1>";
                      html += "<div class='msg msg-success'>" UI_ICON_SUCCESS " Новые настройки вступили в силу</div>";
                      html += "<p><strong>Текущие интервалы:</strong><br>";
@@ -395,6 +487,8 @@ void setupConfigRoutes()
                      }
 
                      // Сбрасываем к умолчанию (МИНИМАЛЬНАЯ ФИЛЬТРАЦИЯ + ЧАСТЫЙ MQTT)
+                     std::optional<ConfigLock> settingsLock;
+                     settingsLock.emplace();
                      config.sensorReadInterval = SENSOR_READ_INTERVAL;
                      config.mqttPublishInterval = MQTT_PUBLISH_INTERVAL;
                      config.thingSpeakInterval = THINGSPEAK_INTERVAL;
@@ -412,13 +506,14 @@ void setupConfigRoutes()
                      config.exponentialAlpha = 0.3F;                    // по умолчанию
                      config.outlierThreshold = 2.0F;                    // по умолчанию
 
+                     settingsLock.reset();
                      saveConfig();
 
                      String html =
                          "<!DOCTYPE html><html><head><meta charset='UTF-8'><meta http-equiv='refresh' "
                          "content='2;url=/intervals'>";
                      html += "<title>" UI_ICON_RESET " Сброс настроек</title>";
-                     html += "<style>" + String(getUnifiedCSS()) + "</style></head><body><div class='container'>";
+                     html += String(getStylesheetLinkHTML()) + "</head><body><div class='container'>";
                      html += "<h1>" UI_ICON_RESET " Настройки сброшены</h1>";
                      html += "<div class='msg msg-success'>" UI_ICON_SUCCESS
                              " Настройки интервалов возвращены к значениям по умолчанию</div>";
@@ -437,7 +532,7 @@ void setupConfigRoutes()
                      {
                          String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>" UI_ICON_FOLDER
                                        " Конфигурация</title>";
-                         html += "<style>" + String(getUnifiedCSS()) + "</style></head><body><div class='container'>";
+                         html += String(getStylesheetLinkHTML()) + "</head><body><div class='container'>";
                          html += "<h1>" UI_ICON_FOLDER " Конфигурация</h1>";
                          html += "<div class='msg msg-error'>" UI_ICON_ERROR
                                  " Недоступно в режиме точки доступа</div></div></body></html>";
@@ -449,7 +544,7 @@ void setupConfigRoutes()
                          "<!DOCTYPE html><html><head><meta charset='UTF-8'><meta name='viewport' "
                          "content='width=device-width, initial-scale=1.0'>";
                      html += "<title>" UI_ICON_FOLDER " Управление конфигурацией JXCT</title>";
-                     html += "<style>" + String(getUnifiedCSS()) + "</style></head><body><div class='container'>";
+                     html += String(getStylesheetLinkHTML()) + "</head><body><div class='container'>";
                      html += navHtml();
                      html += "<h1>" UI_ICON_FOLDER " Управление конфигурацией</h1>";
 
@@ -516,25 +611,29 @@ void setupConfigRoutes()
                 return;
             }
 
-            // --- Применяем конфигурацию --- (минимальный набор, расширяйте по необходимости)
-            if (doc.containsKey("wifi"))
+            // Настройки применяются только целиком: сначала к копии, при ошибке конфигурация не меняется.
+            // Копия статическая — стек задачи веб-сервера уже занят документом JSON
+            static Config imported;
+            {
+                const ConfigLock settingsLock;
+                imported = config;
+            }
+            const char* invalidKey = importConfig(doc.as<JsonObjectConst>(), imported);
+            if (invalidKey != nullptr)
             {
-                JsonObject wifi = doc["wifi"];
-                strlcpy(config.ssid, wifi["ssid"].as<const char*>(), sizeof(config.ssid));
-                strlcpy(config.password, wifi["password"].as<const char*>(), sizeof(config.password));
+                const String resp = String(R"({"error":"Недопустимое значение: )") + invalidKey + "\"}";
+                webServer.send(HTTP_BAD_REQUEST, "application/json", resp);
+                importedJson = "";
+                return;
             }
-            if (doc.containsKey("mqtt"))
             {
-                JsonObject mqtt = doc["mqtt"];
-                config.flags.mqttEnabled = mqtt["enabled"].as<bool>();  // NOLINT(readability-misplaced-array-index)
-                strlcpy(config.mqttServer, mqtt["server"].as<const char*>(), sizeof(config.mqttServer));
-                config.mqttPort = mqtt["port"].as<int>();  // NOLINT(readability-misplaced-array-index)
-                strlcpy(config.mqttUser, mqtt["user"].as<const char*>(), sizeof(config.mqttUser));
-                strlcpy(config.mqttPassword, mqtt["password"].as<const char*>(), sizeof(config.mqttPassword));
+                const ConfigLock settingsLock;
+                config = imported;
             }
 
-            // Сохраняем в NVS
+            // Сохраняем в NVS; кривую калибровки перестраиваем под импортированный способ интерполяции
             saveConfig();
+            CalibrationManager::reloadTable();
             importedJson = "";
 
             // Отправляем 303 Redirect, чтобы браузер вернулся к менеджеру конфигурации
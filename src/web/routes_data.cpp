@@ -6,8 +6,11 @@
 
 #include <ArduinoJson.h>
 #include <LittleFS.h>
-#include <NTPClient.h>
-#include <ctime>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include "../../include/json_writer.h"
 #include "../../include/jxct_config_vars.h"
 #include "../../include/jxct_constants.h"
 #include "../../include/jxct_format_utils.h"
@@ -15,14 +18,18 @@
 #include "../../include/jxct_ui_system.h"
 #include "../../include/logger.h"
 #include "../../include/web/csrf_protection.h"  // 🔒 CSRF защита
+#include "../../include/web/json_response_cache.h"
+#include "../../include/web_assets_manifest.h"
 #include "../../include/web_routes.h"
+#include "../flash_writer.h"
+#include "../history_store.h"
 #include "../modbus_sensor.h"
+#include "../sensor_bus.h"
+#include "../time_service.h"
 #include "../wifi_manager.h"
 #include "business_services.h"
 #include "calibration_manager.h"
 
-extern NTPClient* timeClient;
-
 // Внешние зависимости (уже объявлены в заголовочных файлах)
 // extern String navHtml();  // объявлено в wifi_manager.h
 // extern String formatValue(float value, const char* unit, int precision);  // объявлено в jxct_format_utils.h
@@ -31,7 +38,7 @@ extern NTPClient* timeClient;
 // Буфер для загрузки файлов (калибровка через /readings)
 namespace
 {
-File uploadFile;
+BufferedFlashFile uploadFile;
 SoilProfile uploadProfile = SoilProfile::SAND;
 
 // Используем RecValues из бизнес-сервиса
@@ -74,9 +81,9 @@ RecValues computeRecommendations()
     // Применяем сезонную коррекцию если включена
     if (config.flags.seasonalAdjustEnabled)
     {
-        time_t now = time(nullptr);
-        struct tm* timeInfo = localtime(&now);
-        const int month = timeInfo != nullptr ? timeInfo->tm_mon + 1 : 1;
+        // До синхронизации времени месяц неизвестен — коррекция по январю, как и прежде
+        const uint8_t knownMonth = getTimeMonth();
+        const int month = knownMonth != 0 ? knownMonth : 1;
 
         // Определяем сезон
         Season season = Season::WINTER;
@@ -104,8 +111,7 @@ void handleReadingsUpload()  // ✅ Убираем static - функция exter
     {
         CalibrationManager::init();
         const char* path = CalibrationManager::profileToFilename(SoilProfile::SAND);  // custom.csv
-        uploadFile = LittleFS.open(path, "w");
-        if (!uploadFile)
+        if (!uploadFile.open(path, "w"))
         {
             logErrorSafe("\1", path);
         }
@@ -119,11 +125,12 @@ void handleReadingsUpload()  // ✅ Убираем static - функция exter
     }
     else if (upload.status == UPLOAD_FILE_END)
     {
-        if (uploadFile)
+        if (uploadFile && uploadFile.close())
         {
-            uploadFile.close();
             logSuccessSafe("\1", upload.totalSize);
         }
+        // Разбираем новую таблицу сразу, чтобы опрос датчика не читал файл
+        CalibrationManager::reloadTable();
         webServer.sendHeader("Location", "/readings?toast=Калибровка+загружена", true);
         webServer.send(HTTP_REDIRECT, "text/plain", "Redirect");
     }
@@ -159,8 +166,123 @@ void handleProfileSave()
     webServer.sendHeader("Location", "/readings?toast=Профиль+сохранен", true);
     webServer.send(HTTP_REDIRECT, "text/plain", "Redirect");
 }
+
+// Отклонения от физических пределов датчика: "T, θ, EC"
+void writeAlerts(JsonWriter& json, const SensorData& data)
+{
+    std::array<char, 32> alerts{};
+    size_t length = 0;
+    auto append = [&](const char* name)
+    {
+        const size_t needed = strlen(name) + (length > 0 ? 2 : 0);
+        if (length + needed >= alerts.size())
+        {
+            return;
+        }
+        if (length > 0)
+        {
+            memcpy(alerts.data() + length, ", ", 2);
+            length += 2;
+        }
+        memcpy(alerts.data() + length, name, strlen(name));
+        length += strlen(name);
+        alerts[length] = '\0';
+    };
+    if (data.temperature < TEMP_MIN_VALID || data.temperature > TEMP_MAX_VALID)
+    {
+        append("T");
+    }
+    if (data.humidity < HUM_MIN_VALID || data.humidity > HUM_MAX_VALID)
+    {
+        append("θ");
+    }
+    if (data.ec < 0 || data.ec > EC_MAX_VALID)
+    {
+        append("EC");
+    }
+    if (data.ph < 3 || data.ph > 9)
+    {
+        append("pH");
+    }
+    if (data.nitrogen < 0 || data.nitrogen > NPK_MAX_VALID)
+    {
+        append("N");
+    }
+    if (data.phosphorus < 0 || data.phosphorus > NPK_MAX_VALID)
+    {
+        append("P");
+    }
+    if (data.potassium < 0 || data.potassium > NPK_MAX_VALID)
+    {
+        append("K");
+    }
+    json.member("alerts", alerts.data());
+}
+
+// Значения в том же виде, что и format_*(): строки с 1 знаком (T, θ, pH) или целые (EC, NPK)
+void writeReadingFields(JsonWriter& json, const SensorData& data, uint32_t version)
+{
+    json.memberFixed("temperature", data.temperature, 1, true);
+    json.memberFixed("humidity", data.humidity, 1, true);
+    json.memberFixed("ec", data.ec, 0, true);
+    json.memberFixed("ph", data.ph, 1, true);
+    json.memberFixed("nitrogen", data.nitrogen, 0, true);
+    json.memberFixed("phosphorus", data.phosphorus, 0, true);
+    json.memberFixed("potassium", data.potassium, 0, true);
+    json.memberFixed("raw_temperature", data.raw_temperature, 1, true);
+    json.memberFixed("raw_humidity", data.raw_humidity, 1, true);
+    json.memberFixed("raw_ec", data.raw_ec, 0, true);
+    json.memberFixed("raw_ph", data.raw_ph, 1, true);
+    json.memberFixed("raw_nitrogen", data.raw_nitrogen, 0, true);
+    json.memberFixed("raw_phosphorus", data.raw_phosphorus, 0, true);
+    json.memberFixed("raw_potassium", data.raw_potassium, 0, true);
+    json.member("irrigation", data.recentIrrigation);
+    json.member("valid", data.valid);  // Флаг валидности по лимитам датчика (проверяется задачей опроса)
+    json.member("version", version);   // Номер публикации показаний: клиент видит, обновились ли данные
+    writeAlerts(json, data);
+}
 }  // namespace
 
+size_t renderSensorJson(uint8_t probeIndex, const SensorData& data, uint32_t version, char* buffer, size_t capacity)
+{
+    JsonWriter json(buffer, capacity);
+    json.beginObject();
+    json.member("probe", static_cast<uint32_t>(probeIndex));
+    json.member("probe_address", static_cast<uint32_t>(getSensorBusProbeAddress(probeIndex)));
+    json.member("probe_count", static_cast<uint32_t>(getSensorBusProbeCount()));
+    ProbeCounters counters{};
+    if (getSensorBusProbeCounters(probeIndex, counters))
+    {
+        json.member("probe_polls", counters.polls);
+        json.member("probe_failures", counters.failures);
+        json.member("probe_consecutive_failures", static_cast<uint32_t>(counters.consecutiveFailures));
+    }
+
+    writeReadingFields(json, data, version);
+
+    const RecValues rec = computeRecommendations();
+    json.memberFixed("rec_temperature", rec.t, 1, true);
+    json.memberFixed("rec_humidity", rec.hum, 1, true);
+    json.memberFixed("rec_ec", rec.ec, 0, true);
+    json.memberFixed("rec_ph", rec.ph, 1, true);
+    json.memberFixed("rec_nitrogen", rec.n, 0, true);
+    json.memberFixed("rec_phosphorus", rec.p, 0, true);
+    json.memberFixed("rec_potassium", rec.k, 0, true);
+
+    // ---- Дополнительная информация ----
+    // Сезон и время публикует служба времени: обработчик не ждёт NTP
+    json.member("season", getTimeSeasonName());
+    json.member("timestamp", getTimeEpoch());
+    json.endObject();
+
+    if (json.overflowed())
+    {
+        logError("sensor_json: ответ не поместился в буфер");
+        return 0;
+    }
+    return json.size();
+}
+
 void sendSensorJson()  // ✅ Убираем static - функция extern в header
 {
     // unified JSON response for sensor data
@@ -171,133 +293,196 @@ void sendSensorJson()  // ✅ Убираем static - функция extern в h
         return;
     }
 
-    StaticJsonDocument<SENSOR_JSON_DOC_SIZE> doc;
-    doc["temperature"] = format_temperature(sensorData.temperature);
-    doc["humidity"] = format_moisture(sensorData.humidity);
-    doc["ec"] = format_ec(sensorData.ec);
-    doc["ph"] = format_ph(sensorData.ph);
-    doc["nitrogen"] = format_npk(sensorData.nitrogen);
-    doc["phosphorus"] = format_npk(sensorData.phosphorus);
-    doc["potassium"] = format_npk(sensorData.potassium);
-    doc["raw_temperature"] = format_temperature(sensorData.raw_temperature);
-    doc["raw_humidity"] = format_moisture(sensorData.raw_humidity);
-    doc["raw_ec"] = format_ec(sensorData.raw_ec);
-    doc["raw_ph"] = format_ph(sensorData.raw_ph);
-    doc["raw_nitrogen"] = format_npk(sensorData.raw_nitrogen);
-    doc["raw_phosphorus"] = format_npk(sensorData.raw_phosphorus);
-    doc["raw_potassium"] = format_npk(sensorData.raw_potassium);
-    doc["irrigation"] = sensorData.recentIrrigation;
-    doc["valid"] = validateSensorData(sensorData);  // Флаг валидности по лимитам датчика
-
-    const RecValues rec = computeRecommendations();
-    doc["rec_temperature"] = format_temperature(rec.t);
-    doc["rec_humidity"] = format_moisture(rec.hum);
-    doc["rec_ec"] = format_ec(rec.ec);
-    doc["rec_ph"] = format_ph(rec.ph);
-    doc["rec_nitrogen"] = format_npk(rec.n);
-    doc["rec_phosphorus"] = format_npk(rec.p);
-    doc["rec_potassium"] = format_npk(rec.k);
-
-    // ---- Дополнительная информация ----
-    // Сезон по текущему месяцу
-    const char* seasonName = []()
+    // ?probe=N выбирает датчик на шине RS-485; без параметра отдаётся основной датчик
+    uint8_t probeIndex = 0;
+    if (webServer.hasArg("probe"))
     {
-        // Проверяем инициализацию NTP
-        if (timeClient == nullptr)
+        const long requested = webServer.arg("probe").toInt();
+        if (requested < 0 || requested >= getSensorBusProbeCount())
         {
-            extern WiFiUDP ntpUDP;
-            timeClient = new NTPClient(ntpUDP, "pool.ntp.org", 0, 3600000);
-            timeClient->begin();
+            webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_JSON, R"({"error":"probe out of range"})");
+            return;
         }
+        probeIndex = static_cast<uint8_t>(requested);
+    }
 
-        time_t now = timeClient ? (time_t)timeClient->getEpochTime() : time(nullptr);
-        // если время < 2000-01-01 считаем, что NTP ещё не синхронизирован
-        if (now < NTP_TIMESTAMP_2000)
-        {
-            // Пробуем обновить NTP
-            if (timeClient)
-            {
-                timeClient->forceUpdate();
-                now = (time_t)timeClient->getEpochTime();
-                if (now < NTP_TIMESTAMP_2000)
-                {
-                    return "Н/Д";
-                }
-            }
-            else
-            {
-                return "Н/Д";
-            }
-        }
-        struct tm* timeInfo = localtime(&now);
-        if (!timeInfo)
-        {
-            return "Н/Д";
-        }
-        uint8_t month = timeInfo->tm_mon + 1;
-        if (month == 12 || month == 1 || month == 2)
-        {
-            return "Зима";
-        }
-        if (month >= 3 && month <= 5)
-        {
-            return "Весна";
-        }
-        if (month >= 6 && month <= 8)
-        {
-            return "Лето";
-        }
-        return "Осень";
-    }();
-    doc["season"] = seasonName;
+    // Ответ целиком зависит от снимка показаний и конфигурации: пока они те же, отдаём готовые байты.
+    // Счётчики опроса обновляются до публикации, сезон и timestamp — на момент построения ответа
+    SensorData data{};
+    const uint32_t version = getSensorBusProbeReading(probeIndex, data);
+    const ResponseTag tag = makeResponseTag(CachedRoute::SENSOR_JSON, probeIndex, version);
+    if (version != 0 && sendCachedJson(tag))
+    {
+        return;
+    }
+
+    std::array<char, SENSOR_JSON_BUFFER_SIZE> buffer;
+    const size_t length = renderSensorJson(probeIndex, data, version, buffer.data(), buffer.size());
+    if (length == 0)
+    {
+        webServer.send(HTTP_INTERNAL_SERVER_ERROR, HTTP_CONTENT_TYPE_JSON, R"({"error":"response too large"})");
+        return;
+    }
+    sendJsonAndCache(tag, buffer.data(), length);
+}
 
-    // Проверяем отклонения
-    String alerts = "";
-    auto append = [&](const char* n)
+namespace
+{
+constexpr size_t HISTORY_POINT_JSON_SIZE = 384;  // Одна точка: семь каналов по три значения
+constexpr std::array<const char*, UPLINK_CHANNEL_COUNT> HISTORY_KEYS = {"t", "h", "e", "p", "n", "r", "k"};
+constexpr std::array<uint8_t, UPLINK_CHANNEL_COUNT> HISTORY_DECIMALS = {1, 1, 0, 2, 0, 0, 0};
+
+// Параметр запроса как беззнаковое число; без параметра value не меняется, false — не число
+bool readUnsignedArg(const char* name, uint32_t& value)
+{
+    if (!webServer.hasArg(name))
     {
-        if (alerts.length())
+        return true;
+    }
+    const String text = webServer.arg(name);
+    char* end = nullptr;
+    const unsigned long parsed = strtoul(text.c_str(), &end, 10);
+    if (text.length() == 0 || text[0] == '-' || end == nullptr || *end != '\0')
+    {
+        return false;
+    }
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+// Точка истории: "t":[min,mean,max] по каждому каналу, null — канал не измерялся
+void writeHistoryPoint(ChunkedPageWriter& out, const HistoryRecord& point, bool first)
+{
+    std::array<char, HISTORY_POINT_JSON_SIZE> buffer;
+    JsonWriter json(buffer.data(), buffer.size());
+    json.beginObject();
+    json.member("ts", point.timestamp);
+    json.member("n", point.samples);
+    for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+    {
+        json.beginArray(HISTORY_KEYS[channel]);
+        for (const int16_t value : {point.minimum[channel], point.mean[channel], point.maximum[channel]})
         {
-            alerts += ", ";
+            json.elementFixed(restoreUplinkValue(value, channel), HISTORY_DECIMALS[channel]);
         }
-        alerts += n;
-    };
-    // Физические пределы датчика
-    if (sensorData.temperature < TEMP_MIN_VALID || sensorData.temperature > TEMP_MAX_VALID)
+        json.endArray();
+    }
+    json.endObject();
+    if (!first)
     {
-        append("T");
+        out.write(",", 1);
     }
-    if (sensorData.humidity < HUM_MIN_VALID || sensorData.humidity > HUM_MAX_VALID)
+    out.write(json.data(), json.size());
+}
+
+// Точки ответа /api/v1/history по мере обхода архива
+struct HistoryResponse
+{
+    ChunkedPageWriter* out;
+    HistoryAccumulator point;
+    uint32_t step;
+    bool first;
+};
+
+void flushHistoryPoint(HistoryResponse& response)
+{
+    if (!response.point.empty())
     {
-        append("θ");
+        writeHistoryPoint(*response.out, response.point.finish(), response.first);
+        response.first = false;
     }
-    if (sensorData.ec < 0 || sensorData.ec > EC_MAX_VALID)
+}
+
+// Записи уровня сводятся в точки теми же правилами, что и при свёртке минут в часы
+bool addHistoryRecord(const HistoryRecord& record, void* context)
+{
+    HistoryResponse& response = *static_cast<HistoryResponse*>(context);
+    const uint32_t bucket = record.timestamp - record.timestamp % response.step;
+    if (response.point.empty() || response.point.bucket() != bucket)
     {
-        append("EC");
+        flushHistoryPoint(response);
+        response.point.reset(bucket);
     }
-    if (sensorData.ph < 3 || sensorData.ph > 9)
+    response.point.addRecord(record);
+    return true;
+}
+
+// GET /api/v1/history?from=&to=&step= — архив, сведённый к точкам по step секунд.
+// До синхронизации времени отдаются минуты этой загрузки, время — секунды с загрузки ("synced":false)
+void sendHistoryJson()
+{
+    logWebRequest("GET", webServer.uri(), webServer.client().remoteIP().toString());
+    const uint32_t epoch = getTimeEpoch();
+    const bool synced = epoch != 0;
+    const uint32_t now = synced ? epoch : getHistoryUptime();
+
+    uint32_t to = now;
+    uint32_t step = 0;  // 0 — подобрать по диапазону
+    bool valid = readUnsignedArg("to", to);
+    uint32_t from = to > HISTORY_DEFAULT_SPAN_S ? to - HISTORY_DEFAULT_SPAN_S : 0;
+    valid = valid && readUnsignedArg("from", from) && readUnsignedArg("step", step);
+    if (!valid || from >= to)
     {
-        append("pH");
+        webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_JSON, R"({"error":"invalid range"})");
+        return;
     }
-    if (sensorData.nitrogen < 0 || sensorData.nitrogen > NPK_MAX_VALID)
+
+    // Без step — самый мелкий шаг, кратный минуте, при котором точек не больше HISTORY_MAX_POINTS
+    const uint32_t minute = getHistoryTierPeriod(HistoryTier::MINUTE);
+    if (step == 0)
     {
-        append("N");
+        const uint32_t span = (to - from + HISTORY_MAX_POINTS - 1) / HISTORY_MAX_POINTS;
+        step = (span + minute - 1) / minute * minute;
     }
-    if (sensorData.phosphorus < 0 || sensorData.phosphorus > NPK_MAX_VALID)
+    step = std::max(step, minute);
+
+    // Самый крупный уровень, который не грубее шага; если он уже не хранит начало диапазона — следующий.
+    // До синхронизации есть только минуты
+    size_t tier = 0;
+    while (synced && tier + 1 < HISTORY_TIER_COUNT &&
+           getHistoryTierPeriod(static_cast<HistoryTier>(tier + 1)) <= step)
     {
-        append("P");
+        ++tier;
     }
-    if (sensorData.potassium < 0 || sensorData.potassium > NPK_MAX_VALID)
+    while (synced && tier + 1 < HISTORY_TIER_COUNT &&
+           from + getHistoryTierRetention(static_cast<HistoryTier>(tier)) < now)
     {
-        append("K");
+        ++tier;
+    }
+    const auto source = static_cast<HistoryTier>(tier);
+    step = std::max(step, getHistoryTierPeriod(source));
+    if ((to - from) / step > HISTORY_MAX_POINTS)
+    {
+        webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_JSON, R"({"error":"too many points"})");
+        return;
     }
-    doc["alerts"] = alerts;
-
-    doc["timestamp"] = (long)(timeClient != nullptr ? timeClient->getEpochTime() : 0);
 
-    String json;
-    serializeJson(doc, json);
-    webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_JSON, json);
+    ChunkedPageWriter out(webServer, HTTP_OK, HTTP_CONTENT_TYPE_JSON);
+    std::array<char, HISTORY_POINT_JSON_SIZE> buffer;
+    JsonWriter header(buffer.data(), buffer.size());
+    header.beginObject();
+    header.member("from", from);
+    header.member("to", to);
+    header.member("step", step);
+    header.member("resolution", getHistoryTierPeriod(source));
+    header.member("synced", synced);
+    header.beginArray("points");
+    out.write(header.data(), header.size());
+
+    HistoryResponse response{&out, HistoryAccumulator(), step, true};
+    if (synced)
+    {
+        visitHistoryRecords(source, from, to, addHistoryRecord, &response);
+    }
+    else
+    {
+        visitUnsyncedHistory(from, to, addHistoryRecord, &response);
+    }
+    flushHistoryPoint(response);
+    out.write("]}", 2);
+    out.end();
 }
+}  // namespace
 
 void setupDataRoutes()
 {
@@ -310,12 +495,12 @@ void setupDataRoutes()
 
             if (currentWiFiMode == WiFiMode::AP)
             {
-                webServer.send(200, "text/html; charset=utf-8",
-                               generateApModeUnavailablePage("Показания", UI_ICON_DATA));
+                sendApModeUnavailablePage(200, "Показания", UI_ICON_DATA);
                 return;
             }
 
-            String html = generatePageHeader("Показания датчика", UI_ICON_DATA);
+            ChunkedPageWriter html(webServer, HTTP_OK);
+            streamPageHeader(html, "Показания датчика", UI_ICON_DATA);
             html += navHtml();
             html += "<h1>" UI_ICON_DATA " Показания датчика</h1>";
 
@@ -539,7 +724,7 @@ void setupDataRoutes()
             html += "<li><strong>Стрелки ↑↓</strong> показывают направление изменений после компенсации</li>";
             html += "<li><strong>Сезонные корректировки</strong> учитывают потребности растений в разные периоды</li>";
             html += "<li><strong>Валидность данных</strong> проверяется по диапазонам и логическим связям</li>";
-            html += "<li><strong>Интервал обновления:</strong> каждые 3 секунды</li>";
+            html += "<li><strong>Обновление:</strong> сразу после нового опроса датчика</li>";
             html += "</ul>";
             html += "</div>";
 
@@ -554,266 +739,15 @@ void setupDataRoutes()
                 "F44336}.blue{color:#2196F3}";
             html += "</style>";
 
-            html += "<script>";
-            html += "function set(id,v){if(v!==undefined&&v!==null){document.getElementById(id).textContent=v;}}";
-            html +=
-                "function colorDelta(a,b){var diff=Math.abs(a-b)/b*100;if(diff>30)return 'red';if(diff>20)return "
-                "'orange';if(diff>10)return 'yellow';return '';}";
-            html +=
-                "function colorRange(v,min,max){var span=(max-min);if(span<=0)return '';if(v<min||v>max)return "
-                "'red';if(v<min+0.05*span||v>max-0.05*span)return 'orange';if(v<min+0.10*span||v>max-0.10*span)return "
-                "'yellow';return '';}";
-            html +=
-                "function applyColor(spanId,cls){var "
-                "el=document.getElementById(spanId);if(!el)return;el.classList.remove('red','orange','yellow','green');"
-                "if(cls){el.classList.add(cls);}else{el.classList.add('green');}}";
-            html +=
-                "var "
-                "limits={temp:{min:-45,max:115},hum:{min:0,max:100},ec:{min:0,max:10000},ph:{min:3,max:9},n:{min:0,max:"
-                "1999},p:{min:0,max:1999},k:{min:0,max:1999}};";
-            html += "function updateSensor(){";
-            html += "fetch('/sensor_json').then(r=>r.json()).then(d=>{";
-            html += "set('temp_raw',d.raw_temperature);";
-            html += "set('hum_raw',d.raw_humidity);";
-            html += "set('ec_raw',d.raw_ec);";
-            html += "set('ph_raw',d.raw_ph);";
-            html += "set('n_raw',d.raw_nitrogen);";
-            html += "set('p_raw',d.raw_phosphorus);";
-            html += "set('k_raw',d.raw_potassium);";
-            html +=
-                "set('temp_rec',d.rec_temperature);set('hum_rec',d.rec_humidity);set('ec_rec',d.rec_ec);set('ph_rec',d."
-                "rec_ph);set('n_rec',d.rec_nitrogen);set('p_rec',d.rec_phosphorus);set('k_rec',d.rec_potassium);";
-            // === Arrow indicators block ===
-            html += "const tol={temp:0.2,hum:0.5,ec:20,ph:0.05,n:5,p:3,k:3};";
-            html +=
-                "function "
-                "arrowSign(base,val,thr){base=parseFloat(base);val=parseFloat(val);if(isNaN(base)||isNaN(val))return "
-                "'';if(val>base+thr)return '↑ ';if(val<base-thr)return '↓ ';return '';};";
-            html += "function showWithArrow(id,sign,value){document.getElementById(id).textContent=sign+value;}";
-
-            // Compensated vs RAW arrows
-            html += "showWithArrow('temp', arrowSign(d.raw_temperature ,d.temperature ,tol.temp), d.temperature);";
-            html += "showWithArrow('hum',  arrowSign(d.raw_humidity    ,d.humidity    ,tol.hum ), d.humidity);";
-            html += "showWithArrow('ec',   arrowSign(d.raw_ec          ,d.ec          ,tol.ec  ), d.ec);";
-            html += "showWithArrow('ph',   arrowSign(d.raw_ph          ,d.ph          ,tol.ph  ), d.ph);";
-            html += "showWithArrow('n',    arrowSign(d.raw_nitrogen    ,d.nitrogen    ,tol.n   ), d.nitrogen);";
-            html += "showWithArrow('p',    arrowSign(d.raw_phosphorus  ,d.phosphorus  ,tol.p   ), d.phosphorus);";
-            html += "showWithArrow('k',    arrowSign(d.raw_potassium   ,d.potassium   ,tol.k   ), d.potassium);";
-
-            // Recommendation arrows (target vs current)
-            html +=
-                "showWithArrow('temp_rec', arrowSign(d.temperature ,d.rec_temperature ,tol.temp), d.rec_temperature);";
-            html += "showWithArrow('hum_rec',  arrowSign(d.humidity    ,d.rec_humidity    ,tol.hum ), d.rec_humidity);";
-            html += "showWithArrow('ec_rec',   arrowSign(d.ec          ,d.rec_ec          ,tol.ec  ), d.rec_ec);";
-            html += "showWithArrow('ph_rec',   arrowSign(d.ph          ,d.rec_ph          ,tol.ph  ), d.rec_ph);";
-            html += "showWithArrow('n_rec',    arrowSign(d.nitrogen    ,d.rec_nitrogen    ,tol.n   ), d.rec_nitrogen);";
-            html +=
-                "showWithArrow('p_rec',    arrowSign(d.phosphorus  ,d.rec_phosphorus  ,tol.p   ), d.rec_phosphorus);";
-            html +=
-                "showWithArrow('k_rec',    arrowSign(d.potassium   ,d.rec_potassium   ,tol.k   ), d.rec_potassium);";
-            // === End arrow indicators ===
-
-            // Добавляем индикацию сезонных корректировок
-            html += "function updateSeasonalAdjustments(season) {";
-            html += "  const adjustments = {";
-            html += "    'Весна': { n: '+20%', p: '+15%', k: '+10%' },";
-            html += "    'Лето': { n: '-10%', p: '+5%', k: '+25%' },";
-            html += "    'Осень': { n: '-20%', p: '+10%', k: '+15%' },";
-            html += "    'Зима': { n: '-30%', p: '+5%', k: '+5%' }";
-            html += "  };";
-            html += "  const envType = " + String(config.environmentType) + ";";
-            html += "  const adj = adjustments[season] || { n: '', p: '', k: '' };";
-            html += "  ['n', 'p', 'k'].forEach(elem => {";
-            html += "    const span = document.getElementById(elem + '_season');";
-            html += "    if(span) {";
-            html += "      span.textContent = adj[elem] ? ` (${adj[elem]})` : '';";
-            html += "      span.className = 'season-adj ' + (adj[elem].startsWith('+') ? 'up' : 'down');";
-            html += "    }";
-            html += "  });";
-            html += "}";
-
-            html += R"(var invalid = d.irrigation || d.alerts.length>0 || d.humidity<25 || d.temperature<5 || )"
-                    R"(d.temperature>40;)";
-            html += R"(var statusHtml = invalid ? '<span class="red">Данные&nbsp;не&nbsp;валидны</span>' : '<span )"
-                    R"(class="green">Данные&nbsp;валидны</span>';)";
-            html +=
-                R"(var seasonColor={'Лето':'green','Весна':'yellow','Осень':'yellow','Зима':'red','Н/Д':''}[d.season]||'';)";
-            html += R"(var seasonHtml=seasonColor?(`<span class=\"${seasonColor}\">${d.season}</span>`):d.season;)";
-            html += "document.getElementById('statusInfo').innerHTML=statusHtml+' | Сезон: '+seasonHtml;";
-            html += "updateSeasonalAdjustments(d.season);";
-            html +=
-                "var "
-                "tvr=parseFloat(d.raw_temperature);applyColor('temp_raw',colorRange(tvr,limits.temp.min,limits.temp."
-                "max));";
-            html +=
-                "var "
-                "hvr=parseFloat(d.raw_humidity);applyColor('hum_raw',colorRange(hvr,limits.hum.min,limits.hum.max));";
-            html += "var evr=parseFloat(d.raw_ec);applyColor('ec_raw',colorRange(evr,limits.ec.min,limits.ec.max));";
-            html += "var pvr=parseFloat(d.raw_ph);applyColor('ph_raw',colorRange(pvr,limits.ph.min,limits.ph.max));";
-            html += "var nvr=parseFloat(d.raw_nitrogen);applyColor('n_raw',colorRange(nvr,limits.n.min,limits.n.max));";
-            html +=
-                "var p2r=parseFloat(d.raw_phosphorus);applyColor('p_raw',colorRange(p2r,limits.p.min,limits.p.max));";
-            html +=
-                "var kvr=parseFloat(d.raw_potassium);applyColor('k_raw',colorRange(kvr,limits.k.min,limits.k.max));";
-            html +=
-                "['temp','hum','ec','ph','n','p','k'].forEach(function(id){var "
-                "el=document.getElementById(id);if(el){el.classList.remove('red','orange','yellow','green');}});";
-            html += "var ct=parseFloat(d.temperature);";
-            html += "var ch=parseFloat(d.humidity);";
-            html += "var ce=parseFloat(d.ec);";
-            html += "var cph=parseFloat(d.ph);";
-            html += "var cn=parseFloat(d.nitrogen);";
-            html += "var cp=parseFloat(d.phosphorus);";
-            html += "var ck=parseFloat(d.potassium);";
-            html += "applyColor('temp_rec', colorDelta(ct, parseFloat(d.rec_temperature)));";
-            html += "applyColor('hum_rec',  colorDelta(ch, parseFloat(d.rec_humidity)));";
-            html += "applyColor('ec_rec',   colorDelta(ce, parseFloat(d.rec_ec)));";
-            html += "applyColor('ph_rec',   colorDelta(cph,parseFloat(d.rec_ph)));";
-            html += "applyColor('n_rec',    colorDelta(cn, parseFloat(d.rec_nitrogen)));";
-            html += "applyColor('p_rec',    colorDelta(cp, parseFloat(d.rec_phosphorus)));";
-            html += "applyColor('k_rec',    colorDelta(ck, parseFloat(d.rec_potassium)));";
-            html += "});";
-            html += "}";
-
-            // Функции калибровки
-            html += "function updateCalibrationStatus() {";
-            html += "  fetch('/api/calibration/status')";
-            html += "    .then(response => response.json())";
-            html += "    .then(data => {";
-            html += "      document.getElementById('calibration-status').innerHTML = data.status;";
-            html += "    });";
-            html += "}";
-            html += "function addPHPoint() {";
-            html += "  const expected = parseFloat(document.getElementById('ph_expected').value);";
-            html += "  const measured = parseFloat(document.getElementById('ph_measured').value);";
-            html += "  fetch('/api/calibration/ph/add', {";
-            html += "    method: 'POST',";
-            html += "    headers: {'Content-Type': 'application/json'},";
-            html += "    body: JSON.stringify({expected: expected, measured: measured})";
-            html += "  }).then(response => response.json())";
-            html += "    .then(data => {";
-            html += "      if(data.success) {";
-            html += "        updateCalibrationStatus();";
-            html += "        document.getElementById('ph_expected').value = '';";
-            html += "        document.getElementById('ph_measured').value = '';";
-            html += "      }";
-            html += "    });";
-            html += "}";
-            html += "function addECPoint() {";
-            html += "  const expected = parseFloat(document.getElementById('ec_expected').value);";
-            html += "  const measured = parseFloat(document.getElementById('ec_measured').value);";
-            html += "  fetch('/api/calibration/ec/add', {";
-            html += "    method: 'POST',";
-            html += "    headers: {'Content-Type': 'application/json'},";
-            html += "    body: JSON.stringify({expected: expected, measured: measured})";
-            html += "  }).then(response => response.json())";
-            html += "    .then(data => {";
-            html += "      if(data.success) {";
-            html += "        updateCalibrationStatus();";
-            html += "        document.getElementById('ec_expected').value = '';";
-            html += "        document.getElementById('ec_measured').value = '';";
-            html += "      }";
-            html += "    });";
-            html += "}";
-            html += "function setNPKPoint() {";
-            html += "  const n = parseFloat(document.getElementById('npk_n').value);";
-            html += "  const p = parseFloat(document.getElementById('npk_p').value);";
-            html += "  const k = parseFloat(document.getElementById('npk_k').value);";
-            html += "  fetch('/api/calibration/npk/set', {";
-            html += "    method: 'POST',";
-            html += "    headers: {'Content-Type': 'application/json'},";
-            html += "    body: JSON.stringify({n: n, p: p, k: k})";
-            html += "  }).then(response => response.json())";
-            html += "    .then(data => {";
-            html += "      if(data.success) {";
-            html += "        updateCalibrationStatus();";
-            html += "        document.getElementById('npk_n').value = '';";
-            html += "        document.getElementById('npk_p').value = '';";
-            html += "        document.getElementById('npk_k').value = '';";
-            html += "      }";
-            html += "    });";
-            html += "}";
-            html += "function calculatePH() {";
-            html += "  fetch('/api/calibration/ph/calculate', {method: 'POST'})";
-            html += "    .then(response => response.json())";
-            html += "    .then(data => {";
-            html += "      if(data.success) {";
-            html += "        updateCalibrationStatus();";
-            html += "        alert('pH калибровка рассчитана! R² = ' + data.r_squared);";
-            html += "      }";
-            html += "    });";
-            html += "}";
-            html += "function calculateEC() {";
-            html += "  fetch('/api/calibration/ec/calculate', {method: 'POST'})";
-            html += "    .then(response => response.json())";
-            html += "    .then(data => {";
-            html += "      if(data.success) {";
-            html += "        updateCalibrationStatus();";
-            html += "        alert('EC калибровка рассчитана! R² = ' + data.r_squared);";
-            html += "      }";
-            html += "    });";
-            html += "}";
-            html += "function exportCalibration() {";
-            html += "  fetch('/api/calibration/export')";
-            html += "    .then(response => response.json())";
-            html += "    .then(data => {";
-            html += "      const blob = new Blob([JSON.stringify(data, null, 2)], {type: 'application/json'});";
-            html += "      const url = URL.createObjectURL(blob);";
-            html += "      const a = document.createElement('a');";
-            html += "      a.href = url;";
-            html += "      a.download = 'calibration.json';";
-            html += "      a.click();";
-            html += "    });";
-            html += "}";
-            html += "function importCalibration() {";
-            html += "  const input = document.createElement('input');";
-            html += "  input.type = 'file';";
-            html += "  input.accept = '.json';";
-            html += "  input.onchange = function(e) {";
-            html += "    const file = e.target.files[0];";
-            html += "    const reader = new FileReader();";
-            html += "    reader.onload = function(e) {";
-            html += "      fetch('/api/calibration/import', {";
-            html += "        method: 'POST',";
-            html += "        headers: {'Content-Type': 'application/json'},";
-            html += "        body: e.target.result";
-            html += "      }).then(response => response.json())";
-            html += "        .then(data => {";
-            html += "          if(data.success) {";
-            html += "            updateCalibrationStatus();";
-            html += "            alert('Калибровка импортирована!');";
-            html += "          }";
-            html += "        });";
-            html += "    };";
-            html += "    reader.readAsText(file);";
-            html += "  };";
-            html += "  input.click();";
-            html += "}";
-            html += "function resetCalibration() {";
-            html += "  if(confirm('Сбросить всю калибровку?')) {";
-            html += "    fetch('/api/calibration/reset', {method: 'POST'})";
-            html += "      .then(response => response.json())";
-            html += "      .then(data => {";
-            html += "        if(data.success) {";
-            html += "          updateCalibrationStatus();";
-            html += "          alert('Калибровка сброшена!');";
-            html += "        }";
-            html += "      });";
-            html += "  }";
-            html += "}";
-
-            html += "setInterval(updateSensor,3000);";
-            html += "updateSensor();";
-            html += "updateCalibrationStatus();";
-            html += "setInterval(updateCalibrationStatus, 10000);";
-            html += "</script>";
+            // Логика страницы — web_assets/readings.js, обновления приходят потоком /events/readings
+            html += "<script src='" WEB_ASSET_LIVE_JS_URL "'></script>";
+            html += "<script src='" WEB_ASSET_READINGS_JS_URL "'></script>";
 
             // API-ссылка внизу страницы
             html += "<div style='margin-top:15px;font-size:14px;color:#555'><b>API:</b> <a href='" +
                     String(API_SENSOR) + "' target='_blank'>" + String(API_SENSOR) + "</a> (JSON, +timestamp)</div>";
 
-            html += generatePageFooter();
-            webServer.send(200, "text/html; charset=utf-8", html);
+            streamPageFooter(html);
         });
 
     // AJAX эндпоинт для обновления показаний
@@ -822,6 +756,9 @@ void setupDataRoutes()
     // Primary API v1 endpoint
     webServer.on(API_SENSOR, HTTP_GET, sendSensorJson);
 
+    // Архив показаний: минуты, часы и сутки
+    webServer.on(API_HISTORY, HTTP_GET, sendHistoryJson);
+
     // Загрузка калибровочного CSV через вкладку
     webServer.on("/readings/upload", HTTP_POST, []() {}, handleReadingsUpload);
 
@@ -835,8 +772,7 @@ void setupDataRoutes()
                      if (!checkCSRFSafety())
                      {
                          logWarnSafe("\1", webServer.client().remoteIP().toString().c_str());
-                         const String html = generateErrorPage(403, "Forbidden: Недействительный CSRF токен");
-                         webServer.send(403, "text/html; charset=utf-8", html);
+                         sendErrorPage(403, "Forbidden: Недействительный CSRF токен");
                          return;
                      }
 
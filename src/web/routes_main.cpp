@@ -1,9 +1,12 @@
+#include <algorithm>
+#include <optional>
 #include "../../include/jxct_config_vars.h"
 #include "../../include/jxct_constants.h"
 #include "../../include/jxct_ui_system.h"
 #include "../../include/logger.h"
 #include "../../include/validation_utils.h"  // ✅ Валидация
 #include "../../include/web_routes.h"
+#include "../sensor_bus.h"
 #include "../wifi_manager.h"
 
 void setupMainRoutes()
@@ -23,8 +26,7 @@ void setupMainRoutes()
             if (!checkCSRFSafety())
             {
                 logWarnSafe("\1", webServer.client().remoteIP().toString().c_str());
-                const String html = generateErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
-                webServer.send(HTTP_FORBIDDEN, HTTP_CONTENT_TYPE_HTML, html);
+                sendErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
                 return;
             }
 
@@ -35,8 +37,7 @@ void setupMainRoutes()
             if (!ssidRes.isValid || !passRes.isValid)
             {
                 const String msg = !ssidRes.isValid ? ssidRes.message : passRes.message;
-                const String html = generateErrorPage(HTTP_BAD_REQUEST, msg);
-                webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_HTML, html);
+                sendErrorPage(HTTP_BAD_REQUEST, msg);
                 return;
             }
 
@@ -49,8 +50,7 @@ void setupMainRoutes()
                     if (!hostRes.isValid || !portRes.isValid)
                     {
                         const String msg = !hostRes.isValid ? hostRes.message : portRes.message;
-                        const String html = generateErrorPage(HTTP_BAD_REQUEST, msg);
-                        webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_HTML, html);
+                        sendErrorPage(HTTP_BAD_REQUEST, msg);
                         return;
                     }
                 }
@@ -59,14 +59,15 @@ void setupMainRoutes()
                     const ValidationResult tsRes = validateThingSpeakAPIKey(webServer.arg("ts_api_key"));
                     if (!tsRes.isValid)
                     {
-                        const String html = generateErrorPage(HTTP_BAD_REQUEST, tsRes.message);
-                        webServer.send(HTTP_BAD_REQUEST, HTTP_CONTENT_TYPE_HTML, html);
+                        sendErrorPage(HTTP_BAD_REQUEST, tsRes.message);
                         return;
                     }
                 }
             }
 
-            // Сохранение настроек в конфигурацию
+            // Сохранение настроек в конфигурацию; другие задачи не видят её наполовину изменённой
+            std::optional<ConfigLock> settingsLock;
+            settingsLock.emplace();
             strlcpy(config.ssid, webServer.arg("ssid").c_str(), sizeof(config.ssid));
             strlcpy(config.password, webServer.arg("password").c_str(), sizeof(config.password));
 
@@ -83,10 +84,25 @@ void setupMainRoutes()
                 config.flags.thingSpeakEnabled = (uint8_t)webServer.hasArg("ts_enabled");
                 strlcpy(config.thingSpeakApiKey, webServer.arg("ts_api_key").c_str(), sizeof(config.thingSpeakApiKey));
                 config.mqttQos = webServer.arg("mqtt_qos").toInt();
+                if (webServer.hasArg("mqtt_batch"))
+                {
+                    config.mqttBatchSize = static_cast<uint8_t>(std::max(
+                        CONFIG_MQTT_BATCH_MIN, std::min(CONFIG_MQTT_BATCH_MAX, webServer.arg("mqtt_batch").toInt())));
+                    config.mqttPayloadFormat = webServer.arg("mqtt_format").toInt() == 1 ? 1 : 0;
+                }
                 strlcpy(config.thingSpeakChannelId, webServer.arg("ts_channel_id").c_str(),
                         sizeof(config.thingSpeakChannelId));
                 config.flags.useRealSensor = (uint8_t)webServer.hasArg("real_sensor");
+                if (webServer.hasArg("bus_probes"))
+                {
+                    const long requested = std::max(0L, std::min(255L, webServer.arg("bus_probes").toInt()));
+                    config.busProbeCount = clampBusProbeCount(config.modbusId, static_cast<uint8_t>(requested));
+                }
                 config.flags.calibrationEnabled = (uint8_t)webServer.hasArg("cal_enabled");
+                if (webServer.hasArg("cal_interp"))
+                {
+                    config.calibrationInterpolation = webServer.arg("cal_interp").toInt() == 1 ? 1 : 0;
+                }
                 // Тип среды выращивания v2.6.1
                 if (webServer.hasArg("env_type"))
                 {
@@ -138,14 +154,13 @@ void setupMainRoutes()
                             config.flags.thingSpeakEnabled ? "ON" : "OFF", config.flags.hassEnabled ? "ON" : "OFF");
             }
 
-            // Сохранение в NVS
+            // Сохранение в NVS: saveConfig() копирует config сама, замок ей не нужен
+            settingsLock.reset();
             saveConfig();
 
             // Отправка страницы успеха
-            const String html = generateSuccessPage(
-                "Настройки сохранены", "Настройки сохранены успешно. Устройство перезагружается...", "/", 1);
-
-            webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_HTML, html);
+            sendSuccessPage("Настройки сохранены", "Настройки сохранены успешно. Устройство перезагружается...", "/",
+                            1);
 
             logSuccess("Настройки сохранены успешно");
             delay(1000);
@@ -160,11 +175,8 @@ void setupMainRoutes()
 
 void handleRoot()
 {
-    String html =
-        "<!DOCTYPE html><html><head><meta charset='UTF-8'><meta name='viewport' content='width=device-width, "
-        "initial-scale=1.0'>";
-    html += "<title>" UI_ICON_CONFIG " Настройки JXCT</title>";
-    html += "<style>" + String(getUnifiedCSS()) + "</style></head><body><div class='container'>";
+    ChunkedPageWriter html(webServer, HTTP_OK);
+    streamPageHeader(html, "Настройки JXCT", UI_ICON_CONFIG);
     html += navHtml();
     html += "<h1>" UI_ICON_CONFIG " Настройки JXCT</h1>";
     html += "<form action='/save' method='post'>";
@@ -202,6 +214,16 @@ void handleRoot()
             "<div class='form-group'><label for='mqtt_password'>MQTT пароль:</label><input type='password' "
             "id='mqtt_password' name='mqtt_password' value='" +
             String(config.mqttPassword) + "'></div>";
+        html +=
+            "<div class='form-group'><label for='mqtt_batch'>Показаний в сообщении:</label><input type='number' "
+            "id='mqtt_batch' name='mqtt_batch' min='" +
+            String(CONFIG_MQTT_BATCH_MIN) + "' max='" + String(CONFIG_MQTT_BATCH_MAX) + "' value='" +
+            String(config.mqttBatchSize) + "'><div class='help'>1 — каждое показание отдельно в /state</div></div>";
+        html += "<div class='form-group'><label for='mqtt_format'>Формат пакета:</label>";
+        html += "<select id='mqtt_format' name='mqtt_format'>";
+        html += String("<option value='0'") + (config.mqttPayloadFormat == 0 ? " selected" : "") + ">JSON</option>";
+        html += String("<option value='1'") + (config.mqttPayloadFormat == 1 ? " selected" : "") +
+                ">Двоичный (компактный)</option></select></div>";
         const String hassChecked = config.flags.hassEnabled ? " checked" : "";
         html +=
             "<div class='form-group'><label for='hass_enabled'>Интеграция с Home Assistant:</label><input "
@@ -230,6 +252,13 @@ void handleRoot()
             "<div class='form-group'><label for='real_sensor'>Реальный датчик:</label><input type='checkbox' "
             "id='real_sensor' name='real_sensor'" +
             realSensorChecked + "></div>";
+        html +=
+            "<div class='form-group'><label for='bus_probes'>Датчиков на шине RS-485:</label><input type='number' "
+            "id='bus_probes' name='bus_probes' min='" +
+            String(CONFIG_BUS_PROBES_MIN) + "' max='" +
+            String(clampBusProbeCount(config.modbusId, CONFIG_BUS_PROBES_MAX)) + "' value='" +
+            String(config.busProbeCount) + "'><div class='help'>Адреса Modbus " + String(config.modbusId) + "…" +
+            String(config.modbusId + config.busProbeCount - 1) + "</div></div>";
 
         // ----------------- ⚙️ Компенсация датчиков -----------------
         html += "<div class='section'><h2>⚙️ Компенсация датчиков</h2>";
@@ -238,6 +267,15 @@ void handleRoot()
             "<div class='form-group'><label for='cal_enabled'>Включить компенсацию:</label><input type='checkbox' "
             "id='cal_enabled' name='cal_enabled'" +
             calibChecked + "></div>";
+        const char* selectedLinear = config.calibrationInterpolation == 0 ? " selected" : "";
+        const char* selectedPchip = config.calibrationInterpolation == 1 ? " selected" : "";
+        html +=
+            "<div class='form-group'><label for='cal_interp'>Интерполяция таблицы калибровки:</label>"
+            "<select id='cal_interp' name='cal_interp'>";
+        html += String("<option value='0'") + selectedLinear + ">Линейная</option>";
+        html += String("<option value='1'") + selectedPchip + ">Монотонный сплайн (PCHIP)</option>";
+        html += "</select><div class='help'>Сплайн плавнее на плотных таблицах и не даёт выбросов между точками</div>"
+                "</div>";
         html +=
             "<div class='form-group'><label for='irrig_th'>Порог ∆влажности (%):</label><input type='number' "
             "step='0.1' id='irrig_th' name='irrig_th' value='" +
@@ -352,6 +390,5 @@ void handleRoot()
         html += "</script>";
     }
 
-    html += "</div>" + String(getToastHTML()) + "</body></html>";
-    webServer.send(200, "text/html; charset=utf-8", html);
+    streamPageFooter(html);
 }
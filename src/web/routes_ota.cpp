@@ -73,11 +73,12 @@ void setupOtaRoutes()
 
             if (currentWiFiMode == WiFiMode::AP)
             {
-                webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_HTML, generateApModeUnavailablePage("Обновления", "🚀"));
+                sendApModeUnavailablePage(HTTP_OK, "Обновления", "🚀");
                 return;
             }
 
-            String html = generatePageHeader("Обновления", "🚀");
+            ChunkedPageWriter html(webServer, HTTP_OK);
+            streamPageHeader(html, "Обновления", "🚀");
             html += navHtml();
             html += "<h1>🚀 Обновления прошивки</h1>";
 
@@ -332,8 +333,7 @@ void setupOtaRoutes()
             html += "setInterval(updateStatus, " + String(OTA_UPDATE_INTERVAL_MS) + ");\n";
             html += "updateStatus();\n";
             html += "</script>";
-            html += generatePageFooter();
-            webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_HTML, html);
+            streamPageFooter(html);
         });
 
     // Upload маршрут
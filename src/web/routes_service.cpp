@@ -5,6 +5,7 @@
  */
 
 #include <ArduinoJson.h>
+#include <array>
 #include "../../include/jxct_config_vars.h"
 #include "../../include/jxct_constants.h"
 #include "../../include/jxct_device_info.h"
@@ -13,10 +14,15 @@
 #include "../../include/jxct_ui_system.h"
 #include "../../include/logger.h"
 #include "../../include/web/csrf_protection.h"  // 🔒 CSRF защита
+#include "../../include/web/json_response_cache.h"
+#include "../../include/web_assets_manifest.h"
 #include "../../include/web_routes.h"           // ✅ CSRF защита
+#include "../flash_writer.h"
 #include "../modbus_sensor.h"
 #include "../mqtt_client.h"
+#include "../mqtt_connection.h"
 #include "../thingspeak_client.h"
+#include "../uplink_queue.h"
 #include "../wifi_manager.h"
 
 // Внешние зависимости (уже объявлены в заголовочных файлах)
@@ -59,12 +65,12 @@ void setupServiceRoutes()
 
             if (currentWiFiMode == WiFiMode::AP)
             {
-                webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_HTML,
-                               generateApModeUnavailablePage("Сервис", UI_ICON_SERVICE));
+                sendApModeUnavailablePage(HTTP_OK, "Сервис", UI_ICON_SERVICE);
                 return;
             }
 
-            String html = generatePageHeader("Сервис", UI_ICON_SERVICE);
+            ChunkedPageWriter html(webServer, HTTP_OK);
+            streamPageHeader(html, "Сервис", UI_ICON_SERVICE);
             html += navHtml();
             html += "<h1>" UI_ICON_SERVICE " Сервис</h1>";
             html += "<div class='info-block' id='status-block'>Загрузка статусов...</div>";
@@ -84,6 +90,7 @@ void setupServiceRoutes()
                 "<div class='section' style='margin-top:15px;font-size:14px;color:#555'><b>API:</b> <a "
                 "href='/service_status' target='_blank'>/service_status</a> (JSON, статусы сервисов) | <a "
                 "href='/health' target='_blank'>/health</a> (JSON, подробная диагностика)</div>";
+            html += "<script src='" WEB_ASSET_LIVE_JS_URL "'></script>";
             html += "<script>";
             html += "function dot(status){";
             html += "if(status===true)return'<span class=\"status-dot dot-ok\"></span>';";
@@ -91,7 +98,7 @@ void setupServiceRoutes()
             html += "if(status==='warn')return'<span class=\"status-dot dot-warn\"></span>';";
             html += "return'<span class=\"status-dot dot-off\"></span>';";
             html += "}";
-            html += "function updateStatus(){fetch('/service_status').then(r=>r.json()).then(d=>{let html='';";
+            html += "function renderStatus(d){let html='';";
             html +=
                 "html+=dot(d.wifi_connected)+'<b>WiFi:</b> '+(d.wifi_connected?'Подключено ('+d.wifi_ip+', "
                 "'+d.wifi_ssid+', RSSI '+d.wifi_rssi+' dBm)':'Не подключено')+'<br>';";
@@ -113,10 +120,10 @@ void setupServiceRoutes()
                 "html+=dot(d.sensor_ok)+'<b>Датчик:</b> '+(d.sensor_ok?'Ок':'Ошибка'+(d.sensor_last_error?' "
                 "('+d.sensor_last_error+')':''));";
             html += "document.getElementById('status-block').innerHTML=html;";
-            html += "});}setInterval(updateStatus," + String(config.webUpdateInterval) + ");updateStatus();";
+            html += "}liveSubscribe('/events/status','status','/service_status'," + String(config.webUpdateInterval) +
+                    ",renderStatus);";
             html += "</script>";
-            html += generatePageFooter();
-            webServer.send(200, "text/html; charset=utf-8", html);
+            streamPageFooter(html);
         });
 
     // POST обработчики для сервисных функций
@@ -129,9 +136,7 @@ void setupServiceRoutes()
                      if (!checkCSRFSafety())
                      {
                          logWarnSafe("\1", webServer.client().remoteIP().toString().c_str());
-                         const String html =
-                             generateErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
-                         webServer.send(HTTP_FORBIDDEN, HTTP_CONTENT_TYPE_HTML, html);
+                         sendErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
                          return;
                      }
 
@@ -169,9 +174,7 @@ void setupServiceRoutes()
                      if (!checkCSRFSafety())
                      {
                          logWarnSafe("\1", webServer.client().remoteIP().toString().c_str());
-                         const String html =
-                             generateErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
-                         webServer.send(HTTP_FORBIDDEN, HTTP_CONTENT_TYPE_HTML, html);
+                         sendErrorPage(HTTP_FORBIDDEN, "Forbidden: Недействительный CSRF токен");
                          return;
                      }
 
@@ -240,11 +243,33 @@ static String formatUptime(unsigned long milliseconds)
     return uptime;
 }
 
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+static void writeFlashWear(JsonObject out, FlashPartition partition)
+{
+    FlashWearStats stats{};
+    getFlashWearStats(partition, stats);
+    out["requests"] = stats.requests;
+    out["writes"] = stats.writes;
+    out["bytes"] = stats.bytes;
+    // Меньше 1 — буферизация слила мелкие записи в общие операции
+    out["writes_per_request"] =
+        serialized(String(stats.requests == 0 ? 0.0F : static_cast<float>(stats.writes) / stats.requests, 2));
+    out["amplification"] = serialized(String(getFlashWriteAmplification(partition), 2));
+}
+
 // NOLINTNEXTLINE(misc-use-anonymous-namespace)
 static void sendHealthJson()
 {
     logWebRequest("GET", webServer.uri(), webServer.client().remoteIP().toString());
-    StaticJsonDocument<JSON_DOC_MEDIUM> doc;
+
+    // Кроме показаний и настроек здесь куча, RSSI и состояние MQTT: ответ живёт не дольше окна WEB_STATUS_CACHE_TTL
+    const ResponseTag tag = makeResponseTag(CachedRoute::HEALTH, 0, getSensorReadingVersion(), WEB_STATUS_CACHE_TTL);
+    if (sendCachedJson(tag))
+    {
+        return;
+    }
+
+    StaticJsonDocument<JSON_DOC_LARGE> doc;
 
     // System info
     doc["device"]["manufacturer"] = DEVICE_MANUFACTURER;
@@ -279,10 +304,11 @@ static void sendHealthJson()
     doc["mqtt"]["enabled"] = (bool)config.flags.mqttEnabled;
     if (config.flags.mqttEnabled)
     {
-        doc["mqtt"]["connected"] = mqttClient.connected();
+        doc["mqtt"]["connected"] = isMqttLinkUp();
         doc["mqtt"]["server"] = config.mqttServer;
         doc["mqtt"]["port"] = config.mqttPort;
         doc["mqtt"]["last_error"] = getMqttLastError();
+        doc["mqtt"]["queued"] = getUplinkPending(UplinkSink::MQTT);
     }
 
     // ThingSpeak status
@@ -292,58 +318,107 @@ static void sendHealthJson()
         doc["thingspeak"]["last_publish"] = getThingSpeakLastPublish();
         doc["thingspeak"]["last_error"] = getThingSpeakLastError();
         doc["thingspeak"]["interval"] = config.thingSpeakInterval;
+        doc["thingspeak"]["queued"] = getUplinkPending(UplinkSink::THINGSPEAK);
     }
 
+    // Очередь показаний на флеше
+    doc["uplink_queue"]["stored"] = getUplinkStoredCount();
+    doc["uplink_queue"]["dropped"] = getUplinkDroppedCount();
+
+    // Запись на флеш с загрузки: обращения, операции, байты и оценка усиления записи
+    JsonObject flash = doc.createNestedObject("flash");
+    writeFlashWear(flash.createNestedObject("littlefs"), FlashPartition::LITTLEFS);
+    writeFlashWear(flash.createNestedObject("nvs"), FlashPartition::NVS);
+
     // Home Assistant status
     doc["homeassistant"]["enabled"] = (bool)config.flags.hassEnabled;
 
     // Sensor status
     doc["sensor"]["enabled"] = (bool)config.flags.useRealSensor;
-    doc["sensor"]["valid"] = sensorData.valid;
-    doc["sensor"]["last_read"] = sensorData.last_update;
+    SensorData reading{};
+    getSensorReading(reading);
+    doc["sensor"]["valid"] = reading.valid;
+    doc["sensor"]["last_read"] = reading.last_update;
     if (getSensorLastError().length() > 0)
     {
         doc["sensor"]["last_error"] = getSensorLastError();
     }
 
     // Current readings
-    doc["readings"]["temperature"] = format_temperature(sensorData.temperature);
-    doc["readings"]["humidity"] = format_moisture(sensorData.humidity);
-    doc["readings"]["ec"] = format_ec(sensorData.ec);
-    doc["readings"]["ph"] = format_ph(sensorData.ph);
-    doc["readings"]["nitrogen"] = format_npk(sensorData.nitrogen);
-    doc["readings"]["phosphorus"] = format_npk(sensorData.phosphorus);
-    doc["readings"]["potassium"] = format_npk(sensorData.potassium);
+    doc["readings"]["temperature"] = format_temperature(reading.temperature);
+    doc["readings"]["humidity"] = format_moisture(reading.humidity);
+    doc["readings"]["ec"] = format_ec(reading.ec);
+    doc["readings"]["ph"] = format_ph(reading.ph);
+    doc["readings"]["nitrogen"] = format_npk(reading.nitrogen);
+    doc["readings"]["phosphorus"] = format_npk(reading.phosphorus);
+    doc["readings"]["potassium"] = format_npk(reading.potassium);
 
     // Timestamps
     doc["timestamp"] = millis();
     doc["boot_time"] = millis();
 
-    String json;
-    serializeJson(doc, json);
-    webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_JSON, json);
+    sendJsonAndCache(tag, doc);
 }
 
-// NOLINTNEXTLINE(misc-use-anonymous-namespace)
-static void sendServiceStatusJson()
+size_t renderServiceStatusJson(char* buffer, size_t capacity)
 {
-    logWebRequest("GET", webServer.uri(), webServer.client().remoteIP().toString());
-    StaticJsonDocument<JSON_DOC_SMALL> doc;
+    StaticJsonDocument<JSON_DOC_MEDIUM> doc;
     doc["wifi_connected"] = wifiConnected;
     doc["wifi_ip"] = WiFi.localIP().toString();
     doc["wifi_ssid"] = WiFi.SSID();
     doc["wifi_rssi"] = WiFi.RSSI();
     doc["mqtt_enabled"] = (bool)config.flags.mqttEnabled;
-    doc["mqtt_connected"] = (bool)config.flags.mqttEnabled && mqttClient.connected();
+    doc["mqtt_connected"] = (bool)config.flags.mqttEnabled && isMqttLinkUp();
     doc["mqtt_last_error"] = getMqttLastError();
+    if (config.flags.mqttEnabled)
+    {
+        MqttLinkStats link{};
+        getMqttLinkStats(link);
+        JsonObject connection = doc.createNestedObject("mqtt_connection");
+        connection["state"] = getMqttLinkStateName(link.state);
+        connection["attempts"] = link.attempts;
+        connection["failures"] = link.failures;
+        connection["consecutive_failures"] = link.consecutiveFailures;
+        connection["disconnects"] = link.disconnects;
+        connection["retry_in_ms"] = link.retryInMs;
+        connection["last_attempt_ms"] = link.lastAttemptMs;
+        connection["circuit_open"] = link.circuitOpen;
+        connection["last_error"] = link.lastError;
+    }
     doc["thingspeak_enabled"] = (bool)config.flags.thingSpeakEnabled;
     doc["thingspeak_last_pub"] = getThingSpeakLastPublish();
     doc["thingspeak_last_error"] = getThingSpeakLastError();
     doc["hass_enabled"] = (bool)config.flags.hassEnabled;
-    doc["sensor_ok"] = sensorData.valid;
+    SensorData reading{};
+    getSensorReading(reading);
+    doc["sensor_ok"] = reading.valid;
     doc["sensor_last_error"] = getSensorLastError();
 
-    String json;
-    serializeJson(doc, json);
-    webServer.send(HTTP_OK, HTTP_CONTENT_TYPE_JSON, json);
+    if (measureJson(doc) >= capacity)
+    {
+        return 0;
+    }
+    return serializeJson(doc, buffer, capacity);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+static void sendServiceStatusJson()
+{
+    logWebRequest("GET", webServer.uri(), webServer.client().remoteIP().toString());
+
+    const ResponseTag tag =
+        makeResponseTag(CachedRoute::SERVICE_STATUS, 0, getSensorReadingVersion(), WEB_STATUS_CACHE_TTL);
+    if (sendCachedJson(tag))
+    {
+        return;
+    }
+
+    std::array<char, WEB_RESPONSE_CACHE_BODY_SIZE> buffer;
+    const size_t length = renderServiceStatusJson(buffer.data(), buffer.size());
+    if (length == 0)
+    {
+        webServer.send(HTTP_INTERNAL_SERVER_ERROR, HTTP_CONTENT_TYPE_JSON, R"({"error":"response too large"})");
+        return;
+    }
+    sendJsonAndCache(tag, buffer.data(), length);
 }
@@ -0,0 +1,54 @@
+/**
+ * @file routes_static.cpp
+ * @brief Отдача статических ресурсов веб-интерфейса
+ * @details Ресурсы хранятся во флеше уже сжатыми gzip (см. scripts/build_web_assets.py) и отдаются
+ * без распаковки с Content-Encoding: gzip. Страницы ссылаются на них с версией (?v=ETag), такие ответы
+ * кэшируются браузером без повторных запросов; запрос без версии перепроверяется по If-None-Match.
+ */
+
+#include <cstring>
+#include "../../include/jxct_constants.h"
+#include "../../include/logger.h"
+#include "../../include/web/static_assets.h"
+#include "../../include/web_routes.h"
+
+namespace
+{
+constexpr const char* CACHE_IMMUTABLE = "public, max-age=31536000, immutable";
+constexpr const char* CACHE_REVALIDATE = "no-cache";
+
+// ETag без кавычек совпадает с параметром версии в URL
+bool isVersionedRequest(const WebAsset& asset)
+{
+    const String version = webServer.arg("v");
+    const size_t etagLength = strlen(asset.etag);
+    return version.length() + 2 == etagLength && strncmp(asset.etag + 1, version.c_str(), version.length()) == 0;
+}
+
+void sendAsset(const WebAsset& asset)
+{
+    webServer.sendHeader("ETag", asset.etag);
+    webServer.sendHeader("Cache-Control", isVersionedRequest(asset) ? CACHE_IMMUTABLE : CACHE_REVALIDATE);
+
+    // If-None-Match может содержать список тегов — достаточно вхождения нашего
+    if (webServer.hasHeader("If-None-Match") && webServer.header("If-None-Match").indexOf(asset.etag) >= 0)
+    {
+        webServer.send(HTTP_NOT_MODIFIED);
+        return;
+    }
+
+    webServer.sendHeader("Content-Encoding", "gzip");
+    webServer.send_P(HTTP_OK, asset.contentType, reinterpret_cast<const char*>(asset.data),  // NOLINT
+                     asset.size);
+}
+}  // namespace
+
+void setupStaticRoutes()
+{
+    for (size_t i = 0; i < WEB_ASSET_COUNT; ++i)
+    {
+        const WebAsset& asset = WEB_ASSETS[i];
+        webServer.on(asset.path, HTTP_GET, [&asset]() { sendAsset(asset); });
+    }
+    logDebug("Маршруты статических ресурсов настроены: /static/*");
+}
@@ -0,0 +1,368 @@
+// Auto-generated. DO NOT EDIT MANUALLY.
+// Generated by scripts/build_web_assets.py from web_assets/
+
+#include "../../include/web/static_assets.h"
+
+namespace
+{
+const uint8_t ASSET_APP_CSS[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x58, 0xdd, 0x6e, 0xd4, 0x46,
+    0x14, 0xbe, 0xcf, 0x53, 0x8c, 0x84, 0x10, 0x09, 0x5a, 0x2f, 0xfe, 0x59, 0x7b, 0x97, 0x45, 0x91,
+    0xa0, 0x94, 0x54, 0x54, 0xa2, 0xbd, 0x48, 0x2a, 0x81, 0xaa, 0x5e, 0xcc, 0xda, 0xe3, 0xdd, 0x51,
+    0xbc, 0x1e, 0xcb, 0xe3, 0xcd, 0xee, 0x82, 0xfa, 0x0e, 0x29, 0x14, 0x29, 0x82, 0x40, 0x69, 0x8a,
+    0x2a, 0x55, 0xb4, 0xe2, 0x55, 0xfc, 0x48, 0x3d, 0x63, 0x7b, 0xc6, 0xff, 0x9b, 0xd2, 0x58, 0x90,
+    0x78, 0x7c, 0x7c, 0xe6, 0xcc, 0x77, 0xbe, 0xf3, 0xcd, 0x19, 0xdf, 0xb9, 0x8d, 0x0e, 0x0f, 0x0f,
+    0xd1, 0xb7, 0x4f, 0x1f, 0x9e, 0xa0, 0x1f, 0x1e, 0xa3, 0xaf, 0x1f, 0x1d, 0x3f, 0xfe, 0xe6, 0x3b,
+    0x74, 0xfc, 0xec, 0xf8, 0xe4, 0xd1, 0x13, 0x74, 0x66, 0x0e, 0xad, 0xa1, 0x91, 0x19, 0xdc, 0xbe,
+    0xb3, 0x77, 0x1b, 0xbd, 0x40, 0x33, 0xb6, 0xd1, 0x38, 0x7d, 0x4e, 0xc3, 0xf9, 0x14, 0xfe, 0x8e,
+    0x3d, 0x12, 0x6b, 0x30, 0x74, 0x0f, 0xfd, 0xbc, 0xb7, 0x37, 0x63, 0xde, 0x16, 0xbd, 0xd8, 0x43,
+    0xf0, 0xe3, 0xb3, 0x30, 0xd1, 0x7c, 0xbc, 0xa4, 0xc1, 0x76, 0x8a, 0x1e, 0xc4, 0x14, 0x07, 0x03,
+    0xa4, 0xe1, 0x28, 0x0a, 0x88, 0xc6, 0xb7, 0x3c, 0x21, 0xcb, 0x01, 0xfa, 0x2a, 0xa0, 0xe1, 0xe9,
+    0x13, 0xec, 0x1e, 0x67, 0xf7, 0x47, 0xf0, 0xc2, 0x00, 0xdd, 0x3a, 0x26, 0x73, 0x46, 0x20, 0x8c,
+    0x5b, 0x03, 0xc4, 0x71, 0xc8, 0x35, 0x4e, 0x62, 0xea, 0xdf, 0xcb, 0x5c, 0x2e, 0x71, 0x3c, 0xa7,
+    0xe1, 0x14, 0xe9, 0xf9, 0x6d, 0x84, 0x3d, 0x2f, 0x0b, 0xc2, 0xd4, 0xa3, 0x4d, 0x3e, 0x34, 0xc3,
+    0xee, 0xe9, 0x3c, 0x66, 0xab, 0xd0, 0x9b, 0xa2, 0x1b, 0xbe, 0x2d, 0xae, 0xfc, 0x81, 0xcb, 0x02,
+    0x16, 0xc3, 0x98, 0x65, 0x59, 0xf7, 0xca, 0xf0, 0x60, 0x15, 0x64, 0x8a, 0x0c, 0x47, 0xbe, 0x0e,
+    0xf1, 0x10, 0x6d, 0x41, 0xe8, 0x7c, 0x91, 0xc0, 0xf0, 0x10, 0xde, 0x85, 0x35, 0x0d, 0x5d, 0x30,
+    0xc5, 0xf0, 0x24, 0x2e, 0x56, 0xb6, 0xc4, 0x1b, 0x6d, 0x4d, 0xbd, 0x64, 0x01, 0x36, 0xba, 0xae,
+    0xe6, 0x56, 0xd1, 0x21, 0xbc, 0x4a, 0x58, 0x3b, 0x9e, 0xf5, 0x82, 0x26, 0xa4, 0x18, 0xce, 0x51,
+    0x8b, 0xb1, 0x47, 0x57, 0x7c, 0x8a, 0xd4, 0xfc, 0x19, 0xb2, 0x0b, 0xec, 0xb1, 0xb5, 0x70, 0x63,
+    0x46, 0x1b, 0x98, 0x00, 0xfe, 0x8b, 0xe7, 0x33, 0xbc, 0xaf, 0x0f, 0xb2, 0x6b, 0x68, 0x1c, 0x34,
+    0x56, 0x6f, 0x65, 0x11, 0x40, 0xa0, 0x77, 0xf2, 0x34, 0xa6, 0x57, 0xe9, 0x45, 0xfa, 0x5b, 0xfa,
+    0x3e, 0x7d, 0x95, 0x7e, 0x48, 0xcf, 0xd3, 0x8f, 0x70, 0xf7, 0x26, 0x3d, 0x97, 0x09, 0x5c, 0x18,
+    0xc5, 0x2a, 0x76, 0x21, 0x62, 0x9a, 0xed, 0x45, 0xe9, 0x19, 0xcc, 0x12, 0xfb, 0xcc, 0x78, 0x5d,
+    0x20, 0xe5, 0xe8, 0x7a, 0x16, 0xc0, 0xc2, 0xfc, 0x0f, 0xbe, 0x8d, 0x49, 0xd3, 0x77, 0xee, 0x17,
+    0x19, 0x66, 0x8f, 0x7b, 0x5b, 0xd7, 0x6b, 0xb0, 0xcd, 0x58, 0x92, 0xb0, 0xe5, 0x34, 0xc3, 0x87,
+    0xb3, 0x80, 0x7a, 0xe8, 0xc6, 0xe8, 0xe1, 0x83, 0x23, 0xbb, 0x4e, 0x0b, 0x65, 0xe6, 0x34, 0xe0,
+    0x79, 0x07, 0xa0, 0xbc, 0x04, 0x50, 0x5e, 0xc1, 0xef, 0x3f, 0xe1, 0xf7, 0x67, 0x09, 0xcd, 0x30,
+    0xc4, 0x67, 0x2a, 0xc5, 0x22, 0x34, 0xe5, 0xc2, 0x52, 0x49, 0x56, 0xa8, 0x1b, 0x76, 0x19, 0x6d,
+    0x23, 0x2e, 0xa3, 0x8c, 0xcb, 0xf3, 0xbc, 0x9c, 0x43, 0xc2, 0x35, 0x2e, 0x9c, 0x7b, 0x94, 0x47,
+    0x01, 0x86, 0xaa, 0xa0, 0x61, 0x46, 0xb8, 0x59, 0xc0, 0xdc, 0xd3, 0x2a, 0x24, 0x5a, 0x5c, 0x30,
+    0x50, 0x4d, 0x9b, 0x90, 0x4d, 0xa2, 0x79, 0xc4, 0x65, 0x31, 0x4e, 0x28, 0x03, 0xcc, 0x42, 0x16,
+    0x92, 0x3a, 0xb3, 0xab, 0x10, 0xb4, 0xb3, 0x53, 0x8b, 0x7d, 0x22, 0x88, 0x65, 0x96, 0xa4, 0xeb,
+    0x26, 0x63, 0x12, 0x43, 0xf9, 0xd1, 0x7c, 0x3a, 0x7d, 0x68, 0x72, 0x44, 0x30, 0x27, 0x95, 0xd5,
+    0x4c, 0x17, 0xec, 0x4c, 0xd5, 0x44, 0xad, 0xf0, 0xaa, 0xa1, 0x14, 0xe1, 0x55, 0xc8, 0x9f, 0xf9,
+    0xf5, 0x59, 0x0c, 0x48, 0x65, 0x7f, 0x06, 0x38, 0x21, 0xcf, 0xf6, 0x35, 0x40, 0xed, 0xa0, 0x96,
+    0xa7, 0xdf, 0xd3, 0xd7, 0x40, 0x5c, 0x91, 0xa1, 0x0b, 0x95, 0x21, 0x4e, 0x5c, 0x11, 0x50, 0x77,
+    0x96, 0x4c, 0xbb, 0x33, 0x4b, 0xd5, 0x55, 0xb6, 0x93, 0xb3, 0xb3, 0x1c, 0x6b, 0x6a, 0x82, 0xc5,
+    0x55, 0x8b, 0xf0, 0x23, 0x14, 0xd9, 0x87, 0xf4, 0x32, 0xfd, 0xa4, 0xe2, 0x13, 0xcb, 0xd2, 0xc4,
+    0x2b, 0x51, 0x4f, 0x88, 0xb2, 0x56, 0x03, 0x3c, 0x23, 0x41, 0x93, 0x0f, 0x6d, 0x22, 0xd4, 0x38,
+    0xdc, 0x9f, 0xd9, 0x5a, 0xbd, 0x81, 0x77, 0x1a, 0x46, 0xab, 0xe4, 0xc7, 0x64, 0x1b, 0x91, 0x43,
+    0xc1, 0x9c, 0x9f, 0x06, 0xa8, 0x32, 0x12, 0x61, 0xce, 0xd7, 0xb0, 0xe2, 0xfa, 0x68, 0xb8, 0x5a,
+    0xce, 0x48, 0x5c, 0x1f, 0x23, 0x4b, 0x4c, 0x83, 0xfa, 0x90, 0x4f, 0x03, 0x02, 0x23, 0x9c, 0x04,
+    0x90, 0x89, 0x41, 0xc6, 0x4b, 0x1c, 0x13, 0xc9, 0xec, 0x52, 0x15, 0x6f, 0x36, 0x13, 0xa1, 0x37,
+    0x13, 0x61, 0x7e, 0x41, 0x22, 0x3a, 0xc5, 0xba, 0x9f, 0x9f, 0x59, 0xbc, 0x53, 0x9f, 0xb9, 0x2b,
+    0x2e, 0x43, 0x95, 0x77, 0x32, 0xe0, 0xfc, 0xbe, 0x08, 0x9b, 0xad, 0x12, 0x51, 0x88, 0xd5, 0xaa,
+    0x2a, 0x22, 0xe9, 0x2a, 0xae, 0xba, 0x48, 0x8b, 0xcb, 0x92, 0x1a, 0x3d, 0x76, 0x06, 0xc8, 0x18,
+    0xdb, 0x03, 0x34, 0xd1, 0x07, 0x28, 0x97, 0xea, 0x0a, 0x5d, 0xde, 0x80, 0xf4, 0xbc, 0x07, 0x65,
+    0x7e, 0x03, 0x84, 0xde, 0x07, 0x72, 0xff, 0x0a, 0xd4, 0x16, 0x62, 0xf4, 0x59, 0x70, 0xfd, 0x02,
+    0xfe, 0x5d, 0xc1, 0xe0, 0x65, 0x7a, 0x7e, 0xa0, 0xe8, 0x34, 0x4b, 0xc2, 0xeb, 0x35, 0xa3, 0x5e,
+    0xd6, 0x4e, 0x13, 0xe7, 0xd6, 0x9a, 0x76, 0xa2, 0x3b, 0xea, 0x24, 0x9a, 0x52, 0x60, 0x77, 0x15,
+    0x73, 0x01, 0x48, 0xc4, 0x68, 0x98, 0x90, 0xf8, 0x5a, 0x71, 0xaa, 0xe7, 0xc8, 0x92, 0x39, 0xda,
+    0x25, 0x75, 0x0d, 0xe6, 0x57, 0x1e, 0xc0, 0xa8, 0x24, 0x98, 0x59, 0x57, 0x46, 0x1c, 0xd0, 0x39,
+    0xcc, 0xe0, 0x92, 0x3c, 0x28, 0x21, 0x51, 0x00, 0x5d, 0x4d, 0xa0, 0x7a, 0x54, 0xc7, 0xcc, 0x54,
+    0xa7, 0x9d, 0xd6, 0x51, 0x21, 0x91, 0x8d, 0xbd, 0xd7, 0x3e, 0x50, 0xde, 0xb5, 0x28, 0xa6, 0x10,
+    0xeb, 0xf6, 0xcb, 0x04, 0xb0, 0xf1, 0xf2, 0x0e, 0x0d, 0xb5, 0xb1, 0x3e, 0xba, 0x5b, 0xbe, 0x00,
+    0xca, 0xc7, 0x42, 0xaf, 0x67, 0x3e, 0xd3, 0xb8, 0xeb, 0x1c, 0x59, 0xbb, 0xe6, 0x53, 0xaf, 0xf7,
+    0xcf, 0xa8, 0xcf, 0xc6, 0x9e, 0x87, 0xcb, 0x57, 0x3c, 0x1c, 0xce, 0xbb, 0x2d, 0x8f, 0x46, 0x23,
+    0xcb, 0x72, 0x76, 0x4d, 0x97, 0xbf, 0xdb, 0x3f, 0x97, 0x67, 0x99, 0xbe, 0xe9, 0x97, 0xf6, 0x45,
+    0x05, 0x76, 0x98, 0x66, 0xc9, 0x8a, 0xa0, 0x64, 0xc3, 0xa4, 0x7f, 0xbf, 0xeb, 0xd0, 0x14, 0xf9,
+    0xb8, 0x31, 0xc3, 0xff, 0xd9, 0xb4, 0x6a, 0x7b, 0xd2, 0x7b, 0xb8, 0x7e, 0x49, 0xff, 0x82, 0x4a,
+    0x7d, 0x57, 0xeb, 0x1d, 0x96, 0x7c, 0x5e, 0x78, 0xad, 0xb7, 0x08, 0x66, 0x1f, 0xb1, 0x4d, 0xfd,
+    0xba, 0x0d, 0x78, 0x67, 0x13, 0x14, 0x10, 0x1f, 0x46, 0x47, 0x72, 0xc1, 0xf9, 0x42, 0x21, 0x08,
+    0x8d, 0xaf, 0x5c, 0x97, 0x70, 0xde, 0xb5, 0x44, 0x32, 0xf1, 0x6d, 0x32, 0xa9, 0xc3, 0x68, 0x92,
+    0x31, 0x24, 0xa3, 0xe5, 0xba, 0xa5, 0x7c, 0xd2, 0x3d, 0x89, 0x63, 0xd6, 0x89, 0x9f, 0xef, 0x93,
+    0x19, 0x69, 0xf4, 0x24, 0xae, 0x63, 0x4e, 0xcc, 0x49, 0xbf, 0x73, 0x49, 0x24, 0xe9, 0x7c, 0x8d,
+    0xe3, 0x10, 0xa0, 0xeb, 0x76, 0xef, 0x4f, 0x88, 0x51, 0x77, 0xef, 0xdb, 0x63, 0xb7, 0x03, 0x96,
+    0xd2, 0xfd, 0xd1, 0x43, 0x43, 0x1f, 0x97, 0xee, 0x69, 0xe8, 0xb3, 0x4e, 0x5c, 0x2c, 0x20, 0xa3,
+    0x57, 0xf7, 0x6d, 0xd8, 0x8e, 0xed, 0xee, 0xf0, 0x2d, 0x4b, 0xae, 0x42, 0x8e, 0x97, 0x40, 0x0f,
+    0xd1, 0x77, 0x5f, 0x66, 0xbd, 0xf7, 0x79, 0x26, 0xe7, 0x6f, 0xd3, 0xbf, 0x81, 0x28, 0x9f, 0xd2,
+    0xd7, 0x28, 0xfd, 0x07, 0x6e, 0x84, 0xbe, 0x0b, 0xe6, 0x5c, 0x55, 0x7a, 0x86, 0x05, 0x09, 0xa2,
+    0x46, 0xdf, 0xec, 0x38, 0xce, 0x0e, 0x69, 0x2e, 0x88, 0x94, 0xb0, 0x08, 0x68, 0x51, 0x17, 0xf1,
+    0x64, 0x1b, 0x80, 0x29, 0x4d, 0x40, 0x10, 0xdd, 0x7c, 0xdd, 0x3c, 0xc1, 0xc9, 0x8a, 0x6b, 0x1e,
+    0x4b, 0xae, 0xdf, 0x49, 0x94, 0xba, 0x4a, 0xa7, 0xea, 0x28, 0xd4, 0xd7, 0x2c, 0xda, 0x72, 0xa3,
+    0xaf, 0xab, 0xb9, 0x6a, 0xf1, 0xa1, 0xd6, 0x12, 0xea, 0xe2, 0x40, 0x2a, 0xf4, 0x92, 0x7a, 0x5e,
+    0x50, 0xe8, 0x04, 0x84, 0xa4, 0xb1, 0x53, 0x71, 0x9e, 0xec, 0x28, 0x43, 0x38, 0x4c, 0x66, 0x06,
+    0x82, 0x11, 0x4d, 0x93, 0x22, 0xad, 0xd2, 0x04, 0x18, 0xd9, 0xb2, 0xc8, 0x79, 0x25, 0x2d, 0x98,
+    0xef, 0x37, 0x2d, 0x66, 0xb3, 0x59, 0x76, 0x60, 0x95, 0xb9, 0x7b, 0x0b, 0x39, 0x3b, 0x87, 0x1d,
+    0xf9, 0x75, 0xfa, 0x41, 0x25, 0x26, 0x60, 0xd8, 0x2b, 0xb5, 0xa2, 0x90, 0x18, 0xab, 0x94, 0x18,
+    0xdf, 0x12, 0x57, 0x0d, 0x97, 0x2c, 0x27, 0x56, 0xf7, 0xb9, 0xa4, 0x0f, 0xba, 0x02, 0xf5, 0x52,
+    0x0f, 0x24, 0xea, 0xe5, 0x08, 0x0e, 0x61, 0xb7, 0xc8, 0x77, 0x51, 0x1e, 0xd1, 0x10, 0x19, 0x3c,
+    0x3b, 0xaa, 0xe2, 0x18, 0x92, 0xe8, 0xd3, 0x50, 0xb5, 0xd6, 0x5f, 0x78, 0xb2, 0x80, 0xf5, 0xdf,
+    0x3f, 0x25, 0x5b, 0x3f, 0xc6, 0x4b, 0xc2, 0x73, 0xcf, 0xf9, 0x62, 0xf5, 0x9b, 0x80, 0x57, 0x65,
+    0xc7, 0x8c, 0x19, 0xb0, 0x88, 0xec, 0xeb, 0x1e, 0x99, 0x1f, 0x08, 0xd8, 0x84, 0x8d, 0x68, 0xf2,
+    0x3a, 0xad, 0x2c, 0x47, 0xd9, 0x95, 0x00, 0x9f, 0x7c, 0xff, 0xe0, 0xf8, 0x04, 0xa5, 0x7f, 0x40,
+    0x91, 0x88, 0xc6, 0x47, 0x14, 0xc9, 0xdb, 0x96, 0x86, 0x26, 0x0c, 0x73, 0x49, 0xd3, 0x88, 0xc9,
+    0xbe, 0xc1, 0xa7, 0x1b, 0x52, 0x14, 0x67, 0x06, 0x6f, 0x09, 0x4b, 0xdc, 0xc4, 0xa9, 0x21, 0xbd,
+    0xf6, 0x75, 0x0a, 0xdb, 0x3e, 0x9c, 0x74, 0xf7, 0xd7, 0xcf, 0x41, 0x3a, 0x3c, 0xb2, 0x99, 0xa2,
+    0xbb, 0xf0, 0x93, 0x0f, 0xb1, 0x08, 0xbb, 0x34, 0xd9, 0xaa, 0x8f, 0x11, 0x5d, 0xfd, 0xc5, 0xd3,
+    0x7d, 0x01, 0xd2, 0x41, 0xbb, 0x15, 0xc2, 0x41, 0x50, 0x6d, 0x87, 0x44, 0x35, 0x64, 0x6b, 0x1f,
+    0xf2, 0x05, 0x5b, 0xcb, 0xa6, 0x54, 0x4e, 0x60, 0xec, 0x9a, 0x40, 0xcf, 0x1b, 0x92, 0x92, 0xc8,
+    0x97, 0xd9, 0xfe, 0x74, 0x51, 0x08, 0x4f, 0xd6, 0x5c, 0x0a, 0x5e, 0x9f, 0x83, 0x32, 0x5d, 0x35,
+    0x0f, 0xbc, 0xf7, 0x97, 0xc4, 0xa3, 0x18, 0xed, 0x57, 0x3e, 0x68, 0x8c, 0x1d, 0xa8, 0xdd, 0x03,
+    0xc5, 0x79, 0xf1, 0x35, 0xa7, 0xd1, 0xc4, 0x17, 0xe9, 0xaf, 0x7e, 0x15, 0x69, 0x7c, 0x89, 0x51,
+    0x07, 0x7b, 0xbb, 0x34, 0x17, 0x9f, 0x1d, 0x6a, 0x5f, 0x18, 0x2a, 0xae, 0xc4, 0x67, 0x83, 0x56,
+    0x8b, 0x2f, 0xa7, 0xa9, 0x1e, 0x9c, 0xfb, 0x0e, 0x4b, 0xd5, 0x8f, 0x09, 0x95, 0x63, 0x79, 0x5f,
+    0x7b, 0x28, 0xc6, 0x0b, 0xef, 0x65, 0x83, 0xdd, 0x79, 0x7c, 0x69, 0x17, 0x8e, 0xde, 0x7a, 0xa0,
+    0x1a, 0x55, 0xc5, 0xb6, 0xc2, 0xb7, 0x3a, 0xab, 0x56, 0x00, 0x34, 0x2b, 0x2b, 0xab, 0x9e, 0x15,
+    0x3b, 0x9d, 0x09, 0x7d, 0x82, 0xe4, 0xfe, 0x0b, 0xce, 0xf8, 0x4f, 0xb6, 0x9e, 0x13, 0x00, 0x00,
+};
+
+const uint8_t ASSET_LIVE_JS[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x5d, 0x52, 0xcd, 0x6e, 0xda, 0x40,
+    0x10, 0xbe, 0xf3, 0x14, 0xd3, 0x9b, 0xa9, 0x90, 0xb9, 0x17, 0x71, 0x6a, 0x73, 0x68, 0x14, 0x85,
+    0x03, 0xea, 0x03, 0x2c, 0xf6, 0xd2, 0x38, 0x75, 0xd6, 0x68, 0xbd, 0x80, 0xa2, 0x08, 0x89, 0xe6,
+    0xd0, 0x56, 0x25, 0x2a, 0x8a, 0xd4, 0x7b, 0x5f, 0x81, 0xa0, 0xb8, 0xb8, 0x38, 0x21, 0xaf, 0x30,
+    0xfb, 0x0a, 0x79, 0x92, 0xce, 0xfe, 0x84, 0x38, 0x39, 0x78, 0xb5, 0x3b, 0xf3, 0xcd, 0x37, 0xdf,
+    0x7c, 0xe3, 0x76, 0x1b, 0xf0, 0x0f, 0xee, 0xf0, 0x16, 0x1f, 0xb0, 0xd4, 0x5f, 0x71, 0x8b, 0x2b,
+    0xc0, 0x7b, 0x73, 0x3c, 0xe0, 0x4e, 0x5f, 0x52, 0x66, 0x0b, 0x58, 0xe2, 0x06, 0xef, 0xb0, 0xa0,
+    0xb8, 0xf9, 0x4a, 0xfc, 0x07, 0x6d, 0x3e, 0xe1, 0x42, 0xe5, 0xed, 0xb7, 0xef, 0x80, 0x8a, 0x0a,
+    0x3d, 0xc7, 0xb5, 0x39, 0xa9, 0x8a, 0xae, 0xc4, 0xa3, 0x17, 0x58, 0xe1, 0x8a, 0x42, 0x97, 0x40,
+    0x14, 0x37, 0xfa, 0x27, 0x55, 0x6e, 0xe9, 0xa1, 0xbf, 0xd1, 0xa5, 0x22, 0x8a, 0x2d, 0x85, 0xef,
+    0x3c, 0xdc, 0xf6, 0x22, 0x05, 0x5b, 0xac, 0xf4, 0x2f, 0xfd, 0xdd, 0x37, 0x29, 0x5b, 0x8d, 0x36,
+    0x89, 0xdb, 0xe0, 0x8a, 0x64, 0x14, 0x04, 0xb6, 0x6a, 0x2a, 0x7d, 0x65, 0x6a, 0xeb, 0x9a, 0x4a,
+    0x5c, 0xeb, 0x1f, 0x74, 0x16, 0xd4, 0x76, 0xe9, 0xb8, 0x2a, 0xbd, 0xec, 0xf8, 0x1b, 0x01, 0x76,
+    0x58, 0x18, 0x95, 0x3b, 0xca, 0x13, 0x85, 0x5e, 0xda, 0x1a, 0x17, 0xc2, 0x1b, 0x52, 0x3b, 0x77,
+    0x4a, 0x5d, 0xf9, 0x86, 0x84, 0x18, 0xa6, 0x2b, 0x70, 0xc2, 0xcc, 0x6c, 0x05, 0xc5, 0x56, 0xfa,
+    0xfa, 0x09, 0xb2, 0x06, 0xc9, 0x45, 0xcc, 0x65, 0x68, 0x05, 0x5e, 0x53, 0x7a, 0x03, 0x07, 0xc6,
+    0x8f, 0x7e, 0x36, 0x96, 0x11, 0x37, 0xda, 0x2a, 0x5b, 0xec, 0x86, 0x33, 0x36, 0x92, 0xad, 0xc4,
+    0x5c, 0xbc, 0x30, 0x8b, 0x4c, 0x0e, 0xcc, 0x78, 0x78, 0xaf, 0x97, 0x44, 0xbd, 0x20, 0x62, 0x93,
+    0x36, 0x98, 0xca, 0x14, 0xe9, 0x45, 0x13, 0x1e, 0xe7, 0xbf, 0x1d, 0x4f, 0x81, 0x7f, 0xbd, 0xf5,
+    0x5e, 0x53, 0x69, 0x2d, 0x2b, 0x8d, 0x5d, 0x76, 0x6d, 0x36, 0xb5, 0xb3, 0x58, 0x1a, 0x14, 0x0e,
+    0xfb, 0xbd, 0xe3, 0xb0, 0x31, 0x1c, 0x8b, 0x48, 0x25, 0x99, 0x80, 0x34, 0x99, 0xf0, 0xfe, 0x78,
+    0x90, 0x47, 0x32, 0x19, 0xf0, 0x20, 0x57, 0x92, 0xb3, 0xb3, 0x16, 0xd8, 0x25, 0x1e, 0xb3, 0x33,
+    0xde, 0x82, 0x51, 0x96, 0xa6, 0x9f, 0x64, 0xea, 0x2e, 0x1f, 0x85, 0xe2, 0x72, 0xc2, 0xe8, 0xe5,
+    0x06, 0x6d, 0xc2, 0x45, 0x03, 0x60, 0xc2, 0x24, 0xe4, 0x8a, 0x29, 0x0e, 0x5d, 0xb8, 0x98, 0x75,
+    0x28, 0xb2, 0xa7, 0x67, 0xa3, 0x51, 0x7a, 0x1e, 0xc4, 0x3c, 0x55, 0x8c, 0xb0, 0xd0, 0x1b, 0x9c,
+    0xf2, 0x48, 0x85, 0x2c, 0xcf, 0x93, 0xcf, 0x22, 0xb0, 0x35, 0x2d, 0x70, 0xd9, 0x8e, 0xa7, 0x74,
+    0x51, 0x7a, 0xce, 0xea, 0x3c, 0xa6, 0x79, 0x60, 0x18, 0x86, 0x5c, 0x45, 0x27, 0x81, 0x17, 0xd5,
+    0x0c, 0xd5, 0x09, 0x17, 0xc1, 0x1e, 0x15, 0x18, 0x41, 0xc4, 0xa3, 0xc6, 0x52, 0x80, 0x0c, 0x4f,
+    0xf3, 0x4c, 0x04, 0x86, 0xc9, 0xe3, 0xac, 0x98, 0xd7, 0xcc, 0x43, 0x96, 0xa6, 0x03, 0x16, 0x7d,
+    0xb1, 0xec, 0xae, 0x4d, 0x07, 0x72, 0xae, 0x9e, 0x46, 0xb5, 0xbd, 0x5e, 0x4e, 0xef, 0x29, 0x92,
+    0x21, 0x04, 0x6f, 0xa6, 0x89, 0x88, 0xb3, 0x69, 0x58, 0xdb, 0xb2, 0x55, 0xb9, 0x27, 0xed, 0x78,
+    0x39, 0xae, 0xc4, 0x3a, 0xe5, 0xfe, 0x85, 0x2e, 0x08, 0x3e, 0xad, 0xff, 0x1d, 0xde, 0xfc, 0xa6,
+    0xf1, 0xcf, 0x61, 0x42, 0x16, 0xc7, 0x16, 0x70, 0x94, 0xe4, 0x8a, 0x0b, 0xf2, 0xa6, 0xb6, 0x97,
+    0xe7, 0xa1, 0x6d, 0x47, 0x67, 0xb4, 0x5d, 0xee, 0x88, 0xc9, 0x9c, 0x07, 0x3c, 0x8c, 0x19, 0xd9,
+    0x6a, 0xc7, 0xaf, 0x51, 0x66, 0x44, 0x23, 0x33, 0x49, 0xed, 0x9f, 0x09, 0x4c, 0xbd, 0x19, 0xc6,
+    0x43, 0x48, 0x45, 0x7c, 0xde, 0x77, 0xfb, 0xec, 0x76, 0xeb, 0x12, 0xc3, 0xf7, 0x47, 0xbd, 0xfe,
+    0xc1, 0x87, 0xd7, 0x13, 0xce, 0x80, 0x96, 0x3e, 0x6b, 0xfc, 0x07, 0xce, 0x96, 0xb9, 0x35, 0x32,
+    0x04, 0x00, 0x00,
+};
+
+const uint8_t ASSET_READINGS_JS[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x5a, 0x6f, 0x6f, 0xdc, 0x48,
+    0x19, 0x7f, 0x7f, 0x9f, 0x62, 0x5a, 0x95, 0xb3, 0x7d, 0x71, 0x9c, 0x4d, 0x72, 0x79, 0xd1, 0x6c,
+    0x36, 0x55, 0x2f, 0xf4, 0xd4, 0x42, 0xaf, 0xad, 0x9a, 0x22, 0x5e, 0xe4, 0xaa, 0xd6, 0x6b, 0xcf,
+    0xc6, 0xee, 0x7a, 0xc7, 0xc6, 0x9e, 0xdd, 0x36, 0xda, 0x58, 0xba, 0x1e, 0x12, 0x20, 0x71, 0x42,
+    0x02, 0x4e, 0x42, 0x02, 0x81, 0x74, 0xdf, 0xa0, 0x54, 0x54, 0x54, 0x40, 0x8b, 0xc4, 0x27, 0xd8,
+    0x7c, 0x05, 0x3e, 0x09, 0xcf, 0x33, 0xe3, 0x3f, 0x33, 0xb6, 0x37, 0xdd, 0x50, 0x40, 0xf7, 0x82,
+    0x9c, 0x4e, 0xf5, 0x3c, 0x33, 0xcf, 0xef, 0xf9, 0x3b, 0xcf, 0x3c, 0x33, 0xda, 0xd1, 0x94, 0x79,
+    0x3c, 0x8c, 0x19, 0xc9, 0x28, 0x37, 0x43, 0xdf, 0x9e, 0x59, 0xf3, 0x70, 0x64, 0xce, 0x2e, 0x0d,
+    0x06, 0x53, 0xe6, 0xd3, 0x51, 0xc8, 0xa8, 0xff, 0xe1, 0x87, 0x38, 0x64, 0xd3, 0x28, 0xb2, 0xe6,
+    0x7e, 0xec, 0x4d, 0x27, 0x94, 0x71, 0xe7, 0x98, 0xf2, 0x1b, 0x11, 0xc5, 0xcf, 0x4f, 0x4e, 0x6e,
+    0xf9, 0xc0, 0x69, 0x39, 0x9c, 0x3e, 0xe3, 0x07, 0x31, 0xe3, 0x40, 0x1b, 0xcc, 0xfa, 0x79, 0xfe,
+    0xc1, 0xa8, 0xc4, 0xf6, 0xe2, 0x28, 0x4e, 0xbf, 0x4b, 0x23, 0xee, 0x9a, 0xae, 0x3d, 0xb4, 0xe6,
+    0x33, 0x37, 0x25, 0x7e, 0x38, 0x1a, 0x0d, 0x3e, 0x73, 0x79, 0xe0, 0xb8, 0xc3, 0xcc, 0x74, 0xd7,
+    0x87, 0xd6, 0xc6, 0xf0, 0xa3, 0xcd, 0x5e, 0xaf, 0x0f, 0xe2, 0x71, 0x6e, 0x7f, 0xbb, 0x67, 0xa5,
+    0x94, 0x4f, 0x53, 0x46, 0x8c, 0x94, 0xfa, 0x46, 0x45, 0xdf, 0xaa, 0xe9, 0x71, 0xea, 0xb2, 0x63,
+    0x5a, 0x4f, 0x6d, 0xd6, 0x53, 0x27, 0x34, 0x8a, 0xe2, 0xa7, 0x46, 0xbf, 0x1c, 0x1b, 0xfd, 0xa6,
+    0x3e, 0xf7, 0x91, 0xd7, 0x9c, 0xd9, 0x93, 0x90, 0xd9, 0x13, 0xf7, 0x99, 0xd4, 0x2a, 0x4b, 0x5c,
+    0x36, 0x30, 0x61, 0xb8, 0x0e, 0x64, 0x0b, 0x81, 0x91, 0xb2, 0x37, 0xa8, 0x81, 0x85, 0xb4, 0xd9,
+    0x1e, 0x4c, 0x9f, 0x9e, 0xce, 0xf6, 0x91, 0xb1, 0xa9, 0xa5, 0x98, 0x5c, 0xeb, 0x39, 0xbd, 0x9d,
+    0x8f, 0x90, 0xb9, 0x58, 0xb6, 0x5e, 0x11, 0xba, 0xd4, 0x2f, 0x79, 0x36, 0x7b, 0x0d, 0x9e, 0x82,
+    0xb0, 0x9a, 0x5d, 0x6e, 0x92, 0x44, 0x27, 0x07, 0x68, 0x9c, 0x50, 0xfb, 0x96, 0x6f, 0x7b, 0x51,
+    0x26, 0x0d, 0xa3, 0xd1, 0x60, 0x59, 0xec, 0xe4, 0x52, 0x61, 0xec, 0x25, 0x1a, 0x15, 0x92, 0xfa,
+    0x34, 0x72, 0xbc, 0xc8, 0xcd, 0xb2, 0xdb, 0x61, 0xc6, 0x9d, 0x94, 0x4e, 0xe2, 0x19, 0x35, 0x85,
+    0x89, 0x76, 0xa9, 0xb7, 0x5d, 0x2a, 0x63, 0x1b, 0xc7, 0x29, 0xa5, 0xcc, 0x10, 0x10, 0x42, 0xa2,
+    0xc6, 0xec, 0xfa, 0xbe, 0xa0, 0xf6, 0x73, 0x1a, 0x65, 0xb4, 0x3d, 0x57, 0x71, 0xe7, 0x39, 0x6a,
+    0x1a, 0x85, 0x93, 0x90, 0x67, 0x83, 0x39, 0xa7, 0x93, 0x64, 0x77, 0x0e, 0x6e, 0xd9, 0x5d, 0xff,
+    0x78, 0x07, 0x23, 0xb4, 0xbb, 0xb9, 0xb9, 0x93, 0xdb, 0xc1, 0x74, 0x22, 0xa9, 0x3d, 0x49, 0xeb,
+    0xf5, 0x72, 0x9b, 0x7a, 0x0d, 0x12, 0x12, 0x93, 0x40, 0x12, 0xb7, 0x05, 0xf1, 0x6a, 0x6e, 0x33,
+    0x6d, 0xd1, 0xd5, 0xab, 0x40, 0x4a, 0xda, 0xa4, 0x71, 0x8b, 0x94, 0xf7, 0x6b, 0x0f, 0xa7, 0x14,
+    0x76, 0x45, 0x7a, 0x48, 0x59, 0x06, 0x3e, 0xf6, 0xad, 0x39, 0xee, 0x1a, 0x03, 0x35, 0x7d, 0x94,
+    0xba, 0xe0, 0x08, 0xdf, 0x81, 0x7f, 0x1e, 0xe1, 0x98, 0xa6, 0x2e, 0xb8, 0x91, 0x5a, 0x7d, 0xb1,
+    0x02, 0x94, 0x56, 0x17, 0xc0, 0x30, 0xf4, 0x43, 0x7e, 0x52, 0xcc, 0x52, 0x4f, 0x9d, 0xa4, 0x5e,
+    0x41, 0x4e, 0x02, 0x95, 0x9c, 0x04, 0x05, 0x99, 0xa9, 0x54, 0x16, 0xf2, 0x34, 0x3e, 0xa6, 0xac,
+    0x64, 0xd1, 0x39, 0xe2, 0x0c, 0xfe, 0x4f, 0xa7, 0x59, 0x31, 0x3b, 0xd6, 0x66, 0x63, 0x0e, 0x41,
+    0x08, 0xa7, 0x93, 0x62, 0x52, 0x1a, 0x41, 0x3d, 0x31, 0x0f, 0x1a, 0x2d, 0x31, 0xa2, 0x5e, 0xd0,
+    0x61, 0x44, 0x3d, 0xa9, 0x19, 0x51, 0x93, 0x55, 0x23, 0x6a, 0x6a, 0xdb, 0x08, 0x95, 0xa3, 0x6d,
+    0x84, 0x32, 0x5b, 0x1b, 0xe1, 0xc5, 0x2c, 0xe3, 0x84, 0xc7, 0x51, 0x91, 0x39, 0x3d, 0x67, 0x4b,
+    0xe4, 0x4a, 0xcf, 0xd9, 0xc1, 0xfc, 0xd8, 0xea, 0x61, 0x42, 0xe0, 0x1e, 0x84, 0x3c, 0xd8, 0x81,
+    0xc0, 0x6f, 0x43, 0xa4, 0xb7, 0xd5, 0xd0, 0xba, 0x69, 0x1a, 0x3f, 0x3d, 0x0c, 0x8f, 0x99, 0x39,
+    0x74, 0x33, 0x6a, 0xcf, 0xdc, 0xc8, 0xe6, 0x41, 0x6a, 0xcd, 0x71, 0x34, 0x48, 0xdc, 0x34, 0xa3,
+    0x9f, 0x46, 0xb1, 0xcb, 0xc5, 0xac, 0xd5, 0x87, 0x69, 0x95, 0x08, 0x43, 0x91, 0xfd, 0x61, 0x76,
+    0xc7, 0xbd, 0x23, 0x97, 0x9c, 0x9e, 0xca, 0x01, 0x4e, 0x35, 0xaa, 0x87, 0x1b, 0xed, 0xe3, 0x92,
+    0x35, 0xc4, 0x2f, 0x67, 0xfe, 0xf9, 0x93, 0x5f, 0x92, 0x72, 0x76, 0x0f, 0x67, 0xd7, 0xf5, 0xd9,
+    0x5f, 0x13, 0x6d, 0xd3, 0x2b, 0x8a, 0x67, 0x41, 0xfc, 0xf4, 0x87, 0x21, 0x0f, 0xae, 0xa3, 0x01,
+    0x58, 0xc3, 0x33, 0x30, 0x02, 0xf5, 0x9f, 0xd2, 0xd5, 0x0b, 0x36, 0xf2, 0xac, 0x09, 0x9e, 0x7e,
+    0xae, 0x03, 0x8a, 0xcc, 0x30, 0x6c, 0xc5, 0x3f, 0xad, 0x2c, 0x27, 0x10, 0x0e, 0x6d, 0x08, 0x61,
+    0x10, 0x04, 0xcb, 0x26, 0xda, 0x0c, 0xc4, 0x50, 0xc7, 0x86, 0x08, 0x01, 0x74, 0x0b, 0xbb, 0xcc,
+    0x2d, 0x02, 0x7f, 0x80, 0xad, 0x0d, 0x11, 0x1b, 0x08, 0x44, 0x60, 0x2b, 0x49, 0xa8, 0x03, 0x63,
+    0x8e, 0x90, 0x36, 0x30, 0xf5, 0x48, 0xf5, 0x07, 0xc0, 0xda, 0x10, 0x81, 0x91, 0x20, 0x80, 0x45,
+    0x02, 0xeb, 0x90, 0x49, 0xd0, 0x09, 0x99, 0x04, 0x1a, 0xa4, 0x36, 0x44, 0x48, 0x24, 0x08, 0x48,
+    0x91, 0xfc, 0x3a, 0x24, 0x13, 0x88, 0x2d, 0xc8, 0x72, 0x43, 0x14, 0x90, 0xda, 0x10, 0x21, 0xf1,
+    0x4b, 0x40, 0x2a, 0x3b, 0xa7, 0xa1, 0x6b, 0x37, 0x70, 0xbd, 0x9b, 0x0a, 0x5d, 0x95, 0xa1, 0xd0,
+    0x95, 0x54, 0xba, 0x2a, 0xdb, 0x4e, 0x87, 0x1e, 0x2f, 0x81, 0x2e, 0xb7, 0x62, 0xe1, 0x06, 0x75,
+    0x88, 0xd0, 0xe3, 0x0a, 0x5a, 0x29, 0x3c, 0xed, 0x44, 0x93, 0xbb, 0x5b, 0x43, 0x6f, 0x24, 0x5a,
+    0xa3, 0x38, 0x35, 0x92, 0xad, 0x5d, 0xba, 0x5a, 0x09, 0x57, 0x88, 0xd0, 0x64, 0x34, 0x12, 0x4e,
+    0xad, 0x6f, 0xed, 0xa4, 0x6b, 0x54, 0xbf, 0x66, 0xe2, 0x95, 0xf8, 0x9a, 0x80, 0x46, 0xe2, 0xc9,
+    0x1a, 0xb9, 0x2c, 0xf9, 0xaa, 0x0a, 0xda, 0x4c, 0xc0, 0x4e, 0xe8, 0x46, 0x02, 0xca, 0xaa, 0xb9,
+    0x2c, 0x09, 0xab, 0x2a, 0xdc, 0x48, 0xc4, 0x0a, 0x59, 0x83, 0x6e, 0x24, 0xa2, 0x5a, 0xac, 0xdb,
+    0xc9, 0xd8, 0x28, 0xe5, 0x0d, 0xdd, 0xbb, 0x05, 0x34, 0x12, 0x52, 0xaf, 0xf8, 0xcd, 0xa4, 0x6c,
+    0x9d, 0x07, 0x8d, 0xc4, 0x5c, 0x22, 0x42, 0x4f, 0x4c, 0xed, 0xd8, 0x68, 0x25, 0x67, 0xe3, 0x50,
+    0xa9, 0x8b, 0xec, 0x34, 0xf1, 0x5d, 0x4e, 0x0f, 0xa9, 0x9b, 0xc5, 0xcc, 0x8d, 0xae, 0xfb, 0x4f,
+    0xa6, 0x19, 0xc7, 0x62, 0x9a, 0x99, 0x99, 0xa0, 0x59, 0x64, 0x4e, 0x88, 0x3c, 0x83, 0xdc, 0x7a,
+    0x92, 0x0c, 0x90, 0x4c, 0x88, 0xb1, 0xf8, 0xd5, 0xe2, 0xd5, 0xd9, 0xf3, 0xc5, 0x9b, 0xc5, 0x0b,
+    0x63, 0x17, 0x48, 0x6c, 0x97, 0x18, 0x6b, 0x5b, 0xbd, 0xef, 0x80, 0xb6, 0x09, 0x7e, 0x6e, 0xee,
+    0xe0, 0xe7, 0x58, 0x7c, 0x02, 0x95, 0xe4, 0xb6, 0xe4, 0xfa, 0x1d, 0x70, 0x7d, 0xb9, 0x78, 0x5b,
+    0xf1, 0xac, 0x6f, 0xd6, 0x3c, 0x35, 0xcb, 0xd6, 0x8e, 0xc2, 0xf2, 0x07, 0x10, 0xf3, 0x6a, 0xf1,
+    0xe6, 0xec, 0xab, 0x9a, 0x49, 0x15, 0xd4, 0xab, 0x05, 0xa9, 0x5c, 0xbf, 0x59, 0xbc, 0x5e, 0xfc,
+    0x4d, 0x51, 0x6e, 0x7d, 0xbb, 0x4b, 0x90, 0xe0, 0x20, 0x24, 0xef, 0x2b, 0xa6, 0x82, 0x89, 0x8a,
+    0xc1, 0x47, 0xd2, 0x1b, 0x0f, 0xc9, 0xe9, 0x69, 0x81, 0x54, 0xa0, 0x14, 0x10, 0x86, 0x60, 0x3e,
+    0x12, 0x85, 0x4f, 0x14, 0x29, 0x28, 0x27, 0x0f, 0x9d, 0x51, 0x9c, 0xde, 0x70, 0xbd, 0xc0, 0xa4,
+    0x70, 0x40, 0x91, 0xc1, 0xbe, 0xf4, 0x99, 0x94, 0x80, 0xcd, 0x29, 0x88, 0x58, 0x76, 0x8c, 0x09,
+    0x8e, 0x35, 0x62, 0x3c, 0x92, 0x72, 0xa1, 0x89, 0x44, 0xd6, 0xa2, 0x6d, 0xb7, 0x24, 0x10, 0x11,
+    0x20, 0xea, 0x69, 0x27, 0x75, 0x3e, 0x42, 0xe6, 0x87, 0xe4, 0x1a, 0x79, 0x4c, 0xcc, 0x2b, 0xf3,
+    0x8a, 0x90, 0x5b, 0x8f, 0x09, 0x6a, 0xda, 0x57, 0x78, 0x45, 0xc3, 0x7a, 0xc7, 0x9d, 0x50, 0xe0,
+    0x34, 0xa4, 0xa8, 0x75, 0xb4, 0xdd, 0x00, 0xd9, 0x66, 0xc5, 0xe9, 0x64, 0xdc, 0x4d, 0x79, 0x86,
+    0x29, 0x69, 0x1a, 0x6b, 0x86, 0x05, 0xd0, 0xc6, 0x34, 0x31, 0x10, 0xcd, 0x8f, 0x9f, 0x96, 0xca,
+    0xa1, 0x03, 0xa1, 0xd7, 0xc5, 0x56, 0x37, 0x64, 0x70, 0xe2, 0x86, 0x3e, 0xda, 0xe7, 0x84, 0x69,
+    0x1a, 0x1e, 0xbb, 0x22, 0xd7, 0xc0, 0x77, 0xbe, 0xe3, 0x46, 0x14, 0xb0, 0x9c, 0x88, 0xb2, 0x63,
+    0x1e, 0xec, 0xf7, 0x24, 0xb1, 0xac, 0x3a, 0x7b, 0x5b, 0x3b, 0x92, 0xa0, 0x94, 0xba, 0xbd, 0x36,
+    0x69, 0xff, 0xe3, 0x5e, 0x5f, 0xdc, 0x6a, 0x38, 0x0c, 0xb3, 0x9b, 0x7c, 0x12, 0x81, 0xa8, 0x52,
+    0x28, 0x28, 0xb7, 0x27, 0xbc, 0x2b, 0x8c, 0x1b, 0x5c, 0x86, 0xde, 0xfe, 0xf2, 0xfe, 0xe2, 0xeb,
+    0xc5, 0x0b, 0xc8, 0xd2, 0x37, 0x67, 0x3f, 0x5f, 0xbc, 0xfa, 0x90, 0x0d, 0xb3, 0xa4, 0x0f, 0xa3,
+    0xf2, 0xeb, 0x25, 0xcc, 0xfd, 0x15, 0x12, 0xe5, 0x4f, 0x38, 0xbf, 0xb7, 0x81, 0xcc, 0xfb, 0xc2,
+    0x3a, 0x0d, 0x47, 0x74, 0xf3, 0x9d, 0x48, 0x9d, 0xfc, 0x52, 0x41, 0xe1, 0x52, 0x71, 0x73, 0x19,
+    0xcc, 0x95, 0xb4, 0x2f, 0xae, 0x06, 0xb6, 0xb6, 0x7f, 0xea, 0x6b, 0x87, 0x9a, 0xec, 0x0a, 0xb5,
+    0x4a, 0xe6, 0xe2, 0xbe, 0xb2, 0xf8, 0xfd, 0xc6, 0xe2, 0x6b, 0x18, 0x19, 0xf9, 0x91, 0xef, 0x14,
+    0x09, 0x7a, 0x7a, 0x6a, 0xa8, 0xa2, 0xd1, 0x37, 0x03, 0x45, 0x8b, 0x6b, 0xe6, 0x63, 0xd5, 0xa8,
+    0xcf, 0x2f, 0x5f, 0x99, 0x2b, 0xb3, 0xf9, 0xe7, 0x97, 0xf7, 0xaf, 0xcc, 0x4b, 0xac, 0xbc, 0x30,
+    0xe5, 0xb1, 0xb5, 0x5b, 0x92, 0xfa, 0xcb, 0xf2, 0xd5, 0x90, 0xa1, 0xb8, 0xc5, 0x46, 0xb1, 0x61,
+    0x39, 0x21, 0x63, 0x34, 0xbd, 0xf9, 0xe0, 0xb3, 0xdb, 0x83, 0x3a, 0x42, 0x6b, 0x06, 0x39, 0x25,
+    0x8b, 0x6f, 0xc0, 0xac, 0x3f, 0x2f, 0xde, 0x2e, 0xde, 0xe0, 0xb6, 0xab, 0x55, 0xec, 0x2f, 0x2f,
+    0x43, 0xa5, 0x68, 0x4b, 0x58, 0xc5, 0x67, 0xa9, 0xda, 0x9e, 0x76, 0xdc, 0x4b, 0x94, 0xbb, 0xa2,
+    0x72, 0x81, 0x51, 0x6e, 0xc6, 0x00, 0x61, 0xcb, 0xbb, 0x98, 0x48, 0x29, 0x07, 0xef, 0xc9, 0xda,
+    0x18, 0xae, 0xbe, 0x52, 0x58, 0xd0, 0x25, 0xac, 0x3e, 0x20, 0x55, 0x49, 0xd5, 0x45, 0x48, 0x11,
+    0x14, 0xd4, 0x82, 0x60, 0x5a, 0x95, 0x23, 0x86, 0x95, 0x18, 0xda, 0x25, 0x06, 0x8f, 0x49, 0x55,
+    0x40, 0x79, 0x97, 0x52, 0xf0, 0x69, 0x8d, 0x4f, 0x3d, 0x15, 0x1e, 0x47, 0x15, 0x7a, 0xd2, 0x85,
+    0x8e, 0x27, 0xa5, 0x8a, 0x5e, 0x5e, 0xc9, 0x14, 0xf4, 0xa4, 0x46, 0x4f, 0x02, 0x15, 0x1d, 0x47,
+    0x15, 0x3a, 0xeb, 0x42, 0xaf, 0x0f, 0x4b, 0x55, 0x06, 0x6b, 0x89, 0x60, 0xb5, 0x08, 0xa6, 0x4a,
+    0x60, 0xaa, 0xfa, 0x5b, 0x9d, 0xea, 0xd7, 0x87, 0xa5, 0x66, 0x46, 0xdb, 0x8a, 0xad, 0xda, 0x0a,
+    0xcd, 0x08, 0x45, 0xc4, 0xb8, 0xd3, 0x43, 0xf5, 0x61, 0xa9, 0x4a, 0x18, 0xb7, 0x24, 0x8c, 0x6b,
+    0x23, 0xc6, 0xaa, 0x84, 0x71, 0x21, 0xe1, 0xa8, 0xb8, 0x67, 0xc8, 0x2b, 0x81, 0xe8, 0xdf, 0x45,
+    0xc7, 0x8d, 0x47, 0x05, 0x9e, 0x14, 0xda, 0x41, 0x51, 0x1e, 0xcb, 0x78, 0x8d, 0x79, 0xd7, 0xf3,
+    0x46, 0x28, 0x9f, 0x36, 0x68, 0xd4, 0x78, 0x96, 0x58, 0xf5, 0x4d, 0x23, 0xcf, 0xa5, 0xf9, 0x1e,
+    0xd7, 0xad, 0xd7, 0x76, 0x93, 0x58, 0x10, 0xe8, 0x0b, 0xea, 0x1d, 0x20, 0x66, 0xa9, 0x3e, 0x8b,
+    0x89, 0x2b, 0xe8, 0x49, 0x83, 0x0d, 0x73, 0x4e, 0x4c, 0x30, 0x9d, 0x5e, 0x67, 0x8b, 0x64, 0x6b,
+    0x72, 0xd5, 0xa1, 0x16, 0xf3, 0xe3, 0xc6, 0x7c, 0x77, 0x9c, 0x94, 0x96, 0x5b, 0x79, 0xa4, 0xf3,
+    0x38, 0x1c, 0xda, 0x5a, 0xa4, 0x1b, 0x5d, 0xb5, 0xd5, 0xb1, 0xab, 0x65, 0xef, 0xa5, 0xa2, 0x04,
+    0x1d, 0x28, 0x95, 0x53, 0xac, 0xf6, 0xbe, 0x2d, 0xba, 0x37, 0x15, 0x82, 0x76, 0x40, 0x80, 0xe7,
+    0xac, 0xf6, 0xb6, 0xec, 0x60, 0x4e, 0x02, 0xbb, 0xc5, 0x0c, 0xde, 0xb5, 0x5a, 0xfb, 0xad, 0x6c,
+    0x1b, 0x55, 0x66, 0xd6, 0x21, 0xb9, 0x0a, 0x81, 0xd5, 0xda, 0x4f, 0x5d, 0x10, 0x49, 0x07, 0x84,
+    0x12, 0x27, 0xab, 0xb5, 0x65, 0xba, 0x40, 0xc6, 0x5d, 0x20, 0x55, 0x30, 0x01, 0x23, 0x6f, 0x36,
+    0xa9, 0x07, 0x70, 0xbc, 0x0f, 0x53, 0xd1, 0x4a, 0x1c, 0x8a, 0x63, 0xc5, 0x14, 0x8d, 0xd0, 0x88,
+    0x72, 0xd8, 0x39, 0xc6, 0x86, 0x9b, 0x84, 0x1b, 0x5e, 0xbd, 0x64, 0x43, 0x1e, 0x3d, 0xd0, 0xad,
+    0xc0, 0x9f, 0xc3, 0x03, 0xca, 0xcc, 0x94, 0x66, 0x09, 0x34, 0x5f, 0x14, 0x5b, 0xb1, 0xf2, 0xdb,
+    0x79, 0x02, 0x67, 0x8b, 0x69, 0x29, 0xab, 0x40, 0x94, 0x5b, 0x35, 0x6b, 0x64, 0x69, 0x87, 0x66,
+    0x28, 0xb2, 0xd6, 0x4b, 0x59, 0xf5, 0xc9, 0x87, 0xbd, 0x0f, 0x00, 0x39, 0x72, 0x46, 0x36, 0x48,
+    0x9a, 0x4d, 0xae, 0xef, 0xdf, 0xbb, 0x79, 0x2f, 0x0e, 0x19, 0x37, 0x95, 0x1e, 0x9b, 0x3e, 0x4b,
+    0xa8, 0xc7, 0x29, 0xb6, 0x4e, 0xaa, 0x77, 0x96, 0xe9, 0x00, 0x09, 0x52, 0x72, 0x80, 0x70, 0xf9,
+    0x34, 0x52, 0x35, 0xb1, 0x13, 0x38, 0x37, 0x21, 0xa9, 0x2f, 0x80, 0x55, 0x72, 0xa8, 0x58, 0xcb,
+    0xdc, 0x9b, 0x04, 0x1b, 0x60, 0x02, 0xc4, 0x55, 0xf8, 0x69, 0x42, 0x79, 0x10, 0xfb, 0x70, 0xa8,
+    0xdf, 0xbb, 0x7b, 0xf8, 0x40, 0x06, 0x3b, 0xa0, 0xae, 0x4f, 0xd3, 0x0c, 0x3a, 0x6f, 0xa3, 0x68,
+    0x4f, 0xd7, 0x1f, 0x9c, 0x24, 0x14, 0x5a, 0x71, 0x03, 0xd3, 0x23, 0xf4, 0x24, 0x0e, 0xfa, 0xdf,
+    0x90, 0xed, 0xfa, 0x30, 0xf6, 0x4f, 0x76, 0xc9, 0xf7, 0x0e, 0xef, 0xde, 0x01, 0xb7, 0xa5, 0x21,
+    0x3b, 0x0e, 0x47, 0x27, 0xe6, 0xbc, 0x34, 0x70, 0xb7, 0x72, 0x8e, 0x5d, 0x99, 0xb6, 0x5b, 0x7d,
+    0xe5, 0x16, 0x3a, 0xf8, 0x3d, 0xe2, 0x8c, 0x6f, 0xed, 0x22, 0x60, 0x53, 0xcf, 0xa3, 0x59, 0x56,
+    0xf5, 0xd8, 0x64, 0x79, 0xf6, 0xf5, 0xcb, 0x15, 0x17, 0x89, 0x0f, 0x76, 0xda, 0xc6, 0x4a, 0x9c,
+    0xcd, 0x68, 0xa8, 0x9c, 0x79, 0x67, 0x42, 0xdd, 0x38, 0x78, 0xdf, 0x84, 0xc2, 0x32, 0xf4, 0x9f,
+    0x4a, 0x28, 0xc0, 0xba, 0x48, 0x42, 0x51, 0xef, 0xff, 0x09, 0xf5, 0xce, 0xb4, 0xe8, 0x88, 0xcf,
+    0x8a, 0x09, 0xd5, 0x11, 0x8d, 0x77, 0x24, 0x54, 0x46, 0xf9, 0x9d, 0x7b, 0xdf, 0x6f, 0x65, 0x14,
+    0x5b, 0x31, 0xfc, 0x2c, 0x19, 0x3f, 0x62, 0xed, 0x24, 0x4a, 0x2e, 0xc0, 0x9e, 0xb4, 0xd9, 0xc7,
+    0x17, 0x60, 0x1f, 0xaf, 0x92, 0x76, 0xb0, 0x70, 0x03, 0x2c, 0xfd, 0x1f, 0xe4, 0x1d, 0xdb, 0x25,
+    0x4c, 0x3c, 0x1a, 0x24, 0xe2, 0xcd, 0x60, 0xfc, 0xed, 0xcc, 0x30, 0x2d, 0x6c, 0x2b, 0xe6, 0x96,
+    0x16, 0xab, 0x0b, 0xf0, 0x8c, 0x57, 0xcc, 0x44, 0x88, 0x97, 0x37, 0x8d, 0xc0, 0xa2, 0x7b, 0x37,
+    0xcf, 0x3f, 0xf3, 0xe1, 0x50, 0xaa, 0xd6, 0x62, 0x44, 0xf5, 0x68, 0xe6, 0xef, 0xdb, 0x0b, 0xbc,
+    0x8f, 0xc3, 0xc5, 0xbb, 0x07, 0xd4, 0xf5, 0x9b, 0x64, 0xf1, 0x97, 0xe2, 0xbd, 0xe0, 0x8f, 0x67,
+    0x5f, 0xc0, 0x55, 0xf8, 0x25, 0x8e, 0x09, 0x7c, 0xbe, 0x38, 0x7b, 0x0e, 0xff, 0xfd, 0x74, 0xf1,
+    0xfa, 0xec, 0x4b, 0xf1, 0xc4, 0xf0, 0xe2, 0x12, 0xb9, 0xff, 0x8f, 0x97, 0xe8, 0x1a, 0xb2, 0x26,
+    0x9b, 0x89, 0xf4, 0x51, 0xf6, 0xa3, 0xa9, 0x0b, 0x3b, 0xd8, 0x5a, 0xc1, 0x57, 0x37, 0x0e, 0xce,
+    0xf7, 0x15, 0xd4, 0xdb, 0x6f, 0xb9, 0xaf, 0x6e, 0x1c, 0xfc, 0x97, 0x7d, 0x05, 0xa5, 0x34, 0x4e,
+    0xb9, 0xa2, 0xc9, 0x3b, 0x3c, 0x26, 0x96, 0xbf, 0x77, 0x47, 0x29, 0x0b, 0xd9, 0x30, 0x8a, 0x87,
+    0xa0, 0x2f, 0xa3, 0x4f, 0xc9, 0x27, 0xf0, 0x69, 0x1e, 0x35, 0xca, 0x05, 0x32, 0xd9, 0x04, 0x7f,
+    0x9d, 0x60, 0x93, 0x2d, 0xeb, 0x21, 0x04, 0x88, 0x43, 0xd1, 0xe9, 0xac, 0x39, 0xa5, 0x85, 0x12,
+    0x78, 0x9a, 0xe2, 0x6b, 0xd8, 0x0f, 0xee, 0xdf, 0x76, 0xbc, 0x94, 0x82, 0xa3, 0xef, 0x0e, 0x9f,
+    0xc0, 0x79, 0x01, 0x63, 0x13, 0x45, 0xea, 0x6b, 0x5d, 0xf5, 0x09, 0x52, 0x2e, 0x2f, 0x36, 0xa9,
+    0x69, 0xb8, 0x46, 0xb9, 0xd6, 0x75, 0x82, 0x94, 0x8e, 0x60, 0x29, 0x40, 0x57, 0x24, 0x7c, 0xf9,
+    0x83, 0x12, 0x8c, 0xcd, 0x80, 0xda, 0x0a, 0x0b, 0xeb, 0x8d, 0x6a, 0x95, 0x07, 0xaa, 0x8e, 0x8b,
+    0xc8, 0xea, 0xbe, 0x0f, 0x27, 0x9d, 0xbe, 0x97, 0x7a, 0x85, 0x2c, 0x99, 0xf2, 0x73, 0x74, 0x13,
+    0xf3, 0x42, 0x3f, 0xf1, 0xe5, 0xa0, 0x6b, 0x50, 0x91, 0x51, 0x18, 0x51, 0xa3, 0xa2, 0xba, 0x90,
+    0x79, 0x09, 0xc2, 0x18, 0x95, 0x56, 0x72, 0x22, 0x66, 0x5e, 0x80, 0xd7, 0x62, 0x98, 0xaa, 0x6e,
+    0xdc, 0xd4, 0x52, 0x9f, 0x67, 0x11, 0x08, 0x66, 0xa9, 0xc3, 0xdd, 0x14, 0x2a, 0x97, 0x83, 0xe3,
+    0xec, 0xa8, 0xf7, 0xb0, 0x5f, 0x2f, 0x49, 0xc5, 0xb1, 0x50, 0x84, 0xf0, 0x53, 0x98, 0xbf, 0x2f,
+    0x08, 0x85, 0xb1, 0x72, 0x16, 0x24, 0x15, 0x3e, 0x6a, 0xc9, 0x59, 0x9e, 0x66, 0xd2, 0x33, 0xe5,
+    0x81, 0xb4, 0xe4, 0x50, 0xfa, 0xf7, 0x0e, 0xa6, 0xfa, 0x70, 0xaa, 0x2c, 0x83, 0xb4, 0x9d, 0x46,
+    0xbc, 0xd8, 0x22, 0x2b, 0x9e, 0x46, 0x4b, 0x53, 0xfb, 0xfc, 0x8d, 0xbf, 0xda, 0xe6, 0x57, 0x0a,
+    0xc0, 0xe2, 0xb7, 0x1d, 0xbb, 0x5f, 0x3c, 0x82, 0xfe, 0x7d, 0xf1, 0xf6, 0xec, 0x0b, 0xd8, 0xfb,
+    0xaf, 0x8b, 0x09, 0x59, 0x03, 0x0c, 0x15, 0x25, 0xaf, 0x3e, 0x8a, 0xf4, 0x53, 0xe3, 0x82, 0xff,
+    0x5c, 0xcf, 0x1e, 0xd0, 0x67, 0xdc, 0xc4, 0xd0, 0xe2, 0x8a, 0xbc, 0x4a, 0x8f, 0x32, 0x69, 0x73,
+    0xf5, 0xf7, 0x11, 0xd0, 0x23, 0xb4, 0x92, 0x15, 0x7f, 0x16, 0x12, 0xb3, 0x51, 0x98, 0x4e, 0x40,
+    0xd7, 0x6f, 0xa4, 0x96, 0x67, 0xcf, 0xb1, 0x28, 0x9d, 0x7d, 0x45, 0x16, 0x2f, 0xa1, 0x42, 0xfd,
+    0xa2, 0xa3, 0x82, 0x9d, 0xfd, 0xf8, 0x9a, 0x61, 0x15, 0x6e, 0x59, 0x96, 0x03, 0x42, 0xde, 0xb2,
+    0xaa, 0xbc, 0x6a, 0xf5, 0x59, 0x1a, 0xa4, 0xf3, 0x42, 0xb4, 0x4a, 0x80, 0xce, 0x0b, 0x0f, 0xd8,
+    0x2f, 0xfd, 0xf0, 0x33, 0x7c, 0xc1, 0xd6, 0x83, 0x92, 0x2b, 0x01, 0xc9, 0xf3, 0x28, 0x9c, 0xd1,
+    0xc3, 0xe9, 0x30, 0xf3, 0xd2, 0x70, 0x48, 0xc1, 0x07, 0x74, 0x86, 0x0f, 0xbe, 0x1b, 0x18, 0x1a,
+    0xa8, 0x81, 0x99, 0x61, 0x1b, 0xc5, 0x27, 0x7c, 0x41, 0x8b, 0x86, 0x3f, 0x4d, 0x79, 0x24, 0x72,
+    0xd9, 0xde, 0xee, 0xf5, 0x7a, 0xb6, 0xfa, 0x93, 0x15, 0xab, 0xbf, 0x5c, 0x6d, 0x70, 0xe4, 0x2d,
+    0xd8, 0x1c, 0x29, 0x34, 0x1a, 0xe6, 0x92, 0x55, 0x36, 0x11, 0xbf, 0xad, 0xb1, 0xfa, 0x1f, 0xfc,
+    0x0b, 0x19, 0x34, 0xc7, 0x91, 0x37, 0x26, 0x00, 0x00,
+};
+
+const uint8_t ASSET_TOAST_JS[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x65, 0x53, 0x51, 0x6b, 0xdb, 0x30,
+    0x10, 0x7e, 0xf7, 0xaf, 0x10, 0xec, 0x41, 0x36, 0x04, 0x37, 0x59, 0xb2, 0x8e, 0x2d, 0x74, 0x30,
+    0x4c, 0x03, 0x83, 0x32, 0x46, 0xd7, 0x3e, 0x8d, 0x3e, 0xa8, 0xd2, 0xc5, 0x31, 0xb3, 0xa5, 0x20,
+    0xc9, 0xf1, 0xc2, 0x1a, 0xe8, 0xb6, 0xa7, 0xc1, 0xfe, 0xc3, 0xfe, 0x42, 0xc7, 0x08, 0x2b, 0x1d,
+    0xeb, 0xfe, 0x82, 0xfc, 0x8f, 0x26, 0x59, 0x6e, 0xe2, 0x2c, 0xf6, 0xcb, 0xdd, 0x7d, 0xdf, 0x7d,
+    0x77, 0x3a, 0x9d, 0xa6, 0x25, 0xa7, 0x3a, 0x13, 0x1c, 0xa9, 0x99, 0xa8, 0xce, 0x04, 0x51, 0x3a,
+    0x2c, 0x40, 0x29, 0x92, 0x42, 0x0f, 0xe9, 0xe5, 0x1c, 0x22, 0xf4, 0x31, 0x40, 0xf6, 0xa3, 0x82,
+    0x2b, 0x8d, 0xb4, 0x23, 0xa0, 0x23, 0xc4, 0x04, 0x2d, 0x0b, 0xe0, 0x3a, 0xa6, 0x12, 0x88, 0x86,
+    0xe3, 0x1c, 0x9c, 0x17, 0x62, 0x96, 0x2d, 0x70, 0x34, 0x6e, 0x12, 0x1a, 0x6a, 0x4c, 0x73, 0xa2,
+    0xd4, 0x6b, 0x52, 0x80, 0x4d, 0xc2, 0x4d, 0x08, 0x77, 0x61, 0x0d, 0x1f, 0x74, 0x22, 0xb8, 0xb6,
+    0xc9, 0x96, 0xd0, 0x16, 0x1e, 0x07, 0x9d, 0x8a, 0x54, 0xe4, 0x42, 0x2a, 0x0b, 0xfa, 0x36, 0xdc,
+    0x87, 0x55, 0x49, 0xa9, 0xa5, 0xe2, 0xe7, 0x08, 0x3f, 0x1a, 0x25, 0x2f, 0x27, 0x4f, 0xfa, 0xb8,
+    0xb7, 0x45, 0x41, 0x4a, 0x21, 0x1b, 0x6c, 0x32, 0x1a, 0x0d, 0x87, 0x87, 0x5d, 0xac, 0x22, 0x92,
+    0x67, 0x3c, 0xf5, 0xe8, 0x24, 0x19, 0xf4, 0x9f, 0x76, 0xd1, 0x8c, 0x4f, 0x45, 0x03, 0x3d, 0x1e,
+    0x3c, 0x3b, 0x9c, 0x0c, 0x71, 0x83, 0xac, 0xda, 0x76, 0x7c, 0xc3, 0x4a, 0x2f, 0x73, 0x88, 0x2f,
+    0x09, 0x7d, 0x9f, 0x4a, 0x51, 0x72, 0x66, 0x1b, 0xf3, 0x1d, 0xbe, 0x73, 0xc3, 0xba, 0x40, 0x57,
+    0x57, 0x0f, 0xbe, 0x57, 0xbb, 0xf0, 0xa7, 0xdd, 0xcc, 0xeb, 0x52, 0xb0, 0x65, 0x4c, 0xe6, 0x73,
+    0xe0, 0x2c, 0x99, 0x65, 0x39, 0x0b, 0x1b, 0xd9, 0xa8, 0xad, 0xa1, 0x40, 0x9f, 0x65, 0x05, 0x88,
+    0x52, 0x87, 0x61, 0x84, 0x8e, 0x5e, 0x74, 0x87, 0x78, 0x92, 0x59, 0x8b, 0x30, 0x16, 0x62, 0x77,
+    0x53, 0x38, 0xea, 0xa1, 0x41, 0xbf, 0xdf, 0xce, 0x7a, 0x2f, 0x6f, 0x3b, 0xac, 0xff, 0x15, 0x24,
+    0x14, 0x62, 0x01, 0x0f, 0x22, 0xe3, 0x0d, 0x6f, 0x4f, 0x62, 0xb7, 0x65, 0x9f, 0xd6, 0x6d, 0xb9,
+    0x87, 0x86, 0x9b, 0xfa, 0xab, 0xc6, 0x71, 0xde, 0x2a, 0x08, 0x0e, 0x0e, 0x90, 0xf9, 0x6e, 0xee,
+    0xcd, 0x9d, 0xb9, 0x31, 0xbf, 0xcc, 0x4d, 0xfd, 0xb9, 0xfe, 0xd6, 0xee, 0x8d, 0xf9, 0x5b, 0x5f,
+    0x9b, 0x5b, 0xe4, 0xa2, 0xe6, 0x67, 0x7d, 0x5d, 0x7f, 0xb1, 0xd6, 0x9d, 0x59, 0x23, 0xb3, 0xae,
+    0x3f, 0x99, 0xdf, 0x0e, 0xb1, 0x46, 0xc3, 0xb7, 0xfe, 0xbd, 0xfd, 0x7f, 0xd4, 0x5f, 0xcd, 0xda,
+    0xfc, 0x31, 0xb7, 0x66, 0x1d, 0x54, 0x19, 0x67, 0xa2, 0x72, 0x13, 0x38, 0x5e, 0xd8, 0xb6, 0xdc,
+    0x61, 0x80, 0x83, 0x0c, 0x71, 0x2e, 0x08, 0xc3, 0x3d, 0x34, 0x6d, 0x17, 0x39, 0xdc, 0xdd, 0xd8,
+    0x52, 0xe6, 0x6f, 0x88, 0x24, 0x85, 0x5b, 0x21, 0x0e, 0x15, 0x3a, 0x3f, 0x3d, 0x79, 0x0b, 0x44,
+    0xd2, 0x99, 0x8f, 0x86, 0xad, 0x6c, 0x2e, 0x28, 0x71, 0xd9, 0xb1, 0x6a, 0xc0, 0xf6, 0x5c, 0x5e,
+    0xa2, 0x50, 0xa9, 0x4d, 0xde, 0x08, 0xc5, 0x29, 0xd8, 0x4d, 0xb7, 0x41, 0xbc, 0xc3, 0x72, 0xf7,
+    0xbf, 0x4f, 0x73, 0x51, 0x1c, 0xb9, 0xb5, 0xf0, 0xfb, 0xe0, 0x33, 0xb2, 0x29, 0x0a, 0xad, 0x40,
+    0xd4, 0xb9, 0xa7, 0xed, 0xf3, 0x63, 0x40, 0x05, 0x83, 0xf3, 0xd3, 0x57, 0x89, 0x28, 0xe6, 0x82,
+    0xbb, 0x77, 0xe5, 0xb8, 0xed, 0x73, 0x6c, 0x07, 0x1e, 0xac, 0xac, 0xf5, 0x0f, 0x14, 0x87, 0xec,
+    0xdd, 0xbc, 0x03, 0x00, 0x00,
+};
+
+}  // namespace
+
+const WebAsset WEB_ASSETS[] = {
+    {"/static/app.css", "text/css; charset=utf-8", "\"1f45393e3a5252d5\"", ASSET_APP_CSS, sizeof(ASSET_APP_CSS)},
+    {"/static/live.js", "application/javascript; charset=utf-8", "\"885767482448005e\"", ASSET_LIVE_JS, sizeof(ASSET_LIVE_JS)},
+    {"/static/readings.js", "application/javascript; charset=utf-8", "\"386195893d373ca5\"", ASSET_READINGS_JS, sizeof(ASSET_READINGS_JS)},
+    {"/static/toast.js", "application/javascript; charset=utf-8", "\"0aa91319ef9d3c1f\"", ASSET_TOAST_JS, sizeof(ASSET_TOAST_JS)},
+};
+
+const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
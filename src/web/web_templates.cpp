@@ -1,5 +1,6 @@
 #include "../../include/jxct_constants.h"
 #include "../../include/jxct_ui_system.h"
+#include "../../include/web/chunked_page_writer.h"
 #include "../../include/web_routes.h"
 #include "../wifi_manager.h"
 
@@ -327,7 +328,7 @@ String generatePageHeaderImpl(const PageInfo& page)
     String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
     html += "<meta name='viewport' content='width=device-width, initial-scale=1.0'>";
     html += "<title>" + iconStr + page.title + "</title>";
-    html += "<style>" + String(getUnifiedCSS()) + "</style>";
+    html += getStylesheetLinkHTML();
     html += "</head><body><div class='container'>";
     return html;
 }
@@ -340,6 +341,63 @@ String generateBasePageImpl(const PageInfo& page, const String& content)
     html += generatePageFooter();
     return html;
 }
+
+// Потоковый вариант заголовка (см. generatePageHeaderImpl)
+void streamPageHeaderImpl(ChunkedPageWriter& out, const PageInfo& page)
+{
+    out += "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
+    out += "<meta name='viewport' content='width=device-width, initial-scale=1.0'>";
+    out += "<title>";
+    if (page.icon.length() > 0)
+    {
+        out += page.icon;
+        out += ' ';
+    }
+    out += page.title;
+    out += "</title>";
+    out += getStylesheetLinkHTML();
+    out += "</head><body><div class='container'>";
+}
+
+void streamBasePageImpl(ChunkedPageWriter& out, const PageInfo& page, const String& content)
+{
+    streamPageHeaderImpl(out, page);
+    out += navHtml();
+    out += content;
+    streamPageFooter(out);
+}
+
+String errorPageContent(int errorCode, const String& errorMessage)  // NOLINT(bugprone-easily-swappable-parameters)
+{
+    String content = "<h1>" UI_ICON_ERROR " Ошибка " + String(errorCode) + "</h1>";
+    content += "<div class='msg msg-error'>" UI_ICON_ERROR " " + errorMessage + "</div>";
+    content += "<p><a href='/' style='color: #4CAF50; text-decoration: none;'>← Вернуться на главную</a></p>";
+    return content;
+}
+
+String successPageContent(const String& titleText, const String& messageText, const String& redirectUrlText,
+                          int redirectDelaySeconds)  // NOLINT(bugprone-easily-swappable-parameters)
+{
+    String content = "<h1>" UI_ICON_SUCCESS " " + titleText + "</h1>";
+    content += "<div class='msg msg-success'>" UI_ICON_SUCCESS " " + messageText + "</div>";
+
+    if (redirectUrlText.length() > 0)
+    {
+        content += "<p><em>Перенаправление через " + String(redirectDelaySeconds) + " секунд...</em></p>";
+        content += "<script>setTimeout(function(){window.location.href='" + redirectUrlText + "';}, " +
+                   String(redirectDelaySeconds * JXCT_REDIRECT_DELAY_MS) + ");</script>";
+    }
+    return content;
+}
+
+String apModeUnavailableContent(const String& titleText,
+                                const String& iconText)  // NOLINT(bugprone-easily-swappable-parameters)
+{
+    String content = "<h1>" + iconText + " " + titleText + "</h1>";
+    content += "<div class='msg msg-warning'>" UI_ICON_WARNING " Эта страница недоступна в режиме точки доступа</div>";
+    content += "<p><a href='/' style='color: #4CAF50; text-decoration: none;'>← Вернуться на главную</a></p>";
+    return content;
+}
 }  // namespace
 
 // Реализации функций, объявленных в web_routes.h, должны быть в глобальном пространстве имён
@@ -368,11 +426,7 @@ String generateErrorPage(
     int errorCode,
     const String& errorMessage)  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
 {
-    String content = "<h1>" UI_ICON_ERROR " Ошибка " + String(errorCode) + "</h1>";
-    content += "<div class='msg msg-error'>" UI_ICON_ERROR " " + errorMessage + "</div>";
-    content += "<p><a href='/' style='color: #4CAF50; text-decoration: none;'>← Вернуться на главную</a></p>";
-
-    return generateBasePage("Ошибка " + String(errorCode), content, UI_ICON_ERROR);
+    return generateBasePage("Ошибка " + String(errorCode), errorPageContent(errorCode, errorMessage), UI_ICON_ERROR);
 }
 
 String generateSuccessPage(
@@ -380,26 +434,63 @@ String generateSuccessPage(
     const String& redirectUrlText,  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
     int redirectDelaySeconds)       // NOLINT(bugprone-easily-swappable-parameters)
 {
-    String content = "<h1>" UI_ICON_SUCCESS " " + titleText + "</h1>";
-    content += "<div class='msg msg-success'>" UI_ICON_SUCCESS " " + messageText + "</div>";
-
-    if (redirectUrlText.length() > 0)
-    {
-        content += "<p><em>Перенаправление через " + String(redirectDelaySeconds) + " секунд...</em></p>";
-        content += "<script>setTimeout(function(){window.location.href='" + redirectUrlText + "';}, " +
-                   String(redirectDelaySeconds * JXCT_REDIRECT_DELAY_MS) + ");</script>";
-    }
-
-    return generateBasePage(titleText, content, UI_ICON_SUCCESS);
+    return generateBasePage(titleText,
+                            successPageContent(titleText, messageText, redirectUrlText, redirectDelaySeconds),
+                            UI_ICON_SUCCESS);
 }
 
 String generateApModeUnavailablePage(
     const String& titleText,
     const String& iconText)  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
 {
-    String content = "<h1>" + iconText + " " + titleText + "</h1>";
-    content += "<div class='msg msg-warning'>" UI_ICON_WARNING " Эта страница недоступна в режиме точки доступа</div>";
-    content += "<p><a href='/' style='color: #4CAF50; text-decoration: none;'>← Вернуться на главную</a></p>";
+    return generateBasePage(titleText, apModeUnavailableContent(titleText, iconText), iconText);
+}
+
+// ============================================================================
+// Потоковая отдача страниц
+// ============================================================================
 
-    return generateBasePage(titleText, content, iconText);
+void streamPageHeader(
+    ChunkedPageWriter& out, const String& titleText,
+    const String& iconText)  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
+{
+    streamPageHeaderImpl(out, PageInfo::builder().setTitle(titleText).setIcon(iconText).build());
+}
+
+void streamPageFooter(ChunkedPageWriter& out)  // NOLINT(misc-use-internal-linkage)
+{
+    out += "</div>";
+    out += getToastHTML();
+    out += "</body></html>";
+}
+
+void sendBasePage(
+    int statusCode, const String& titleText, const String& contentText,
+    const String& iconText)  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
+{
+    ChunkedPageWriter out(webServer, statusCode);
+    streamBasePageImpl(out, PageInfo::builder().setTitle(titleText).setIcon(iconText).build(), contentText);
+}
+
+void sendErrorPage(
+    int errorCode,
+    const String& errorMessage)  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
+{
+    sendBasePage(errorCode, "Ошибка " + String(errorCode), errorPageContent(errorCode, errorMessage), UI_ICON_ERROR);
+}
+
+void sendSuccessPage(
+    const String& titleText, const String& messageText,
+    const String& redirectUrlText,  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
+    int redirectDelaySeconds)       // NOLINT(bugprone-easily-swappable-parameters)
+{
+    sendBasePage(HTTP_OK, titleText,
+                 successPageContent(titleText, messageText, redirectUrlText, redirectDelaySeconds), UI_ICON_SUCCESS);
+}
+
+void sendApModeUnavailablePage(
+    int statusCode, const String& titleText,
+    const String& iconText)  // NOLINT(bugprone-easily-swappable-parameters,misc-use-internal-linkage)
+{
+    sendBasePage(statusCode, titleText, apModeUnavailableContent(titleText, iconText), iconText);
 }
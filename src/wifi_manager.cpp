@@ -5,7 +5,6 @@
  * и сервисных функций.
  */
 #include "wifi_manager.h"
-#include <NTPClient.h>
 #include <array>
 #include "jxct_config_vars.h"
 #include "jxct_constants.h"
@@ -15,9 +14,12 @@
 #include "logger.h"
 #include "modbus_sensor.h"
 #include "mqtt_client.h"
+#include "mqtt_connection.h"
 #include "thingspeak_client.h"
+#include "time_service.h"
 #include "web/csrf_protection.h"  // 🔒 CSRF защита
-#include "web_routes.h"           // 🏗️ Модульная архитектура v2.4.5
+#include "web/live_events.h"
+#include "web_routes.h"  // 🏗️ Модульная архитектура v2.4.5
 
 // Константы
 enum class WifiConstants : std::uint16_t  // NOLINT(performance-enum-size)
@@ -27,7 +29,6 @@ enum class WifiConstants : std::uint16_t  // NOLINT(performance-enum-size)
     LED_FAST_BLINK_INTERVAL = 100,    // Интервал быстрого мигания светодиода (мс)
     LED_SLOW_BLINK_INTERVAL = 500,    // Интервал медленного мигания светодиода (мс)
     WIFI_MODE_DELAY = 100,            // Задержка при смене режима WiFi (мс)
-    NTP_TIMEOUT_MS = 5000,            // Таймаут для NTP синхронизации (мс)
     RESET_BUTTON_HOLD_TIME = 5000,    // Время удержания кнопки сброса (мс)
     RESTART_DELAY_MS = 1000,          // Задержка перед перезагрузкой (мс)
     DNS_SERVER_PORT = 53,             // Порт DNS сервера
@@ -42,15 +43,70 @@ WebServer webServer(DEFAULT_WEB_SERVER_PORT);  // Используем конс
 namespace
 {
 DNSServer dnsServer;
+
+// Веб-сервер обслуживается отдельной задачей, чтобы медленный клиент не задерживал loop() (MQTT, ThingSpeak).
+// Сам сервер остался синхронным WebServer: клиенты обслуживаются по одному, соединение закрывается после ответа
+// (без keep-alive), ожидающие подключения копятся в очереди WiFiServer. Переход на событийный сервер с пулом
+// соединений (esp_http_server или AsyncTCP) требует переписать все обработчики routes_*.cpp и не сделан.
+// Частые опросы нескольких панелей снимают поток /events/* и ответы 304 по ETag на /sensor_json.
+SemaphoreHandle_t webServerMutex = nullptr;  // Защищает webServer/dnsServer между loop() и задачей
+TaskHandle_t webServerTaskHandle = nullptr;
+constexpr TickType_t WEB_SERVER_POLL_TICKS = 2;  // Пауза задачи между опросами клиентов
+
+// Захват веб-сервера на время блока; мьютекс рекурсивный, т.к. обработчики маршрутов сами могут
+// перенастраивать WiFi и, соответственно, сервер
+class WebServerLock
+{
+   public:
+    WebServerLock()
+    {
+        xSemaphoreTakeRecursive(webServerMutex, portMAX_DELAY);
+    }
+    ~WebServerLock()
+    {
+        xSemaphoreGiveRecursive(webServerMutex);
+    }
+    WebServerLock(const WebServerLock&) = delete;
+    WebServerLock& operator=(const WebServerLock&) = delete;
+};
+
+void webServerTask(void* /*parameters*/)
+{
+    for (;;)
+    {
+        {
+            const WebServerLock lock;
+            if (currentWiFiMode == WiFiMode::AP)
+            {
+                dnsServer.processNextRequest();
+            }
+            webServer.handleClient();
+            serviceLiveEvents();
+        }
+        vTaskDelay(WEB_SERVER_POLL_TICKS);
+    }
+}
+
+void ensureWebServerTask()
+{
+    if (webServerMutex == nullptr)
+    {
+        webServerMutex = xSemaphoreCreateRecursiveMutex();
+    }
+    if (webServerTaskHandle == nullptr)
+    {
+        xTaskCreate(webServerTask, "WebServer", WEB_SERVER_TASK_STACK_SIZE, nullptr, WEB_SERVER_TASK_PRIORITY,
+                    &webServerTaskHandle);
+        logSystem("Веб-сервер обслуживается отдельной задачей");
+    }
+}
+
 unsigned long ledLastToggle = 0;
 bool ledState = false;
 unsigned long ledBlinkInterval = 0;
 bool ledFastBlink = false;
 }  // namespace
 
-extern NTPClient* timeClient;
-extern WiFiUDP ntpUDP;
-
 void setLedOn()
 {
     digitalWrite(STATUS_LED_PIN, HIGH);
@@ -144,8 +200,7 @@ void handleWiFi()
     updateLed();
     if (currentWiFiMode == WiFiMode::AP)
     {
-        dnsServer.processNextRequest();
-        webServer.handleClient();
+        // DNS и HTTP обслуживает webServerTask
 
         // Периодическая попытка вернуться в STA-режим, если точка доступа пуста
         static unsigned long lastStaRetry = 0;
@@ -217,28 +272,13 @@ void handleWiFi()
                 logSystemSafe("\1", WiFi.macAddress().c_str());  // NOLINT(readability-static-accessed-through-instance)
                 logSystemSafe("\1", config.ssid);
                 logSystemSafe("\1", WiFi.RSSI());  // NOLINT(readability-static-accessed-through-instance)
-                // --- Первичная синхронизация времени NTP (блок до 5 сек) ---
-                if (timeClient == nullptr)
-                {
-                    timeClient = new NTPClient(ntpUDP, "pool.ntp.org", 0, 3600000);
-                    timeClient->begin();
-                }
-                if (timeClient != nullptr)
-                {
-                    const unsigned long ntpStart = millis();
-                    while (!timeClient->forceUpdate() &&
-                           millis() - ntpStart < static_cast<unsigned long>(WifiConstants::NTP_TIMEOUT_MS))
-                    {
-                        delay(static_cast<unsigned long>(WifiConstants::WIFI_MODE_DELAY));
-                    }
-                    logSystemSafe("\1", timeClient->isTimeSet() ? "OK" : "не удалось");
-                }
+                requestTimeSync();  // Время синхронизирует служба времени, подключение не ждёт NTP
+                requestMqttReconnect();  // Пауза после неудач из-за WiFi к брокеру не относится
 
                 setupWebServer();
                 return;
             }
         }
-        webServer.handleClient();
     }
 }
 
@@ -262,6 +302,8 @@ void startAPMode()
     WiFi.mode(WIFI_AP);  // NOLINT(readability-static-accessed-through-instance)
     const String apSsid = getApSsid();
     WiFi.softAP(apSsid.c_str(), JXCT_WIFI_AP_PASS);  // NOLINT(readability-static-accessed-through-instance)
+    ensureWebServerTask();
+    const WebServerLock lock;
     dnsServer.start(static_cast<uint16_t>(WifiConstants::DNS_SERVER_PORT), "*",
                     WiFi.softAPIP());  // NOLINT(readability-static-accessed-through-instance)
     setupWebServer();
@@ -321,22 +363,8 @@ void startSTAMode()
             logSystemSafe("\1", WiFi.macAddress().c_str());    // NOLINT(readability-static-accessed-through-instance)
             logSystemSafe("\1", hostname.c_str());
             logSystemSafe("\1", WiFi.RSSI());  // NOLINT(readability-static-accessed-through-instance)
-            // --- Первичная синхронизация времени NTP (блок до 5 сек) ---
-            if (timeClient == nullptr)
-            {
-                timeClient = new NTPClient(ntpUDP, "pool.ntp.org", 0, 3600000);
-                timeClient->begin();
-            }
-            if (timeClient != nullptr)
-            {
-                const unsigned long ntpStart = millis();
-                while (!timeClient->forceUpdate() &&
-                       millis() - ntpStart < static_cast<unsigned long>(WifiConstants::NTP_TIMEOUT_MS))
-                {
-                    delay(static_cast<unsigned long>(WifiConstants::WIFI_MODE_DELAY));
-                }
-                logSystemSafe("\1", timeClient->isTimeSet() ? "OK" : "не удалось");
-            }
+            requestTimeSync();  // Время синхронизирует служба времени, подключение не ждёт NTP
+            requestMqttReconnect();
 
             setupWebServer();
             return;
@@ -390,9 +418,8 @@ void restartESP()
 
 void handleStatus()  // NOLINT(misc-use-internal-linkage)
 {
-    String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
-    html += "<title>" UI_ICON_STATUS " Статус JXCT</title>";
-    html += "<style>" + String(getUnifiedCSS()) + "</style></head><body><div class='container'>";
+    ChunkedPageWriter html(webServer, HTTP_OK);
+    streamPageHeader(html, "Статус JXCT", UI_ICON_STATUS);
     html += navHtml();
     html += "<h1>" UI_ICON_STATUS " Статус системы</h1>";
     html += "<div class='section'><h2>WiFi</h2><ul>";
@@ -411,24 +438,28 @@ void handleStatus()  // NOLINT(misc-use-internal-linkage)
     html += "<li>Время работы: " + String(millis() / 1000) + " сек</li>";
     html += "<li>Свободная память: " + String(ESP.getFreeHeap()) + " байт</li>";
     html += "</ul></div>";
-    html += "</div>" + String(getToastHTML()) + "</body></html>";
-    webServer.send(200, "text/html; charset=utf-8", html);
+    streamPageFooter(html);
 }
 
 void setupWebServer()
 {
     logInfo("🏗️ Настройка модульного веб-сервера v2.4.5...");
 
+    ensureWebServerTask();
+    const WebServerLock lock;  // Маршруты меняются, пока задача сервера не обслуживает клиентов
+
     // ============================================================================
     // МОДУЛЬНАЯ АРХИТЕКТУРА - Настройка всех маршрутов по группам
     // ============================================================================
 
-    setupMainRoutes();     // Основные маршруты (/, /save, /status)
-    setupDataRoutes();     // Данные датчика (/readings, /sensor_json, /api/sensor)
-    setupConfigRoutes();   // Конфигурация (/intervals, /config_manager, /api/config/*)
-    setupServiceRoutes();  // Сервис
-    setupOtaRoutes();      // OTA (/updates, api)
-    setupReportsRoutes();  // Отчёты тестирования (/api/reports/*, /reports)
+    setupMainRoutes();       // Основные маршруты (/, /save, /status)
+    setupDataRoutes();       // Данные датчика (/readings, /sensor_json, /api/sensor)
+    setupConfigRoutes();     // Конфигурация (/intervals, /config_manager, /api/config/*)
+    setupServiceRoutes();    // Сервис
+    setupOtaRoutes();        // OTA (/updates, api)
+    setupReportsRoutes();    // Отчёты тестирования (/api/reports/*, /reports)
+    setupStaticRoutes();     // Сжатые CSS/JS (/static/*)
+    setupLiveEventRoutes();  // Поток изменений показаний и статусов (/events/*)
 
     setupErrorHandlers();  // Обработчики ошибок (404, 500) - должны быть последними
 
@@ -436,8 +467,12 @@ void setupWebServer()
     // ЗАПУСК СЕРВЕРА
     // ============================================================================
 
+    // WebServer сохраняет только перечисленные заголовки запроса
+    static const char* collectedHeaders[] = {"If-None-Match", "X-CSRF-Token"};
+    webServer.collectHeaders(collectedHeaders, sizeof(collectedHeaders) / sizeof(collectedHeaders[0]));
+    webServer.enableDelay(false);  // Паузу между опросами делает webServerTask
     webServer.begin();
     logSuccessSafe("\1", currentWiFiMode == WiFiMode::AP ? "AP" : "STA");
-    logSystem("✅ Активные модули: main, data, config, service, ota, error_handlers");
+    logSystem("✅ Активные модули: main, data, config, service, ota, static, events, error_handlers");
     logSystem("📋 Полный набор маршрутов готов к использованию");
 }
@@ -0,0 +1,122 @@
+/**
+ * @file test_calibration_curve.cpp
+ * @brief Проверка скомпилированной калибровочной кривой: линейная интерполяция против прежнего перебора, PCHIP
+ */
+
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include <vector>
+#include "../../include/calibration_curve.h"
+
+namespace
+{
+// Эталон: прежний applyCalibrationWithInterpolation (линейный перебор отсортированных точек)
+float referenceInterpolation(const std::vector<std::pair<float, float>>& sorted, float rawValue)
+{
+    if (rawValue <= sorted.front().first)
+    {
+        return sorted.front().second;
+    }
+    if (rawValue >= sorted.back().first)
+    {
+        return sorted.back().second;
+    }
+    for (size_t i = 0; i + 1 < sorted.size(); ++i)
+    {
+        if (rawValue >= sorted[i].first && rawValue <= sorted[i + 1].first)
+        {
+            const float x1 = sorted[i].first;
+            const float y1 = sorted[i].second;
+            const float x2 = sorted[i + 1].first;
+            const float y2 = sorted[i + 1].second;
+            return y1 + (rawValue - x1) * (y2 - y1) / (x2 - x1);
+        }
+    }
+    return rawValue;
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_linear_matches_reference()
+{
+    // Точки намеренно не отсортированы
+    const std::array<float, 5> raw = {800.0F, 100.0F, 400.0F, 1500.0F, 250.0F};
+    const std::array<float, 5> reference = {900.0F, 120.0F, 430.0F, 1480.0F, 260.0F};
+
+    CalibrationCurve curve;
+    curve.build(raw.data(), reference.data(), raw.size(), CalibrationInterpolation::LINEAR);
+    TEST_ASSERT_EQUAL(5, curve.size());
+
+    std::vector<std::pair<float, float>> sorted;
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+        sorted.emplace_back(raw[i], reference[i]);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    for (float value = 0.0F; value <= 1700.0F; value += 3.7F)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-3F, referenceInterpolation(sorted, value), curve.evaluate(value));
+    }
+}
+
+void test_out_of_range_clamps_to_edges()
+{
+    const std::array<float, 3> raw = {10.0F, 20.0F, 30.0F};
+    const std::array<float, 3> reference = {11.0F, 19.0F, 33.0F};
+
+    CalibrationCurve curve;
+    curve.build(raw.data(), reference.data(), raw.size(), CalibrationInterpolation::PCHIP);
+    TEST_ASSERT_EQUAL_FLOAT(11.0F, curve.evaluate(-5.0F));
+    TEST_ASSERT_EQUAL_FLOAT(33.0F, curve.evaluate(100.0F));
+    TEST_ASSERT_EQUAL_FLOAT(19.0F, curve.evaluate(20.0F));
+}
+
+void test_pchip_is_monotonic_without_overshoot()
+{
+    // Резкий перегиб: обычный кубический сплайн дал бы выброс за пределы соседних эталонов
+    const std::array<float, 6> raw = {0.0F, 1.0F, 2.0F, 3.0F, 4.0F, 5.0F};
+    const std::array<float, 6> reference = {0.0F, 0.0F, 0.0F, 10.0F, 10.0F, 10.0F};
+
+    CalibrationCurve curve;
+    curve.build(raw.data(), reference.data(), raw.size(), CalibrationInterpolation::PCHIP);
+
+    float previous = curve.evaluate(0.0F);
+    for (float value = 0.0F; value <= 5.0F; value += 0.01F)
+    {
+        const float current = curve.evaluate(value);
+        TEST_ASSERT_TRUE(current >= previous - 1e-5F);
+        TEST_ASSERT_TRUE(current >= -1e-5F && current <= 10.0F + 1e-5F);
+        previous = current;
+    }
+}
+
+void test_duplicates_and_empty_curve()
+{
+    const std::array<float, 3> raw = {5.0F, 5.0F, 15.0F};
+    const std::array<float, 3> reference = {50.0F, 70.0F, 150.0F};
+
+    CalibrationCurve curve;
+    curve.build(raw.data(), reference.data(), raw.size(), CalibrationInterpolation::LINEAR);
+    TEST_ASSERT_EQUAL(2, curve.size());
+    TEST_ASSERT_EQUAL_FLOAT(100.0F, curve.evaluate(10.0F));
+
+    curve.clear();
+    TEST_ASSERT_TRUE(curve.empty());
+    TEST_ASSERT_EQUAL_FLOAT(42.0F, curve.evaluate(42.0F));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_linear_matches_reference);
+    RUN_TEST(test_out_of_range_clamps_to_edges);
+    RUN_TEST(test_pchip_is_monotonic_without_overshoot);
+    RUN_TEST(test_duplicates_and_empty_curve);
+
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+/**
+ * @file test_channel_smoothing_kernel.cpp
+ * @brief Пакетный шаг EMA/Калмана должен давать те же числа, что и поканальный скалярный расчёт
+ */
+
+#include <unity.h>
+#include <array>
+#include <iostream>
+#include <random>
+#include "../../include/channel_smoothing_kernel.h"
+
+namespace
+{
+constexpr size_t CHANNELS = 7;
+constexpr float Q = 0.01F;
+constexpr float R = 0.1F;
+constexpr float P0 = 1.0F;
+constexpr uint32_t ON = ChannelSmoothingKernel<CHANNELS>::LANE_ACTIVE;
+
+// Эталон: прежние скалярные applyExponentialSmoothing и KalmanFilter::update из advanced_filters.cpp
+struct ScalarEma
+{
+    float smoothed_value = 0.0F;
+    bool initialized = false;
+
+    float update(float new_value, float alpha)
+    {
+        if (!initialized)
+        {
+            smoothed_value = new_value;
+            initialized = true;
+            return new_value;
+        }
+        smoothed_value = alpha * new_value + (1.0F - alpha) * smoothed_value;
+        return smoothed_value;
+    }
+};
+
+struct ScalarKalman
+{
+    float x = 0.0F;
+    float P = P0;
+    bool initialized = false;
+
+    float update(float measurement)
+    {
+        if (!initialized)
+        {
+            x = measurement;
+            initialized = true;
+            return measurement;
+        }
+        const float P_pred = P + Q;
+        const float kalman_gain = P_pred / (P_pred + R);
+        x = x + kalman_gain * (measurement - x);
+        P = (1.0F - kalman_gain) * P_pred;
+        return x;
+    }
+};
+
+const std::array<float, CHANNELS> ALPHAS = {0.3F, 0.3F, 0.15F, 0.3F, 0.24F, 0.24F, 0.24F};
+const std::array<float, CHANNELS> OFFSETS = {22.0F, 45.0F, 1500.0F, 6.5F, 120.0F, 40.0F, 200.0F};
+}  // namespace
+
+void test_kernel_matches_scalar_bitwise()
+{
+    ChannelSmoothingKernel<CHANNELS> kernel(Q, R, P0);
+    std::array<ScalarEma, CHANNELS> ema{};
+    std::array<ScalarKalman, CHANNELS> kalman{};
+    for (size_t i = 0; i < CHANNELS; ++i)
+    {
+        kernel.setAlpha(i, ALPHAS[i]);
+    }
+
+    std::mt19937 rng(42U);
+    std::normal_distribution<float> noise(0.0F, 1.0F);
+    std::uniform_int_distribution<int> coin(0, 3);
+
+    for (int step = 0; step < 5000; ++step)
+    {
+        std::array<float, CHANNELS> values{};
+        std::array<float, CHANNELS> expected{};
+        std::array<uint32_t, CHANNELS> emaMask{};
+        std::array<uint32_t, CHANNELS> kalmanMask{};
+        for (size_t i = 0; i < CHANNELS; ++i)
+        {
+            values[i] = OFFSETS[i] + noise(rng) * OFFSETS[i] * 0.05F;
+            // Часть каналов пропускает стадию (выброс, отключённая стадия)
+            emaMask[i] = coin(rng) != 0 ? ON : 0U;
+            kalmanMask[i] = coin(rng) != 0 ? ON : 0U;
+
+            float value = values[i];
+            if (emaMask[i] != 0)
+            {
+                value = ema[i].update(value, ALPHAS[i]);
+            }
+            if (kalmanMask[i] != 0)
+            {
+                value = kalman[i].update(value);
+            }
+            expected[i] = value;
+        }
+
+        kernel.smooth(values.data(), emaMask.data());
+        kernel.kalman(values.data(), kalmanMask.data());
+
+        for (size_t i = 0; i < CHANNELS; ++i)
+        {
+            TEST_ASSERT_TRUE(expected[i] == values[i]);
+        }
+    }
+    std::cout << "✅ Пакетный шаг совпадает со скалярным побитово" << std::endl;
+}
+
+void test_masked_lanes_untouched()
+{
+    ChannelSmoothingKernel<CHANNELS> kernel(Q, R, P0);
+    std::array<float, CHANNELS> values = {1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F};
+    const std::array<uint32_t, CHANNELS> none{};
+    kernel.smooth(values.data(), none.data());
+    kernel.kalman(values.data(), none.data());
+    for (size_t i = 0; i < CHANNELS; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(static_cast<float>(i + 1), values[i]);
+    }
+
+    // Первое измерение после пропусков принимается как есть
+    const std::array<uint32_t, CHANNELS> all = {ON, ON, ON, ON, ON, ON, ON};
+    kernel.kalman(values.data(), all.data());
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, kernel.kalmanEstimate(2));
+}
+
+void test_reset_restarts_lanes()
+{
+    ChannelSmoothingKernel<CHANNELS> kernel(Q, R, P0);
+    const std::array<uint32_t, CHANNELS> all = {ON, ON, ON, ON, ON, ON, ON};
+    for (size_t i = 0; i < CHANNELS; ++i)
+    {
+        kernel.setAlpha(i, 0.5F);
+    }
+    std::array<float, CHANNELS> values{};
+    values.fill(10.0F);
+    kernel.smooth(values.data(), all.data());
+    values.fill(20.0F);
+    kernel.smooth(values.data(), all.data());
+    TEST_ASSERT_EQUAL_FLOAT(15.0F, values[0]);
+
+    kernel.reset();
+    values.fill(20.0F);
+    kernel.smooth(values.data(), all.data());
+    TEST_ASSERT_EQUAL_FLOAT(20.0F, values[0]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_kernel_matches_scalar_bitwise);
+    RUN_TEST(test_masked_lanes_untouched);
+    RUN_TEST(test_reset_restarts_lanes);
+
+    return UNITY_END();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file test_flash_write_buffer.cpp
+ * @brief Проверка накопителя записи на флеш: слияние мелких записей, выравнивание по страницам и сброс по времени
+ */
+
+#include <unity.h>
+#include <vector>
+#include "../../include/flash_write_buffer.h"
+
+namespace
+{
+struct Chunk
+{
+    size_t offset;
+    size_t length;
+};
+
+struct Sink
+{
+    std::vector<uint8_t> file;
+    std::vector<Chunk> chunks;
+};
+
+bool collect(const uint8_t* data, size_t length, size_t offset, void* context)
+{
+    auto* sink = static_cast<Sink*>(context);
+    sink->file.insert(sink->file.end(), data, data + length);
+    sink->chunks.push_back({offset, length});
+    return true;
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_bytes_coalesce_into_page_aligned_chunks()
+{
+    // Дописывание в файл из 100 байт: первый кусок дополняет начатую страницу, остальные — по 512 байт
+    Sink sink;
+    sink.file.assign(100, 0xFF);
+    FlashWriteBuffer<512> buffer;
+    buffer.reset(sink.file.size());
+    for (int i = 0; i < 1500; ++i)
+    {
+        const auto value = static_cast<uint8_t>(i);
+        TEST_ASSERT_TRUE(buffer.write(&value, 1, 0, collect, &sink));
+    }
+    TEST_ASSERT_TRUE(buffer.flush(collect, &sink));
+
+    TEST_ASSERT_EQUAL(4, sink.chunks.size());
+    TEST_ASSERT_EQUAL(100, sink.chunks[0].offset);
+    TEST_ASSERT_EQUAL(412, sink.chunks[0].length);
+    TEST_ASSERT_EQUAL(512, sink.chunks[1].offset);
+    TEST_ASSERT_EQUAL(512, sink.chunks[1].length);
+    TEST_ASSERT_EQUAL(1024, sink.chunks[2].offset);
+    TEST_ASSERT_EQUAL(64, sink.chunks[3].length);
+    TEST_ASSERT_EQUAL(1600, sink.file.size());
+    for (int i = 0; i < 1500; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(i), sink.file[100 + i]);
+    }
+
+    // Полный кусок затрагивает ровно свои страницы, кусок через границу страницы — обе
+    TEST_ASSERT_EQUAL_UINT32(2, flashPagesTouched(sink.chunks[1].offset, sink.chunks[1].length));
+    TEST_ASSERT_EQUAL_UINT32(2, flashPagesTouched(250, 10));
+    TEST_ASSERT_EQUAL_UINT32(0, flashPagesTouched(250, 0));
+}
+
+void test_stale_data_is_flushed_by_age()
+{
+    Sink sink;
+    FlashWriteBuffer<256> buffer;
+    buffer.reset(0);
+    const uint8_t data[3] = {1, 2, 3};
+    TEST_ASSERT_TRUE(buffer.write(data, sizeof(data), 1000, collect, &sink));
+    TEST_ASSERT_TRUE(buffer.flushIfStale(2999, 2000, collect, &sink));
+    TEST_ASSERT_EQUAL(3, buffer.pending());
+    TEST_ASSERT_TRUE(buffer.flushIfStale(3000, 2000, collect, &sink));
+    TEST_ASSERT_EQUAL(0, buffer.pending());
+    TEST_ASSERT_EQUAL(1, sink.chunks.size());
+
+    // Возраст отсчитывается от первого байта в пустом буфере
+    TEST_ASSERT_TRUE(buffer.write(data, 1, 5000, collect, &sink));
+    TEST_ASSERT_TRUE(buffer.write(data, 1, 6500, collect, &sink));
+    TEST_ASSERT_TRUE(buffer.flushIfStale(7000, 2000, collect, &sink));
+    TEST_ASSERT_EQUAL(2, sink.chunks.size());
+    TEST_ASSERT_EQUAL(3, sink.chunks[1].offset);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bytes_coalesce_into_page_aligned_chunks);
+    RUN_TEST(test_stale_data_is_flushed_by_age);
+
+    return UNITY_END();
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_history_block_codec.cpp
+ * @brief Проверка и замер сжатого блока архива: точное восстановление, защита от повреждений, степень сжатия
+ * @details Бенчмарк строит неделю минутных записей из показаний раз в 10 с с суточным ходом и шумом датчика
+ * и сравнивает размер блоков с хранением float-значений и с несжатой записью архива.
+ */
+
+#include <unity.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../../include/history_block_codec.h"
+
+namespace
+{
+constexpr size_t BLOCK_RECORDS = 600;  // Сегмент минутного уровня: 10 часов (HISTORY_SEGMENT_RECORDS)
+constexpr size_t WEEK_MINUTES = 7 * 24 * 60;
+constexpr size_t FLOAT_RECORD_SIZE = 4 + 4 + 3 * 4 * UPLINK_CHANNEL_COUNT;  // Время, число и float min/mean/max
+constexpr size_t BLOCK_CAPACITY = 16384;
+
+// Минутные записи из показаний раз в 10 с: суточный ход температуры, медленное высыхание с поливом, шум
+std::vector<HistoryRecord> makeMinutes(size_t count, unsigned seed)
+{
+    std::mt19937 random(seed);
+    std::normal_distribution<float> noise(0.0F, 1.0F);
+    std::vector<HistoryRecord> minutes;
+    const uint32_t start = 1751328000U;
+    float moisture = 45.0F;
+    for (size_t minute = 0; minute < count; ++minute)
+    {
+        HistoryAccumulator accumulator;
+        accumulator.reset(start + static_cast<uint32_t>(minute) * 60);
+        moisture = minute % 1440 == 360 ? 45.0F : moisture - 0.004F;
+        for (int sample = 0; sample < 6; ++sample)
+        {
+            const float hour = static_cast<float>(minute % 1440) / 60.0F;
+            const float temperature = 18.0F + 4.0F * std::sin((hour - 9.0F) * 3.14159F / 12.0F);
+            const std::array<float, UPLINK_CHANNEL_COUNT> reading = {
+                temperature + 0.05F * noise(random), moisture + 0.1F * noise(random),
+                1200.0F + 8.0F * (moisture - 40.0F) + 2.0F * noise(random), 6.5F + 0.01F * noise(random),
+                120.0F + 0.4F * noise(random), 45.0F, NAN};
+            std::array<int16_t, UPLINK_CHANNEL_COUNT> values{};
+            for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+            {
+                values[channel] = quantizeUplinkValue(reading[channel], channel);
+            }
+            accumulator.addSample(values);
+        }
+        minutes.push_back(accumulator.finish());
+    }
+    return minutes;
+}
+
+bool sameRecord(const HistoryRecord& left, const HistoryRecord& right)
+{
+    return left.timestamp == right.timestamp && left.samples == right.samples && left.minimum == right.minimum &&
+           left.mean == right.mean && left.maximum == right.maximum;
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_round_trip_and_range()
+{
+    std::vector<HistoryRecord> records = makeMinutes(300, 7);
+    // Пропуск записи (устройство было выключено) и выпадение канала
+    records[100].timestamp += 3600;
+    for (size_t i = 101; i < records.size(); ++i)
+    {
+        records[i].timestamp += 3600;
+    }
+    records[150].minimum[2] = records[150].mean[2] = records[150].maximum[2] = UPLINK_VALUE_MISSING;
+    records[151].samples = 86400;
+
+    std::vector<uint8_t> block(BLOCK_CAPACITY);
+    const size_t size = encodeHistoryBlock(records.data(), records.size(), block.data(), block.size());
+    TEST_ASSERT_TRUE(size > 0);
+
+    uint32_t first = 0;
+    uint32_t last = 0;
+    TEST_ASSERT_TRUE(peekHistoryBlockRange(block.data(), HISTORY_BLOCK_RANGE_SIZE, first, last));
+    TEST_ASSERT_EQUAL_UINT32(records.front().timestamp, first);
+    TEST_ASSERT_EQUAL_UINT32(records.back().timestamp, last);
+
+    HistoryBlockReader reader;
+    TEST_ASSERT_TRUE(reader.open(block.data(), size));
+    TEST_ASSERT_EQUAL(records.size(), reader.pending());
+    HistoryRecord decoded{};
+    for (const HistoryRecord& expected : records)
+    {
+        TEST_ASSERT_TRUE(reader.next(decoded));
+        TEST_ASSERT_TRUE(sameRecord(expected, decoded));
+    }
+    TEST_ASSERT_FALSE(reader.next(decoded));
+
+    // Не помещается — 0; повреждённый или обрезанный блок не открывается
+    TEST_ASSERT_EQUAL(0, encodeHistoryBlock(records.data(), records.size(), block.data(), size - 1));
+    TEST_ASSERT_EQUAL(size, encodeHistoryBlock(records.data(), records.size(), block.data(), size));
+    block[size / 2] ^= 0x10;
+    TEST_ASSERT_FALSE(reader.open(block.data(), size));
+    block[size / 2] ^= 0x10;
+    TEST_ASSERT_FALSE(reader.open(block.data(), size - 1));
+}
+
+void test_compression_benchmark()
+{
+    const std::vector<HistoryRecord> week = makeMinutes(WEEK_MINUTES, 11);
+    std::vector<uint8_t> block(BLOCK_CAPACITY);
+    size_t compressed = 0;
+    size_t blocks = 0;
+    const auto encodeStart = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < week.size(); offset += BLOCK_RECORDS)
+    {
+        const size_t count = std::min(BLOCK_RECORDS, week.size() - offset);
+        const size_t size = encodeHistoryBlock(week.data() + offset, count, block.data(), block.size());
+        TEST_ASSERT_TRUE(size > 0);
+        compressed += size;
+        ++blocks;
+    }
+    const auto encodeTime = std::chrono::steady_clock::now() - encodeStart;
+
+    // Распаковка последнего блока, повторённая для всех блоков недели
+    const size_t lastCount = week.size() - (blocks - 1) * BLOCK_RECORDS;
+    const size_t lastSize = encodeHistoryBlock(week.data() + (blocks - 1) * BLOCK_RECORDS, lastCount, block.data(),
+                                               block.size());
+    const auto decodeStart = std::chrono::steady_clock::now();
+    size_t decoded = 0;
+    for (size_t i = 0; i < blocks; ++i)
+    {
+        HistoryBlockReader reader;
+        TEST_ASSERT_TRUE(reader.open(block.data(), lastSize));
+        HistoryRecord record{};
+        while (reader.next(record))
+        {
+            ++decoded;
+        }
+    }
+    const auto decodeTime = std::chrono::steady_clock::now() - decodeStart;
+    TEST_ASSERT_EQUAL(blocks * lastCount, decoded);
+
+    const double perRecord = static_cast<double>(compressed) / static_cast<double>(week.size());
+    const auto micros = [](std::chrono::steady_clock::duration duration)
+    { return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()); };
+    printf("history block: %zu records in %zu blocks, %zu bytes (%.2f B/record)\n", week.size(), blocks, compressed,
+           perRecord);
+    printf("  vs float %zu B/record: %.1fx, vs fixed record %zu B: %.1fx\n", FLOAT_RECORD_SIZE,
+           FLOAT_RECORD_SIZE / perRecord, HISTORY_RECORD_SIZE, HISTORY_RECORD_SIZE / perRecord);
+    printf("  encode %.0f ns/record, decode %.0f ns/record\n", micros(encodeTime) * 1000.0 / week.size(),
+           micros(decodeTime) * 1000.0 / decoded);
+
+    // Цель — в 10 раз больше истории на байт флеша, чем при хранении float
+    TEST_ASSERT_TRUE(FLOAT_RECORD_SIZE / perRecord >= 10.0);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_round_trip_and_range);
+    RUN_TEST(test_compression_benchmark);
+
+    return UNITY_END();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file test_history_record.cpp
+ * @brief Проверка записи архива: двоичный формат и свёртка показаний в минимум, среднее и максимум
+ */
+
+#include <unity.h>
+#include <array>
+#include "../../include/history_record.h"
+
+namespace
+{
+constexpr int16_t MISSING = UPLINK_VALUE_MISSING;
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_record_round_trip_and_crc()
+{
+    const HistoryRecord record{1751371200U,
+                               86400U,
+                               {-105, 400, 0, 550, MISSING, 10, 200},
+                               {215, 452, 1230, 672, MISSING, 45, 300},
+                               {330, 610, 2100, 701, MISSING, 90, INT16_MAX}};
+    std::array<uint8_t, HISTORY_RECORD_SIZE> raw{};
+    encodeHistoryRecord(record, raw.data());
+
+    HistoryRecord decoded{};
+    TEST_ASSERT_TRUE(decodeHistoryRecord(raw.data(), decoded));
+    TEST_ASSERT_EQUAL_UINT32(record.timestamp, decoded.timestamp);
+    TEST_ASSERT_EQUAL_UINT32(record.samples, decoded.samples);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(record.minimum.data(), decoded.minimum.data(), UPLINK_CHANNEL_COUNT);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(record.mean.data(), decoded.mean.data(), UPLINK_CHANNEL_COUNT);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(record.maximum.data(), decoded.maximum.data(), UPLINK_CHANNEL_COUNT);
+
+    raw[20] ^= 0x04;
+    TEST_ASSERT_FALSE(decodeHistoryRecord(raw.data(), decoded));
+}
+
+void test_rollup_matches_direct_aggregate()
+{
+    // Два «часа» по-разному заполненных показаний: 3 и 1 показание
+    HistoryAccumulator first;
+    first.reset(3600);
+    first.addSample({10, 20, 30, 40, 50, 60, 70});
+    first.addSample({20, 20, 30, 40, 50, 60, MISSING});
+    first.addSample({30, 20, 30, 40, 50, 60, MISSING});
+    HistoryAccumulator second;
+    second.reset(7200);
+    second.addSample({-50, 20, 30, 40, 50, 60, MISSING});
+
+    const HistoryRecord hour = first.finish();
+    TEST_ASSERT_EQUAL_UINT32(3, hour.samples);
+    TEST_ASSERT_EQUAL_INT16(10, hour.minimum[0]);
+    TEST_ASSERT_EQUAL_INT16(20, hour.mean[0]);
+    TEST_ASSERT_EQUAL_INT16(30, hour.maximum[0]);
+    TEST_ASSERT_EQUAL_INT16(70, hour.mean[6]);
+
+    // Среднее суток взвешено числом показаний: (10+20+30−50)/4 = 2.5 → 3
+    HistoryAccumulator day;
+    day.reset(0);
+    TEST_ASSERT_TRUE(day.empty());
+    day.addRecord(hour);
+    day.addRecord(second.finish());
+    const HistoryRecord total = day.finish();
+    TEST_ASSERT_EQUAL_UINT32(0, total.timestamp);
+    TEST_ASSERT_EQUAL_UINT32(4, total.samples);
+    TEST_ASSERT_EQUAL_INT16(-50, total.minimum[0]);
+    TEST_ASSERT_EQUAL_INT16(3, total.mean[0]);
+    TEST_ASSERT_EQUAL_INT16(30, total.maximum[0]);
+    TEST_ASSERT_EQUAL_INT16(70, total.minimum[6]);
+
+    // Канал без единого измерения остаётся пустым
+    HistoryAccumulator empty;
+    empty.reset(0);
+    empty.addSample({MISSING, MISSING, MISSING, MISSING, MISSING, MISSING, MISSING});
+    const HistoryRecord blank = empty.finish();
+    TEST_ASSERT_EQUAL_UINT32(1, blank.samples);
+    TEST_ASSERT_EQUAL_INT16(MISSING, blank.minimum[3]);
+    TEST_ASSERT_EQUAL_INT16(MISSING, blank.mean[3]);
+    TEST_ASSERT_EQUAL_INT16(MISSING, blank.maximum[3]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_record_round_trip_and_crc);
+    RUN_TEST(test_rollup_matches_direct_aggregate);
+
+    return UNITY_END();
+}
@@ -0,0 +1,61 @@
+/**
+ * @file test_json_delta.cpp
+ * @brief Проверка разницы JSON-объектов для потока показаний
+ */
+
+#include <unity.h>
+#include <array>
+#include <cstring>
+#include <string>
+#include "../../include/json_delta.h"
+
+namespace
+{
+std::string delta(const char* previous, const char* current)
+{
+    std::array<char, 256> buf{};
+    JsonWriter writer(buf.data(), buf.size());
+    writer.beginObject();
+    writeJsonDelta(writer, previous, strlen(previous), current, strlen(current));
+    writer.endObject();
+    return std::string(writer.data(), writer.size());
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_only_changed_members()
+{
+    TEST_ASSERT_EQUAL_STRING("{\"t\":\"21.5\",\"ts\":7}",
+                             delta("{\"t\":\"21.4\",\"h\":\"40.0\",\"ts\":6}", "{\"t\":\"21.5\",\"h\":\"40.0\",\"ts\":7}")
+                                 .c_str());
+    TEST_ASSERT_EQUAL_STRING("{}", delta("{\"a\":1,\"b\":true}", "{\"a\":1,\"b\":true}").c_str());
+}
+
+void test_empty_previous_gives_full_object()
+{
+    TEST_ASSERT_EQUAL_STRING("{\"a\":1,\"b\":\"x\"}", delta("", "{\"a\":1,\"b\":\"x\"}").c_str());
+}
+
+void test_strings_and_nested_values_are_atomic()
+{
+    // Запятые и скобки внутри строк и вложенных объектов не разбивают поле
+    const char* previous = "{\"alerts\":\"T, EC\",\"wifi\":{\"rssi\":-60,\"ip\":\"1.2.3.4\"},\"q\":\"a\\\"b\"}";
+    const char* current = "{\"alerts\":\"T, EC\",\"wifi\":{\"rssi\":-61,\"ip\":\"1.2.3.4\"},\"q\":\"a\\\"b\"}";
+    TEST_ASSERT_EQUAL_STRING("{\"wifi\":{\"rssi\":-61,\"ip\":\"1.2.3.4\"}}", delta(previous, current).c_str());
+
+    // Совпадает значение, но не имя
+    TEST_ASSERT_EQUAL_STRING("{\"ab\":1}", delta("{\"a\":1}", "{\"ab\":1}").c_str());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_only_changed_members);
+    RUN_TEST(test_empty_previous_gives_full_object);
+    RUN_TEST(test_strings_and_nested_values_are_atomic);
+
+    return UNITY_END();
+}
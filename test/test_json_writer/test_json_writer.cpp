@@ -0,0 +1,158 @@
+/**
+ * @file test_json_writer.cpp
+ * @brief Проверка JSON-писателя с фиксированным буфером против прежнего форматирования snprintf
+ */
+
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include "../../include/json_writer.h"
+
+namespace
+{
+// Эталон: прежний formatFloat() из jxct_format_utils.cpp
+std::string referenceFormat(float value, int precision)
+{
+    std::array<char, 32> buf{};
+    if (precision == 0)
+    {
+        snprintf(buf.data(), buf.size(), "%d", static_cast<int>(lround(value)));
+    }
+    else
+    {
+        snprintf(buf.data(), buf.size(), "%.*f", precision, value);
+    }
+    return std::string(buf.data());
+}
+
+std::string writeFixed(float value, uint8_t decimals)
+{
+    std::array<char, 64> buf{};
+    JsonWriter writer(buf.data(), buf.size());
+    writer.beginObject();
+    writer.memberFixed("v", value, decimals, false);
+    writer.endObject();
+    const std::string json(writer.data(), writer.size());
+    return json.substr(5, json.size() - 6);  // {"v":...}
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_fixed_matches_snprintf()
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-50.0F, 10000.0F);
+    for (int i = 0; i < 20000; ++i)
+    {
+        const float value = dist(rng);
+        for (const int decimals : {0, 1, 2})
+        {
+            TEST_ASSERT_EQUAL_STRING(referenceFormat(value, decimals).c_str(), writeFixed(value, decimals).c_str());
+        }
+    }
+}
+
+void test_fixed_edge_values()
+{
+    TEST_ASSERT_EQUAL_STRING("0.0", writeFixed(0.0F, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("-0.0", writeFixed(-0.01F, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("0", writeFixed(-0.01F, 0).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.2", writeFixed(0.25F, 1).c_str());  // Половина к чётному, как snprintf
+    TEST_ASSERT_EQUAL_STRING("3", writeFixed(2.5F, 0).c_str());     // Целые — как lround
+    TEST_ASSERT_EQUAL_STRING("-3.5", writeFixed(-3.5F, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("1.05", writeFixed(1.05F, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("null", writeFixed(NAN, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("null", writeFixed(INFINITY, 1).c_str());
+}
+
+void test_object_and_escaping()
+{
+    std::array<char, 128> buf{};
+    JsonWriter writer(buf.data(), buf.size());
+    writer.beginObject();
+    writer.member("season", "Лето");
+    writer.member("note", "a\"b\\c\n");
+    writer.member("valid", true);
+    writer.member("version", static_cast<uint32_t>(4000000000U));
+    writer.member("delta", static_cast<int32_t>(-12));
+    writer.memberFixed("ph", 6.72F, 1, true);
+    writer.endObject();
+
+    TEST_ASSERT_FALSE(writer.overflowed());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"season\":\"Лето\",\"note\":\"a\\\"b\\\\c\\u000a\",\"valid\":true,\"version\":4000000000,"
+        "\"delta\":-12,\"ph\":\"6.7\"}",
+        writer.data());
+}
+
+void test_members_fragment_and_overflow()
+{
+    std::array<char, 64> fragmentBuf{};
+    JsonWriter fragment(fragmentBuf.data(), fragmentBuf.size());
+    fragment.memberFixed("t", 21.35F, 1, true);
+    fragment.member("ok", false);
+
+    std::array<char, 64> buf{};
+    JsonWriter writer(buf.data(), buf.size());
+    writer.beginObject();
+    writer.member("probe", static_cast<uint32_t>(0));
+    writer.members(fragment.data(), fragment.size());
+    writer.member("ts", static_cast<uint32_t>(5));
+    writer.endObject();
+    TEST_ASSERT_EQUAL_STRING("{\"probe\":0,\"t\":\"21.4\",\"ok\":false,\"ts\":5}", writer.data());
+
+    std::array<char, 8> tiny{};
+    JsonWriter small(tiny.data(), tiny.size());
+    small.beginObject();
+    small.member("long_name", "value");
+    TEST_ASSERT_TRUE(small.overflowed());
+    TEST_ASSERT_TRUE(small.size() < tiny.size());
+    TEST_ASSERT_EQUAL('\0', tiny[small.size()]);
+}
+
+void test_array_of_objects()
+{
+    std::array<char, 128> buf{};
+    JsonWriter writer(buf.data(), buf.size());
+    writer.beginObject();
+    writer.member("n", static_cast<uint32_t>(2));
+    writer.beginArray("b");
+    for (uint32_t ts : {10U, 20U})
+    {
+        writer.beginObject();
+        writer.member("ts", ts);
+        writer.memberFixed("t", 21.5F, 1, false);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.member("last", true);
+    writer.beginArray("c");
+    writer.element("t");
+    writer.element(static_cast<uint32_t>(100));
+    writer.elementFixed(-6.75F, 2);
+    writer.elementFixed(NAN, 1);
+    writer.endArray();
+    writer.endObject();
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"n\":2,\"b\":[{\"ts\":10,\"t\":21.5},{\"ts\":20,\"t\":21.5}],\"last\":true,\"c\":[\"t\",100,-6.75,null]}",
+        writer.data());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fixed_matches_snprintf);
+    RUN_TEST(test_fixed_edge_values);
+    RUN_TEST(test_object_and_escaping);
+    RUN_TEST(test_members_fragment_and_overflow);
+    RUN_TEST(test_array_of_objects);
+
+    return UNITY_END();
+}
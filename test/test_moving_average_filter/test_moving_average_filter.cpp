@@ -0,0 +1,145 @@
+/**
+ * @file test_moving_average_filter.cpp
+ * @brief Сравнение инкрементального скользящего среднего/медианы с прежним полным пересчётом окна
+ */
+
+#include <unity.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "../../include/moving_average_filter.h"
+
+namespace
+{
+// Эталон: прежний алгоритм addToMovingAverage/calculateMovingAverage (полный пересчёт окна)
+struct ReferenceWindow
+{
+    std::array<float, 15> buffer{};
+    uint8_t index = 0;
+    uint8_t filled = 0;
+
+    float add(float value, uint8_t window, bool median)
+    {
+        buffer[index] = value;
+        index = (index + 1) % window;
+        if (filled < window)
+        {
+            filled++;
+        }
+        const uint8_t count = std::min(filled, window);
+        std::array<float, 15> values{};
+        std::copy(buffer.begin(), buffer.begin() + count, values.begin());
+        if (median)
+        {
+            std::sort(values.begin(), values.begin() + count);
+            return values[count / 2];
+        }
+        float sum = 0.0F;
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            sum += values[i];
+        }
+        return sum / count;
+    }
+};
+
+void compareWithReference(uint8_t window, bool median)
+{
+    std::mt19937 rng(window * 31U + (median ? 1U : 0U));
+    std::uniform_real_distribution<float> dist(0.0F, 2000.0F);
+
+    MovingAverageFilter filter;
+    filter.reset();
+    ReferenceWindow reference;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        // Частые повторы значений проверяют удаление дубликатов из отсортированного окна
+        const float value = (i % 7 == 0) ? 500.0F : dist(rng);
+        const float expected = reference.add(value, window, median);
+        const float actual = filter.add(value, window, median);
+        if (median)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(expected, actual);
+        }
+        else
+        {
+            TEST_ASSERT_FLOAT_WITHIN(0.05F, expected, actual);
+        }
+    }
+}
+}  // namespace
+
+void test_moving_average_matches_reference()
+{
+    for (uint8_t window = 5; window <= 15; ++window)
+    {
+        compareWithReference(window, false);
+    }
+    std::cout << "✅ Скользящее среднее совпадает с полным пересчётом" << std::endl;
+}
+
+void test_moving_median_matches_reference()
+{
+    for (uint8_t window = 5; window <= 15; ++window)
+    {
+        compareWithReference(window, true);
+    }
+    std::cout << "✅ Скользящая медиана совпадает с сортировкой окна" << std::endl;
+}
+
+void test_window_change_restarts_window()
+{
+    MovingAverageFilter filter;
+    filter.reset();
+    for (int i = 0; i < 10; ++i)
+    {
+        filter.add(100.0F, 10, false);
+    }
+    TEST_ASSERT_EQUAL(10, filter.size());
+
+    // После смены окна в расчёт входят только новые измерения
+    TEST_ASSERT_EQUAL_FLOAT(7.0F, filter.add(7.0F, 5, false));
+    TEST_ASSERT_EQUAL(1, filter.size());
+}
+
+void test_non_finite_samples_are_skipped()
+{
+    MovingAverageFilter filter;
+    filter.reset();
+    filter.add(10.0F, 5, false);
+    filter.add(20.0F, 5, false);
+    TEST_ASSERT_EQUAL_FLOAT(15.0F, filter.add(NAN, 5, false));
+    TEST_ASSERT_EQUAL_FLOAT(20.0F, filter.add(INFINITY, 5, true));
+    TEST_ASSERT_EQUAL(2, filter.size());
+    // Следующие средние не отравлены пропущенными значениями
+    TEST_ASSERT_EQUAL_FLOAT(20.0F, filter.add(30.0F, 5, false));
+}
+
+void test_large_window_capacity()
+{
+    BasicMovingAverageFilter<256> filter;
+    filter.reset();
+    for (int i = 1; i <= 1000; ++i)
+    {
+        filter.add(static_cast<float>(i), 256, false);
+    }
+    // Окно содержит 746..1001: среднее 873.5; затем 747..1002: верхняя медиана 747 + 128
+    TEST_ASSERT_FLOAT_WITHIN(0.01F, 873.5F, filter.add(1001.0F, 256, false));
+    TEST_ASSERT_EQUAL_FLOAT(875.0F, filter.add(1002.0F, 256, true));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_moving_average_matches_reference);
+    RUN_TEST(test_moving_median_matches_reference);
+    RUN_TEST(test_window_change_restarts_window);
+    RUN_TEST(test_non_finite_samples_are_skipped);
+    RUN_TEST(test_large_window_capacity);
+
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+/**
+ * @file test_reading_batch_codec.cpp
+ * @brief Проверка двоичного пакета показаний MQTT: точное восстановление, размер и защита от обрыва
+ */
+
+#include <unity.h>
+#include <array>
+#include <cstdlib>
+#include "../../include/reading_batch_codec.h"
+
+namespace
+{
+constexpr size_t SERIES_LENGTH = 60;
+
+// Показания раз в 10 секунд с медленным дрейфом, как у реального датчика
+std::array<UplinkRecord, SERIES_LENGTH> makeSeries()
+{
+    std::array<UplinkRecord, SERIES_LENGTH> series{};
+    srand(3);
+    UplinkRecord current{1751371200U, {215, 452, 1230, 672, 120, 45, 300}};
+    for (auto& record : series)
+    {
+        record = current;
+        current.timestamp += 10;
+        for (auto& value : current.values)
+        {
+            value = static_cast<int16_t>(value + rand() % 5 - 2);
+        }
+    }
+    return series;
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_varint_and_zigzag()
+{
+    std::array<uint8_t, VARINT_MAX_BYTES> buffer{};
+    const std::array<int64_t, 10> values = {0, -1, 1, -64, 63, 300, -70000, 4294967295, INT64_MIN, INT64_MAX};
+    for (const int64_t value : values)
+    {
+        size_t position = 0;
+        TEST_ASSERT_TRUE(putSignedVarint(value, buffer.data(), buffer.size(), position));
+        size_t readPosition = 0;
+        int64_t decoded = 0;
+        TEST_ASSERT_TRUE(getSignedVarint(buffer.data(), position, readPosition, decoded));
+        TEST_ASSERT_TRUE(decoded == value);
+        TEST_ASSERT_EQUAL(position, readPosition);
+    }
+    size_t position = 0;
+    TEST_ASSERT_TRUE(putSignedVarint(-2, buffer.data(), buffer.size(), position));
+    TEST_ASSERT_EQUAL(1, position);  // Малые разности — один байт
+}
+
+void test_batch_round_trip_and_size()
+{
+    auto series = makeSeries();
+    series[7].values[3] = UPLINK_VALUE_MISSING;  // Пропуск канала и несинхронизированное время
+    series[0].timestamp = 0;
+
+    std::array<uint8_t, READING_BATCH_HEADER_SIZE + SERIES_LENGTH * READING_BATCH_MAX_RECORD_SIZE> packet{};
+    const size_t size = encodeReadingBatch(series.data(), series.size(), packet.data(), packet.size());
+    TEST_ASSERT_TRUE(size > 0);
+    TEST_ASSERT_TRUE(size < SERIES_LENGTH * 10);  // В среднем меньше 10 байт на показание
+
+    std::array<UplinkRecord, SERIES_LENGTH> decoded{};
+    TEST_ASSERT_EQUAL(SERIES_LENGTH, decodeReadingBatch(packet.data(), size, decoded.data(), decoded.size()));
+    for (size_t i = 0; i < SERIES_LENGTH; ++i)
+    {
+        TEST_ASSERT_EQUAL(series[i].timestamp, decoded[i].timestamp);
+        for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+        {
+            TEST_ASSERT_EQUAL(series[i].values[channel], decoded[i].values[channel]);
+        }
+    }
+}
+
+void test_truncated_or_small_buffers_rejected()
+{
+    const auto series = makeSeries();
+    std::array<uint8_t, 1024> packet{};
+    const size_t size = encodeReadingBatch(series.data(), series.size(), packet.data(), packet.size());
+    std::array<UplinkRecord, SERIES_LENGTH> decoded{};
+
+    TEST_ASSERT_EQUAL(0, decodeReadingBatch(packet.data(), size - 1, decoded.data(), decoded.size()));
+    TEST_ASSERT_EQUAL(0, decodeReadingBatch(packet.data(), size, decoded.data(), SERIES_LENGTH - 1));
+    TEST_ASSERT_EQUAL(0, encodeReadingBatch(series.data(), series.size(), packet.data(), size - 1));
+    packet[0] = READING_BATCH_VERSION + 1;
+    TEST_ASSERT_EQUAL(0, decodeReadingBatch(packet.data(), size, decoded.data(), decoded.size()));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_varint_and_zigzag);
+    RUN_TEST(test_batch_round_trip_and_size);
+    RUN_TEST(test_truncated_or_small_buffers_rejected);
+
+    return UNITY_END();
+}
@@ -0,0 +1,52 @@
+/**
+ * @file test_reconnect_backoff.cpp
+ * @brief Проверка паузы переподключения: рост, предел, разброс и размыкатель
+ */
+
+#include <unity.h>
+#include "../../include/reconnect_backoff.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_delay_doubles_up_to_limit()
+{
+    ReconnectBackoff backoff(1000, 8000, 0, 60000);
+    // Ноль даёт половину предела, random == половине — весь предел
+    TEST_ASSERT_EQUAL_UINT32(1000, backoff.onFailure(500));
+    TEST_ASSERT_EQUAL_UINT32(2000, backoff.onFailure(1000));
+    TEST_ASSERT_EQUAL_UINT32(2000, backoff.onFailure(0));
+    TEST_ASSERT_EQUAL_UINT32(8000, backoff.onFailure(4000));
+    for (int i = 0; i < 100; ++i)
+    {
+        const uint32_t delay = backoff.onFailure(static_cast<uint32_t>(i) * 2654435761U);
+        TEST_ASSERT_TRUE(delay >= 4000 && delay <= 8000);
+    }
+    TEST_ASSERT_FALSE(backoff.isOpen());  // Без порога размыкатель не срабатывает
+}
+
+void test_circuit_opens_after_threshold_and_resets_on_success()
+{
+    ReconnectBackoff backoff(1000, 8000, 3, 60000);
+    backoff.onFailure(0);
+    backoff.onFailure(0);
+    TEST_ASSERT_FALSE(backoff.isOpen());
+    TEST_ASSERT_EQUAL_UINT32(30000, backoff.onFailure(0));
+    TEST_ASSERT_TRUE(backoff.isOpen());
+    TEST_ASSERT_EQUAL_UINT32(60000, backoff.onFailure(30000));  // Пробная попытка не удалась — снова открыт
+    TEST_ASSERT_EQUAL_UINT32(4, backoff.getConsecutiveFailures());
+
+    backoff.onSuccess();
+    TEST_ASSERT_FALSE(backoff.isOpen());
+    TEST_ASSERT_EQUAL_UINT32(500, backoff.onFailure(0));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_delay_doubles_up_to_limit);
+    RUN_TEST(test_circuit_opens_after_threshold_and_resets_on_success);
+
+    return UNITY_END();
+}
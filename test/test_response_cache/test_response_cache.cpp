@@ -0,0 +1,88 @@
+/**
+ * @file test_response_cache.cpp
+ * @brief Проверка кэша готовых ответов: совпадение меток, вытеснение и ETag
+ */
+
+#include <unity.h>
+#include <cstring>
+#include "../../include/response_cache.h"
+
+namespace
+{
+ResponseTag tagOf(uint32_t route, uint32_t generation, uint32_t configVersion = 1, uint32_t epoch = 0,
+                  uint32_t boot = 0)
+{
+    return ResponseTag{route, generation, configVersion, epoch, boot};
+}
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_hit_requires_identical_tag()
+{
+    ResponseCache<2, 16> cache;
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 5)));
+
+    TEST_ASSERT_NOT_NULL(cache.store(tagOf(1, 5), "{\"a\":1}", 7));
+    const auto* entry = cache.find(tagOf(1, 5));
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL(7, entry->length);
+    TEST_ASSERT_EQUAL(0, memcmp(entry->body.data(), "{\"a\":1}", 7));
+
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 6)));     // Новая публикация показаний
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 5, 2)));  // saveConfig()
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 5, 1, 3)));
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 5, 1, 0, 7)));  // Та же версия после перезагрузки
+    TEST_ASSERT_NULL(cache.find(tagOf(2, 5)));
+
+    cache.clear();
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 5)));
+}
+
+void test_route_reuses_its_slot_and_evicts_oldest()
+{
+    ResponseCache<2, 16> cache;
+    cache.store(tagOf(1, 1), "a", 1);
+    cache.store(tagOf(2, 1), "b", 1);
+    cache.store(tagOf(1, 2), "c", 1);  // Заменяет запись маршрута 1, маршрут 2 остаётся
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 1)));
+    TEST_ASSERT_NOT_NULL(cache.find(tagOf(1, 2)));
+    TEST_ASSERT_NOT_NULL(cache.find(tagOf(2, 1)));
+
+    cache.store(tagOf(3, 1), "d", 1);  // Свободных нет — вытесняется первая по порядку запись
+    TEST_ASSERT_NOT_NULL(cache.find(tagOf(3, 1)));
+    TEST_ASSERT_NULL(cache.find(tagOf(1, 2)));
+    TEST_ASSERT_NOT_NULL(cache.find(tagOf(2, 1)));
+
+    TEST_ASSERT_NULL(cache.store(tagOf(4, 1), "0123456789abcdefg", 17));  // Больше записи
+}
+
+void test_etag_format_and_matching()
+{
+    char etag[RESPONSE_ETAG_SIZE];
+    TEST_ASSERT_EQUAL(14, formatResponseETag(tagOf(0x101, 0x2a, 1, 0, 0xf), etag));
+    TEST_ASSERT_EQUAL_STRING("\"101-2a-1-0-f\"", etag);
+
+    TEST_ASSERT_EQUAL(RESPONSE_ETAG_SIZE - 1, formatResponseETag(tagOf(~0U, ~0U, ~0U, ~0U, ~0U), etag));
+
+    formatResponseETag(tagOf(1, 2, 3, 4, 5), etag);
+    TEST_ASSERT_TRUE(responseETagMatches("\"1-2-3-4-5\"", etag));
+    TEST_ASSERT_TRUE(responseETagMatches("\"x\", W/\"1-2-3-4-5\"", etag));
+    TEST_ASSERT_TRUE(responseETagMatches(" *", etag));
+    TEST_ASSERT_FALSE(responseETagMatches("\"1-2-3-4-55\"", etag));
+    TEST_ASSERT_FALSE(responseETagMatches("\"1-2-3-4-6\"", etag));  // ETag прошлой загрузки
+    TEST_ASSERT_FALSE(responseETagMatches("", etag));
+    TEST_ASSERT_FALSE(responseETagMatches(nullptr, etag));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_hit_requires_identical_tag);
+    RUN_TEST(test_route_reuses_its_slot_and_evicts_oldest);
+    RUN_TEST(test_etag_format_and_matching);
+
+    return UNITY_END();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_sliding_statistics.cpp
+ * @brief Сравнение скользящей статистики Уэлфорда с прежним двухпроходным расчётом окна
+ */
+
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "../../include/sliding_statistics.h"
+
+namespace
+{
+constexpr size_t WINDOW = 20;
+
+// Эталон: прежний updateStatistics (два прохода по окну на каждое измерение)
+struct ReferenceWindow
+{
+    std::array<float, WINDOW> values{};
+    size_t index = 0;
+    size_t filled = 0;
+    double mean = 0.0;
+    double std_dev = 0.0;
+
+    void add(float value)
+    {
+        values[index] = value;
+        index = (index + 1) % WINDOW;
+        if (filled < WINDOW)
+        {
+            filled++;
+        }
+        double sum = 0.0;
+        for (size_t i = 0; i < filled; ++i)
+        {
+            sum += values[i];
+        }
+        mean = sum / static_cast<double>(filled);
+        double squares = 0.0;
+        for (size_t i = 0; i < filled; ++i)
+        {
+            const double diff = values[i] - mean;
+            squares += diff * diff;
+        }
+        std_dev = std::sqrt(squares / static_cast<double>(filled));
+    }
+};
+
+void compareWithReference(float offset, float spread, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(offset, spread);
+
+    SlidingStatistics<WINDOW> stats;
+    ReferenceWindow reference;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const float value = dist(rng);
+        stats.add(value);
+        reference.add(value);
+
+        TEST_ASSERT_EQUAL(reference.filled, stats.size());
+        TEST_ASSERT_EQUAL_FLOAT(value, stats.last());
+        // Допуск относительно масштаба данных: float против эталона в double
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F * (std::fabs(offset) + spread), static_cast<float>(reference.mean),
+                                 stats.mean());
+        TEST_ASSERT_FLOAT_WITHIN(2e-3F * spread + 1e-4F * std::fabs(offset),
+                                 static_cast<float>(reference.std_dev), stats.stddev());
+    }
+}
+}  // namespace
+
+void test_statistics_match_two_pass()
+{
+    compareWithReference(25.0F, 3.0F, 1U);     // Температура
+    compareWithReference(6.5F, 0.2F, 2U);      // pH
+    std::cout << "✅ Скользящие среднее и σ совпадают с двухпроходным расчётом" << std::endl;
+}
+
+void test_statistics_stable_with_large_offset()
+{
+    // EC: большое смещение и малый разброс — худший случай для наивной формулы Σx² − n·μ²
+    compareWithReference(1500.0F, 5.0F, 3U);
+    std::cout << "✅ σ остаётся точной при большом смещении значений" << std::endl;
+}
+
+void test_constant_signal_has_zero_deviation()
+{
+    SlidingStatistics<WINDOW> stats;
+    for (int i = 0; i < 1000; ++i)
+    {
+        stats.add(i < 500 ? 1234.5F : 0.1F);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3F, 0.1F, stats.mean());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3F, 0.0F, stats.stddev());
+}
+
+void test_reset_clears_window()
+{
+    SlidingStatistics<WINDOW> stats;
+    stats.add(10.0F);
+    stats.add(20.0F);
+    stats.reset();
+    TEST_ASSERT_EQUAL(0, stats.size());
+    stats.add(5.0F);
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, stats.mean());
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, stats.stddev());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_statistics_match_two_pass);
+    RUN_TEST(test_statistics_stable_with_large_offset);
+    RUN_TEST(test_constant_signal_has_zero_deviation);
+    RUN_TEST(test_reset_clears_window);
+
+    return UNITY_END();
+}
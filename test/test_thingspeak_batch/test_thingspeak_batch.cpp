@@ -0,0 +1,122 @@
+/**
+ * @file test_thingspeak_batch.cpp
+ * @brief Проверка отбора пакета ThingSpeak: прореживание до интервала и догоняние очереди под потоком показаний
+ */
+
+#include <unity.h>
+#include <deque>
+#include "../../include/thingspeak_batch.h"
+
+void setUp() {}
+void tearDown() {}
+
+namespace
+{
+// Те же пределы, что UPLINK_THINGSPEAK_* в jxct_constants.h
+constexpr size_t BATCH_RECORDS = 50;
+constexpr size_t READ_RECORDS = 25;
+constexpr size_t SCAN_RECORDS = 960;
+constexpr uint32_t DRAIN_SECONDS = 15;
+constexpr uint32_t READ_SECONDS = 2;
+constexpr uint32_t INTERVAL_SECONDS = 600;
+
+UplinkRecord recordAt(uint32_t timestamp)
+{
+    UplinkRecord record{};
+    record.timestamp = timestamp;
+    return record;
+}
+
+// Один запрос догоняния, как в sendBacklog(): кусками, пока пакет и лимит просмотра позволяют
+size_t drainOnce(std::deque<UplinkRecord>& queue, uint32_t& lastSent, std::deque<uint32_t>& sent)
+{
+    ThingSpeakBatchSelector selector(lastSent, INTERVAL_SECONDS, BATCH_RECORDS, SCAN_RECORDS);
+    size_t position = 0;
+    while (selector.wantsChunk(READ_RECORDS) && position < queue.size())
+    {
+        for (size_t i = 0; i < READ_RECORDS && position < queue.size(); ++i, ++position)
+        {
+            if (selector.take(queue[position]))
+            {
+                sent.push_back(queue[position].timestamp);
+            }
+        }
+    }
+    queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(position));
+    lastSent = selector.lastSelected();
+    return selector.entryCount();
+}
+}  // namespace
+
+void test_selects_one_reading_per_interval()
+{
+    ThingSpeakBatchSelector selector(1000, 600, BATCH_RECORDS, SCAN_RECORDS);
+    TEST_ASSERT_FALSE(selector.take(recordAt(1300)));  // Раньше интервала после последней отправки
+    TEST_ASSERT_TRUE(selector.take(recordAt(1600)));
+    TEST_ASSERT_FALSE(selector.take(recordAt(0)));  // Без метки времени не отправляется
+    TEST_ASSERT_FALSE(selector.take(recordAt(2199)));
+    TEST_ASSERT_TRUE(selector.take(recordAt(500)));  // Часы ушли назад — отсчёт заново
+    TEST_ASSERT_EQUAL_UINT32(2, selector.entryCount());
+    TEST_ASSERT_EQUAL_UINT32(5, selector.scannedCount());
+    TEST_ASSERT_EQUAL_UINT32(500, selector.lastSelected());
+}
+
+void test_chunk_refused_when_batch_could_overflow()
+{
+    ThingSpeakBatchSelector selector(0, 0, 30, SCAN_RECORDS);
+    TEST_ASSERT_TRUE(selector.wantsChunk(READ_RECORDS));
+    for (uint32_t i = 1; i <= READ_RECORDS; ++i)
+    {
+        selector.take(recordAt(i));
+    }
+    TEST_ASSERT_FALSE(selector.wantsChunk(READ_RECORDS));  // 25 + 25 > 30
+}
+
+void test_backlog_drains_while_readings_keep_arriving()
+{
+    // Несколько часов без связи при опросе раз в 2 с
+    std::deque<UplinkRecord> queue;
+    uint32_t now = 1700000000;
+    for (size_t i = 0; i < 6000; ++i)
+    {
+        queue.push_back(recordAt(now));
+        now += READ_SECONDS;
+    }
+
+    uint32_t lastSent = 0;
+    std::deque<uint32_t> sent;
+    size_t drains = 0;
+    uint32_t lastDrain = 0;
+    for (uint32_t elapsed = 0; elapsed < 3600; elapsed += READ_SECONDS)
+    {
+        queue.push_back(recordAt(now));
+        now += READ_SECONDS;
+        // Таймер догоняния — как в handleThingSpeakBacklog(): не чаще раза в 15 с
+        if (elapsed - lastDrain >= DRAIN_SECONDS)
+        {
+            TEST_ASSERT_TRUE(drainOnce(queue, lastSent, sent) <= BATCH_RECORDS);
+            lastDrain = elapsed;
+            ++drains;
+        }
+    }
+
+    // Очередь свелась к показаниям, пришедшим после последнего запроса
+    TEST_ASSERT_TRUE(queue.size() <= DRAIN_SECONDS / READ_SECONDS + 2);
+    TEST_ASSERT_TRUE(drains > 0);
+    TEST_ASSERT_TRUE(sent.size() > 20);
+    for (size_t i = 1; i < sent.size(); ++i)
+    {
+        TEST_ASSERT_TRUE(sent[i] - sent[i - 1] >= INTERVAL_SECONDS);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_selects_one_reading_per_interval);
+    RUN_TEST(test_chunk_refused_when_batch_could_overflow);
+    RUN_TEST(test_backlog_drains_while_readings_keep_arriving);
+
+    return UNITY_END();
+}
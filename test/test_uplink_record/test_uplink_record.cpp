@@ -0,0 +1,79 @@
+/**
+ * @file test_uplink_record.cpp
+ * @brief Проверка записи очереди отправки: квантование, двоичный формат и обнаружение повреждений
+ */
+
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include "../../include/uplink_record.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_quantization_matches_sensor_resolution()
+{
+    TEST_ASSERT_EQUAL(215, quantizeUplinkValue(21.49F, 0));    // Температура — десятые
+    TEST_ASSERT_EQUAL(-123, quantizeUplinkValue(-12.3F, 0));
+    TEST_ASSERT_EQUAL(672, quantizeUplinkValue(6.72F, 3));     // pH — сотые
+    TEST_ASSERT_EQUAL(1999, quantizeUplinkValue(1999.2F, 4));  // NPK — целые
+    TEST_ASSERT_EQUAL(INT16_MAX, quantizeUplinkValue(1e6F, 2));
+    TEST_ASSERT_EQUAL(INT16_MIN + 1, quantizeUplinkValue(-1e6F, 2));  // Не путается с «нет значения»
+    TEST_ASSERT_EQUAL(UPLINK_VALUE_MISSING, quantizeUplinkValue(NAN, 1));
+
+    TEST_ASSERT_TRUE(std::fabs(restoreUplinkValue(672, 3) - 6.72F) < 1e-6F);
+    TEST_ASSERT_TRUE(std::isnan(restoreUplinkValue(UPLINK_VALUE_MISSING, 3)));
+}
+
+void test_record_round_trip()
+{
+    UplinkRecord record{};
+    record.timestamp = 1751371200U;
+    record.values = {215, 452, 1230, 672, 120, UPLINK_VALUE_MISSING, 1999};
+
+    std::array<uint8_t, UPLINK_RECORD_SIZE> raw{};
+    encodeUplinkRecord(record, raw.data());
+    TEST_ASSERT_EQUAL(0xC0, raw[0]);  // little-endian: младший байт времени первым
+
+    UplinkRecord decoded{};
+    TEST_ASSERT_TRUE(decodeUplinkRecord(raw.data(), decoded));
+    TEST_ASSERT_EQUAL(record.timestamp, decoded.timestamp);
+    for (size_t channel = 0; channel < UPLINK_CHANNEL_COUNT; ++channel)
+    {
+        TEST_ASSERT_EQUAL(record.values[channel], decoded.values[channel]);
+    }
+}
+
+void test_corruption_is_detected()
+{
+    UplinkRecord record{};
+    record.timestamp = 42;
+    record.values = {1, 2, 3, 4, 5, 6, 7};
+    std::array<uint8_t, UPLINK_RECORD_SIZE> raw{};
+    encodeUplinkRecord(record, raw.data());
+
+    // Любой изменённый бит, как и недописанная (стёртая до 0xFF) запись, отбрасывается
+    UplinkRecord decoded{};
+    for (size_t byte = 0; byte < raw.size(); ++byte)
+    {
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            raw[byte] ^= static_cast<uint8_t>(1U << bit);
+            TEST_ASSERT_FALSE(decodeUplinkRecord(raw.data(), decoded));
+            raw[byte] ^= static_cast<uint8_t>(1U << bit);
+        }
+    }
+    raw.fill(0xFF);
+    TEST_ASSERT_FALSE(decodeUplinkRecord(raw.data(), decoded));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_quantization_matches_sensor_resolution);
+    RUN_TEST(test_record_round_trip);
+    RUN_TEST(test_corruption_is_detected);
+
+    return UNITY_END();
+}
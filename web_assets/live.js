@@ -0,0 +1,13 @@
+// Подписка на поток изменений /events/*: сервер присылает объект целиком при подключении,
+// затем только изменившиеся поля; полное состояние собирается здесь и передаётся в render.
+// Без EventSource или при отказе сервера (заняты все слоты) — прежний периодический опрос JSON.
+function liveSubscribe(stream, eventName, pollUrl, pollInterval, render) {
+  var state = {};
+  function apply(delta) { Object.assign(state, delta); render(state); }
+  function poll() { fetch(pollUrl).then(function (r) { return r.json(); }).then(apply); }
+  function fallback() { poll(); setInterval(poll, pollInterval); }
+  if (!window.EventSource) { fallback(); return; }
+  var source = new EventSource(stream);
+  source.addEventListener(eventName, function (e) { apply(JSON.parse(e.data)); });
+  source.onerror = function () { if (source.readyState === EventSource.CLOSED) { fallback(); } };
+}
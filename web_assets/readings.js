@@ -0,0 +1,17 @@
+function set(id,v){if(v!==undefined&&v!==null){document.getElementById(id).textContent=v;}}
+function colorDelta(a,b){var diff=Math.abs(a-b)/b*100;if(diff>30)return 'red';if(diff>20)return 'orange';if(diff>10)return 'yellow';return '';}
+function colorRange(v,min,max){var span=(max-min);if(span<=0)return '';if(v<min||v>max)return 'red';if(v<min+0.05*span||v>max-0.05*span)return 'orange';if(v<min+0.10*span||v>max-0.10*span)return 'yellow';return '';}
+function applyColor(spanId,cls){var el=document.getElementById(spanId);if(!el)return;el.classList.remove('red','orange','yellow','green');if(cls){el.classList.add(cls);}else{el.classList.add('green');}}var limits={temp:{min:-45,max:115},hum:{min:0,max:100},ec:{min:0,max:10000},ph:{min:3,max:9},n:{min:0,max:1999},p:{min:0,max:1999},k:{min:0,max:1999}};
+function renderSensor(d){set('temp_raw',d.raw_temperature);set('hum_raw',d.raw_humidity);set('ec_raw',d.raw_ec);set('ph_raw',d.raw_ph);set('n_raw',d.raw_nitrogen);set('p_raw',d.raw_phosphorus);set('k_raw',d.raw_potassium);set('temp_rec',d.rec_temperature);set('hum_rec',d.rec_humidity);set('ec_rec',d.rec_ec);set('ph_rec',d.rec_ph);set('n_rec',d.rec_nitrogen);set('p_rec',d.rec_phosphorus);set('k_rec',d.rec_potassium);const tol={temp:0.2,hum:0.5,ec:20,ph:0.05,n:5,p:3,k:3};
+function arrowSign(base,val,thr){base=parseFloat(base);val=parseFloat(val);if(isNaN(base)||isNaN(val))return '';if(val>base+thr)return '↑ ';if(val<base-thr)return '↓ ';return '';};
+function showWithArrow(id,sign,value){document.getElementById(id).textContent=sign+value;}showWithArrow('temp', arrowSign(d.raw_temperature ,d.temperature ,tol.temp), d.temperature);showWithArrow('hum',  arrowSign(d.raw_humidity    ,d.humidity    ,tol.hum ), d.humidity);showWithArrow('ec',   arrowSign(d.raw_ec          ,d.ec          ,tol.ec  ), d.ec);showWithArrow('ph',   arrowSign(d.raw_ph          ,d.ph          ,tol.ph  ), d.ph);showWithArrow('n',    arrowSign(d.raw_nitrogen    ,d.nitrogen    ,tol.n   ), d.nitrogen);showWithArrow('p',    arrowSign(d.raw_phosphorus  ,d.phosphorus  ,tol.p   ), d.phosphorus);showWithArrow('k',    arrowSign(d.raw_potassium   ,d.potassium   ,tol.k   ), d.potassium);showWithArrow('temp_rec', arrowSign(d.temperature ,d.rec_temperature ,tol.temp), d.rec_temperature);showWithArrow('hum_rec',  arrowSign(d.humidity    ,d.rec_humidity    ,tol.hum ), d.rec_humidity);showWithArrow('ec_rec',   arrowSign(d.ec          ,d.rec_ec          ,tol.ec  ), d.rec_ec);showWithArrow('ph_rec',   arrowSign(d.ph          ,d.rec_ph          ,tol.ph  ), d.rec_ph);showWithArrow('n_rec',    arrowSign(d.nitrogen    ,d.rec_nitrogen    ,tol.n   ), d.rec_nitrogen);showWithArrow('p_rec',    arrowSign(d.phosphorus  ,d.rec_phosphorus  ,tol.p   ), d.rec_phosphorus);showWithArrow('k_rec',    arrowSign(d.potassium   ,d.rec_potassium   ,tol.k   ), d.rec_potassium);
+function updateSeasonalAdjustments(season) {  const adjustments = {    'Весна': { n: '+20%', p: '+15%', k: '+10%' },    'Лето': { n: '-10%', p: '+5%', k: '+25%' },    'Осень': { n: '-20%', p: '+10%', k: '+15%' },    'Зима': { n: '-30%', p: '+5%', k: '+5%' }  };  const adj = adjustments[season] || { n: '', p: '', k: '' };  ['n', 'p', 'k'].forEach(elem => {    const span = document.getElementById(elem + '_season');    if(span) {      span.textContent = adj[elem] ? ` (${adj[elem]})` : '';      span.className = 'season-adj ' + (adj[elem].startsWith('+') ? 'up' : 'down');    }  });}var invalid = d.irrigation || d.alerts.length>0 || d.humidity<25 || d.temperature<5 || d.temperature>40;var statusHtml = invalid ? '<span class="red">Данные&nbsp;не&nbsp;валидны</span>' : '<span class="green">Данные&nbsp;валидны</span>';var seasonColor={'Лето':'green','Весна':'yellow','Осень':'yellow','Зима':'red','Н/Д':''}[d.season]||'';var seasonHtml=seasonColor?(`<span class=\"${seasonColor}\">${d.season}</span>`):d.season;document.getElementById('statusInfo').innerHTML=statusHtml+' | Сезон: '+seasonHtml;updateSeasonalAdjustments(d.season);var tvr=parseFloat(d.raw_temperature);applyColor('temp_raw',colorRange(tvr,limits.temp.min,limits.temp.max));var hvr=parseFloat(d.raw_humidity);applyColor('hum_raw',colorRange(hvr,limits.hum.min,limits.hum.max));var evr=parseFloat(d.raw_ec);applyColor('ec_raw',colorRange(evr,limits.ec.min,limits.ec.max));var pvr=parseFloat(d.raw_ph);applyColor('ph_raw',colorRange(pvr,limits.ph.min,limits.ph.max));var nvr=parseFloat(d.raw_nitrogen);applyColor('n_raw',colorRange(nvr,limits.n.min,limits.n.max));var p2r=parseFloat(d.raw_phosphorus);applyColor('p_raw',colorRange(p2r,limits.p.min,limits.p.max));var kvr=parseFloat(d.raw_potassium);applyColor('k_raw',colorRange(kvr,limits.k.min,limits.k.max));['temp','hum','ec','ph','n','p','k'].forEach(function(id){var el=document.getElementById(id);if(el){el.classList.remove('red','orange','yellow','green');}});var ct=parseFloat(d.temperature);var ch=parseFloat(d.humidity);var ce=parseFloat(d.ec);var cph=parseFloat(d.ph);var cn=parseFloat(d.nitrogen);var cp=parseFloat(d.phosphorus);var ck=parseFloat(d.potassium);applyColor('temp_rec', colorDelta(ct, parseFloat(d.rec_temperature)));applyColor('hum_rec',  colorDelta(ch, parseFloat(d.rec_humidity)));applyColor('ec_rec',   colorDelta(ce, parseFloat(d.rec_ec)));applyColor('ph_rec',   colorDelta(cph,parseFloat(d.rec_ph)));applyColor('n_rec',    colorDelta(cn, parseFloat(d.rec_nitrogen)));applyColor('p_rec',    colorDelta(cp, parseFloat(d.rec_phosphorus)));applyColor('k_rec',    colorDelta(ck, parseFloat(d.rec_potassium)));}
+function updateCalibrationStatus() {  fetch('/api/calibration/status')    .then(response => response.json())    .then(data => {      document.getElementById('calibration-status').innerHTML = data.status;    });}
+function addPHPoint() {  const expected = parseFloat(document.getElementById('ph_expected').value);  const measured = parseFloat(document.getElementById('ph_measured').value);  fetch('/api/calibration/ph/add', {    method: 'POST',    headers: {'Content-Type': 'application/json'},    body: JSON.stringify({expected: expected, measured: measured})  }).then(response => response.json())    .then(data => {      if(data.success) {        updateCalibrationStatus();        document.getElementById('ph_expected').value = '';        document.getElementById('ph_measured').value = '';      }    });}
+function addECPoint() {  const expected = parseFloat(document.getElementById('ec_expected').value);  const measured = parseFloat(document.getElementById('ec_measured').value);  fetch('/api/calibration/ec/add', {    method: 'POST',    headers: {'Content-Type': 'application/json'},    body: JSON.stringify({expected: expected, measured: measured})  }).then(response => response.json())    .then(data => {      if(data.success) {        updateCalibrationStatus();        document.getElementById('ec_expected').value = '';        document.getElementById('ec_measured').value = '';      }    });}
+function setNPKPoint() {  const n = parseFloat(document.getElementById('npk_n').value);  const p = parseFloat(document.getElementById('npk_p').value);  const k = parseFloat(document.getElementById('npk_k').value);  fetch('/api/calibration/npk/set', {    method: 'POST',    headers: {'Content-Type': 'application/json'},    body: JSON.stringify({n: n, p: p, k: k})  }).then(response => response.json())    .then(data => {      if(data.success) {        updateCalibrationStatus();        document.getElementById('npk_n').value = '';        document.getElementById('npk_p').value = '';        document.getElementById('npk_k').value = '';      }    });}
+function calculatePH() {  fetch('/api/calibration/ph/calculate', {method: 'POST'})    .then(response => response.json())    .then(data => {      if(data.success) {        updateCalibrationStatus();        alert('pH калибровка рассчитана! R² = ' + data.r_squared);      }    });}
+function calculateEC() {  fetch('/api/calibration/ec/calculate', {method: 'POST'})    .then(response => response.json())    .then(data => {      if(data.success) {        updateCalibrationStatus();        alert('EC калибровка рассчитана! R² = ' + data.r_squared);      }    });}
+function exportCalibration() {  fetch('/api/calibration/export')    .then(response => response.json())    .then(data => {      const blob = new Blob([JSON.stringify(data, null, 2)], {type: 'application/json'});      const url = URL.createObjectURL(blob);      const a = document.createElement('a');      a.href = url;      a.download = 'calibration.json';      a.click();    });}
+function importCalibration() {  const input = document.createElement('input');  input.type = 'file';  input.accept = '.json';  input.onchange = function(e) {    const file = e.target.files[0];    const reader = new FileReader();    reader.onload = function(e) {      fetch('/api/calibration/import', {        method: 'POST',        headers: {'Content-Type': 'application/json'},        body: e.target.result      }).then(response => response.json())        .then(data => {          if(data.success) {            updateCalibrationStatus();            alert('Калибровка импортирована!');          }        });    };    reader.readAsText(file);  };  input.click();}
+function resetCalibration() {  if(confirm('Сбросить всю калибровку?')) {    fetch('/api/calibration/reset', {method: 'POST'})      .then(response => response.json())      .then(data => {        if(data.success) {          updateCalibrationStatus();          alert('Калибровка сброшена!');        }      });  }}liveSubscribe('/events/readings','reading','/sensor_json',3000,renderSensor);updateCalibrationStatus();setInterval(updateCalibrationStatus, 10000);